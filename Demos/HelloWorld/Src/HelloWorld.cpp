@@ -60,6 +60,7 @@ bool DemoApp::Init(const DemoInitDesc& desc)
 	RenderDog::InitDesc renderDogDesc;
 	renderDogDesc.wndDesc = desc.wndDesc;
 	renderDogDesc.pMainCamera = m_pFPSCamera;
+	renderDogDesc.bRenderThread = true;
 	if (!m_pRenderDog->Init(renderDogDesc))
 	{
 		MessageBox(nullptr, "RenderDog Init Failed!", "ERROR", MB_OK);
@@ -110,6 +111,9 @@ bool DemoApp::Init(const DemoInitDesc& desc)
 
 void DemoApp::Release()
 {
+	//Ⱦܻ߳̿ڻһ֡ͷųԴ֮ǰҪ
+	RenderDog::g_pIFramework->FlushRendering();
+
 	RenderDog::g_pRDFbxImporter->Release();
 
 	if (m_pGridLine)
@@ -16,6 +16,7 @@ cbuffer ComVar_ConstantBuffer_ViewParam
 cbuffer ComVar_ConstantBuffer_PerObject
 {
 	row_major matrix	ComVar_Matrix_LocalToWorld;
+	row_major matrix	ComVar_Matrix_LocalToWorldNormal;
 };
 
 cbuffer ComVar_ConstantBuffer_BoneTransforms
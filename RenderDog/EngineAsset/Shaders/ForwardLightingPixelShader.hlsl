@@ -48,8 +48,8 @@ float4 Main(VSOutput VsOutput) : SV_Target
 	float3 SpecularColor = LocFunc_Lighting_GetSpecularColor(BaseColor, Specular, Metallic);
 	float3 DirectionalLighting = ComFunc_Lighting_DirectionalLighting(NoH, NoV, NoL, HoV, BaseColor, SpecularColor, Metallic, Roughness);
 	//Shadow
-	float3 ShadowPos = VsOutput.ShadowPos.xyz / VsOutput.ShadowPos.w;
-	float ShadowFactor = ComFunc_ShadowDepth_GetShadowFactor(ShadowPos);
+	float3 ShadowViewPos = VsOutput.ShadowPos.xyz / VsOutput.ShadowPos.w;
+	float ShadowFactor = ComFunc_ShadowDepth_GetShadowFactor(ShadowViewPos);
 	DirectionalLighting *= ShadowFactor;
 
 	float3 EnvironmentLighting = ComFunc_Lighting_EnvReflection(NoV, WorldNormal, EyeDir, BaseColor, SpecularColor, Metallic, Roughness);
@@ -5,6 +5,8 @@
 ////////////////////////////////////////
 
 #define PCF_SAMPLE_COUNT 9
+//GlobalValue.hеg_ShadowCascadeNumһ£2x2Ӱͼ
+#define SHADOW_CASCADE_NUM 4
 
 Texture2D				ComVar_Texture_ShadowDepthTexture;
 SamplerComparisonState	ComVar_Texture_ShadowDepthTextureSampler;
@@ -12,30 +14,60 @@ SamplerComparisonState	ComVar_Texture_ShadowDepthTextureSampler;
 cbuffer ComVar_ConstantBuffer_ShadowParam
 {
 	float4 ComVar_Vector_ShadowParam0;
+	float4 ComVar_Vector_ShadowCascadeScales[SHADOW_CASCADE_NUM];
+	float4 ComVar_Vector_ShadowCascadeOffsets[SHADOW_CASCADE_NUM];
 };
 
+//ӰʱΪԴ۲ĳһͶӰɫʱͶӰΪλ
 cbuffer ComVar_ConstantBuffer_ShadowMatrixs
 {
 	row_major matrix ComVar_Matrix_ShadowView;
 	row_major matrix ComVar_Matrix_ShadowProjection;
 }
 
-#define ComVar_ShadowDepth_Offset	ComVar_Vector_ShadowParam0.x
-#define ComVar_ShadowDepth_RTSize	ComVar_Vector_ShadowParam0.y
+#define ComVar_ShadowDepth_Offset		ComVar_Vector_ShadowParam0.x
+#define ComVar_ShadowDepth_RTSize		ComVar_Vector_ShadowParam0.y
+#define ComVar_ShadowDepth_CascadeNum	ComVar_Vector_ShadowParam0.z
 
-float ComFunc_ShadowDepth_GetShadowFactor(float3 ShadowPos)
+//ShadowViewPosΪԴ۲ռеλ
+float ComFunc_ShadowDepth_GetShadowFactor(float3 ShadowViewPos)
 {
-	//Shadow
+	//ѡصĵһԽǰļԽ
+	int CascadeIndex = SHADOW_CASCADE_NUM;
+	float3 ShadowPos = float3(0.0f, 0.0f, 0.0f);
+	[unroll]
+	for (int c = SHADOW_CASCADE_NUM - 1; c >= 0; --c)
+	{
+		float3 CascadePos = ShadowViewPos * ComVar_Vector_ShadowCascadeScales[c].xyz + ComVar_Vector_ShadowCascadeOffsets[c].xyz;
+		if (c < ComVar_ShadowDepth_CascadeNum && all(abs(CascadePos.xy) < 1.0f))
+		{
+			CascadeIndex = c;
+			ShadowPos = CascadePos;
+		}
+	}
+
+	//ӰزӰ
+	if (CascadeIndex == SHADOW_CASCADE_NUM)
+	{
+		return 1.0f;
+	}
+
+	const float dx = 1.0f / ComVar_ShadowDepth_RTSize;
+
+	//PCFĲԽһͼеı߽
 	float2 ShadowTex = float2(ShadowPos.x * 0.5f + 0.5f, 0.5f - ShadowPos.y * 0.5f);
+	ShadowTex = clamp(ShadowTex, dx, 1.0f - dx);
+	ShadowTex = (ShadowTex + float2(CascadeIndex & 1, CascadeIndex >> 1)) * 0.5f;
 
 	float sceneDepthInLightSpace = ShadowPos.z - ComVar_ShadowDepth_Offset;
 	
-	const float dx = 1.0f / ComVar_ShadowDepth_RTSize;
+	//ͼı߳ÿһ
+	const float atlasDx = 0.5f * dx;
 	const float2 sampleOffset[PCF_SAMPLE_COUNT] =
 	{
-		float2(-dx, -dx), float2(0.0f, -dx), float2(+dx, -dx),
-		float2(-dx, 0.0f), float2(0.0f, 0.0f), float2(+dx, 0.0f),
-		float2(-dx, +dx), float2(0.0f, +dx), float2(+dx, +dx)
+		float2(-atlasDx, -atlasDx), float2(0.0f, -atlasDx), float2(+atlasDx, -atlasDx),
+		float2(-atlasDx, 0.0f), float2(0.0f, 0.0f), float2(+atlasDx, 0.0f),
+		float2(-atlasDx, +atlasDx), float2(0.0f, +atlasDx), float2(+atlasDx, +atlasDx)
 	};
 
 	float ShadowFactor = 0.0f;
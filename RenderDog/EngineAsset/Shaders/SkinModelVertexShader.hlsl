@@ -59,11 +59,11 @@ VSOutput Main(VSInput vsInput)
 	vsOutput.PosH = mul(vsOutput.PosH, ComVar_Matrix_WorldToView);
 	vsOutput.PosH = mul(vsOutput.PosH, ComVar_Matrix_ViewToClip);
 
-	float4 WorldNormal = mul(float4(normal, 0.0f), ComVar_Matrix_LocalToWorld);
-	vsOutput.Normal = normalize(normal.xyz);
+	float4 WorldNormal = mul(float4(normal, 0.0f), ComVar_Matrix_LocalToWorldNormal);
+	vsOutput.Normal = normalize(WorldNormal.xyz);
 
-	float4 WorldTangent = mul(float4(tangent, 1.0f), ComVar_Matrix_LocalToWorld);
-	vsOutput.Tangent = normalize(tangent.xyz);
+	float4 WorldTangent = mul(float4(tangent, 0.0f), ComVar_Matrix_LocalToWorld);
+	vsOutput.Tangent = normalize(WorldTangent.xyz);
 
 	float3 WorldBiTangent = cross(WorldNormal.xyz, WorldTangent.xyz) * vsInput.Tangent.w;
 	vsOutput.BiTangent = normalize(WorldBiTangent);
@@ -40,7 +40,7 @@ VSOutput Main(VSInput VsInput)
 	VsOutput.PosH = mul(VsOutput.PosH, ComVar_Matrix_ViewToClip);
 
 	float4 normal = float4(VsInput.Normal, 0.0f);
-	normal = mul(normal, ComVar_Matrix_LocalToWorld);
+	normal = mul(normal, ComVar_Matrix_LocalToWorldNormal);
 	VsOutput.Normal = normalize(normal.xyz);
 
 	float4 tangent = float4(VsInput.Tangent.xyz, 0.0f);
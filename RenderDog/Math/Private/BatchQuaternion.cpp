@@ -0,0 +1,174 @@
+///////////////////////////////////
+//RenderDog <,>
+//FileName: BatchQuaternion.cpp
+//Written by Xiang Weikang
+///////////////////////////////////
+
+#include "BatchQuaternion.h"
+#include "Transform.h"
+#include "SIMD.h"
+
+#include <cmath>
+
+namespace RenderDog
+{
+	template<bool bApproxSLerp>
+	static void BatchLerpQuaternion(QuaternionArraySoA& outQuats, const QuaternionArraySoA& fromQuats, const QuaternionArraySoA& toQuats, const float* pLerpFactors, uint32_t count)
+	{
+		uint32_t i = 0;
+
+#if RD_SIMD_SSE
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 signMask = _mm_set1_ps(-0.0f);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x0 = _mm_loadu_ps(&fromQuats.x[i]);
+			__m128 y0 = _mm_loadu_ps(&fromQuats.y[i]);
+			__m128 z0 = _mm_loadu_ps(&fromQuats.z[i]);
+			__m128 w0 = _mm_loadu_ps(&fromQuats.w[i]);
+
+			__m128 x1 = _mm_loadu_ps(&toQuats.x[i]);
+			__m128 y1 = _mm_loadu_ps(&toQuats.y[i]);
+			__m128 z1 = _mm_loadu_ps(&toQuats.z[i]);
+			__m128 w1 = _mm_loadu_ps(&toQuats.w[i]);
+
+			__m128 t = _mm_loadu_ps(pLerpFactors + i);
+
+			__m128 cosine = _mm_mul_ps(x0, x1);
+			cosine = _mm_add_ps(cosine, _mm_mul_ps(y0, y1));
+			cosine = _mm_add_ps(cosine, _mm_mul_ps(z0, z1));
+			cosine = _mm_add_ps(cosine, _mm_mul_ps(w0, w1));
+
+			//ΪʱĿԪȡ·
+			__m128 cosineSign = _mm_and_ps(cosine, signMask);
+			x1 = _mm_xor_ps(x1, cosineSign);
+			y1 = _mm_xor_ps(y1, cosineSign);
+			z1 = _mm_xor_ps(z1, cosineSign);
+			w1 = _mm_xor_ps(w1, cosineSign);
+
+			if (bApproxSLerp)
+			{
+				//GetSLerpApproxFactorͬĶʽ
+				__m128 d = _mm_andnot_ps(signMask, cosine);
+
+				__m128 a = _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)));
+				a = _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, a));
+				a = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, a));
+
+				__m128 b = _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)));
+				b = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, b));
+
+				__m128 tMinusHalf = _mm_sub_ps(t, half);
+				__m128 k = _mm_add_ps(_mm_mul_ps(a, _mm_mul_ps(tMinusHalf, tMinusHalf)), b);
+
+				__m128 correction = _mm_mul_ps(_mm_mul_ps(t, tMinusHalf), _mm_mul_ps(_mm_sub_ps(t, one), k));
+				t = _mm_add_ps(t, correction);
+			}
+
+			__m128 x = _mm_add_ps(x0, _mm_mul_ps(t, _mm_sub_ps(x1, x0)));
+			__m128 y = _mm_add_ps(y0, _mm_mul_ps(t, _mm_sub_ps(y1, y0)));
+			__m128 z = _mm_add_ps(z0, _mm_mul_ps(t, _mm_sub_ps(z1, z0)));
+			__m128 w = _mm_add_ps(w0, _mm_mul_ps(t, _mm_sub_ps(w1, w0)));
+
+			//ȡԪнǲ90ȣֵĳȲΪ0
+			__m128 sqrLength = _mm_mul_ps(x, x);
+			sqrLength = _mm_add_ps(sqrLength, _mm_mul_ps(y, y));
+			sqrLength = _mm_add_ps(sqrLength, _mm_mul_ps(z, z));
+			sqrLength = _mm_add_ps(sqrLength, _mm_mul_ps(w, w));
+			__m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(sqrLength));
+
+			_mm_storeu_ps(&outQuats.x[i], _mm_mul_ps(x, invLength));
+			_mm_storeu_ps(&outQuats.y[i], _mm_mul_ps(y, invLength));
+			_mm_storeu_ps(&outQuats.z[i], _mm_mul_ps(z, invLength));
+			_mm_storeu_ps(&outQuats.w[i], _mm_mul_ps(w, invLength));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			Quaternion result = bApproxSLerp ? SLerpApprox(fromQuats.Get(i), toQuats.Get(i), pLerpFactors[i]) :
+											   NLerp(fromQuats.Get(i), toQuats.Get(i), pLerpFactors[i]);
+			outQuats.Set(i, result);
+		}
+	}
+
+	void BatchNLerp(QuaternionArraySoA& outQuats, const QuaternionArraySoA& fromQuats, const QuaternionArraySoA& toQuats, const float* pLerpFactors, uint32_t count)
+	{
+		BatchLerpQuaternion<false>(outQuats, fromQuats, toQuats, pLerpFactors, count);
+	}
+
+	void BatchSLerpApprox(QuaternionArraySoA& outQuats, const QuaternionArraySoA& fromQuats, const QuaternionArraySoA& toQuats, const float* pLerpFactors, uint32_t count)
+	{
+		BatchLerpQuaternion<true>(outQuats, fromQuats, toQuats, pLerpFactors, count);
+	}
+
+	void BatchGetAffineTransform(Matrix3x4* pOutMatrices, const Vector3* pTranslations, const Vector3* pScales, const QuaternionArraySoA& rotQuats, uint32_t count)
+	{
+		uint32_t i = 0;
+
+#if RD_SIMD_SSE
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 two = _mm_set1_ps(2.0f);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&rotQuats.x[i]);
+			__m128 y = _mm_loadu_ps(&rotQuats.y[i]);
+			__m128 z = _mm_loadu_ps(&rotQuats.z[i]);
+			__m128 w = _mm_loadu_ps(&rotQuats.w[i]);
+
+			__m128 x2 = _mm_mul_ps(x, two);
+			__m128 y2 = _mm_mul_ps(y, two);
+			__m128 z2 = _mm_mul_ps(z, two);
+
+			__m128 xx = _mm_mul_ps(x, x2);
+			__m128 yy = _mm_mul_ps(y, y2);
+			__m128 zz = _mm_mul_ps(z, z2);
+			__m128 xy = _mm_mul_ps(x, y2);
+			__m128 xz = _mm_mul_ps(x, z2);
+			__m128 yz = _mm_mul_ps(y, z2);
+			__m128 wx = _mm_mul_ps(w, x2);
+			__m128 wy = _mm_mul_ps(w, y2);
+			__m128 wz = _mm_mul_ps(w, z2);
+
+			//GetRotationMatrix(const Quaternion&)Ԫһ£rot[r][c]Ϊrеc
+			RD_SIMD_ALIGN float rot[3][3][4];
+			_mm_store_ps(rot[0][0], _mm_sub_ps(one, _mm_add_ps(yy, zz)));
+			_mm_store_ps(rot[0][1], _mm_add_ps(xy, wz));
+			_mm_store_ps(rot[0][2], _mm_sub_ps(xz, wy));
+
+			_mm_store_ps(rot[1][0], _mm_sub_ps(xy, wz));
+			_mm_store_ps(rot[1][1], _mm_sub_ps(one, _mm_add_ps(xx, zz)));
+			_mm_store_ps(rot[1][2], _mm_add_ps(yz, wx));
+
+			_mm_store_ps(rot[2][0], _mm_add_ps(xz, wy));
+			_mm_store_ps(rot[2][1], _mm_sub_ps(yz, wx));
+			_mm_store_ps(rot[2][2], _mm_sub_ps(one, _mm_add_ps(xx, yy)));
+
+			for (uint32_t k = 0; k < 4; ++k)
+			{
+				const Vector3& scales = pScales[i + k];
+				const float scale[3] = { scales.x, scales.y, scales.z };
+
+				Matrix3x4& outMatrix = pOutMatrices[i + k];
+				for (int r = 0; r < 3; ++r)
+				{
+					for (int c = 0; c < 3; ++c)
+					{
+						outMatrix(r, c) = rot[r][c][k] * scale[r];
+					}
+				}
+				outMatrix.SetTranslation(pTranslations[i + k]);
+			}
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			pOutMatrices[i] = GetAffineTransform(pTranslations[i], pScales[i], rotQuats.Get(i));
+		}
+	}
+
+}// namespace RenderDog
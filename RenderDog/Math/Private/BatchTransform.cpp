@@ -0,0 +1,293 @@
+///////////////////////////////////
+//RenderDog <,>
+//FileName: BatchTransform.cpp
+//Written by Xiang Weikang
+///////////////////////////////////
+
+#include "BatchTransform.h"
+#include "SIMD.h"
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace RenderDog
+{
+	//ÿٴԪ̫ʱĵȿᳬ
+	static const uint32_t	BATCH_MIN_COUNT_PER_THREAD = 8192;
+
+	static uint32_t			g_BatchTransformMaxThreadNum = 0;	//0ʾʹϵͳй߳
+
+	void SetBatchTransformMaxThreadNum(uint32_t threadNum)
+	{
+		g_BatchTransformMaxThreadNum = threadNum;
+	}
+
+	static uint32_t GetBatchChunkNum(uint32_t count)
+	{
+		if (!g_pJobSystem->IsInitialized())
+		{
+			return 1;
+		}
+
+		uint32_t maxThreadNum = g_pJobSystem->GetWorkerNum();
+		if (g_BatchTransformMaxThreadNum != 0)
+		{
+			maxThreadNum = std::min(maxThreadNum, g_BatchTransformMaxThreadNum);
+		}
+
+		uint32_t chunkNum = count / BATCH_MIN_COUNT_PER_THREAD;
+		chunkNum = chunkNum < maxThreadNum ? chunkNum : maxThreadNum;
+
+		return chunkNum > 1 ? chunkNum : 1;
+	}
+
+	//[0, count)ƽֳchunkNumνϵͳִУfuncĲΪ(begin, end, chunkIndex)
+	template<typename Func>
+	static void BatchParallelFor(uint32_t count, uint32_t chunkNum, const Func& func)
+	{
+		if (chunkNum <= 1)
+		{
+			func(0, count, 0);
+			return;
+		}
+
+		uint32_t chunkSize = (count + chunkNum - 1) / chunkNum;
+
+		g_pJobSystem->ParallelFor(chunkNum, 1, [&](uint32_t chunkBegin, uint32_t chunkEnd)
+		{
+			for (uint32_t i = chunkBegin; i < chunkEnd; ++i)
+			{
+				uint32_t begin = chunkSize * i;
+				uint32_t end = std::min(count, begin + chunkSize);
+				if (begin < end)
+				{
+					func(begin, end, i);
+				}
+			}
+		});
+	}
+
+	static inline const float* GetStridedElement(const void* pBase, size_t stride, uint32_t index)
+	{
+		return reinterpret_cast<const float*>(static_cast<const uint8_t*>(pBase) + stride * index);
+	}
+
+	static inline float* GetStridedElement(void* pBase, size_t stride, uint32_t index)
+	{
+		return reinterpret_cast<float*>(static_cast<uint8_t*>(pBase) + stride * index);
+	}
+
+	//Ԫصı任wΪ01
+	static inline void TransformElementScalar(float* pOut, uint32_t outComponentNum, const float* pIn, float w, const Matrix4x4& mat)
+	{
+		float x = pIn[0];
+		float y = pIn[1];
+		float z = pIn[2];
+
+		for (uint32_t c = 0; c < outComponentNum; ++c)
+		{
+			pOut[c] = x * mat(0, c) + y * mat(1, c) + z * mat(2, c) + w * mat(3, c);
+		}
+	}
+
+#if RD_SIMD_SSE
+	//ÿԪع㲥4ͨһα任4SoAʽԪ
+	struct SIMDSplatMatrix
+	{
+		__m128 m[4][4];
+
+		explicit SIMDSplatMatrix(const Matrix4x4& mat)
+		{
+			for (int r = 0; r < 4; ++r)
+			{
+				for (int c = 0; c < 4; ++c)
+				{
+					m[r][c] = _mm_set1_ps(mat(r, c));
+				}
+			}
+		}
+	};
+
+	//ȡ4Vector3תΪxxxx, yyyy, zzzz
+	static inline void LoadStridedVector3x4(const void* pBase, size_t stride, uint32_t index, __m128& x, __m128& y, __m128& z)
+	{
+		const float* p0 = GetStridedElement(pBase, stride, index);
+		const float* p1 = GetStridedElement(pBase, stride, index + 1);
+		const float* p2 = GetStridedElement(pBase, stride, index + 2);
+		const float* p3 = GetStridedElement(pBase, stride, index + 3);
+
+		x = _mm_setr_ps(p0[0], p1[0], p2[0], p3[0]);
+		y = _mm_setr_ps(p0[1], p1[1], p2[1], p3[1]);
+		z = _mm_setr_ps(p0[2], p1[2], p2[2], p3[2]);
+	}
+
+	//SoAʽ4Ԫر任ĵcbPointΪtrueʱƽ
+	template<bool bPoint>
+	static inline __m128 TransformComponentx4(const SIMDSplatMatrix& mat, __m128 x, __m128 y, __m128 z, int c)
+	{
+		__m128 result = _mm_mul_ps(x, mat.m[0][c]);
+		result = _mm_add_ps(result, _mm_mul_ps(y, mat.m[1][c]));
+		result = _mm_add_ps(result, _mm_mul_ps(z, mat.m[2][c]));
+		if (bPoint)
+		{
+			result = _mm_add_ps(result, mat.m[3][c]);
+		}
+
+		return result;
+	}
+#endif
+
+	template<bool bPoint, uint32_t outComponentNum>
+	static void TransformRange(void* pOut, size_t outStride, const void* pIn, size_t inStride, uint32_t begin, uint32_t end, const Matrix4x4& mat)
+	{
+		uint32_t i = begin;
+
+#if RD_SIMD_SSE
+		SIMDSplatMatrix splatMat(mat);
+
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 x, y, z;
+			LoadStridedVector3x4(pIn, inStride, i, x, y, z);
+
+			//ȫȡдأ֤ԭر任ʱȷ
+			RD_SIMD_ALIGN float result[4][4];
+			for (uint32_t c = 0; c < outComponentNum; ++c)
+			{
+				_mm_store_ps(result[c], TransformComponentx4<bPoint>(splatMat, x, y, z, c));
+			}
+
+			for (uint32_t k = 0; k < 4; ++k)
+			{
+				float* pDst = GetStridedElement(pOut, outStride, i + k);
+				for (uint32_t c = 0; c < outComponentNum; ++c)
+				{
+					pDst[c] = result[c][k];
+				}
+			}
+		}
+#endif
+
+		for (; i < end; ++i)
+		{
+			RD_SIMD_ALIGN float result[4];
+			TransformElementScalar(result, outComponentNum, GetStridedElement(pIn, inStride, i), bPoint ? 1.0f : 0.0f, mat);
+
+			float* pDst = GetStridedElement(pOut, outStride, i);
+			for (uint32_t c = 0; c < outComponentNum; ++c)
+			{
+				pDst[c] = result[c];
+			}
+		}
+	}
+
+	template<bool bPoint, uint32_t outComponentNum>
+	static void TransformArray(void* pOut, size_t outStride, const void* pIn, size_t inStride, uint32_t count, const Matrix4x4& mat)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		uint32_t chunkNum = GetBatchChunkNum(count);
+		BatchParallelFor(count, chunkNum, [=, &mat](uint32_t begin, uint32_t end, uint32_t)
+		{
+			TransformRange<bPoint, outComponentNum>(pOut, outStride, pIn, inStride, begin, end, mat);
+		});
+	}
+
+	void TransformPoints(Vector3* pOut, size_t outStride, const Vector3* pIn, size_t inStride, uint32_t count, const Matrix4x4& mat)
+	{
+		TransformArray<true, 3>(pOut, outStride, pIn, inStride, count, mat);
+	}
+
+	void TransformDirections(Vector3* pOut, size_t outStride, const Vector3* pIn, size_t inStride, uint32_t count, const Matrix4x4& mat)
+	{
+		TransformArray<false, 3>(pOut, outStride, pIn, inStride, count, mat);
+	}
+
+	void TransformPointsToVector4(Vector4* pOut, size_t outStride, const Vector3* pIn, size_t inStride, uint32_t count, const Matrix4x4& mat)
+	{
+		TransformArray<true, 4>(pOut, outStride, pIn, inStride, count, mat);
+	}
+
+	void TransformAABBs(AABB* pOut, const AABB* pIn, uint32_t count, const Matrix3x4& mat)
+	{
+		//°ΧÿķΧƽƼϾɰΧиڸͶӰСֵ(ֵ)֮
+		uint32_t chunkNum = GetBatchChunkNum(count);
+		BatchParallelFor(count, chunkNum, [=, &mat](uint32_t begin, uint32_t end, uint32_t)
+		{
+#if RD_SIMD_SSE
+			//Matrix3x4д洢תóɵȼ4x4ǰɵУΪ0
+			__m128 row0 = _mm_load_ps(mat.GetData());
+			__m128 row1 = _mm_load_ps(mat.GetData() + 4);
+			__m128 row2 = _mm_load_ps(mat.GetData() + 8);
+			__m128 row3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				const AABB& inAABB = pIn[i];
+				if (!inAABB.IsValid())
+				{
+					pOut[i] = inAABB;
+					continue;
+				}
+
+				__m128 a0 = _mm_mul_ps(row0, _mm_set1_ps(inAABB.minPoint.x));
+				__m128 b0 = _mm_mul_ps(row0, _mm_set1_ps(inAABB.maxPoint.x));
+				__m128 a1 = _mm_mul_ps(row1, _mm_set1_ps(inAABB.minPoint.y));
+				__m128 b1 = _mm_mul_ps(row1, _mm_set1_ps(inAABB.maxPoint.y));
+				__m128 a2 = _mm_mul_ps(row2, _mm_set1_ps(inAABB.minPoint.z));
+				__m128 b2 = _mm_mul_ps(row2, _mm_set1_ps(inAABB.maxPoint.z));
+
+				__m128 newMin = _mm_add_ps(row3, _mm_min_ps(a0, b0));
+				newMin = _mm_add_ps(newMin, _mm_min_ps(a1, b1));
+				newMin = _mm_add_ps(newMin, _mm_min_ps(a2, b2));
+
+				__m128 newMax = _mm_add_ps(row3, _mm_max_ps(a0, b0));
+				newMax = _mm_add_ps(newMax, _mm_max_ps(a1, b1));
+				newMax = _mm_add_ps(newMax, _mm_max_ps(a2, b2));
+
+				RD_SIMD_ALIGN float minPoint[4];
+				RD_SIMD_ALIGN float maxPoint[4];
+				_mm_store_ps(minPoint, newMin);
+				_mm_store_ps(maxPoint, newMax);
+
+				pOut[i].minPoint = Vector3(minPoint[0], minPoint[1], minPoint[2]);
+				pOut[i].maxPoint = Vector3(maxPoint[0], maxPoint[1], maxPoint[2]);
+			}
+#else
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				if (!pIn[i].IsValid())
+				{
+					pOut[i] = pIn[i];
+					continue;
+				}
+
+				const float inMin[3] = { pIn[i].minPoint.x, pIn[i].minPoint.y, pIn[i].minPoint.z };
+				const float inMax[3] = { pIn[i].maxPoint.x, pIn[i].maxPoint.y, pIn[i].maxPoint.z };
+
+				float newMin[3] = { mat(3, 0), mat(3, 1), mat(3, 2) };
+				float newMax[3] = { mat(3, 0), mat(3, 1), mat(3, 2) };
+				for (int c = 0; c < 3; ++c)
+				{
+					for (int r = 0; r < 3; ++r)
+					{
+						float a = mat(r, c) * inMin[r];
+						float b = mat(r, c) * inMax[r];
+						newMin[c] += a < b ? a : b;
+						newMax[c] += a < b ? b : a;
+					}
+				}
+
+				pOut[i].minPoint = Vector3(newMin[0], newMin[1], newMin[2]);
+				pOut[i].maxPoint = Vector3(newMax[0], newMax[1], newMax[2]);
+			}
+#endif
+		});
+	}
+
+}// namespace RenderDog
@@ -11,44 +11,6 @@
 
 namespace RenderDog
 {
-	Quaternion& Quaternion::operator*=(const Quaternion& rhs)
-	{
-		float resX = w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y;
-		float resY = w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x;
-		float resZ = w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w;
-		float resW = w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z;
-
-		x = resX;
-		y = resY;
-		z = resZ;
-		w = resW;
-
-		return *this;
-	}
-
-	void Quaternion::Normalize()
-	{
-		float sqrSum = x * x + y * y + z * z + w * w;
-		if (std::abs(sqrSum - 0.0f) < RD_FLT_EPSILON)
-		{
-			x = y = z = 0;
-			w = 1;
-
-			return;
-		}
-
-		float invSqrt = 1.0f / std::sqrt(sqrSum);
-		x *= invSqrt;
-		y *= invSqrt;
-		z *= invSqrt;
-		w *= invSqrt;
-	}
-
-	float Quaternion::Length() const
-	{
-		return std::sqrt(x * x + y * y + z * z + w * w);
-	}
-
 	float Quaternion::GetAngle() const
 	{
 		return 2.0f * std::acosf(w);
@@ -63,15 +25,6 @@ namespace RenderDog
 		return rotAxis;
 	}
 
-	Quaternion Normalize(const Quaternion& quat)
-	{
-		Quaternion result = quat;
-
-		result.Normalize();
-
-		return result;
-	}
-
 	Quaternion Lerp(const Quaternion& quat1, const Quaternion& quat2, float lerpFactor)
 	{
 		float x = quat1.x * (1.0f - lerpFactor) + quat2.x * lerpFactor;
@@ -116,14 +69,38 @@ namespace RenderDog
 		return Normalize(result);
 	}
 
-	Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs)
+	Quaternion NLerp(const Quaternion& quat1, const Quaternion& quat2, float lerpFactor)
+	{
+		float cosine = quat1.x * quat2.x + quat1.y * quat2.y + quat1.z * quat2.z + quat1.w * quat2.w;
+		//q-qʾͬһתΪʱȡ·
+		float scale1 = cosine >= 0.0f ? lerpFactor : -lerpFactor;
+		float scale0 = 1.0f - lerpFactor;
+
+		Quaternion result;
+		result.x = scale0 * quat1.x + scale1 * quat2.x;
+		result.y = scale0 * quat1.y + scale1 * quat2.y;
+		result.z = scale0 * quat1.z + scale1 * quat2.z;
+		result.w = scale0 * quat1.w + scale1 * quat2.w;
+
+		return Normalize(result);
+	}
+
+	float GetSLerpApproxFactor(float lerpFactor, float absCosine)
+	{
+		//ϵԶSLerpֵߵСϣʹNLerpĽٶȽӽ
+		float a = 1.0904f + absCosine * (-3.2452f + absCosine * (3.55645f - absCosine * 1.43519f));
+		float b = 0.848013f + absCosine * (-1.06021f + absCosine * 0.215638f);
+		float k = a * (lerpFactor - 0.5f) * (lerpFactor - 0.5f) + b;
+
+		return lerpFactor + lerpFactor * (lerpFactor - 0.5f) * (lerpFactor - 1.0f) * k;
+	}
+
+	Quaternion SLerpApprox(const Quaternion& quat1, const Quaternion& quat2, float lerpFactor)
 	{
-		float resX = lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y;
-		float resY = lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x;
-		float resZ = lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w;
-		float resW = lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z;
+		float cosine = quat1.x * quat2.x + quat1.y * quat2.y + quat1.z * quat2.z + quat1.w * quat2.w;
+		float correctedFactor = GetSLerpApproxFactor(lerpFactor, std::abs(cosine));
 
-		return Quaternion(resX, resY, resZ, resW);
+		return NLerp(quat1, quat2, correctedFactor);
 	}
 
 }// namespace RenderDog
\ No newline at end of file
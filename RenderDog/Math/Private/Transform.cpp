@@ -9,6 +9,8 @@
 #include "Quaternion.h"
 #include "Utility.h"
 
+#include <cmath>
+
 namespace RenderDog
 {
 	Matrix4x4 GetTranslationMatrix(float xOffset, float yOffset, float zOffset)
@@ -199,4 +201,101 @@ namespace RenderDog
 		return scaleMatrix * rotationMatrix * translationMatrix;
 	}
 
+	Matrix3x4 GetAffineTransform(const Vector3& translation, const Vector3& scales, const Vector3& eulers)
+	{
+		Matrix3x4 rotationMatrix(GetRotationMatrix(eulers.x, eulers.y, eulers.z));
+
+		return Matrix3x4(rotationMatrix.GetAxis(0) * scales.x,
+						 rotationMatrix.GetAxis(1) * scales.y,
+						 rotationMatrix.GetAxis(2) * scales.z,
+						 translation);
+	}
+
+	Matrix3x4 GetAffineTransform(const Vector3& translation, const Vector3& scales, const Quaternion& rotQuat)
+	{
+		//ֱԪ죬GetRotationMatrix(const Quaternion&)Ľһ
+		Quaternion normalizeQuat = Normalize(rotQuat);
+
+		float x = normalizeQuat.x;
+		float y = normalizeQuat.y;
+		float z = normalizeQuat.z;
+		float w = normalizeQuat.w;
+
+		Vector3 axisX(1.0f - 2.0f * y * y - 2.0f * z * z, 2.0f * x * y + 2.0f * w * z, 2.0f * x * z - 2.0f * w * y);
+		Vector3 axisY(2.0f * x * y - 2.0f * w * z, 1.0f - 2.0f * x * x - 2.0f * z * z, 2.0f * y * z + 2.0f * w * x);
+		Vector3 axisZ(2.0f * x * z + 2.0f * w * y, 2.0f * y * z - 2.0f * w * x, 1.0f - 2.0f * x * x - 2.0f * y * y);
+
+		return Matrix3x4(axisX * scales.x, axisY * scales.y, axisZ * scales.z, translation);
+	}
+
+	//GetRotationMatrix(const Quaternion&)㣬Ϊת
+	static Quaternion GetQuaternionFromRotation(const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ)
+	{
+		float m00 = axisX.x, m01 = axisX.y, m02 = axisX.z;
+		float m10 = axisY.x, m11 = axisY.y, m12 = axisY.z;
+		float m20 = axisZ.x, m21 = axisZ.y, m22 = axisZ.z;
+
+		float trace = m00 + m11 + m22;
+		Quaternion result;
+		if (trace > 0.0f)
+		{
+			float s = 2.0f * std::sqrt(1.0f + trace);
+			result.w = 0.25f * s;
+			result.x = (m12 - m21) / s;
+			result.y = (m20 - m02) / s;
+			result.z = (m01 - m10) / s;
+		}
+		else if (m00 > m11 && m00 > m22)
+		{
+			float s = 2.0f * std::sqrt(1.0f + m00 - m11 - m22);
+			result.w = (m12 - m21) / s;
+			result.x = 0.25f * s;
+			result.y = (m01 + m10) / s;
+			result.z = (m02 + m20) / s;
+		}
+		else if (m11 > m22)
+		{
+			float s = 2.0f * std::sqrt(1.0f + m11 - m00 - m22);
+			result.w = (m20 - m02) / s;
+			result.x = (m01 + m10) / s;
+			result.y = 0.25f * s;
+			result.z = (m12 + m21) / s;
+		}
+		else
+		{
+			float s = 2.0f * std::sqrt(1.0f + m22 - m00 - m11);
+			result.w = (m01 - m10) / s;
+			result.x = (m02 + m20) / s;
+			result.y = (m12 + m21) / s;
+			result.z = 0.25f * s;
+		}
+
+		return Normalize(result);
+	}
+
+	bool DecomposeAffineTransform(const Matrix3x4& mat, Vector3& translation, Vector3& scales, Quaternion& rotQuat)
+	{
+		translation = mat.GetTranslation();
+
+		Vector3 axisX = mat.GetAxis(0);
+		Vector3 axisY = mat.GetAxis(1);
+		Vector3 axisZ = mat.GetAxis(2);
+
+		scales = Vector3(axisX.Length(), axisY.Length(), axisZ.Length());
+		if (scales.x < RD_FLT_EPSILON || scales.y < RD_FLT_EPSILON || scales.z < RD_FLT_EPSILON)
+		{
+			return false;
+		}
+
+		//ʽΪʱ˵񣬰鵽X
+		if (DotProduct(CrossProduct(axisX, axisY), axisZ) < 0.0f)
+		{
+			scales.x = -scales.x;
+		}
+
+		rotQuat = GetQuaternionFromRotation(axisX / scales.x, axisY / scales.y, axisZ / scales.z);
+
+		return true;
+	}
+
 }// namespace RenderDog
\ No newline at end of file
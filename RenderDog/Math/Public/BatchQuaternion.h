@@ -0,0 +1,41 @@
+///////////////////////////////////
+//RenderDog <,>
+//FileName: BatchQuaternion.h
+//Written by Xiang Weikang
+//Desc: ԪֵԼԪתڹƲ
+///////////////////////////////////
+
+#pragma once
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "Quaternion.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace RenderDog
+{
+	//SoAʽԪ飬ĸֱ洢һδ4Ԫ
+	struct QuaternionArraySoA
+	{
+		std::vector<float>	x;
+		std::vector<float>	y;
+		std::vector<float>	z;
+		std::vector<float>	w;
+
+		void				Resize(uint32_t num) { x.resize(num); y.resize(num); z.resize(num); w.resize(num); }
+		uint32_t			Size() const { return (uint32_t)x.size(); }
+
+		void				Set(uint32_t index, const Quaternion& quat) { x[index] = quat.x; y[index] = quat.y; z[index] = quat.z; w[index] = quat.w; }
+		Quaternion			Get(uint32_t index) const { return Quaternion(x[index], y[index], z[index], w[index]); }
+	};
+
+	//outQuatsҪԤResizeСcountpLerpFactorsΪÿԪظԵĲֵ
+	void		BatchNLerp(QuaternionArraySoA& outQuats, const QuaternionArraySoA& fromQuats, const QuaternionArraySoA& toQuats, const float* pLerpFactors, uint32_t count);
+	void		BatchSLerpApprox(QuaternionArraySoA& outQuats, const QuaternionArraySoA& fromQuats, const QuaternionArraySoA& toQuats, const float* pLerpFactors, uint32_t count);
+
+	//šתƽƵ˳ΪԪҪǵλԪ
+	void		BatchGetAffineTransform(Matrix3x4* pOutMatrices, const Vector3* pTranslations, const Vector3* pScales, const QuaternionArraySoA& rotQuats, uint32_t count);
+
+}// namespace RenderDog
@@ -0,0 +1,39 @@
+///////////////////////////////////
+//RenderDog <,>
+//FileName: BatchTransform.h
+//Written by Xiang Weikang
+//Desc: 任㡢ͰΧ
+///////////////////////////////////
+
+#pragma once
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "Bounding.h"
+
+#include <cstdint>
+#include <cstddef>
+
+namespace RenderDog
+{
+	//нӿڶʹֽڲ(stride)飬˿ֱӴ붥ṹĳԱĵַ
+	// TransformPoints(&verts[0].position, sizeof(StandardVertex), ...)
+	//ͬһڴ(ԭر任)ܲص
+	//ԪֵʱֳɶϵͳĹִ߳
+
+	//λñ任(w = 1)͸ӳ
+	void		TransformPoints(Vector3* pOut, size_t outStride, const Vector3* pIn, size_t inStride, uint32_t count, const Matrix4x4& mat);
+
+	//任(w = 0)һ
+	void		TransformDirections(Vector3* pOut, size_t outStride, const Vector3* pIn, size_t inStride, uint32_t count, const Matrix4x4& mat);
+
+	//λñ任(w = 1)꣬ڱ任üռ
+	void		TransformPointsToVector4(Vector4* pOut, size_t outStride, const Vector3* pIn, size_t inStride, uint32_t count, const Matrix4x4& mat);
+
+	//ArvoķֱɾֲΧкͷ任õµİΧУҪ任㣻ЧAABBЧ
+	void		TransformAABBs(AABB* pOut, const AABB* pIn, uint32_t count, const Matrix3x4& mat);
+
+	//任ʹõ߳Ϊ1ʱرն̣߳Ĭʹϵͳй߳
+	void		SetBatchTransformMaxThreadNum(uint32_t threadNum);
+
+}// namespace RenderDog
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Vector.h"
+#include "SIMD.h"
 
 namespace RenderDog
 {
@@ -14,14 +15,14 @@ namespace RenderDog
 	// ----------------------       Matrix4x4         -------------------------------//
 	///////////////////////////////////////////////////////////////////////////////////
 
-	class Matrix4x4
+	class RD_SIMD_ALIGN Matrix4x4
 	{
 	public:
 		Matrix4x4();		//ȫ
-		~Matrix4x4();
+		~Matrix4x4() = default;
 
-		Matrix4x4(const Matrix4x4& mat);
-		Matrix4x4& operator=(const Matrix4x4& mat);
+		Matrix4x4(const Matrix4x4& mat) = default;
+		Matrix4x4& operator=(const Matrix4x4& mat) = default;
 
 		Matrix4x4(float f00, float f01, float f02, float f03,
 				  float f10, float f11, float f12, float f13,
@@ -31,19 +32,22 @@ namespace RenderDog
 		//
 		Matrix4x4(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3);
 
-		float		operator()(int r, int c) const { return m_fData[r][c]; }
-		float&		operator()(int r, int c) { return m_fData[r][c]; }
-		Vector4		GetRow(int r) const { return Vector4(m_fData[r][0], m_fData[r][1], m_fData[r][2], m_fData[r][3]); }
-		Vector4		GetCol(int c) const { return Vector4(m_fData[0][c], m_fData[1][c], m_fData[2][c], m_fData[3][c]); }
+		float			operator()(int r, int c) const { return m_fData[r][c]; }
+		float&			operator()(int r, int c) { return m_fData[r][c]; }
+		Vector4			GetRow(int r) const { return Vector4(m_fData[r][0], m_fData[r][1], m_fData[r][2], m_fData[r][3]); }
+		Vector4			GetCol(int c) const { return Vector4(m_fData[0][c], m_fData[1][c], m_fData[2][c], m_fData[3][c]); }
 
-		void		Identity();
+		const float*	GetData() const { return &m_fData[0][0]; }
+		float*			GetData() { return &m_fData[0][0]; }
 
-		Vector3		GetTranslatePart();
-		Vector3		GetScalePart();
-		Matrix4x4	GetRotationPart();
+		void			Identity();
+
+		Vector3			GetTranslatePart();
+		Vector3			GetScalePart();
+		Matrix4x4		GetRotationPart();
 
 	private:
-		float		m_fData[4][4];
+		float			m_fData[4][4];
 	};
 
 	Vector4			operator*(const Vector4& vec, const Matrix4x4& mat);
@@ -55,4 +59,442 @@ namespace RenderDog
 
 	Matrix4x4		Transpose(const Matrix4x4& mat);
 
+					//ͨõ4x4棬󲻿ʱصλ󲢽ʽдΪ0
+	Matrix4x4		Inverse(const Matrix4x4& mat, float* pDeterminant = nullptr);
+
+					//߾3x3ֵתãƽƲΪ0
+	Matrix4x4		GetNormalMatrix(const Matrix4x4& mat);
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// ----------------------       Matrix3x4         -------------------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	//任󣬵ȼһй̶Ϊ(0, 0, 0, 1)Matrix4x4ֻҪ48ֽ
+	//Ϊ˷SIMD㣬д洢ȼ4x4ǰУm_fData[c][r] = Matrix4x4(r, c)
+	class RD_SIMD_ALIGN Matrix3x4
+	{
+	public:
+		Matrix3x4();		//λ
+		~Matrix3x4() = default;
+
+		Matrix3x4(const Matrix3x4& mat) = default;
+		Matrix3x4& operator=(const Matrix3x4& mat) = default;
+
+		//matһ
+		explicit Matrix3x4(const Matrix4x4& mat);
+
+		//Matrix4x4ʽһ£任Ľƽ
+		Matrix3x4(const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ, const Vector3& translation);
+
+		//rcΪȼ4x4еУrķΧΪ[0, 3]cķΧΪ[0, 2]
+		float			operator()(int r, int c) const { return m_fData[c][r]; }
+		float&			operator()(int r, int c) { return m_fData[c][r]; }
+
+		Vector3			GetAxis(int r) const { return Vector3(m_fData[0][r], m_fData[1][r], m_fData[2][r]); }
+		Vector3			GetTranslation() const { return Vector3(m_fData[0][3], m_fData[1][3], m_fData[2][3]); }
+		void			SetTranslation(const Vector3& translation);
+
+		const float*	GetData() const { return &m_fData[0][0]; }
+		float*			GetData() { return &m_fData[0][0]; }
+
+		void			Identity();
+
+		Matrix4x4		ToMatrix4x4() const;
+
+		Vector3			TransformPoint(const Vector3& point) const;
+		Vector3			TransformVector(const Vector3& vec) const;
+
+	private:
+		float			m_fData[3][4];
+	};
+
+					//lhsı任rhsı任Matrix4x4ĳ˷˳һ
+	Matrix3x4		operator*(const Matrix3x4& matLhs, const Matrix3x4& matRhs);
+
+					//任棬󲻿ʱصλ
+	Matrix3x4		AffineInverse(const Matrix3x4& mat);
+					//ֻתƽʱĿ棬תֱת
+	Matrix3x4		RigidInverse(const Matrix3x4& mat);
+
+	Matrix3x4		GetNormalMatrix(const Matrix3x4& mat);
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// ----------------------       Inline Definition       -------------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	inline Matrix4x4::Matrix4x4()
+	{
+#if RD_SIMD_SSE
+		__m128 zero = _mm_setzero_ps();
+		_mm_store_ps(m_fData[0], zero);
+		_mm_store_ps(m_fData[1], zero);
+		_mm_store_ps(m_fData[2], zero);
+		_mm_store_ps(m_fData[3], zero);
+#else
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				m_fData[i][j] = 0.0f;
+			}
+		}
+#endif
+	}
+
+	inline Matrix4x4::Matrix4x4(float f00, float f01, float f02, float f03,
+								float f10, float f11, float f12, float f13,
+								float f20, float f21, float f22, float f23,
+								float f30, float f31, float f32, float f33)
+	{
+		m_fData[0][0] = f00;
+		m_fData[0][1] = f01;
+		m_fData[0][2] = f02;
+		m_fData[0][3] = f03;
+
+		m_fData[1][0] = f10;
+		m_fData[1][1] = f11;
+		m_fData[1][2] = f12;
+		m_fData[1][3] = f13;
+
+		m_fData[2][0] = f20;
+		m_fData[2][1] = f21;
+		m_fData[2][2] = f22;
+		m_fData[2][3] = f23;
+
+		m_fData[3][0] = f30;
+		m_fData[3][1] = f31;
+		m_fData[3][2] = f32;
+		m_fData[3][3] = f33;
+	}
+
+	inline Matrix4x4::Matrix4x4(const Vector4& v0, const Vector4& v1, const Vector4& v2, const Vector4& v3)
+	{
+#if RD_SIMD_SSE
+		//Vector4ûжҪʹ÷Ƕ
+		_mm_store_ps(m_fData[0], _mm_loadu_ps(&v0.x));
+		_mm_store_ps(m_fData[1], _mm_loadu_ps(&v1.x));
+		_mm_store_ps(m_fData[2], _mm_loadu_ps(&v2.x));
+		_mm_store_ps(m_fData[3], _mm_loadu_ps(&v3.x));
+#else
+		m_fData[0][0] = v0.x;
+		m_fData[0][1] = v0.y;
+		m_fData[0][2] = v0.z;
+		m_fData[0][3] = v0.w;
+
+		m_fData[1][0] = v1.x;
+		m_fData[1][1] = v1.y;
+		m_fData[1][2] = v1.z;
+		m_fData[1][3] = v1.w;
+
+		m_fData[2][0] = v2.x;
+		m_fData[2][1] = v2.y;
+		m_fData[2][2] = v2.z;
+		m_fData[2][3] = v2.w;
+
+		m_fData[3][0] = v3.x;
+		m_fData[3][1] = v3.y;
+		m_fData[3][2] = v3.z;
+		m_fData[3][3] = v3.w;
+#endif
+	}
+
+	inline void Matrix4x4::Identity()
+	{
+#if RD_SIMD_SSE
+		_mm_store_ps(m_fData[0], _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f));
+		_mm_store_ps(m_fData[1], _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f));
+		_mm_store_ps(m_fData[2], _mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f));
+		_mm_store_ps(m_fData[3], _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+#else
+		m_fData[0][0] = 1.0f;
+		m_fData[1][1] = 1.0f;
+		m_fData[2][2] = 1.0f;
+		m_fData[3][3] = 1.0f;
+
+		m_fData[0][1] = 0.0f;
+		m_fData[0][2] = 0.0f;
+		m_fData[0][3] = 0.0f;
+
+		m_fData[1][0] = 0.0f;
+		m_fData[1][2] = 0.0f;
+		m_fData[1][3] = 0.0f;
+
+		m_fData[2][0] = 0.0f;
+		m_fData[2][1] = 0.0f;
+		m_fData[2][3] = 0.0f;
+
+		m_fData[3][0] = 0.0f;
+		m_fData[3][1] = 0.0f;
+		m_fData[3][2] = 0.0f;
+#endif
+	}
+
+	inline Vector4 operator*(const Vector4& vec, const Matrix4x4& mat)
+	{
+#if RD_SIMD_SSE
+		const float* pMat = mat.GetData();
+		__m128 result = SIMDTransformRow(_mm_loadu_ps(&vec.x),
+										 _mm_load_ps(pMat), _mm_load_ps(pMat + 4), _mm_load_ps(pMat + 8), _mm_load_ps(pMat + 12));
+
+		Vector4 vecResult;
+		_mm_storeu_ps(&vecResult.x, result);
+
+		return vecResult;
+#else
+		Vector4 result;
+		result.x = vec.x * mat(0, 0) + vec.y * mat(1, 0) + vec.z * mat(2, 0) + vec.w * mat(3, 0);
+		result.y = vec.x * mat(0, 1) + vec.y * mat(1, 1) + vec.z * mat(2, 1) + vec.w * mat(3, 1);
+		result.z = vec.x * mat(0, 2) + vec.y * mat(1, 2) + vec.z * mat(2, 2) + vec.w * mat(3, 2);
+		result.w = vec.x * mat(0, 3) + vec.y * mat(1, 3) + vec.z * mat(2, 3) + vec.w * mat(3, 3);
+
+		return result;
+#endif
+	}
+
+	inline Matrix4x4 operator*(const Matrix4x4& matLhs, const Matrix4x4& matRhs)
+	{
+		Matrix4x4 matResult;
+
+		const float* pLhs = matLhs.GetData();
+		const float* pRhs = matRhs.GetData();
+		float* pResult = matResult.GetData();
+
+#if RD_SIMD_AVX
+		//һδУÿ128λͨӦһУֻ֤16ֽڶ룬ʹ÷Ƕ256λд
+		__m256 rhsRow0 = _mm256_broadcast_ps((const __m128*)(pRhs));
+		__m256 rhsRow1 = _mm256_broadcast_ps((const __m128*)(pRhs + 4));
+		__m256 rhsRow2 = _mm256_broadcast_ps((const __m128*)(pRhs + 8));
+		__m256 rhsRow3 = _mm256_broadcast_ps((const __m128*)(pRhs + 12));
+
+		for (int i = 0; i < 16; i += 8)
+		{
+			__m256 lhsRows = _mm256_loadu_ps(pLhs + i);
+
+			__m256 result = _mm256_mul_ps(_mm256_shuffle_ps(lhsRows, lhsRows, _MM_SHUFFLE(0, 0, 0, 0)), rhsRow0);
+			result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(lhsRows, lhsRows, _MM_SHUFFLE(1, 1, 1, 1)), rhsRow1));
+			result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(lhsRows, lhsRows, _MM_SHUFFLE(2, 2, 2, 2)), rhsRow2));
+			result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_shuffle_ps(lhsRows, lhsRows, _MM_SHUFFLE(3, 3, 3, 3)), rhsRow3));
+
+			_mm256_storeu_ps(pResult + i, result);
+		}
+#elif RD_SIMD_SSE
+		__m128 rhsRow0 = _mm_load_ps(pRhs);
+		__m128 rhsRow1 = _mm_load_ps(pRhs + 4);
+		__m128 rhsRow2 = _mm_load_ps(pRhs + 8);
+		__m128 rhsRow3 = _mm_load_ps(pRhs + 12);
+
+		for (int i = 0; i < 16; i += 4)
+		{
+			_mm_store_ps(pResult + i, SIMDTransformRow(_mm_load_ps(pLhs + i), rhsRow0, rhsRow1, rhsRow2, rhsRow3));
+		}
+#else
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				pResult[i * 4 + j] = pLhs[i * 4 + 0] * pRhs[0 * 4 + j] +
+									 pLhs[i * 4 + 1] * pRhs[1 * 4 + j] +
+									 pLhs[i * 4 + 2] * pRhs[2 * 4 + j] +
+									 pLhs[i * 4 + 3] * pRhs[3 * 4 + j];
+			}
+		}
+#endif
+
+		return matResult;
+	}
+
+	inline Matrix4x4 GetIdentityMatrix()
+	{
+		Matrix4x4 identityMat;
+		identityMat.Identity();
+
+		return identityMat;
+	}
+
+	inline Matrix4x4 Transpose(const Matrix4x4& mat)
+	{
+		Matrix4x4 result;
+
+#if RD_SIMD_SSE
+		const float* pMat = mat.GetData();
+		__m128 row0 = _mm_load_ps(pMat);
+		__m128 row1 = _mm_load_ps(pMat + 4);
+		__m128 row2 = _mm_load_ps(pMat + 8);
+		__m128 row3 = _mm_load_ps(pMat + 12);
+
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		float* pResult = result.GetData();
+		_mm_store_ps(pResult, row0);
+		_mm_store_ps(pResult + 4, row1);
+		_mm_store_ps(pResult + 8, row2);
+		_mm_store_ps(pResult + 12, row3);
+#else
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result(i, j) = mat(j, i);
+			}
+		}
+#endif
+
+		return result;
+	}
+
+	inline Matrix3x4::Matrix3x4()
+	{
+		Identity();
+	}
+
+	inline Matrix3x4::Matrix3x4(const Matrix4x4& mat)
+	{
+#if RD_SIMD_SSE
+		const float* pMat = mat.GetData();
+		__m128 row0 = _mm_load_ps(pMat);
+		__m128 row1 = _mm_load_ps(pMat + 4);
+		__m128 row2 = _mm_load_ps(pMat + 8);
+		__m128 row3 = _mm_load_ps(pMat + 12);
+
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		_mm_store_ps(m_fData[0], row0);
+		_mm_store_ps(m_fData[1], row1);
+		_mm_store_ps(m_fData[2], row2);
+#else
+		for (int c = 0; c < 3; ++c)
+		{
+			for (int r = 0; r < 4; ++r)
+			{
+				m_fData[c][r] = mat(r, c);
+			}
+		}
+#endif
+	}
+
+	inline Matrix3x4::Matrix3x4(const Vector3& axisX, const Vector3& axisY, const Vector3& axisZ, const Vector3& translation)
+	{
+		m_fData[0][0] = axisX.x;
+		m_fData[1][0] = axisX.y;
+		m_fData[2][0] = axisX.z;
+
+		m_fData[0][1] = axisY.x;
+		m_fData[1][1] = axisY.y;
+		m_fData[2][1] = axisY.z;
+
+		m_fData[0][2] = axisZ.x;
+		m_fData[1][2] = axisZ.y;
+		m_fData[2][2] = axisZ.z;
+
+		m_fData[0][3] = translation.x;
+		m_fData[1][3] = translation.y;
+		m_fData[2][3] = translation.z;
+	}
+
+	inline void Matrix3x4::SetTranslation(const Vector3& translation)
+	{
+		m_fData[0][3] = translation.x;
+		m_fData[1][3] = translation.y;
+		m_fData[2][3] = translation.z;
+	}
+
+	inline void Matrix3x4::Identity()
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			for (int r = 0; r < 4; ++r)
+			{
+				m_fData[c][r] = (r == c) ? 1.0f : 0.0f;
+			}
+		}
+	}
+
+	inline Matrix4x4 Matrix3x4::ToMatrix4x4() const
+	{
+		Matrix4x4 result;
+
+#if RD_SIMD_SSE
+		__m128 col0 = _mm_load_ps(m_fData[0]);
+		__m128 col1 = _mm_load_ps(m_fData[1]);
+		__m128 col2 = _mm_load_ps(m_fData[2]);
+		__m128 col3 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+		_MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+
+		float* pResult = result.GetData();
+		_mm_store_ps(pResult, col0);
+		_mm_store_ps(pResult + 4, col1);
+		_mm_store_ps(pResult + 8, col2);
+		_mm_store_ps(pResult + 12, col3);
+#else
+		for (int r = 0; r < 4; ++r)
+		{
+			for (int c = 0; c < 3; ++c)
+			{
+				result(r, c) = m_fData[c][r];
+			}
+			result(r, 3) = (r == 3) ? 1.0f : 0.0f;
+		}
+#endif
+
+		return result;
+	}
+
+	inline Vector3 Matrix3x4::TransformPoint(const Vector3& point) const
+	{
+		return Vector3(point.x * m_fData[0][0] + point.y * m_fData[0][1] + point.z * m_fData[0][2] + m_fData[0][3],
+					   point.x * m_fData[1][0] + point.y * m_fData[1][1] + point.z * m_fData[1][2] + m_fData[1][3],
+					   point.x * m_fData[2][0] + point.y * m_fData[2][1] + point.z * m_fData[2][2] + m_fData[2][3]);
+	}
+
+	inline Vector3 Matrix3x4::TransformVector(const Vector3& vec) const
+	{
+		return Vector3(vec.x * m_fData[0][0] + vec.y * m_fData[0][1] + vec.z * m_fData[0][2],
+					   vec.x * m_fData[1][0] + vec.y * m_fData[1][1] + vec.z * m_fData[1][2],
+					   vec.x * m_fData[2][0] + vec.y * m_fData[2][1] + vec.z * m_fData[2][2]);
+	}
+
+	inline Matrix3x4 operator*(const Matrix3x4& matLhs, const Matrix3x4& matRhs)
+	{
+		Matrix3x4 matResult;
+
+#if RD_SIMD_SSE
+		const float* pLhs = matLhs.GetData();
+		const float* pRhs = matRhs.GetData();
+		float* pResult = matResult.GetData();
+
+		//ĵc = rhs(0, c) * lhs0 + rhs(1, c) * lhs1 + rhs(2, c) * lhs2 + (0, 0, 0, rhs(3, c))
+		__m128 lhsCol0 = _mm_load_ps(pLhs);
+		__m128 lhsCol1 = _mm_load_ps(pLhs + 4);
+		__m128 lhsCol2 = _mm_load_ps(pLhs + 8);
+		__m128 translationMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+		for (int c = 0; c < 12; c += 4)
+		{
+			__m128 rhsCol = _mm_load_ps(pRhs + c);
+
+			__m128 result = _mm_and_ps(rhsCol, translationMask);
+			result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(rhsCol, 0), lhsCol0));
+			result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(rhsCol, 1), lhsCol1));
+			result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(rhsCol, 2), lhsCol2));
+
+			_mm_store_ps(pResult + c, result);
+		}
+#else
+		for (int c = 0; c < 3; ++c)
+		{
+			for (int r = 0; r < 4; ++r)
+			{
+				matResult(r, c) = matLhs(r, 0) * matRhs(0, c) + matLhs(r, 1) * matRhs(1, c) + matLhs(r, 2) * matRhs(2, c);
+				if (r == 3)
+				{
+					matResult(r, c) += matRhs(3, c);
+				}
+			}
+		}
+#endif
+
+		return matResult;
+	}
+
 }// namespace RenderDog
\ No newline at end of file
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Vector.h"
+#include "SIMD.h"
 
 namespace RenderDog
 {
@@ -65,7 +66,105 @@ namespace RenderDog
 				
 	Quaternion	Lerp(const Quaternion& quat1, const Quaternion& quat2, float lerpFactor);
 	Quaternion	SLerp(const Quaternion& quat1, const Quaternion& quat2, float lerpFactor);
+				//·ԲֵһٶȲ
+	Quaternion	NLerp(const Quaternion& quat1, const Quaternion& quat2, float lerpFactor);
+				//öʽֵӵNLerpҪǺSLerpתԼΪ1e-3
+	Quaternion	SLerpApprox(const Quaternion& quat1, const Quaternion& quat2, float lerpFactor);
+				//SLerpApproxʹõĲֵabsCosineΪԪľֵ
+	float		GetSLerpApproxFactor(float lerpFactor, float absCosine);
 
 	Quaternion	operator*(const Quaternion& lhs, const Quaternion& rhs);
 
+	///////////////////////////////////////////////////////////////////////////////////
+	// ----------------------       Inline Definition       -------------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	inline Quaternion operator*(const Quaternion& lhs, const Quaternion& rhs)
+	{
+#if RD_SIMD_SSE
+		//lhsķչlw * (rx, ry, rz, rw) + lx * (rw, -rz, ry, -rx) + ly * (rz, rw, -rx, -ry) + lz * (-ry, rx, rw, -rz)
+		__m128 l = _mm_loadu_ps(&lhs.x);
+		__m128 r = _mm_loadu_ps(&rhs.x);
+
+		__m128 r1 = _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f));
+		__m128 r2 = _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f));
+		__m128 r3 = _mm_mul_ps(_mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-1.0f, 1.0f, 1.0f, -1.0f));
+
+		__m128 result = _mm_mul_ps(RD_SIMD_SPLAT(l, 3), r);
+		result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(l, 0), r1));
+		result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(l, 1), r2));
+		result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(l, 2), r3));
+
+		Quaternion quatResult;
+		_mm_storeu_ps(&quatResult.x, result);
+
+		return quatResult;
+#else
+		float resX = lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y;
+		float resY = lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x;
+		float resZ = lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w;
+		float resW = lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z;
+
+		return Quaternion(resX, resY, resZ, resW);
+#endif
+	}
+
+	inline Quaternion& Quaternion::operator*=(const Quaternion& rhs)
+	{
+		*this = *this * rhs;
+
+		return *this;
+	}
+
+	inline float Quaternion::Length() const
+	{
+#if RD_SIMD_SSE
+		__m128 q = _mm_loadu_ps(&x);
+		return _mm_cvtss_f32(_mm_sqrt_ss(SIMDDot4(q, q)));
+#else
+		return std::sqrt(x * x + y * y + z * z + w * w);
+#endif
+	}
+
+	inline void Quaternion::Normalize()
+	{
+#if RD_SIMD_SSE
+		__m128 q = _mm_loadu_ps(&x);
+		__m128 sqrSum = SIMDDot4(q, q);
+		if (_mm_cvtss_f32(sqrSum) < RD_FLT_EPSILON)
+		{
+			x = y = z = 0;
+			w = 1;
+
+			return;
+		}
+
+		_mm_storeu_ps(&x, _mm_div_ps(q, _mm_sqrt_ps(sqrSum)));
+#else
+		float sqrSum = x * x + y * y + z * z + w * w;
+		if (std::abs(sqrSum - 0.0f) < RD_FLT_EPSILON)
+		{
+			x = y = z = 0;
+			w = 1;
+
+			return;
+		}
+
+		float invSqrt = 1.0f / std::sqrt(sqrSum);
+		x *= invSqrt;
+		y *= invSqrt;
+		z *= invSqrt;
+		w *= invSqrt;
+#endif
+	}
+
+	inline Quaternion Normalize(const Quaternion& quat)
+	{
+		Quaternion result = quat;
+
+		result.Normalize();
+
+		return result;
+	}
+
 }// namespace RenderDog
@@ -0,0 +1,65 @@
+///////////////////////////////////
+//RenderDog <,>
+//FileName: SIMD.h
+//Written by Xiang Weikang
+//Desc: ѧʹõSIMDָ
+///////////////////////////////////
+
+#pragma once
+
+//RD_SIMD_LEVEL: 0 ʵ֣1 SSE22 AVX
+//Ĭϸݱѡѡ(x64֧SSE2/arch:AVXʹAVX)ҲڹԤǿʹĳһ
+#if !defined(RD_SIMD_LEVEL)
+	#if defined(__AVX__)
+		#define RD_SIMD_LEVEL 2
+	#elif defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define RD_SIMD_LEVEL 1
+	#else
+		#define RD_SIMD_LEVEL 0
+	#endif
+#endif
+
+#define RD_SIMD_SSE		(RD_SIMD_LEVEL >= 1)
+#define RD_SIMD_AVX		(RD_SIMD_LEVEL >= 2)
+
+#if RD_SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#if RD_SIMD_AVX
+#include <immintrin.h>
+#endif
+
+//ҪĴʹ16ֽڶ
+#define RD_SIMD_ALIGN alignas(16)
+
+#if RD_SIMD_SSE
+namespace RenderDog
+{
+	//vĵi㲥4ͨ
+	#define RD_SIMD_SPLAT(v, i) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(i, i, i, i))
+
+	//4ͨǵ
+	inline __m128 SIMDDot4(__m128 lhs, __m128 rhs)
+	{
+		__m128 mul = _mm_mul_ps(lhs, rhs);
+		__m128 shuf = _mm_shuffle_ps(mul, mul, _MM_SHUFFLE(2, 3, 0, 1));
+		__m128 sums = _mm_add_ps(mul, shuf);
+		shuf = _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2));
+
+		return _mm_add_ps(sums, shuf);
+	}
+
+	//԰д洢4x4v.x * row0 + v.y * row1 + v.z * row2 + v.w * row3
+	inline __m128 SIMDTransformRow(__m128 v, __m128 row0, __m128 row1, __m128 row2, __m128 row3)
+	{
+		__m128 result = _mm_mul_ps(RD_SIMD_SPLAT(v, 0), row0);
+		result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(v, 1), row1));
+		result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(v, 2), row2));
+		result = _mm_add_ps(result, _mm_mul_ps(RD_SIMD_SPLAT(v, 3), row3));
+
+		return result;
+	}
+
+}// namespace RenderDog
+#endif
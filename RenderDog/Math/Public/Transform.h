@@ -11,6 +11,7 @@ namespace RenderDog
 	struct	Vector3;
 	struct	Quaternion;
 	class	Matrix4x4;
+	class	Matrix3x4;
 
 	Matrix4x4	GetTranslationMatrix(float xOffset, float yOffset, float zOffset);
 
@@ -29,4 +30,11 @@ namespace RenderDog
 	Matrix4x4	GetTransformMatrix(const Vector3& translation, const Vector3& scales, const Vector3& eulers);
 	Matrix4x4	GetTransformMatrix(const Vector3& translation, const Vector3& scales, const Quaternion& rotQuat);
 
+				//GetTransformMatrixͬšתƽ˳򣬽Ϊ
+	Matrix3x4	GetAffineTransform(const Vector3& translation, const Vector3& scales, const Vector3& eulers);
+	Matrix3x4	GetAffineTransform(const Vector3& translation, const Vector3& scales, const Quaternion& rotQuat);
+
+				//ֽΪšתƽƣ֧б䣻ĳΪ0ʱfalse
+	bool		DecomposeAffineTransform(const Matrix3x4& mat, Vector3& translation, Vector3& scales, Quaternion& rotQuat);
+
 }// namespace RenderDog
\ No newline at end of file
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include "SIMD.h"
+#include "Utility.h"
+
 #include <cmath>
 
 namespace RenderDog
@@ -97,12 +100,12 @@ namespace RenderDog
 		}
 	};
 
-	Vector2	operator+(const Vector2& lhs, const Vector2& rhs);
-	Vector2	operator-(const Vector2& lhs, const Vector2& rhs);
-	Vector2	operator*(const Vector2& lhs, const Vector2& rhs);
-	Vector2	operator*(const Vector2& v, float f);
-	Vector2	operator*(float f, const Vector2& v);
-	Vector2	operator/(const Vector2& v, float f);
+	inline Vector2 operator+(const Vector2& lhs, const Vector2& rhs) { return Vector2(lhs.x + rhs.x, lhs.y + rhs.y); }
+	inline Vector2 operator-(const Vector2& lhs, const Vector2& rhs) { return Vector2(lhs.x - rhs.x, lhs.y - rhs.y); }
+	inline Vector2 operator*(const Vector2& lhs, const Vector2& rhs) { return Vector2(lhs.x * rhs.x, lhs.y * rhs.y); }
+	inline Vector2 operator*(const Vector2& v, float f) { return Vector2(v.x * f, v.y * f); }
+	inline Vector2 operator*(float f, const Vector2& v) { return Vector2(v.x * f, v.y * f); }
+	inline Vector2 operator/(const Vector2& v, float f) { return Vector2(v.x / f, v.y / f); }
 
 	bool	operator==(const Vector2& lhs, const Vector2& rhs);
 	bool	operator!=(const Vector2& lhs, const Vector2& rhs);
@@ -212,24 +215,62 @@ namespace RenderDog
 		}
 
 		//ֵΪģ
-		float Normalize();
+		float Normalize()
+		{
+			float len = Length();
+			if (std::abs(len - 0.0f) < RD_FLT_EPSILON)
+			{
+				return 0.0f;
+			}
+
+			float invLen = 1.0f / len;
+
+			x *= invLen;
+			y *= invLen;
+			z *= invLen;
+
+			return len;
+		}
 	};
 
-	Vector3		operator+(const Vector3& lhs, const Vector3& rhs);
-	Vector3		operator-(const Vector3& lhs, const Vector3& rhs);
-	Vector3		operator*(const Vector3& lhs, const Vector3& rhs);
-	Vector3		operator*(float f, const Vector3& rhs);
-	Vector3		operator*(const Vector3& lhs, float f);
-	Vector3		operator/(const Vector3& lhs, float f);
+	//Vector3ֻ12ֽڣSIMDҪƴװﱣֱʵֲ
+	inline Vector3 operator+(const Vector3& lhs, const Vector3& rhs) { return Vector3(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z); }
+	inline Vector3 operator-(const Vector3& lhs, const Vector3& rhs) { return Vector3(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z); }
+	inline Vector3 operator*(const Vector3& lhs, const Vector3& rhs) { return Vector3(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z); }
+	inline Vector3 operator*(float f, const Vector3& rhs) { return Vector3(f * rhs.x, f * rhs.y, f * rhs.z); }
+	inline Vector3 operator*(const Vector3& lhs, float f) { return Vector3(f * lhs.x, f * lhs.y, f * lhs.z); }
+	inline Vector3 operator/(const Vector3& lhs, float f) { return Vector3(lhs.x / f, lhs.y / f, lhs.z / f); }
 
 	bool		operator==(const Vector3& lhs, const Vector3& rhs);
 	bool		operator!=(const Vector3& lhs, const Vector3& rhs);
 
-	float		DotProduct(const Vector3& lhs, const Vector3& rhs);
-	Vector3		CrossProduct(const Vector3& lhs, const Vector3& rhs);
+	inline float DotProduct(const Vector3& lhs, const Vector3& rhs)
+	{
+		return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+	}
+
+	inline Vector3 CrossProduct(const Vector3& lhs, const Vector3& rhs)
+	{
+		return Vector3(lhs.y * rhs.z - lhs.z * rhs.y,
+					   lhs.z * rhs.x - lhs.x * rhs.z,
+					   lhs.x * rhs.y - lhs.y * rhs.x);
+	}
+
+	inline Vector3 Normalize(const Vector3& v)
+	{
+		Vector3 result = v;
+		if (result.Normalize() == 0.0f)
+		{
+			return Vector3(0.0f);
+		}
+
+		return result;
+	}
 
-	Vector3		Normalize(const Vector3& v);
-	Vector3		Lerp(const Vector3& lhs, const Vector3& rhs, float lerpFactor);
+	inline Vector3 Lerp(const Vector3& lhs, const Vector3& rhs, float lerpFactor)
+	{
+		return lhs * (1.0f - lerpFactor) + rhs * lerpFactor;
+	}
 
 #pragma endregion Vector3
 
@@ -295,25 +336,80 @@ namespace RenderDog
 
 		float Length() const
 		{
+#if RD_SIMD_SSE
+			__m128 v = _mm_loadu_ps(&x);
+			return _mm_cvtss_f32(_mm_sqrt_ss(SIMDDot4(v, v)));
+#else
 			return std::sqrt(x * x + y * y + z * z + w * w);
+#endif
 		}
 
 		//ֵΪģ
-		float Normalize();
+		float Normalize()
+		{
+			float len = Length();
+			if (std::abs(len - 0.0f) < RD_FLT_EPSILON)
+			{
+				return 0.0f;
+			}
+
+			float invLen = 1.0f / len;
+#if RD_SIMD_SSE
+			_mm_storeu_ps(&x, _mm_mul_ps(_mm_loadu_ps(&x), _mm_set1_ps(invLen)));
+#else
+			x *= invLen;
+			y *= invLen;
+			z *= invLen;
+			w *= invLen;
+#endif
+
+			return len;
+		}
 	};
 
-	Vector4		operator+(const Vector4& lhs, const Vector4& rhs);
-	Vector4		operator-(const Vector4& lhs, const Vector4& rhs);
-	Vector4		operator*(const Vector4& lhs, const Vector4& rhs);
-	Vector4		operator*(const Vector4& lhs, float f);
-	Vector4		operator*(float f, const Vector4& rhs);
-	Vector4		operator/(const Vector4& lhs, float rhs);
+	//Vector4ûжҪ(ᱻڶṹ)SIMDʵͳһʹ÷Ƕд
+#if RD_SIMD_SSE
+	inline Vector4 SIMDStoreVector4(__m128 v)
+	{
+		Vector4 result;
+		_mm_storeu_ps(&result.x, v);
+
+		return result;
+	}
+
+	inline Vector4 operator+(const Vector4& lhs, const Vector4& rhs) { return SIMDStoreVector4(_mm_add_ps(_mm_loadu_ps(&lhs.x), _mm_loadu_ps(&rhs.x))); }
+	inline Vector4 operator-(const Vector4& lhs, const Vector4& rhs) { return SIMDStoreVector4(_mm_sub_ps(_mm_loadu_ps(&lhs.x), _mm_loadu_ps(&rhs.x))); }
+	inline Vector4 operator*(const Vector4& lhs, const Vector4& rhs) { return SIMDStoreVector4(_mm_mul_ps(_mm_loadu_ps(&lhs.x), _mm_loadu_ps(&rhs.x))); }
+	inline Vector4 operator*(const Vector4& lhs, float f) { return SIMDStoreVector4(_mm_mul_ps(_mm_loadu_ps(&lhs.x), _mm_set1_ps(f))); }
+	inline Vector4 operator*(float f, const Vector4& rhs) { return SIMDStoreVector4(_mm_mul_ps(_mm_loadu_ps(&rhs.x), _mm_set1_ps(f))); }
+	inline Vector4 operator/(const Vector4& lhs, float rhs) { return SIMDStoreVector4(_mm_div_ps(_mm_loadu_ps(&lhs.x), _mm_set1_ps(rhs))); }
+#else
+	inline Vector4 operator+(const Vector4& lhs, const Vector4& rhs) { return Vector4(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w); }
+	inline Vector4 operator-(const Vector4& lhs, const Vector4& rhs) { return Vector4(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w); }
+	inline Vector4 operator*(const Vector4& lhs, const Vector4& rhs) { return Vector4(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w); }
+	inline Vector4 operator*(const Vector4& lhs, float f) { return Vector4(lhs.x * f, lhs.y * f, lhs.z * f, lhs.w * f); }
+	inline Vector4 operator*(float f, const Vector4& rhs) { return Vector4(rhs.x * f, rhs.y * f, rhs.z * f, rhs.w * f); }
+	inline Vector4 operator/(const Vector4& lhs, float rhs) { return Vector4(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs); }
+#endif
 
 	bool		operator==(const Vector4& lhs, const Vector4& rhs);
 	bool		operator!=(const Vector4& lhs, const Vector4& rhs);
 
-	Vector4		Normalize(const Vector4& vec);
-	Vector4		Lerp(const Vector4& lhs, const Vector4& rhs, float lerpFactor);
+	inline Vector4 Normalize(const Vector4& vec)
+	{
+		Vector4 result = vec;
+		if (result.Normalize() == 0.0f)
+		{
+			return Vector4(0.0f);
+		}
+
+		return result;
+	}
+
+	inline Vector4 Lerp(const Vector4& lhs, const Vector4& rhs, float lerpFactor)
+	{
+		return lhs * (1.0f - lerpFactor) + rhs * lerpFactor;
+	}
 
 #pragma endregion Vector4
 
@@ -0,0 +1,569 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: BVH.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "BVH.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace RenderDog
+{
+	//SAHͰ
+	static const int		BVH_BIN_NUM = 16;
+	//ԪֵʱֻSAH۸Ͳż
+	static const uint32_t	BVH_MAX_LEAF_ITEM_NUM = 4;
+	//һڵڲһԪصĴ
+	static const float		BVH_NODE_TRAVERSAL_COST = 1.0f;
+	//ѯʱջĳʼ㹻ƽʹ
+	static const uint32_t	BVH_QUERY_STACK_RESERVE = 64;
+
+	struct BVHBin
+	{
+		AABB		bounds;
+		uint32_t	itemNum;
+
+		BVHBin() :
+			bounds(),
+			itemNum(0)
+		{}
+	};
+
+	static inline float GetAxisValue(const Vector3& v, int axis)
+	{
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	static inline int GetBinIndex(float centroid, float binMin, float binScale)
+	{
+		int binIndex = (int)((centroid - binMin) * binScale);
+		return binIndex < BVH_BIN_NUM - 1 ? binIndex : BVH_BIN_NUM - 1;
+	}
+
+	//invDirectionԤȼ㣬Ϊ0ʱõslabȻ
+	static inline bool IntersectRayNode(const Vector3& origin, const Vector3& invDirection, const AABB& bounds, float maxDistance, float& outDistance)
+	{
+		float tx0 = (bounds.minPoint.x - origin.x) * invDirection.x;
+		float tx1 = (bounds.maxPoint.x - origin.x) * invDirection.x;
+		float ty0 = (bounds.minPoint.y - origin.y) * invDirection.y;
+		float ty1 = (bounds.maxPoint.y - origin.y) * invDirection.y;
+		float tz0 = (bounds.minPoint.z - origin.z) * invDirection.z;
+		float tz1 = (bounds.maxPoint.z - origin.z) * invDirection.z;
+
+		float tMin = (std::max)((std::max)((std::min)(tx0, tx1), (std::min)(ty0, ty1)), (std::max)((std::min)(tz0, tz1), 0.0f));
+		float tMax = (std::min)((std::min)((std::max)(tx0, tx1), (std::max)(ty0, ty1)), (std::min)((std::max)(tz0, tz1), maxDistance));
+
+		outDistance = tMin;
+
+		return tMin <= tMax;
+	}
+
+	static inline bool IsSameAABB(const AABB& aabb0, const AABB& aabb1)
+	{
+		return aabb0.minPoint.x == aabb1.minPoint.x && aabb0.minPoint.y == aabb1.minPoint.y && aabb0.minPoint.z == aabb1.minPoint.z &&
+			   aabb0.maxPoint.x == aabb1.maxPoint.x && aabb0.maxPoint.y == aabb1.maxPoint.y && aabb0.maxPoint.z == aabb1.maxPoint.z;
+	}
+
+	BVH::BVH() :
+		m_Nodes(0),
+		m_ItemIndices(0),
+		m_ItemAABBs(0),
+		m_UnboundedItems(0),
+		m_ItemLeaves(0),
+		m_DirtyLeaves(0),
+		m_ItemNum(0),
+		m_AreaSum(0.0f),
+		m_BuildAreaSum(0.0f)
+	{}
+
+	BVH::~BVH()
+	{
+		Clear();
+	}
+
+	void BVH::Build(const AABB* pAABBs, uint32_t count)
+	{
+		Clear();
+
+		m_ItemNum = count;
+		m_ItemAABBs.assign(pAABBs, pAABBs + count);
+		m_ItemLeaves.assign(count, BVH_INVALID_INDEX);
+
+		std::vector<Vector3> centroids(count);
+		m_ItemIndices.reserve(count);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			if (!pAABBs[i].IsValid())
+			{
+				m_UnboundedItems.push_back(i);
+				continue;
+			}
+
+			m_ItemIndices.push_back(i);
+			centroids[i] = pAABBs[i].GetCenter();
+		}
+
+		if (m_ItemIndices.empty())
+		{
+			return;
+		}
+
+		//nҶڵĶ2n - 1ڵ
+		m_Nodes.reserve(m_ItemIndices.size() * 2);
+
+		BVHNode root;
+		root.firstItem = 0;
+		root.itemNum = (uint32_t)m_ItemIndices.size();
+		root.parent = BVH_INVALID_INDEX;
+		m_Nodes.push_back(root);
+
+		std::vector<uint32_t> nodeStack;
+		nodeStack.push_back(0);
+		while (!nodeStack.empty())
+		{
+			uint32_t nodeIndex = nodeStack.back();
+			nodeStack.pop_back();
+
+			if (SplitNode(nodeIndex, centroids))
+			{
+				nodeStack.push_back(m_Nodes[nodeIndex].leftChild);
+				nodeStack.push_back(m_Nodes[nodeIndex].leftChild + 1);
+			}
+		}
+
+		for (uint32_t i = 0; i < m_Nodes.size(); ++i)
+		{
+			const BVHNode& node = m_Nodes[i];
+			if (node.IsLeaf())
+			{
+				for (uint32_t j = node.firstItem; j < node.firstItem + node.itemNum; ++j)
+				{
+					m_ItemLeaves[m_ItemIndices[j]] = i;
+				}
+			}
+
+			m_AreaSum += node.bounds.GetSurfaceArea();
+		}
+		m_BuildAreaSum = m_AreaSum;
+	}
+
+	void BVH::Clear()
+	{
+		m_Nodes.clear();
+		m_ItemIndices.clear();
+		m_ItemAABBs.clear();
+		m_UnboundedItems.clear();
+		m_ItemLeaves.clear();
+		m_DirtyLeaves.clear();
+		m_ItemNum = 0;
+
+		m_AreaSum = 0.0f;
+		m_BuildAreaSum = 0.0f;
+	}
+
+	void BVH::Swap(BVH& other)
+	{
+		m_Nodes.swap(other.m_Nodes);
+		m_ItemIndices.swap(other.m_ItemIndices);
+		m_ItemAABBs.swap(other.m_ItemAABBs);
+		m_UnboundedItems.swap(other.m_UnboundedItems);
+		m_ItemLeaves.swap(other.m_ItemLeaves);
+		m_DirtyLeaves.swap(other.m_DirtyLeaves);
+		std::swap(m_ItemNum, other.m_ItemNum);
+		std::swap(m_AreaSum, other.m_AreaSum);
+		std::swap(m_BuildAreaSum, other.m_BuildAreaSum);
+	}
+
+	bool BVH::UpdateItem(uint32_t item, const AABB& aabb)
+	{
+		bool bWasBounded = m_ItemLeaves[item] != BVH_INVALID_INDEX;
+		m_ItemAABBs[item] = aabb;
+
+		if (aabb.IsValid() != bWasBounded)
+		{
+			return false;
+		}
+
+		if (bWasBounded)
+		{
+			BVHNode& leaf = m_Nodes[m_ItemLeaves[item]];
+			if (!leaf.bRefitDirty)
+			{
+				leaf.bRefitDirty = true;
+				m_DirtyLeaves.push_back(m_ItemLeaves[item]);
+			}
+		}
+
+		return true;
+	}
+
+	void BVH::Refit()
+	{
+		for (uint32_t i = 0; i < m_DirtyLeaves.size(); ++i)
+		{
+			uint32_t nodeIndex = m_DirtyLeaves[i];
+			m_Nodes[nodeIndex].bRefitDirty = false;
+
+			//Ÿڵϸ£Χûб仯ʱϲڵҲҪ
+			while (nodeIndex != BVH_INVALID_INDEX)
+			{
+				BVHNode& node = m_Nodes[nodeIndex];
+
+				AABB oldBounds = node.bounds;
+				CalcNodeBounds(node);
+				if (IsSameAABB(oldBounds, node.bounds))
+				{
+					break;
+				}
+
+				m_AreaSum += node.bounds.GetSurfaceArea() - oldBounds.GetSurfaceArea();
+				nodeIndex = node.parent;
+			}
+		}
+
+		m_DirtyLeaves.clear();
+	}
+
+	void BVH::CalcNodeBounds(BVHNode& node) const
+	{
+		node.bounds.Reset();
+		if (node.IsLeaf())
+		{
+			for (uint32_t i = node.firstItem; i < node.firstItem + node.itemNum; ++i)
+			{
+				node.bounds.Merge(m_ItemAABBs[m_ItemIndices[i]]);
+			}
+		}
+		else
+		{
+			node.bounds.Merge(m_Nodes[node.leftChild].bounds);
+			node.bounds.Merge(m_Nodes[node.leftChild + 1].bounds);
+		}
+	}
+
+	bool BVH::SplitNode(uint32_t nodeIndex, const std::vector<Vector3>& centroids)
+	{
+		BVHNode& node = m_Nodes[nodeIndex];
+
+		AABB centroidBounds;
+		for (uint32_t i = node.firstItem; i < node.firstItem + node.itemNum; ++i)
+		{
+			uint32_t item = m_ItemIndices[i];
+			node.bounds.Merge(m_ItemAABBs[item]);
+			centroidBounds.Merge(centroids[item]);
+		}
+
+		if (node.itemNum <= 1)
+		{
+			return false;
+		}
+
+		//ϷֱͰȡSAHСĻ
+		int bestAxis = -1;
+		int bestSplitBin = 0;
+		float bestCost = FLT_MAX;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float binMin = GetAxisValue(centroidBounds.minPoint, axis);
+			float binMax = GetAxisValue(centroidBounds.maxPoint, axis);
+			if (binMax <= binMin)
+			{
+				continue;
+			}
+
+			float binScale = BVH_BIN_NUM / (binMax - binMin);
+
+			BVHBin bins[BVH_BIN_NUM];
+			for (uint32_t i = node.firstItem; i < node.firstItem + node.itemNum; ++i)
+			{
+				uint32_t item = m_ItemIndices[i];
+				BVHBin& bin = bins[GetBinIndex(GetAxisValue(centroids[item], axis), binMin, binScale)];
+				bin.bounds.Merge(m_ItemAABBs[item]);
+				++bin.itemNum;
+			}
+
+			//rightCosts[i]Ϊi + 1һͰϲĴ
+			float rightCosts[BVH_BIN_NUM - 1];
+			AABB rightBounds;
+			uint32_t rightItemNum = 0;
+			for (int i = BVH_BIN_NUM - 1; i > 0; --i)
+			{
+				rightBounds.Merge(bins[i].bounds);
+				rightItemNum += bins[i].itemNum;
+				rightCosts[i - 1] = rightItemNum > 0 ? rightItemNum * rightBounds.GetSurfaceArea() : 0.0f;
+			}
+
+			AABB leftBounds;
+			uint32_t leftItemNum = 0;
+			for (int i = 0; i < BVH_BIN_NUM - 1; ++i)
+			{
+				leftBounds.Merge(bins[i].bounds);
+				leftItemNum += bins[i].itemNum;
+				if (leftItemNum == 0 || leftItemNum == node.itemNum)
+				{
+					continue;
+				}
+
+				float cost = leftItemNum * leftBounds.GetSurfaceArea() + rightCosts[i];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplitBin = i;
+				}
+			}
+		}
+
+		//Ԫصغϣ޷ٻ
+		if (bestAxis < 0)
+		{
+			return false;
+		}
+
+		float nodeArea = node.bounds.GetSurfaceArea();
+		float leafCost = node.itemNum * nodeArea;
+		if (node.itemNum <= BVH_MAX_LEAF_ITEM_NUM && bestCost + BVH_NODE_TRAVERSAL_COST * nodeArea >= leafCost)
+		{
+			return false;
+		}
+
+		float binMin = GetAxisValue(centroidBounds.minPoint, bestAxis);
+		float binScale = BVH_BIN_NUM / (GetAxisValue(centroidBounds.maxPoint, bestAxis) - binMin);
+
+		uint32_t* pFirst = &m_ItemIndices[node.firstItem];
+		uint32_t* pMid = std::partition(pFirst, pFirst + node.itemNum, [&](uint32_t item)
+		{
+			return GetBinIndex(GetAxisValue(centroids[item], bestAxis), binMin, binScale) <= bestSplitBin;
+		});
+
+		uint32_t leftItemNum = (uint32_t)(pMid - pFirst);
+		if (leftItemNum == 0 || leftItemNum == node.itemNum)
+		{
+			return false;
+		}
+
+		BVHNode leftChild;
+		leftChild.firstItem = node.firstItem;
+		leftChild.itemNum = leftItemNum;
+		leftChild.parent = nodeIndex;
+
+		BVHNode rightChild;
+		rightChild.firstItem = node.firstItem + leftItemNum;
+		rightChild.itemNum = node.itemNum - leftItemNum;
+		rightChild.parent = nodeIndex;
+
+		//push_back֮nodeÿʧЧȼ¼ӽڵλ
+		uint32_t leftChildIndex = (uint32_t)m_Nodes.size();
+		m_Nodes.push_back(leftChild);
+		m_Nodes.push_back(rightChild);
+		m_Nodes[nodeIndex].leftChild = leftChildIndex;
+
+		return true;
+	}
+
+	void BVH::AppendSubtreeItems(const BVHNode& node, std::vector<uint32_t>& outItems) const
+	{
+		outItems.insert(outItems.end(), m_ItemIndices.begin() + node.firstItem, m_ItemIndices.begin() + node.firstItem + node.itemNum);
+	}
+
+	void BVH::QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& nodeStack, std::vector<uint32_t>& outItems) const
+	{
+		outItems.insert(outItems.end(), m_UnboundedItems.begin(), m_UnboundedItems.end());
+
+		if (m_Nodes.empty())
+		{
+			return;
+		}
+
+		nodeStack.clear();
+		nodeStack.reserve(BVH_QUERY_STACK_RESERVE);
+		nodeStack.push_back(0);
+		while (!nodeStack.empty())
+		{
+			const BVHNode& node = m_Nodes[nodeStack.back()];
+			nodeStack.pop_back();
+
+			CONTAINMENT_TYPE result = frustum.Test(node.bounds);
+			if (result == CONTAINMENT_TYPE::OUTSIDE)
+			{
+				continue;
+			}
+
+			//ڵȫ׶ʱҪٲ
+			if (result == CONTAINMENT_TYPE::INSIDE)
+			{
+				AppendSubtreeItems(node, outItems);
+			}
+			else if (node.IsLeaf())
+			{
+				for (uint32_t i = node.firstItem; i < node.firstItem + node.itemNum; ++i)
+				{
+					uint32_t item = m_ItemIndices[i];
+					if (frustum.Test(m_ItemAABBs[item]) != CONTAINMENT_TYPE::OUTSIDE)
+					{
+						outItems.push_back(item);
+					}
+				}
+			}
+			else
+			{
+				nodeStack.push_back(node.leftChild);
+				nodeStack.push_back(node.leftChild + 1);
+			}
+		}
+	}
+
+	void BVH::QuerySphere(const BoundingSphere& sphere, std::vector<uint32_t>& nodeStack, std::vector<uint32_t>& outItems) const
+	{
+		outItems.insert(outItems.end(), m_UnboundedItems.begin(), m_UnboundedItems.end());
+
+		if (m_Nodes.empty())
+		{
+			return;
+		}
+
+		nodeStack.clear();
+		nodeStack.reserve(BVH_QUERY_STACK_RESERVE);
+		nodeStack.push_back(0);
+		while (!nodeStack.empty())
+		{
+			const BVHNode& node = m_Nodes[nodeStack.back()];
+			nodeStack.pop_back();
+
+			if (!IntersectSphereAABB(sphere, node.bounds))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.firstItem; i < node.firstItem + node.itemNum; ++i)
+				{
+					uint32_t item = m_ItemIndices[i];
+					if (IntersectSphereAABB(sphere, m_ItemAABBs[item]))
+					{
+						outItems.push_back(item);
+					}
+				}
+			}
+			else
+			{
+				nodeStack.push_back(node.leftChild);
+				nodeStack.push_back(node.leftChild + 1);
+			}
+		}
+	}
+
+	void BVH::QueryAABB(const AABB& aabb, std::vector<uint32_t>& nodeStack, std::vector<uint32_t>& outItems) const
+	{
+		outItems.insert(outItems.end(), m_UnboundedItems.begin(), m_UnboundedItems.end());
+
+		if (m_Nodes.empty())
+		{
+			return;
+		}
+
+		nodeStack.clear();
+		nodeStack.reserve(BVH_QUERY_STACK_RESERVE);
+		nodeStack.push_back(0);
+		while (!nodeStack.empty())
+		{
+			const BVHNode& node = m_Nodes[nodeStack.back()];
+			nodeStack.pop_back();
+
+			if (!IntersectAABB(aabb, node.bounds))
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.firstItem; i < node.firstItem + node.itemNum; ++i)
+				{
+					uint32_t item = m_ItemIndices[i];
+					if (IntersectAABB(aabb, m_ItemAABBs[item]))
+					{
+						outItems.push_back(item);
+					}
+				}
+			}
+			else
+			{
+				nodeStack.push_back(node.leftChild);
+				nodeStack.push_back(node.leftChild + 1);
+			}
+		}
+	}
+
+	void BVH::QueryRay(const Ray& ray, float maxDistance, std::vector<uint32_t>& nodeStack, std::vector<uint32_t>& outItems) const
+	{
+		outItems.insert(outItems.end(), m_UnboundedItems.begin(), m_UnboundedItems.end());
+
+		if (m_Nodes.empty())
+		{
+			return;
+		}
+
+		Vector3 invDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+		float rootDistance = 0.0f;
+		if (!IntersectRayNode(ray.origin, invDirection, m_Nodes[0].bounds, maxDistance, rootDistance))
+		{
+			return;
+		}
+
+		nodeStack.clear();
+		nodeStack.reserve(BVH_QUERY_STACK_RESERVE);
+		nodeStack.push_back(0);
+		while (!nodeStack.empty())
+		{
+			const BVHNode& node = m_Nodes[nodeStack.back()];
+			nodeStack.pop_back();
+
+			if (node.IsLeaf())
+			{
+				for (uint32_t i = node.firstItem; i < node.firstItem + node.itemNum; ++i)
+				{
+					uint32_t item = m_ItemIndices[i];
+					float distance = 0.0f;
+					if (IntersectRayNode(ray.origin, invDirection, m_ItemAABBs[item], maxDistance, distance))
+					{
+						outItems.push_back(item);
+					}
+				}
+
+				continue;
+			}
+
+			uint32_t nearChild = node.leftChild;
+			uint32_t farChild = node.leftChild + 1;
+			float nearDistance = 0.0f;
+			float farDistance = 0.0f;
+			bool bHitNear = IntersectRayNode(ray.origin, invDirection, m_Nodes[nearChild].bounds, maxDistance, nearDistance);
+			bool bHitFar = IntersectRayNode(ray.origin, invDirection, m_Nodes[farChild].bounds, maxDistance, farDistance);
+			if (bHitNear && bHitFar && farDistance < nearDistance)
+			{
+				std::swap(nearChild, farChild);
+			}
+			else if (!bHitNear)
+			{
+				nearChild = farChild;
+				bHitNear = bHitFar;
+				bHitFar = false;
+			}
+
+			//ջȳջӽڵջ
+			if (bHitFar)
+			{
+				nodeStack.push_back(farChild);
+			}
+			if (bHitNear)
+			{
+				nodeStack.push_back(nearChild);
+			}
+		}
+	}
+
+}// namespace RenderDog
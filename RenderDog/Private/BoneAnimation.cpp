@@ -8,6 +8,8 @@
 #include "Transform.h"
 
 #include <cmath>
+#include <cfloat>
+#include <algorithm>
 
 namespace RenderDog
 {
@@ -21,52 +23,29 @@ namespace RenderDog
 		return m_KeyFrames.back().timePos;
 	}
 
-	void BoneAnimation::Interpolate(float timePos, Matrix4x4& outputUpToParent) const
+	void BoneAnimation::GetKeyFramePair(float timePos, const BoneKeyFrame*& pKeyFrame0, const BoneKeyFrame*& pKeyFrame1, float& lerpFactor) const
 	{
 		if (timePos <= m_KeyFrames.front().timePos)
 		{
-			Vector3 translation = m_KeyFrames.front().translation;
-			Vector3 scales = m_KeyFrames.front().scales;
-			Quaternion rotationQuat = m_KeyFrames.front().rotationQuat;
-
-			outputUpToParent = GetTransformMatrix(translation, scales, rotationQuat);
+			pKeyFrame0 = &m_KeyFrames.front();
+			pKeyFrame1 = pKeyFrame0;
+			lerpFactor = 0.0f;
 		}
 		else if (timePos >= m_KeyFrames.back().timePos)
 		{
-			Vector3 translation = m_KeyFrames.back().translation;
-			Vector3 scales = m_KeyFrames.back().scales;
-			Quaternion rotationQuat = m_KeyFrames.back().rotationQuat;
-
-			outputUpToParent = GetTransformMatrix(translation, scales, rotationQuat);
+			pKeyFrame0 = &m_KeyFrames.back();
+			pKeyFrame1 = pKeyFrame0;
+			lerpFactor = 0.0f;
 		}
 		else
 		{
-			for (size_t i = 0; i < m_KeyFrames.size() - 1; ++i)
-			{
-				//ҵǰʱλؼ֮֡
-				if (timePos >= m_KeyFrames[i].timePos && timePos <= m_KeyFrames[i + 1].timePos)
-				{
-					float lerpFactor = (timePos - m_KeyFrames[i].timePos) / (m_KeyFrames[i + 1].timePos - m_KeyFrames[i].timePos);
-
-					Vector3 scales0 = m_KeyFrames[i].scales;
-					Vector3 scales1 = m_KeyFrames[i + 1].scales;
-					Vector3 currScales = Lerp(scales0, scales1, lerpFactor);
-
-					Quaternion rotationQuat0 = m_KeyFrames[i].rotationQuat;
-					Quaternion rotationQuat1 = m_KeyFrames[i + 1].rotationQuat;
-					Quaternion currRotationQuat = SLerp(rotationQuat0, rotationQuat1, lerpFactor);
-					//FIXME!!! LerpCrunchĶЧЩ⣬ĳЩ֡ᷢͻ䣬ҪģͲ
-					//Quaternion currRotationQuat = Lerp(rotationQuat0, rotationQuat1, lerpFactor);
-
-					Vector3 translation0 = m_KeyFrames[i].translation;
-					Vector3 translation1 = m_KeyFrames[i + 1].translation;
-					Vector3 currTranslation = Lerp(translation0, translation1, lerpFactor);
-
-					outputUpToParent = GetTransformMatrix(currTranslation, currScales, currRotationQuat);
-
-					break;
-				}
-			}
+			//ؼ֡ʱ򣬶ֲҵһʱtimePosĹؼ֡
+			auto iter = std::upper_bound(m_KeyFrames.begin(), m_KeyFrames.end(), timePos,
+				[](float time, const BoneKeyFrame& keyFrame) { return time < keyFrame.timePos; });
+
+			pKeyFrame1 = &(*iter);
+			pKeyFrame0 = &(*(iter - 1));
+			lerpFactor = (timePos - pKeyFrame0->timePos) / (pKeyFrame1->timePos - pKeyFrame0->timePos);
 		}
 	}
 
@@ -94,12 +73,35 @@ namespace RenderDog
 
 	void BoneAnimationClip::Interpolate(float timePos)
 	{
-		m_BoneAnimTransforms.resize(m_BoneAnimations.size());
+		uint32_t boneAnimNum = (uint32_t)m_BoneAnimations.size();
 
-		for (size_t i = 0; i < m_BoneAnimations.size(); ++i)
+		m_BoneAnimTransforms.resize(boneAnimNum);
+		m_FromRotations.Resize(boneAnimNum);
+		m_ToRotations.Resize(boneAnimNum);
+		m_CurrRotations.Resize(boneAnimNum);
+		m_LerpFactors.resize(boneAnimNum);
+		m_CurrScales.resize(boneAnimNum);
+		m_CurrTranslations.resize(boneAnimNum);
+
+		for (uint32_t i = 0; i < boneAnimNum; ++i)
 		{
-			m_BoneAnimations[i].Interpolate(timePos, m_BoneAnimTransforms[i]);
+			const BoneKeyFrame* pKeyFrame0 = nullptr;
+			const BoneKeyFrame* pKeyFrame1 = nullptr;
+			float lerpFactor = 0.0f;
+			m_BoneAnimations[i].GetKeyFramePair(timePos, pKeyFrame0, pKeyFrame1, lerpFactor);
+
+			m_FromRotations.Set(i, pKeyFrame0->rotationQuat);
+			m_ToRotations.Set(i, pKeyFrame1->rotationQuat);
+			m_LerpFactors[i] = lerpFactor;
+
+			m_CurrScales[i] = Lerp(pKeyFrame0->scales, pKeyFrame1->scales, lerpFactor);
+			m_CurrTranslations[i] = Lerp(pKeyFrame0->translation, pKeyFrame1->translation, lerpFactor);
 		}
+
+		//תͳһֵֵ·У֮ǰLerpCrunchĶϳֵͻûдԪŵµ
+		BatchSLerpApprox(m_CurrRotations, m_FromRotations, m_ToRotations, m_LerpFactors.data(), boneAnimNum);
+
+		BatchGetAffineTransform(m_BoneAnimTransforms.data(), m_CurrTranslations.data(), m_CurrScales.data(), m_CurrRotations, boneAnimNum);
 	}
 
 	int	BoneAnimationClip::GetBoneAnimIndexByName(const std::string& boneName) const
@@ -115,7 +117,7 @@ namespace RenderDog
 		return index;
 	}
 
-	const Matrix4x4& BoneAnimationClip::GetBoneAnimTransform(int boneAnimIndex) const
+	const Matrix3x4& BoneAnimationClip::GetBoneAnimTransform(int boneAnimIndex) const
 	{
 		return m_BoneAnimTransforms[boneAnimIndex];
 	}
@@ -0,0 +1,402 @@
+////////////////////////////////////////
+//	RenderDog <,>
+//	FileName: Bounding.cpp
+//	Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "Bounding.h"
+#include "SIMD.h"
+
+#include <cmath>
+
+namespace RenderDog
+{
+	OBB::OBB(const AABB& localAABB, const Matrix3x4& localToWorld)
+	{
+		center = localToWorld.TransformPoint(localAABB.GetCenter());
+
+		Vector3 localExtents = localAABB.GetExtents();
+		float localExtent[3] = { localExtents.x, localExtents.y, localExtents.z };
+		float worldExtent[3] = { 0.0f, 0.0f, 0.0f };
+		for (int i = 0; i < 3; ++i)
+		{
+			Vector3 worldAxis = localToWorld.GetAxis(i);
+			float scale = worldAxis.Length();
+
+			axis[i] = scale > 0.0f ? worldAxis / scale : Vector3(i == 0 ? 1.0f : 0.0f, i == 1 ? 1.0f : 0.0f, i == 2 ? 1.0f : 0.0f);
+			worldExtent[i] = localExtent[i] * scale;
+		}
+
+		extents = Vector3(worldExtent[0], worldExtent[1], worldExtent[2]);
+	}
+
+	void Plane::Normalize()
+	{
+		float length = normal.Length();
+		if (length > 0.0f)
+		{
+			float invLength = 1.0f / length;
+			normal *= invLength;
+			distance *= invLength;
+		}
+	}
+
+	void Frustum::ExtractFromMatrix(const Matrix4x4& matrix)
+	{
+		//Լ clip = (x, y, z, 1) * matrixclipÿǵ;ĳһеĵ
+		//-w <= x <= w-w <= y <= w0 <= z <= w Ӧƽ(Gribb-Hartmann)
+		Vector4 col0 = matrix.GetCol(0);
+		Vector4 col1 = matrix.GetCol(1);
+		Vector4 col2 = matrix.GetCol(2);
+		Vector4 col3 = matrix.GetCol(3);
+
+		planes[PLANE_LEFT]		= Plane(col3 + col0);
+		planes[PLANE_RIGHT]		= Plane(col3 - col0);
+		planes[PLANE_BOTTOM]	= Plane(col3 + col1);
+		planes[PLANE_TOP]		= Plane(col3 - col1);
+		planes[PLANE_NEAR]		= Plane(col2);
+		planes[PLANE_FAR]		= Plane(col3 - col2);
+
+		for (int i = 0; i < PLANE_NUM; ++i)
+		{
+			planes[i].Normalize();
+		}
+	}
+
+	bool Frustum::Contains(const Vector3& point) const
+	{
+		for (int i = 0; i < PLANE_NUM; ++i)
+		{
+			if (planes[i].GetSignedDistance(point) < 0.0f)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	CONTAINMENT_TYPE Frustum::Test(const AABB& aabb) const
+	{
+		Vector3 center = aabb.GetCenter();
+		Vector3 extents = aabb.GetExtents();
+
+		CONTAINMENT_TYPE result = CONTAINMENT_TYPE::INSIDE;
+		for (int i = 0; i < PLANE_NUM; ++i)
+		{
+			const Plane& plane = planes[i];
+
+			//Χƽ淨ϵͶӰ뾶
+			float radius = extents.x * std::abs(plane.normal.x) + extents.y * std::abs(plane.normal.y) + extents.z * std::abs(plane.normal.z);
+			float dist = plane.GetSignedDistance(center);
+			if (dist < -radius)
+			{
+				return CONTAINMENT_TYPE::OUTSIDE;
+			}
+			else if (dist < radius)
+			{
+				result = CONTAINMENT_TYPE::INTERSECT;
+			}
+		}
+
+		return result;
+	}
+
+	CONTAINMENT_TYPE Frustum::Test(const BoundingSphere& sphere) const
+	{
+		CONTAINMENT_TYPE result = CONTAINMENT_TYPE::INSIDE;
+		for (int i = 0; i < PLANE_NUM; ++i)
+		{
+			float dist = planes[i].GetSignedDistance(sphere.center);
+			if (dist < -sphere.radius)
+			{
+				return CONTAINMENT_TYPE::OUTSIDE;
+			}
+			else if (dist < sphere.radius)
+			{
+				result = CONTAINMENT_TYPE::INTERSECT;
+			}
+		}
+
+		return result;
+	}
+
+	CONTAINMENT_TYPE Frustum::Test(const OBB& obb) const
+	{
+		CONTAINMENT_TYPE result = CONTAINMENT_TYPE::INSIDE;
+		for (int i = 0; i < PLANE_NUM; ++i)
+		{
+			const Plane& plane = planes[i];
+
+			float radius = obb.extents.x * std::abs(DotProduct(plane.normal, obb.axis[0])) +
+						   obb.extents.y * std::abs(DotProduct(plane.normal, obb.axis[1])) +
+						   obb.extents.z * std::abs(DotProduct(plane.normal, obb.axis[2]));
+			float dist = plane.GetSignedDistance(obb.center);
+			if (dist < -radius)
+			{
+				return CONTAINMENT_TYPE::OUTSIDE;
+			}
+			else if (dist < radius)
+			{
+				result = CONTAINMENT_TYPE::INTERSECT;
+			}
+		}
+
+		return result;
+	}
+
+	bool IntersectAABB(const AABB& aabb0, const AABB& aabb1)
+	{
+		return aabb0.minPoint.x <= aabb1.maxPoint.x && aabb0.maxPoint.x >= aabb1.minPoint.x &&
+			   aabb0.minPoint.y <= aabb1.maxPoint.y && aabb0.maxPoint.y >= aabb1.minPoint.y &&
+			   aabb0.minPoint.z <= aabb1.maxPoint.z && aabb0.maxPoint.z >= aabb1.minPoint.z;
+	}
+
+	bool IntersectSphereAABB(const BoundingSphere& sphere, const AABB& aabb)
+	{
+		//ĵAABB
+		float closestX = sphere.center.x < aabb.minPoint.x ? aabb.minPoint.x : (sphere.center.x > aabb.maxPoint.x ? aabb.maxPoint.x : sphere.center.x);
+		float closestY = sphere.center.y < aabb.minPoint.y ? aabb.minPoint.y : (sphere.center.y > aabb.maxPoint.y ? aabb.maxPoint.y : sphere.center.y);
+		float closestZ = sphere.center.z < aabb.minPoint.z ? aabb.minPoint.z : (sphere.center.z > aabb.maxPoint.z ? aabb.maxPoint.z : sphere.center.z);
+
+		Vector3 delta = Vector3(closestX, closestY, closestZ) - sphere.center;
+
+		return DotProduct(delta, delta) <= sphere.radius * sphere.radius;
+	}
+
+	bool IntersectRayAABB(const Ray& ray, const AABB& aabb, float maxDistance, float& outDistance)
+	{
+		float tMin = 0.0f;
+		float tMax = maxDistance;
+
+		const float origin[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+		const float direction[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+		const float boxMin[3] = { aabb.minPoint.x, aabb.minPoint.y, aabb.minPoint.z };
+		const float boxMax[3] = { aabb.maxPoint.x, aabb.maxPoint.y, aabb.maxPoint.z };
+
+		for (int i = 0; i < 3; ++i)
+		{
+			if (std::abs(direction[i]) < FLT_EPSILON)
+			{
+				//һƽƽУ㲻ƽ֮Ͳཻ
+				if (origin[i] < boxMin[i] || origin[i] > boxMax[i])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			float invDir = 1.0f / direction[i];
+			float t0 = (boxMin[i] - origin[i]) * invDir;
+			float t1 = (boxMax[i] - origin[i]) * invDir;
+			if (t0 > t1)
+			{
+				float temp = t0;
+				t0 = t1;
+				t1 = temp;
+			}
+
+			tMin = t0 > tMin ? t0 : tMin;
+			tMax = t1 < tMax ? t1 : tMax;
+			if (tMin > tMax)
+			{
+				return false;
+			}
+		}
+
+		outDistance = tMin;
+
+		return true;
+	}
+
+	//outsideMaskintersectMaskĵkλӦkΧ
+	static inline void WriteContainmentResults(CONTAINMENT_TYPE* pResults, uint32_t laneNum, int outsideMask, int intersectMask)
+	{
+		for (uint32_t k = 0; k < laneNum; ++k)
+		{
+			if (outsideMask & (1 << k))
+			{
+				pResults[k] = CONTAINMENT_TYPE::OUTSIDE;
+			}
+			else if (intersectMask & (1 << k))
+			{
+				pResults[k] = CONTAINMENT_TYPE::INTERSECT;
+			}
+			else
+			{
+				pResults[k] = CONTAINMENT_TYPE::INSIDE;
+			}
+		}
+	}
+
+	void FrustumTestAABBs(const Frustum& frustum, const AABB* pAABBs, uint32_t count, CONTAINMENT_TYPE* pResults)
+	{
+		uint32_t i = 0;
+
+#if RD_SIMD_AVX
+		{
+			const __m256 half = _mm256_set1_ps(0.5f);
+
+			for (; i + 8 <= count; i += 8)
+			{
+				const AABB* p = pAABBs + i;
+
+				__m256 minX = _mm256_setr_ps(p[0].minPoint.x, p[1].minPoint.x, p[2].minPoint.x, p[3].minPoint.x, p[4].minPoint.x, p[5].minPoint.x, p[6].minPoint.x, p[7].minPoint.x);
+				__m256 minY = _mm256_setr_ps(p[0].minPoint.y, p[1].minPoint.y, p[2].minPoint.y, p[3].minPoint.y, p[4].minPoint.y, p[5].minPoint.y, p[6].minPoint.y, p[7].minPoint.y);
+				__m256 minZ = _mm256_setr_ps(p[0].minPoint.z, p[1].minPoint.z, p[2].minPoint.z, p[3].minPoint.z, p[4].minPoint.z, p[5].minPoint.z, p[6].minPoint.z, p[7].minPoint.z);
+				__m256 maxX = _mm256_setr_ps(p[0].maxPoint.x, p[1].maxPoint.x, p[2].maxPoint.x, p[3].maxPoint.x, p[4].maxPoint.x, p[5].maxPoint.x, p[6].maxPoint.x, p[7].maxPoint.x);
+				__m256 maxY = _mm256_setr_ps(p[0].maxPoint.y, p[1].maxPoint.y, p[2].maxPoint.y, p[3].maxPoint.y, p[4].maxPoint.y, p[5].maxPoint.y, p[6].maxPoint.y, p[7].maxPoint.y);
+				__m256 maxZ = _mm256_setr_ps(p[0].maxPoint.z, p[1].maxPoint.z, p[2].maxPoint.z, p[3].maxPoint.z, p[4].maxPoint.z, p[5].maxPoint.z, p[6].maxPoint.z, p[7].maxPoint.z);
+
+				__m256 centerX = _mm256_mul_ps(_mm256_add_ps(minX, maxX), half);
+				__m256 centerY = _mm256_mul_ps(_mm256_add_ps(minY, maxY), half);
+				__m256 centerZ = _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half);
+				__m256 extentX = _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half);
+				__m256 extentY = _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half);
+				__m256 extentZ = _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half);
+
+				__m256 outside = _mm256_setzero_ps();
+				__m256 intersect = _mm256_setzero_ps();
+				for (int j = 0; j < Frustum::PLANE_NUM; ++j)
+				{
+					const Plane& plane = frustum.planes[j];
+
+					__m256 dist = _mm256_mul_ps(centerX, _mm256_set1_ps(plane.normal.x));
+					dist = _mm256_add_ps(dist, _mm256_mul_ps(centerY, _mm256_set1_ps(plane.normal.y)));
+					dist = _mm256_add_ps(dist, _mm256_mul_ps(centerZ, _mm256_set1_ps(plane.normal.z)));
+					dist = _mm256_add_ps(dist, _mm256_set1_ps(plane.distance));
+
+					__m256 radius = _mm256_mul_ps(extentX, _mm256_set1_ps(std::abs(plane.normal.x)));
+					radius = _mm256_add_ps(radius, _mm256_mul_ps(extentY, _mm256_set1_ps(std::abs(plane.normal.y))));
+					radius = _mm256_add_ps(radius, _mm256_mul_ps(extentZ, _mm256_set1_ps(std::abs(plane.normal.z))));
+
+					outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(dist, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+					intersect = _mm256_or_ps(intersect, _mm256_cmp_ps(dist, radius, _CMP_LT_OQ));
+				}
+
+				WriteContainmentResults(pResults + i, 8, _mm256_movemask_ps(outside), _mm256_movemask_ps(intersect));
+			}
+		}
+#endif
+
+#if RD_SIMD_SSE
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				const AABB* p = pAABBs + i;
+
+				__m128 minX = _mm_setr_ps(p[0].minPoint.x, p[1].minPoint.x, p[2].minPoint.x, p[3].minPoint.x);
+				__m128 minY = _mm_setr_ps(p[0].minPoint.y, p[1].minPoint.y, p[2].minPoint.y, p[3].minPoint.y);
+				__m128 minZ = _mm_setr_ps(p[0].minPoint.z, p[1].minPoint.z, p[2].minPoint.z, p[3].minPoint.z);
+				__m128 maxX = _mm_setr_ps(p[0].maxPoint.x, p[1].maxPoint.x, p[2].maxPoint.x, p[3].maxPoint.x);
+				__m128 maxY = _mm_setr_ps(p[0].maxPoint.y, p[1].maxPoint.y, p[2].maxPoint.y, p[3].maxPoint.y);
+				__m128 maxZ = _mm_setr_ps(p[0].maxPoint.z, p[1].maxPoint.z, p[2].maxPoint.z, p[3].maxPoint.z);
+
+				__m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+				__m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+				__m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+				__m128 extentX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+				__m128 extentY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+				__m128 extentZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+				__m128 outside = _mm_setzero_ps();
+				__m128 intersect = _mm_setzero_ps();
+				for (int j = 0; j < Frustum::PLANE_NUM; ++j)
+				{
+					const Plane& plane = frustum.planes[j];
+
+					__m128 dist = _mm_mul_ps(centerX, _mm_set1_ps(plane.normal.x));
+					dist = _mm_add_ps(dist, _mm_mul_ps(centerY, _mm_set1_ps(plane.normal.y)));
+					dist = _mm_add_ps(dist, _mm_mul_ps(centerZ, _mm_set1_ps(plane.normal.z)));
+					dist = _mm_add_ps(dist, _mm_set1_ps(plane.distance));
+
+					__m128 radius = _mm_mul_ps(extentX, _mm_set1_ps(std::abs(plane.normal.x)));
+					radius = _mm_add_ps(radius, _mm_mul_ps(extentY, _mm_set1_ps(std::abs(plane.normal.y))));
+					radius = _mm_add_ps(radius, _mm_mul_ps(extentZ, _mm_set1_ps(std::abs(plane.normal.z))));
+
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+					intersect = _mm_or_ps(intersect, _mm_cmplt_ps(dist, radius));
+				}
+
+				WriteContainmentResults(pResults + i, 4, _mm_movemask_ps(outside), _mm_movemask_ps(intersect));
+			}
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			pResults[i] = frustum.Test(pAABBs[i]);
+		}
+	}
+
+	void FrustumTestSpheres(const Frustum& frustum, const BoundingSphere* pSpheres, uint32_t count, CONTAINMENT_TYPE* pResults)
+	{
+		uint32_t i = 0;
+
+#if RD_SIMD_AVX
+		for (; i + 8 <= count; i += 8)
+		{
+			const BoundingSphere* p = pSpheres + i;
+
+			__m256 centerX = _mm256_setr_ps(p[0].center.x, p[1].center.x, p[2].center.x, p[3].center.x, p[4].center.x, p[5].center.x, p[6].center.x, p[7].center.x);
+			__m256 centerY = _mm256_setr_ps(p[0].center.y, p[1].center.y, p[2].center.y, p[3].center.y, p[4].center.y, p[5].center.y, p[6].center.y, p[7].center.y);
+			__m256 centerZ = _mm256_setr_ps(p[0].center.z, p[1].center.z, p[2].center.z, p[3].center.z, p[4].center.z, p[5].center.z, p[6].center.z, p[7].center.z);
+			__m256 radius = _mm256_setr_ps(p[0].radius, p[1].radius, p[2].radius, p[3].radius, p[4].radius, p[5].radius, p[6].radius, p[7].radius);
+
+			__m256 outside = _mm256_setzero_ps();
+			__m256 intersect = _mm256_setzero_ps();
+			for (int j = 0; j < Frustum::PLANE_NUM; ++j)
+			{
+				const Plane& plane = frustum.planes[j];
+
+				__m256 dist = _mm256_mul_ps(centerX, _mm256_set1_ps(plane.normal.x));
+				dist = _mm256_add_ps(dist, _mm256_mul_ps(centerY, _mm256_set1_ps(plane.normal.y)));
+				dist = _mm256_add_ps(dist, _mm256_mul_ps(centerZ, _mm256_set1_ps(plane.normal.z)));
+				dist = _mm256_add_ps(dist, _mm256_set1_ps(plane.distance));
+
+				outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(dist, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+				intersect = _mm256_or_ps(intersect, _mm256_cmp_ps(dist, radius, _CMP_LT_OQ));
+			}
+
+			WriteContainmentResults(pResults + i, 8, _mm256_movemask_ps(outside), _mm256_movemask_ps(intersect));
+		}
+#endif
+
+#if RD_SIMD_SSE
+		for (; i + 4 <= count; i += 4)
+		{
+			const BoundingSphere* p = pSpheres + i;
+
+			__m128 centerX = _mm_setr_ps(p[0].center.x, p[1].center.x, p[2].center.x, p[3].center.x);
+			__m128 centerY = _mm_setr_ps(p[0].center.y, p[1].center.y, p[2].center.y, p[3].center.y);
+			__m128 centerZ = _mm_setr_ps(p[0].center.z, p[1].center.z, p[2].center.z, p[3].center.z);
+			__m128 radius = _mm_setr_ps(p[0].radius, p[1].radius, p[2].radius, p[3].radius);
+
+			__m128 outside = _mm_setzero_ps();
+			__m128 intersect = _mm_setzero_ps();
+			for (int j = 0; j < Frustum::PLANE_NUM; ++j)
+			{
+				const Plane& plane = frustum.planes[j];
+
+				__m128 dist = _mm_mul_ps(centerX, _mm_set1_ps(plane.normal.x));
+				dist = _mm_add_ps(dist, _mm_mul_ps(centerY, _mm_set1_ps(plane.normal.y)));
+				dist = _mm_add_ps(dist, _mm_mul_ps(centerZ, _mm_set1_ps(plane.normal.z)));
+				dist = _mm_add_ps(dist, _mm_set1_ps(plane.distance));
+
+				outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+				intersect = _mm_or_ps(intersect, _mm_cmplt_ps(dist, radius));
+			}
+
+			WriteContainmentResults(pResults + i, 4, _mm_movemask_ps(outside), _mm_movemask_ps(intersect));
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			pResults[i] = frustum.Test(pSpheres[i]);
+		}
+	}
+
+}// namespace RenderDog
@@ -7,6 +7,9 @@
 #include "Camera.h"
 #include "Utility.h"
 #include "Transform.h"
+#include "Bounding.h"
+
+#include <cmath>
 
 namespace RenderDog
 {
@@ -63,7 +66,18 @@ namespace RenderDog
 
 	Matrix4x4 FPSCamera::GetViewMatrix() const
 	{
-		return GetLookAtMatrixLH(m_Postion, m_Postion + m_Direction, Vector3(0.0f, 1.0f, 0.0f));
+		//任ֻתƽƣֱת
+		return RigidInverse(GetCameraToWorldMatrix()).ToMatrix4x4();
+	}
+
+	Matrix3x4 FPSCamera::GetCameraToWorldMatrix() const
+	{
+		//GetLookAtMatrixLHĹ췽ʽһ
+		Vector3 camZAxis = Normalize(m_Direction);
+		Vector3 camXAxis = Normalize(CrossProduct(Vector3(0.0f, 1.0f, 0.0f), camZAxis));
+		Vector3 camYAxis = CrossProduct(camZAxis, camXAxis);
+
+		return Matrix3x4(camXAxis, camYAxis, camZAxis, m_Postion);
 	}
 
 	Matrix4x4 FPSCamera::GetPerspProjectionMatrix() const
@@ -71,6 +85,15 @@ namespace RenderDog
 		return GetPerspectiveMatrixLH(m_Fov, m_Aspect, m_Near, m_Far);
 	}
 
+	Ray FPSCamera::GetPickRay(float ndcX, float ndcY) const
+	{
+		//m_FovΪֱӽǣռzΪ1ƽĻİΪtan(fov / 2)
+		float tanHalfFov = std::tan(0.5f * AngleToRadians(m_Fov));
+		Vector3 camDirection(ndcX * tanHalfFov * m_Aspect, ndcY * tanHalfFov, 1.0f);
+
+		return Ray(m_Postion, Normalize(GetCameraToWorldMatrix().TransformVector(camDirection)));
+	}
+
 	void FPSCamera::Move(MOVE_MODE moveMode, float deltaTime)
 	{
 		float moveDistance = m_moveSpeed * deltaTime;
@@ -128,6 +151,16 @@ namespace RenderDog
 		m_Up.Normalize();
 	}
 
+	void FPSCamera::SetPosAndRotation(const Vector3& pos, float yaw, float pitch)
+	{
+		m_Postion = pos;
+		m_Yaw = yaw;
+		m_Pitch = pitch;
+
+		//RotateƸǲ·
+		Rotate(0.0f, 0.0f);
+	}
+
 	void FPSCamera::OnWindowResize(uint32_t width, uint32_t height)
 	{
 		m_Aspect = float(width) / (float)height;
@@ -6,6 +6,7 @@
 
 #include "FbxImporter.h"
 #include "Matrix.h"
+#include "Profiler.h"
 
 namespace RenderDog
 {
@@ -103,6 +104,8 @@ namespace RenderDog
 
 	bool RDFbxImporter::LoadFbxFile(const std::string& filePath, FBX_LOAD_TYPE loadType, const FbxLoadParam& loadParam/* = FbxLoadParam()*/)
 	{
+		RD_PROFILE_SCOPE("RDFbxImporter::LoadFbxFile");
+
 		m_bNeedBoneSkin = (loadType == FBX_LOAD_TYPE::SKIN_MODEL);
 		
 		if (!m_pImporter->Initialize(filePath.c_str(), -1, m_pManager->GetIOSettings()))
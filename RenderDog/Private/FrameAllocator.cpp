@@ -0,0 +1,167 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: FrameAllocator.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "FrameAllocator.h"
+
+#include <cstdlib>
+#include <algorithm>
+
+namespace RenderDog
+{
+	struct FrameThreadArena
+	{
+		LinearAllocator		allocators[2];
+		uint32_t			frameIndex;		//һηʱ֡
+
+		FrameThreadArena() :
+			frameIndex(0)
+		{}
+	};
+
+	FrameAllocator	g_FrameAllocator;
+	FrameAllocator*	g_pFrameAllocator = &g_FrameAllocator;
+
+	thread_local FrameThreadArena*	t_pFrameArena = nullptr;
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//------------------             LinearAllocator             --------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	LinearAllocator::LinearAllocator(uint32_t blockSize) :
+		m_Blocks(0),
+		m_BlockSize(blockSize),
+		m_CurrOffset(0),
+		m_UsedSize(0)
+	{}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		for (uint32_t i = 0; i < m_Blocks.size(); ++i)
+		{
+			std::free(m_Blocks[i].pData);
+		}
+		m_Blocks.clear();
+	}
+
+	void* LinearAllocator::Allocate(size_t size, size_t alignment)
+	{
+		//ʼַmalloc룬ƫƶַǶ
+		size_t alignedOffset = (m_CurrOffset + alignment - 1) & ~(alignment - 1);
+		if (m_Blocks.empty() || alignedOffset + size > m_Blocks.back().size)
+		{
+			if (!AllocateBlock((std::max)(m_BlockSize, size + alignment)))
+			{
+				return nullptr;
+			}
+			alignedOffset = 0;
+		}
+
+		void* pResult = m_Blocks.back().pData + alignedOffset;
+		m_UsedSize += alignedOffset + size - m_CurrOffset;
+		m_CurrOffset = alignedOffset + size;
+
+		return pResult;
+	}
+
+	void LinearAllocator::Reset()
+	{
+		//һ֡˶ʱϲһ㹻Ŀ飬֮֡ҪӶϷ
+		if (m_Blocks.size() > 1)
+		{
+			size_t totalSize = 0;
+			for (uint32_t i = 0; i < m_Blocks.size(); ++i)
+			{
+				totalSize += m_Blocks[i].size;
+				std::free(m_Blocks[i].pData);
+			}
+			m_Blocks.clear();
+
+			AllocateBlock(totalSize);
+		}
+
+		m_CurrOffset = 0;
+		m_UsedSize = 0;
+	}
+
+	bool LinearAllocator::AllocateBlock(size_t size)
+	{
+		Block block;
+		block.pData = static_cast<unsigned char*>(std::malloc(size));
+		if (!block.pData)
+		{
+			return false;
+		}
+		block.size = size;
+
+		m_Blocks.push_back(block);
+		m_CurrOffset = 0;
+
+		return true;
+	}
+
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//------------------              FrameAllocator             --------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	FrameAllocator::FrameAllocator() :
+		m_FrameIndex(0),
+		m_ArenaMutex(),
+		m_ThreadArenas(0)
+	{}
+
+	FrameAllocator::~FrameAllocator()
+	{
+		for (uint32_t i = 0; i < m_ThreadArenas.size(); ++i)
+		{
+			delete m_ThreadArenas[i];
+		}
+		m_ThreadArenas.clear();
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		m_FrameIndex.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		FrameThreadArena* pArena = GetThreadArena();
+
+		return pArena->allocators[pArena->frameIndex & 1].Allocate(size, alignment);
+	}
+
+	//---------------------------------------------------------------------------
+	//   Private Function Definition
+	//---------------------------------------------------------------------------
+
+	FrameThreadArena* FrameAllocator::GetThreadArena()
+	{
+		if (!t_pFrameArena)
+		{
+			t_pFrameArena = new FrameThreadArena();
+			t_pFrameArena->frameIndex = m_FrameIndex.load(std::memory_order_relaxed);
+
+			std::lock_guard<std::mutex> lock(m_ArenaMutex);
+			m_ThreadArenas.push_back(t_pFrameArena);
+		}
+
+		//µһ֡߳Լ֮֡ǰʹõķһ֡ڴ汣Ч
+		uint32_t frameIndex = m_FrameIndex.load(std::memory_order_relaxed);
+		if (t_pFrameArena->frameIndex != frameIndex)
+		{
+			if (frameIndex - t_pFrameArena->frameIndex > 1)
+			{
+				t_pFrameArena->allocators[(frameIndex + 1) & 1].Reset();
+			}
+			t_pFrameArena->allocators[frameIndex & 1].Reset();
+			t_pFrameArena->frameIndex = frameIndex;
+		}
+
+		return t_pFrameArena;
+	}
+
+}// namespace RenderDog
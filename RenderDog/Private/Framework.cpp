@@ -8,6 +8,12 @@
 #include "Framework.h"
 #include "Renderer.h"
 #include "Scene.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "RenderThread.h"
+#include "FrameAllocator.h"
+#include "TransformSystem.h"
+#include "Camera.h"
 
 #include <vector>
 
@@ -17,7 +23,10 @@ namespace RenderDog
 	{
 	public:
 		Framework():
-			m_Scenes(0)
+			m_Scenes(0),
+			m_pGameCamera(nullptr),
+			m_RenderCamera(),
+			m_bRenderThread(false)
 		{}
 
 		virtual ~Framework()
@@ -25,7 +34,7 @@ namespace RenderDog
 			m_Scenes.clear();
 		}
 
-		virtual bool			Init() override;
+		virtual bool			Init(const FrameworkInitDesc& desc) override;
 		virtual void			Release() override;
 
 		virtual void			Frame() override;
@@ -33,8 +42,19 @@ namespace RenderDog
 
 		virtual void			RegisterScene(IScene* pScene) override;
 
+		virtual FPSCamera*		GetRenderCamera() override;
+		virtual void			FlushRendering() override;
+
+	private:
+		void					RenderScenes();
+
 	private:
+		//ֻȾ̷߳
 		std::vector<IScene*>	m_Scenes;
+
+		FPSCamera*				m_pGameCamera;
+		FPSCamera				m_RenderCamera;
+		bool					m_bRenderThread;
 	};
 
 	Framework	g_Framework;
@@ -45,39 +65,122 @@ namespace RenderDog
 	// -----------------     Public Function Definition       -----------------------//
 	///////////////////////////////////////////////////////////////////////////////////
 
-	bool Framework::Init()
+	bool Framework::Init(const FrameworkInitDesc& desc)
 	{
+		if (!g_pJobSystem->Init())
+		{
+			return false;
+		}
+
+		m_pGameCamera = desc.pMainCamera;
+		m_bRenderThread = desc.bRenderThread && m_pGameCamera;
+		if (m_pGameCamera)
+		{
+			m_RenderCamera = *m_pGameCamera;
+		}
+
 		return true;
 	}
 
 	void Framework::Release()
 	{
+		//Ⱦִ̻߳ʣ
+		g_pRenderThread->Stop();
+
+		g_pJobSystem->Release();
+
 		return;
 	}
 
 	void Framework::Frame()
 	{
-		for (uint32_t i = 0; i < m_Scenes.size(); ++i)
+		RD_PROFILE_SCOPE("Framework::Frame");
+
+		//߳ύִֻ߳е
+		g_pJobSystem->ExecuteMainThreadJobs();
+
+		if (m_bRenderThread && !g_pRenderThread->IsRunning())
 		{
-			g_pIRenderer->Update(m_Scenes[i]);
+			if (!g_pRenderThread->Start())
+			{
+				m_bRenderThread = false;
+			}
 		}
 
-		for (uint32_t i = 0; i < m_Scenes.size(); ++i)
+		//һ֡޸Ĺı任ͳһ£ڻصаµı任ͰΧύȾ߳
+		g_pTransformSystem->Update();
+
+		if (!g_pRenderThread->IsRunning())
 		{
-			g_pIRenderer->Render(m_Scenes[i]);
+			RenderScenes();
+			return;
 		}
+
+		//�һݣϷ߳Ⱦ̻߳һ֡ͬʱԼһ֡
+		FPSCamera gameCamera = *m_pGameCamera;
+		g_pRenderThread->EnqueueCommand([this, gameCamera]()
+		{
+			m_RenderCamera = gameCamera;
+			RenderScenes();
+		});
+
+		g_pRenderThread->EndFrame();
 	}
 
 	void Framework::OnResize(uint32_t width, uint32_t height)
 	{
-		g_pIRenderer->OnResize(width, height);
+		//Ⱦֻ޸ȾϷĿ߱Ҫͬ
+		if (m_bRenderThread)
+		{
+			m_pGameCamera->OnWindowResize(width, height);
+		}
+
+		g_pRenderThread->EnqueueCommand([width, height]()
+		{
+			g_pIRenderer->OnResize(width, height);
+		});
 
 		return;
 	}
 
 	void Framework::RegisterScene(IScene* pScene)
 	{
-		m_Scenes.push_back(pScene);
+		g_pRenderThread->EnqueueCommand([this, pScene]()
+		{
+			m_Scenes.push_back(pScene);
+		});
+	}
+
+	FPSCamera* Framework::GetRenderCamera()
+	{
+		return m_bRenderThread ? &m_RenderCamera : m_pGameCamera;
+	}
+
+	void Framework::FlushRendering()
+	{
+		g_pRenderThread->Flush();
+	}
+
+	//---------------------------------------------------------------------------
+	//   Private Function Definition
+	//---------------------------------------------------------------------------
+
+	void Framework::RenderScenes()
+	{
+		//һ֮֡ǰʱ֮Ա
+		g_pFrameAllocator->BeginFrame();
+
+		for (uint32_t i = 0; i < m_Scenes.size(); ++i)
+		{
+			RD_PROFILE_SCOPE("IRenderer::Update");
+			g_pIRenderer->Update(m_Scenes[i]);
+		}
+
+		for (uint32_t i = 0; i < m_Scenes.size(); ++i)
+		{
+			RD_PROFILE_SCOPE("IRenderer::Render");
+			g_pIRenderer->Render(m_Scenes[i]);
+		}
 	}
 
 }// namespace RenderDog
\ No newline at end of file
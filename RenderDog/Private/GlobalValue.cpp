@@ -11,6 +11,7 @@ namespace RenderDog
 	//Shadow
 	int			g_ShadowMapRTSize = 2048;
 	float		g_ShadowDepthOffset = 0.01f;
-	float		g_ShadowDistance = 100.0f;
+	float		g_ShadowDistance = 3000.0f;			//λcmزӰ
+	float		g_ShadowCascadeSplitLambda = 0.75f;	//ʱռıΪȻ
 
 }// namespace RenderDog
\ No newline at end of file
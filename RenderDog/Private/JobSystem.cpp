@@ -0,0 +1,521 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: JobSystem.cpp
+//Written by Xiang Weikang
+//Desc: ڹȡȣÿ߳ӵһ
+////////////////////////////////////////
+
+#include "JobSystem.h"
+
+#include <cassert>
+
+namespace RenderDog
+{
+	//߳ҲʱóʱƬôΣȻ˯
+	static const uint32_t	JOB_SPIN_COUNT = 64;
+
+	struct JobWorker
+	{
+		JobQueue				queue;
+		Job*					pJobPool;
+		uint32_t				jobPoolIndex;
+		uint32_t				randomState;		//ѡȡ״̬
+
+		JobWorker() :
+			queue(),
+			pJobPool(nullptr),
+			jobPoolIndex(0),
+			randomState(0)
+		{}
+	};
+
+	JobSystem	g_JobSystem;
+	JobSystem*	g_pJobSystem = &g_JobSystem;
+
+	thread_local uint32_t	t_WorkerIndex = JOB_INVALID_WORKER;
+
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// ----------------------          JobQueue          ----------------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	JobQueue::JobQueue() :
+		m_Top(0),
+		m_Bottom(0)
+	{
+		for (uint32_t i = 0; i < JOB_QUEUE_SIZE; ++i)
+		{
+			m_Jobs[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	bool JobQueue::Push(Job* pJob)
+	{
+		int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+		int64_t top = m_Top.load(std::memory_order_acquire);
+		if (bottom - top >= (int64_t)JOB_QUEUE_SIZE)
+		{
+			return false;
+		}
+
+		//release֤ȡ߳̿µbottomʱҲܿ
+		m_Jobs[bottom & (JOB_QUEUE_SIZE - 1)].store(pJob, std::memory_order_relaxed);
+		m_Bottom.store(bottom + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	Job* JobQueue::Pop()
+	{
+		int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+		m_Bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t top = m_Top.load(std::memory_order_relaxed);
+
+		if (top > bottom)
+		{
+			//Ϊ
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		Job* pJob = m_Jobs[bottom & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+		if (top == bottom)
+		{
+			//ֻʣһ񣬺ȡ߳̾
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				pJob = nullptr;
+			}
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return pJob;
+	}
+
+	Job* JobQueue::Steal()
+	{
+		int64_t top = m_Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+		{
+			return nullptr;
+		}
+
+		Job* pJob = m_Jobs[top & (JOB_QUEUE_SIZE - 1)].load(std::memory_order_relaxed);
+		if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			return nullptr;
+		}
+
+		return pJob;
+	}
+
+
+	///////////////////////////////////////////////////////////////////////////////////
+	// ----------------------          JobSystem         ----------------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	JobSystem::JobSystem() :
+		m_WorkerNum(0),
+		m_WorkerThreads(0),
+		m_Workers(0),
+		m_pExternalJobPool(nullptr),
+		m_ExternalJobPoolIndex(0),
+		m_ExternalQueue(),
+		m_ExternalJobNum(0),
+		m_MainThreadQueue(),
+		m_MainThreadJobNum(0),
+		m_SubmitCount(0),
+		m_SleepingWorkerNum(0),
+		m_bQuit(false)
+	{
+		//ûгʼʱύʱֱִУҲҪأֵʼʹunfinishedNumΪ0ڼ⸴δɵ
+		m_pExternalJobPool = new Job[JOB_POOL_SIZE]();
+	}
+
+	JobSystem::~JobSystem()
+	{
+		Release();
+
+		if (m_pExternalJobPool)
+		{
+			delete[] m_pExternalJobPool;
+			m_pExternalJobPool = nullptr;
+		}
+	}
+
+	bool JobSystem::Init(uint32_t workerNum /* = 0 */)
+	{
+		if (IsInitialized())
+		{
+			return true;
+		}
+
+		if (workerNum == 0)
+		{
+			workerNum = std::thread::hardware_concurrency();
+			workerNum = workerNum > 0 ? workerNum : 1;
+		}
+
+		m_bQuit.store(false);
+
+		m_Workers.resize(workerNum);
+		for (uint32_t i = 0; i < workerNum; ++i)
+		{
+			m_Workers[i] = new JobWorker();
+			m_Workers[i]->pJobPool = new Job[JOB_POOL_SIZE]();
+			m_Workers[i]->randomState = i * 2654435761u + 1;
+		}
+
+		m_WorkerNum = workerNum;
+		t_WorkerIndex = 0;
+
+		m_WorkerThreads.reserve(workerNum - 1);
+		for (uint32_t i = 1; i < workerNum; ++i)
+		{
+			m_WorkerThreads.emplace_back(&JobSystem::WorkerThreadMain, this, i);
+		}
+
+		return true;
+	}
+
+	void JobSystem::Release()
+	{
+		if (!IsInitialized())
+		{
+			return;
+		}
+
+		//ûִеֱӶ
+		{
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+			m_bQuit.store(true);
+		}
+		m_SleepCondition.notify_all();
+
+		for (uint32_t i = 0; i < m_WorkerThreads.size(); ++i)
+		{
+			m_WorkerThreads[i].join();
+		}
+		m_WorkerThreads.clear();
+
+		for (uint32_t i = 0; i < m_Workers.size(); ++i)
+		{
+			delete[] m_Workers[i]->pJobPool;
+			delete m_Workers[i];
+		}
+		m_Workers.clear();
+
+		m_ExternalQueue.clear();
+		m_ExternalJobNum.store(0);
+		m_MainThreadQueue.clear();
+		m_MainThreadJobNum.store(0);
+
+		m_WorkerNum = 0;
+		t_WorkerIndex = JOB_INVALID_WORKER;
+	}
+
+	uint32_t JobSystem::GetCurrWorkerIndex() const
+	{
+		return t_WorkerIndex < m_WorkerNum ? t_WorkerIndex : JOB_INVALID_WORKER;
+	}
+
+	bool JobSystem::AddContinuation(Job* pJob, Job* pContinuation)
+	{
+		int32_t index = pJob->continuationNum.fetch_add(1, std::memory_order_relaxed);
+		if (index >= (int32_t)JOB_MAX_CONTINUATION_NUM)
+		{
+			pJob->continuationNum.fetch_sub(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		pJob->continuations[index] = pContinuation;
+		pContinuation->dependencyNum.fetch_add(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	void JobSystem::Run(Job* pJob)
+	{
+		Submit(pJob);
+	}
+
+	void JobSystem::Wait(const Job* pJob)
+	{
+		uint32_t workerIndex = GetCurrWorkerIndex();
+		//ϵͳѾͷʱе񱻶ٵȴ
+		while (IsInitialized() && !IsFinished(pJob))
+		{
+			//ǹֻ߳ܰæִйύе
+			Job* pOtherJob = workerIndex != JOB_INVALID_WORKER ? GetJob(workerIndex) : PopExternalJob();
+			if (pOtherJob)
+			{
+				Execute(pOtherJob);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void JobSystem::ExecuteMainThreadJobs()
+	{
+		if (!IsMainThread())
+		{
+			return;
+		}
+
+		while (m_MainThreadJobNum.load(std::memory_order_acquire) > 0)
+		{
+			Job* pJob = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(m_MainThreadQueueMutex);
+				if (m_MainThreadQueue.empty())
+				{
+					break;
+				}
+
+				pJob = m_MainThreadQueue.front();
+				m_MainThreadQueue.pop_front();
+				m_MainThreadJobNum.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			Execute(pJob);
+		}
+	}
+
+	Job* JobSystem::AllocateJob()
+	{
+		Job* pJob = nullptr;
+		uint32_t workerIndex = GetCurrWorkerIndex();
+		if (workerIndex != JOB_INVALID_WORKER)
+		{
+			JobWorker* pWorker = m_Workers[workerIndex];
+			pJob = &(pWorker->pJobPool[(pWorker->jobPoolIndex++) & (JOB_POOL_SIZE - 1)]);
+		}
+		else
+		{
+			uint32_t index = m_ExternalJobPoolIndex.fetch_add(1, std::memory_order_relaxed);
+			pJob = &(m_pExternalJobPool[index & (JOB_POOL_SIZE - 1)]);
+		}
+
+		//ƻصûɵ˵JOB_POOL_SIZEδҪCreateJobInPlace
+		assert(pJob->unfinishedNum.load(std::memory_order_acquire) == 0 && "Job pool wrapped onto an unfinished job.");
+
+		return pJob;
+	}
+
+	void JobSystem::InitJob(Job* pJob, JobFunction pFunction, Job* pParent, bool bMainThreadOnly)
+	{
+		pJob->pFunction = pFunction;
+		pJob->pParent = pParent;
+		pJob->unfinishedNum.store(1, std::memory_order_relaxed);
+		pJob->dependencyNum.store(0, std::memory_order_relaxed);
+		pJob->continuationNum.store(0, std::memory_order_relaxed);
+		pJob->bMainThreadOnly = bMainThreadOnly;
+
+		if (pParent)
+		{
+			pParent->unfinishedNum.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void JobSystem::Submit(Job* pJob)
+	{
+		if (!IsInitialized())
+		{
+			Execute(pJob);
+			return;
+		}
+
+		uint32_t workerIndex = GetCurrWorkerIndex();
+		if (pJob->bMainThreadOnly)
+		{
+			std::lock_guard<std::mutex> lock(m_MainThreadQueueMutex);
+			m_MainThreadQueue.push_back(pJob);
+			m_MainThreadJobNum.fetch_add(1, std::memory_order_release);
+		}
+		else if (workerIndex != JOB_INVALID_WORKER)
+		{
+			if (!m_Workers[workerIndex]->queue.Push(pJob))
+			{
+				Execute(pJob);
+				return;
+			}
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(m_ExternalQueueMutex);
+			m_ExternalQueue.push_back(pJob);
+			m_ExternalJobNum.fetch_add(1, std::memory_order_release);
+		}
+
+		m_SubmitCount.fetch_add(1);
+		WakeWorkers();
+	}
+
+	Job* JobSystem::GetJob(uint32_t workerIndex)
+	{
+		JobWorker* pWorker = m_Workers[workerIndex];
+
+		if (workerIndex == 0 && m_MainThreadJobNum.load(std::memory_order_acquire) > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_MainThreadQueueMutex);
+			if (!m_MainThreadQueue.empty())
+			{
+				Job* pJob = m_MainThreadQueue.front();
+				m_MainThreadQueue.pop_front();
+				m_MainThreadJobNum.fetch_sub(1, std::memory_order_relaxed);
+
+				return pJob;
+			}
+		}
+
+		Job* pJob = pWorker->queue.Pop();
+		if (pJob)
+		{
+			return pJob;
+		}
+
+		pJob = PopExternalJob();
+		if (pJob)
+		{
+			return pJob;
+		}
+
+		//λÿʼγȡ߳ͬʱȡͬһ
+		uint32_t state = pWorker->randomState;
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		pWorker->randomState = state;
+
+		for (uint32_t i = 0; i < m_WorkerNum; ++i)
+		{
+			uint32_t victimIndex = (state + i) % m_WorkerNum;
+			if (victimIndex == workerIndex)
+			{
+				continue;
+			}
+
+			pJob = m_Workers[victimIndex]->queue.Steal();
+			if (pJob)
+			{
+				return pJob;
+			}
+		}
+
+		return nullptr;
+	}
+
+	Job* JobSystem::PopExternalJob()
+	{
+		if (m_ExternalJobNum.load(std::memory_order_acquire) == 0)
+		{
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(m_ExternalQueueMutex);
+		if (m_ExternalQueue.empty())
+		{
+			return nullptr;
+		}
+
+		Job* pJob = m_ExternalQueue.front();
+		m_ExternalQueue.pop_front();
+		m_ExternalJobNum.fetch_sub(1, std::memory_order_relaxed);
+
+		return pJob;
+	}
+
+	void JobSystem::Execute(Job* pJob)
+	{
+		pJob->pFunction(pJob);
+
+		Finish(pJob);
+	}
+
+	void JobSystem::Finish(Job* pJob)
+	{
+		int32_t unfinishedNum = pJob->unfinishedNum.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		if (unfinishedNum != 0)
+		{
+			return;
+		}
+
+		int32_t continuationNum = pJob->continuationNum.load(std::memory_order_relaxed);
+		for (int32_t i = 0; i < continuationNum; ++i)
+		{
+			Job* pContinuation = pJob->continuations[i];
+			if (pContinuation->dependencyNum.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			{
+				Submit(pContinuation);
+			}
+		}
+
+		if (pJob->pParent)
+		{
+			Finish(pJob->pParent);
+		}
+	}
+
+	void JobSystem::WorkerThreadMain(uint32_t workerIndex)
+	{
+		t_WorkerIndex = workerIndex;
+
+		uint32_t spinCount = 0;
+		while (!m_bQuit.load(std::memory_order_relaxed))
+		{
+			Job* pJob = GetJob(workerIndex);
+			if (pJob)
+			{
+				Execute(pJob);
+				spinCount = 0;
+				continue;
+			}
+
+			if (spinCount < JOB_SPIN_COUNT)
+			{
+				++spinCount;
+				std::this_thread::yield();
+				continue;
+			}
+
+			//ȼ¼ύټһζУ֮ύʱһ仯
+			uint32_t submitCount = m_SubmitCount.load();
+			pJob = GetJob(workerIndex);
+			if (pJob)
+			{
+				Execute(pJob);
+				spinCount = 0;
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_SleepMutex);
+			m_SleepingWorkerNum.fetch_add(1);
+			m_SleepCondition.wait(lock, [this, submitCount]()
+			{
+				return m_SubmitCount.load() != submitCount || m_bQuit.load();
+			});
+			m_SleepingWorkerNum.fetch_sub(1);
+
+			spinCount = 0;
+		}
+
+		t_WorkerIndex = JOB_INVALID_WORKER;
+	}
+
+	void JobSystem::WakeWorkers()
+	{
+		if (m_SleepingWorkerNum.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_SleepMutex);
+			m_SleepCondition.notify_one();
+		}
+	}
+
+}// namespace RenderDog
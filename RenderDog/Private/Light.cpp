@@ -8,6 +8,7 @@
 #include "Matrix.h"
 #include "Transform.h"
 #include "Scene.h"
+#include "RenderThread.h"
 
 namespace RenderDog
 {
@@ -35,14 +36,14 @@ namespace RenderDog
 		virtual		float		GetLuminance() const override { return m_Luminance; }
 
 		virtual		void		SetDirection(float eulerX, float eulerY, float eulerZ) override;
-		virtual		void		SetColor(const Vector3& color) override { m_Color = color; }
-		virtual		void		SetLuminance(float luma) override { m_Luminance = luma; }
+		virtual		void		SetColor(const Vector3& color) override;
+		virtual		void		SetLuminance(float luma) override;
 
 		virtual void			RegisterToScene(IScene* pScene) override;
 
 	private:
 		Vector3					m_Direction;	//ӹԴߵķ
-		Vector3					m_eulerAngle;
+		Vector3					m_eulerAngle;	//ֻϷ̷߳
 		Vector3					m_Color;
 		float					m_Luminance;
 	};
@@ -103,16 +104,40 @@ namespace RenderDog
 		Vector4 dir = Vector4(g_InitLightDir, 0.0f);
 		dir = dir * rotMat;
 
-		m_Direction = Vector3(dir.x, dir.y, dir.z);
+		Vector3 direction = Vector3(dir.x, dir.y, dir.z);
+		g_pRenderThread->EnqueueCommand([this, direction]()
+		{
+			m_Direction = direction;
+		});
 
 		m_eulerAngle.x = eulerX;
 		m_eulerAngle.y = eulerY;
 		m_eulerAngle.z = eulerZ;
 	}
 
+	void DirectionalLight::SetColor(const Vector3& color)
+	{
+		g_pRenderThread->EnqueueCommand([this, color]()
+		{
+			m_Color = color;
+		});
+	}
+
+	void DirectionalLight::SetLuminance(float luma)
+	{
+		g_pRenderThread->EnqueueCommand([this, luma]()
+		{
+			m_Luminance = luma;
+		});
+	}
+
 	void DirectionalLight::RegisterToScene(IScene* pScene)
 	{
-		pScene->RegisterLight(this);
+		//ֻȾ̷߳
+		g_pRenderThread->EnqueueCommand([this, pScene]()
+		{
+			pScene->RegisterLight(this);
+		});
 	}
 
 	ILight* LightManager::CreateLight(const LightDesc& desc)
@@ -6,6 +6,7 @@
 
 #include "Material.h"
 #include "RefCntObject.h"
+#include "ObjectPool.h"
 #include "Shader.h"
 #include "Texture.h"
 #include "Buffer.h"
@@ -71,6 +72,8 @@ namespace RenderDog
 
 	class Material : public IMaterial, public RefCntObject
 	{
+		RD_POOLED_OBJECT(Material)
+
 		friend class MaterialInstance;
 
 	public:
@@ -143,6 +146,8 @@ namespace RenderDog
 
 	class MaterialInstance : public IMaterialInstance, public RefCntObject
 	{
+		RD_POOLED_OBJECT(MaterialInstance)
+
 	public:
 		MaterialInstance() :
 			m_Name(""),
@@ -201,6 +206,9 @@ namespace RenderDog
 		MaterialInsMap					m_MaterialInsMap;
 	};
 
+	ObjectPool<Material>	Material::s_Pool;
+	ObjectPool<MaterialInstance>	MaterialInstance::s_Pool;
+
 	MaterialManager		g_MaterialManager;
 	IMaterialManager*	g_pMaterialManager = &g_MaterialManager;
 
@@ -0,0 +1,661 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: MeshLOD.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "MeshLOD.h"
+
+#include <cmath>
+#include <algorithm>
+#include <queue>
+#include <unordered_map>
+
+namespace RenderDog
+{
+	//߽ߵԼƽȨأԽ߽Խѱƶ
+	static const double SIMPLIFY_BORDER_WEIGHT = 10.0;
+	//۵ηԭ߼нǵСֵʱΪηת
+	static const double SIMPLIFY_MIN_NORMAL_COS = 0.2;
+
+	static const uint32_t SIMPLIFY_INVALID_VERT = 0xffffffff;
+
+	//Գ4x4Q(v) = v^T * Q * v Ϊ㵽һƽƽ
+	struct Quadric
+	{
+		double a2, ab, ac, ad;
+		double b2, bc, bd;
+		double c2, cd;
+		double d2;
+
+		Quadric() :
+			a2(0.0), ab(0.0), ac(0.0), ad(0.0),
+			b2(0.0), bc(0.0), bd(0.0),
+			c2(0.0), cd(0.0),
+			d2(0.0)
+		{}
+
+		//ƽ ax + by + cz + d = 0(a, b, c)Ϊλ
+		void AddPlane(double a, double b, double c, double d, double weight)
+		{
+			a2 += weight * a * a; ab += weight * a * b; ac += weight * a * c; ad += weight * a * d;
+			b2 += weight * b * b; bc += weight * b * c; bd += weight * b * d;
+			c2 += weight * c * c; cd += weight * c * d;
+			d2 += weight * d * d;
+		}
+
+		void Add(const Quadric& rhs)
+		{
+			a2 += rhs.a2; ab += rhs.ab; ac += rhs.ac; ad += rhs.ad;
+			b2 += rhs.b2; bc += rhs.bc; bd += rhs.bd;
+			c2 += rhs.c2; cd += rhs.cd;
+			d2 += rhs.d2;
+		}
+
+		double Evaluate(const Vector3& v) const
+		{
+			double x = v.x;
+			double y = v.y;
+			double z = v.z;
+
+			double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+						 + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+						 + c2 * z * z + 2.0 * cd * z
+						 + d2;
+
+			return error > 0.0 ? error : 0.0;
+		}
+	};
+
+	struct CollapseCandidate
+	{
+		double		cost;
+		float		edgeLengthSq;
+		uint32_t	from;
+		uint32_t	to;
+		uint32_t	version;
+
+		bool operator<(const CollapseCandidate& rhs) const
+		{
+			//priority_queueǴ󶥶ѣСǰ棻ͬʱ۵̱ߣƽ̹᲻۵ͬһ
+			if (cost != rhs.cost)
+			{
+				return cost > rhs.cost;
+			}
+
+			return edgeLengthSq > rhs.edgeLengthSq;
+		}
+	};
+
+	static inline const Vector3& GetPosition(const Vector3* pPositions, uint32_t positionStride, uint32_t index)
+	{
+		return *(const Vector3*)((const uint8_t*)pPositions + (size_t)positionStride * index);
+	}
+
+	static inline uint64_t MakeEdgeKey(uint32_t v0, uint32_t v1)
+	{
+		return v0 < v1 ? ((uint64_t)v0 << 32) | v1 : ((uint64_t)v1 << 32) | v0;
+	}
+
+	class MeshSimplifier
+	{
+	public:
+		MeshSimplifier(const Vector3* pPositions, uint32_t positionStride, uint32_t vertNum, const std::vector<uint32_t>& indices);
+
+		void						Simplify(uint32_t targetTriNum, double maxCost);
+
+		void						GetIndices(std::vector<uint32_t>& outIndices) const;
+		double						GetMaxCost() const { return m_MaxCost; }
+
+	private:
+		void						WeldPositions();
+		void						InitQuadrics();
+
+		//ÿλֻСһ۵仯ʱ¼
+		void						PushBestCollapse(uint32_t from);
+
+		//Ϸʱtrueͬʱ۵Ҫ滻ɵĿ궥㣨ĿλϿжԲͬĶ㣩
+		bool						CheckCollapse(uint32_t from, uint32_t to, uint32_t& outTargetVert);
+		void						ApplyCollapse(uint32_t from, uint32_t to, uint32_t targetVert);
+
+		void						CollectNeighbors(uint32_t vert, std::vector<uint32_t>& outNeighbors);
+
+	private:
+		const Vector3*							m_pPositions;
+		uint32_t								m_PositionStride;
+		uint32_t								m_VertNum;
+
+		std::vector<uint32_t>					m_TriVerts;			//ÿεԭʼ
+		std::vector<bool>						m_TriAlive;
+		uint32_t								m_AliveTriNum;
+
+		std::vector<uint32_t>					m_PosRemap;			//ԭʼ㵽ͬλõĵһ
+		std::vector<uint32_t>					m_PosVertNum;		//ͬһλϵԭʼ1λǽӷ
+		std::vector<std::vector<uint32_t>>		m_PosTris;			//λڵΣܰѾɾ
+
+		std::vector<Quadric>					m_Quadrics;
+		std::vector<bool>						m_PosAlive;
+		std::vector<uint32_t>					m_PosVersions;
+
+		std::priority_queue<CollapseCandidate>	m_Candidates;
+		double									m_MaxCost;
+
+		std::vector<uint32_t>					m_NeighborsFrom;
+		std::vector<uint32_t>					m_NeighborsTo;
+	};
+
+	MeshSimplifier::MeshSimplifier(const Vector3* pPositions, uint32_t positionStride, uint32_t vertNum, const std::vector<uint32_t>& indices) :
+		m_pPositions(pPositions),
+		m_PositionStride(positionStride),
+		m_VertNum(vertNum),
+		m_TriVerts(0),
+		m_TriAlive(0),
+		m_AliveTriNum(0),
+		m_PosRemap(0),
+		m_PosVertNum(0),
+		m_PosTris(0),
+		m_Quadrics(0),
+		m_PosAlive(0),
+		m_PosVersions(0),
+		m_Candidates(),
+		m_MaxCost(0.0),
+		m_NeighborsFrom(0),
+		m_NeighborsTo(0)
+	{
+		m_TriVerts.reserve(indices.size());
+		for (uint32_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			uint32_t i0 = indices[i];
+			uint32_t i1 = indices[i + 1];
+			uint32_t i2 = indices[i + 2];
+			if (i0 >= vertNum || i1 >= vertNum || i2 >= vertNum)
+			{
+				continue;
+			}
+
+			m_TriVerts.push_back(i0);
+			m_TriVerts.push_back(i1);
+			m_TriVerts.push_back(i2);
+		}
+
+		m_AliveTriNum = (uint32_t)m_TriVerts.size() / 3;
+		m_TriAlive.assign(m_AliveTriNum, true);
+
+		WeldPositions();
+		InitQuadrics();
+	}
+
+	void MeshSimplifier::WeldPositions()
+	{
+		std::vector<uint32_t> sortedVerts(m_VertNum);
+		for (uint32_t i = 0; i < m_VertNum; ++i)
+		{
+			sortedVerts[i] = i;
+		}
+
+		std::sort(sortedVerts.begin(), sortedVerts.end(), [this](uint32_t lhs, uint32_t rhs)
+		{
+			const Vector3& posL = GetPosition(m_pPositions, m_PositionStride, lhs);
+			const Vector3& posR = GetPosition(m_pPositions, m_PositionStride, rhs);
+			if (posL.x != posR.x)
+			{
+				return posL.x < posR.x;
+			}
+			if (posL.y != posR.y)
+			{
+				return posL.y < posR.y;
+			}
+			if (posL.z != posR.z)
+			{
+				return posL.z < posR.z;
+			}
+
+			return lhs < rhs;
+		});
+
+		m_PosRemap.resize(m_VertNum);
+		m_PosVertNum.assign(m_VertNum, 0);
+		for (uint32_t i = 0; i < m_VertNum; )
+		{
+			uint32_t first = sortedVerts[i];
+			const Vector3& firstPos = GetPosition(m_pPositions, m_PositionStride, first);
+
+			uint32_t j = i;
+			while (j < m_VertNum && GetPosition(m_pPositions, m_PositionStride, sortedVerts[j]) == firstPos)
+			{
+				m_PosRemap[sortedVerts[j]] = first;
+				++j;
+			}
+
+			m_PosVertNum[first] = j - i;
+			i = j;
+		}
+
+		m_PosTris.resize(m_VertNum);
+		for (uint32_t tri = 0; tri < m_TriAlive.size(); ++tri)
+		{
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				m_PosTris[m_PosRemap[m_TriVerts[tri * 3 + k]]].push_back(tri);
+			}
+		}
+
+		m_PosAlive.assign(m_VertNum, true);
+		m_PosVersions.assign(m_VertNum, 0);
+	}
+
+	void MeshSimplifier::InitQuadrics()
+	{
+		m_Quadrics.assign(m_VertNum, Quadric());
+
+		std::unordered_map<uint64_t, uint32_t> edgeTriCounts;
+		edgeTriCounts.reserve(m_TriVerts.size());
+
+		for (uint32_t tri = 0; tri < m_TriAlive.size(); ++tri)
+		{
+			uint32_t p[3] = { m_PosRemap[m_TriVerts[tri * 3]], m_PosRemap[m_TriVerts[tri * 3 + 1]], m_PosRemap[m_TriVerts[tri * 3 + 2]] };
+
+			const Vector3& pos0 = GetPosition(m_pPositions, m_PositionStride, p[0]);
+			const Vector3& pos1 = GetPosition(m_pPositions, m_PositionStride, p[1]);
+			const Vector3& pos2 = GetPosition(m_pPositions, m_PositionStride, p[2]);
+
+			Vector3 normal = CrossProduct(pos1 - pos0, pos2 - pos0);
+			float length = normal.Length();
+			if (length > 0.0f)
+			{
+				normal = normal / length;
+				double d = -(double)DotProduct(normal, pos0);
+				for (uint32_t k = 0; k < 3; ++k)
+				{
+					m_Quadrics[p[k]].AddPlane(normal.x, normal.y, normal.z, d, 1.0);
+				}
+			}
+
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				++edgeTriCounts[MakeEdgeKey(p[k], p[(k + 1) % 3])];
+			}
+		}
+
+		//ֻһʹõıǱ߽磬һ߽Ҵֱεƽ棬ֹ߽
+		for (uint32_t tri = 0; tri < m_TriAlive.size(); ++tri)
+		{
+			uint32_t p[3] = { m_PosRemap[m_TriVerts[tri * 3]], m_PosRemap[m_TriVerts[tri * 3 + 1]], m_PosRemap[m_TriVerts[tri * 3 + 2]] };
+
+			const Vector3& pos0 = GetPosition(m_pPositions, m_PositionStride, p[0]);
+			const Vector3& pos1 = GetPosition(m_pPositions, m_PositionStride, p[1]);
+			const Vector3& pos2 = GetPosition(m_pPositions, m_PositionStride, p[2]);
+			Vector3 faceNormal = CrossProduct(pos1 - pos0, pos2 - pos0);
+
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				uint32_t v0 = p[k];
+				uint32_t v1 = p[(k + 1) % 3];
+				if (edgeTriCounts[MakeEdgeKey(v0, v1)] != 1)
+				{
+					continue;
+				}
+
+				const Vector3& edgePos0 = GetPosition(m_pPositions, m_PositionStride, v0);
+				const Vector3& edgePos1 = GetPosition(m_pPositions, m_PositionStride, v1);
+				Vector3 edgeNormal = CrossProduct(edgePos1 - edgePos0, faceNormal);
+				float length = edgeNormal.Length();
+				if (length <= 0.0f)
+				{
+					continue;
+				}
+
+				edgeNormal = edgeNormal / length;
+				double d = -(double)DotProduct(edgeNormal, edgePos0);
+				m_Quadrics[v0].AddPlane(edgeNormal.x, edgeNormal.y, edgeNormal.z, d, SIMPLIFY_BORDER_WEIGHT);
+				m_Quadrics[v1].AddPlane(edgeNormal.x, edgeNormal.y, edgeNormal.z, d, SIMPLIFY_BORDER_WEIGHT);
+			}
+		}
+	}
+
+	void MeshSimplifier::PushBestCollapse(uint32_t from)
+	{
+		++m_PosVersions[from];
+
+		//ӷϵĶ㲻ƶ
+		if (m_PosVertNum[from] > 1)
+		{
+			return;
+		}
+
+		CollectNeighbors(from, m_NeighborsFrom);
+
+		const Vector3& fromPos = GetPosition(m_pPositions, m_PositionStride, from);
+
+		CollapseCandidate candidate;
+		candidate.cost = DBL_MAX;
+		candidate.edgeLengthSq = FLT_MAX;
+		candidate.from = from;
+		candidate.to = SIMPLIFY_INVALID_VERT;
+		candidate.version = m_PosVersions[from];
+		for (uint32_t i = 0; i < m_NeighborsFrom.size(); ++i)
+		{
+			uint32_t to = m_NeighborsFrom[i];
+
+			Quadric quadric = m_Quadrics[from];
+			quadric.Add(m_Quadrics[to]);
+
+			const Vector3& toPos = GetPosition(m_pPositions, m_PositionStride, to);
+			Vector3 edge = toPos - fromPos;
+
+			CollapseCandidate collapse;
+			collapse.cost = quadric.Evaluate(toPos);
+			collapse.edgeLengthSq = DotProduct(edge, edge);
+			if (candidate < collapse)
+			{
+				candidate.cost = collapse.cost;
+				candidate.edgeLengthSq = collapse.edgeLengthSq;
+				candidate.to = to;
+			}
+		}
+
+		if (candidate.to != SIMPLIFY_INVALID_VERT)
+		{
+			m_Candidates.push(candidate);
+		}
+	}
+
+	void MeshSimplifier::CollectNeighbors(uint32_t vert, std::vector<uint32_t>& outNeighbors)
+	{
+		outNeighbors.clear();
+
+		const std::vector<uint32_t>& tris = m_PosTris[vert];
+		for (uint32_t i = 0; i < tris.size(); ++i)
+		{
+			uint32_t tri = tris[i];
+			if (!m_TriAlive[tri])
+			{
+				continue;
+			}
+
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				uint32_t pos = m_PosRemap[m_TriVerts[tri * 3 + k]];
+				if (pos != vert)
+				{
+					outNeighbors.push_back(pos);
+				}
+			}
+		}
+
+		std::sort(outNeighbors.begin(), outNeighbors.end());
+		outNeighbors.erase(std::unique(outNeighbors.begin(), outNeighbors.end()), outNeighbors.end());
+	}
+
+	bool MeshSimplifier::CheckCollapse(uint32_t from, uint32_t to, uint32_t& outTargetVert)
+	{
+		const Vector3& toPos = GetPosition(m_pPositions, m_PositionStride, to);
+
+		outTargetVert = SIMPLIFY_INVALID_VERT;
+		uint32_t sharedTriNum = 0;
+
+		const std::vector<uint32_t>& tris = m_PosTris[from];
+		for (uint32_t i = 0; i < tris.size(); ++i)
+		{
+			uint32_t tri = tris[i];
+			if (!m_TriAlive[tri])
+			{
+				continue;
+			}
+
+			uint32_t p[3] = { m_PosRemap[m_TriVerts[tri * 3]], m_PosRemap[m_TriVerts[tri * 3 + 1]], m_PosRemap[m_TriVerts[tri * 3 + 2]] };
+
+			uint32_t toSlot = 3;
+			uint32_t fromSlot = 3;
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				if (p[k] == to)
+				{
+					toSlot = k;
+				}
+				else if (p[k] == from)
+				{
+					fromSlot = k;
+				}
+			}
+
+			if (toSlot < 3)
+			{
+				//۵ᱻɾΣĿλʹõĶ滻Ķ㣬಻һʱ˵Խ˽ӷ
+				uint32_t targetVert = m_TriVerts[tri * 3 + toSlot];
+				if (outTargetVert != SIMPLIFY_INVALID_VERT && outTargetVert != targetVert)
+				{
+					return false;
+				}
+
+				outTargetVert = targetVert;
+				++sharedTriNum;
+				continue;
+			}
+
+			Vector3 pos[3] =
+			{
+				GetPosition(m_pPositions, m_PositionStride, p[0]),
+				GetPosition(m_pPositions, m_PositionStride, p[1]),
+				GetPosition(m_pPositions, m_PositionStride, p[2])
+			};
+
+			Vector3 oldNormal = CrossProduct(pos[1] - pos[0], pos[2] - pos[0]);
+			pos[fromSlot] = toPos;
+			Vector3 newNormal = CrossProduct(pos[1] - pos[0], pos[2] - pos[0]);
+
+			double oldLength = oldNormal.Length();
+			double newLength = newNormal.Length();
+			if (newLength <= 0.0 || (oldLength > 0.0 && DotProduct(oldNormal, newNormal) < SIMPLIFY_MIN_NORMAL_COS * oldLength * newLength))
+			{
+				return false;
+			}
+		}
+
+		if (sharedTriNum == 0)
+		{
+			return false;
+		}
+
+		//㹲ͬھֻ۵εĵ㣬۵εı
+		CollectNeighbors(from, m_NeighborsFrom);
+		CollectNeighbors(to, m_NeighborsTo);
+
+		uint32_t commonNum = 0;
+		uint32_t i = 0;
+		uint32_t j = 0;
+		while (i < m_NeighborsFrom.size() && j < m_NeighborsTo.size())
+		{
+			if (m_NeighborsFrom[i] < m_NeighborsTo[j])
+			{
+				++i;
+			}
+			else if (m_NeighborsFrom[i] > m_NeighborsTo[j])
+			{
+				++j;
+			}
+			else
+			{
+				++commonNum;
+				++i;
+				++j;
+			}
+		}
+
+		return commonNum <= sharedTriNum;
+	}
+
+	void MeshSimplifier::ApplyCollapse(uint32_t from, uint32_t to, uint32_t targetVert)
+	{
+		std::vector<uint32_t>& fromTris = m_PosTris[from];
+		std::vector<uint32_t>& toTris = m_PosTris[to];
+
+		//ɾѾʧЧΣڽӱԽԽ
+		toTris.erase(std::remove_if(toTris.begin(), toTris.end(), [this](uint32_t tri) { return !m_TriAlive[tri]; }), toTris.end());
+
+		for (uint32_t i = 0; i < fromTris.size(); ++i)
+		{
+			uint32_t tri = fromTris[i];
+			if (!m_TriAlive[tri])
+			{
+				continue;
+			}
+
+			uint32_t* pVerts = &m_TriVerts[tri * 3];
+			if (m_PosRemap[pVerts[0]] == to || m_PosRemap[pVerts[1]] == to || m_PosRemap[pVerts[2]] == to)
+			{
+				m_TriAlive[tri] = false;
+				--m_AliveTriNum;
+				continue;
+			}
+
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				if (m_PosRemap[pVerts[k]] == from)
+				{
+					pVerts[k] = targetVert;
+				}
+			}
+
+			toTris.push_back(tri);
+		}
+
+		fromTris.clear();
+		fromTris.shrink_to_fit();
+
+		m_Quadrics[to].Add(m_Quadrics[from]);
+		m_PosAlive[from] = false;
+		++m_PosVersions[from];
+
+		//ĿλõĶ򶼱ˣھӵ۵Ҫ¼
+		CollectNeighbors(to, m_NeighborsTo);
+		PushBestCollapse(to);
+		for (uint32_t i = 0; i < m_NeighborsTo.size(); ++i)
+		{
+			PushBestCollapse(m_NeighborsTo[i]);
+		}
+	}
+
+	void MeshSimplifier::Simplify(uint32_t targetTriNum, double maxCost)
+	{
+		for (uint32_t pos = 0; pos < m_VertNum; ++pos)
+		{
+			if (m_PosRemap[pos] != pos || m_PosTris[pos].empty())
+			{
+				continue;
+			}
+
+			PushBestCollapse(pos);
+		}
+
+		while (m_AliveTriNum > targetTriNum && !m_Candidates.empty())
+		{
+			CollapseCandidate candidate = m_Candidates.top();
+			m_Candidates.pop();
+
+			if (candidate.cost > maxCost)
+			{
+				break;
+			}
+
+			uint32_t from = candidate.from;
+			uint32_t to = candidate.to;
+			if (!m_PosAlive[from] || !m_PosAlive[to] || candidate.version != m_PosVersions[from])
+			{
+				continue;
+			}
+
+			uint32_t targetVert = 0;
+			if (!CheckCollapse(from, to, targetVert))
+			{
+				continue;
+			}
+
+			ApplyCollapse(from, to, targetVert);
+
+			m_MaxCost = (std::max)(m_MaxCost, candidate.cost);
+		}
+	}
+
+	void MeshSimplifier::GetIndices(std::vector<uint32_t>& outIndices) const
+	{
+		outIndices.clear();
+		outIndices.reserve(m_AliveTriNum * 3);
+		for (uint32_t tri = 0; tri < m_TriAlive.size(); ++tri)
+		{
+			if (m_TriAlive[tri])
+			{
+				outIndices.push_back(m_TriVerts[tri * 3]);
+				outIndices.push_back(m_TriVerts[tri * 3 + 1]);
+				outIndices.push_back(m_TriVerts[tri * 3 + 2]);
+			}
+		}
+	}
+
+	void SimplifyMesh(const Vector3* pPositions, uint32_t positionStride, uint32_t vertNum,
+					  const std::vector<uint32_t>& indices, uint32_t targetIndexNum, float maxError,
+					  std::vector<uint32_t>& outIndices, float& outError)
+	{
+		outIndices.clear();
+		outError = 0.0f;
+		if (!pPositions || vertNum == 0 || indices.size() < 3)
+		{
+			return;
+		}
+
+		double maxCost = maxError < FLT_MAX ? (double)maxError * maxError : DBL_MAX;
+
+		MeshSimplifier simplifier(pPositions, positionStride, vertNum, indices);
+		simplifier.Simplify(targetIndexNum / 3, maxCost);
+		simplifier.GetIndices(outIndices);
+
+		outError = (float)std::sqrt(simplifier.GetMaxCost());
+	}
+
+	void CompactMeshIndices(const std::vector<uint32_t>& indices, std::vector<uint32_t>& outIndices, std::vector<uint32_t>& outVertexRemap)
+	{
+		outIndices.resize(indices.size());
+		outVertexRemap.clear();
+
+		std::unordered_map<uint32_t, uint32_t> newIndices;
+		newIndices.reserve(indices.size());
+		for (uint32_t i = 0; i < indices.size(); ++i)
+		{
+			auto result = newIndices.insert({ indices[i], (uint32_t)outVertexRemap.size() });
+			if (result.second)
+			{
+				outVertexRemap.push_back(indices[i]);
+			}
+
+			outIndices[i] = result.first->second;
+		}
+	}
+
+	float CalcMeshRadius(const Vector3* pPositions, uint32_t positionStride, uint32_t vertNum)
+	{
+		if (!pPositions || vertNum == 0)
+		{
+			return 0.0f;
+		}
+
+		Vector3 minPoint(FLT_MAX, FLT_MAX, FLT_MAX);
+		Vector3 maxPoint(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		for (uint32_t i = 0; i < vertNum; ++i)
+		{
+			const Vector3& pos = GetPosition(pPositions, positionStride, i);
+			minPoint = Vector3((std::min)(minPoint.x, pos.x), (std::min)(minPoint.y, pos.y), (std::min)(minPoint.z, pos.z));
+			maxPoint = Vector3((std::max)(maxPoint.x, pos.x), (std::max)(maxPoint.y, pos.y), (std::max)(maxPoint.z, pos.z));
+		}
+
+		Vector3 center = (minPoint + maxPoint) * 0.5f;
+		float radiusSq = 0.0f;
+		for (uint32_t i = 0; i < vertNum; ++i)
+		{
+			Vector3 offset = GetPosition(pPositions, positionStride, i) - center;
+			radiusSq = (std::max)(radiusSq, DotProduct(offset, offset));
+		}
+
+		return std::sqrt(radiusSq);
+	}
+
+}// namespace RenderDog
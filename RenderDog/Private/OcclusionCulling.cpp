@@ -0,0 +1,268 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: OcclusionCulling.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "OcclusionCulling.h"
+#include "BatchTransform.h"
+#include "SIMD.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace RenderDog
+{
+	//wСֵĶΪڽƽ֮
+	static const float OCCLUSION_MIN_CLIP_W = 1e-4f;
+
+	OcclusionBuffer::OcclusionBuffer() :
+		m_Width(0),
+		m_Height(0),
+		m_Depths(0),
+		m_WorldToClipMatrix(),
+		m_ClipPositions(0)
+	{
+		m_WorldToClipMatrix.Identity();
+	}
+
+	void OcclusionBuffer::Init(uint32_t width, uint32_t height)
+	{
+		m_Width = (width + 3) & ~3u;
+		m_Height = height;
+		m_Depths.resize(m_Width * m_Height);
+
+		Clear();
+	}
+
+	void OcclusionBuffer::Clear()
+	{
+		std::fill(m_Depths.begin(), m_Depths.end(), 1.0f);
+	}
+
+	void OcclusionBuffer::RenderOccluder(const OccluderData& occluder)
+	{
+		if (m_Depths.empty() || !occluder.pPositions || !occluder.pIndices || occluder.vertNum == 0)
+		{
+			return;
+		}
+
+		Matrix4x4 localToClip = occluder.localToWorldMatrix * m_WorldToClipMatrix;
+
+		m_ClipPositions.resize(occluder.vertNum);
+		TransformPointsToVector4(&m_ClipPositions[0], sizeof(Vector4), occluder.pPositions, occluder.positionStride, occluder.vertNum, localToClip);
+
+		for (uint32_t i = 0; i + 2 < occluder.indexNum; i += 3)
+		{
+			const Vector4& clipPos0 = m_ClipPositions[occluder.pIndices[i]];
+			const Vector4& clipPos1 = m_ClipPositions[occluder.pIndices[i + 1]];
+			const Vector4& clipPos2 = m_ClipPositions[occluder.pIndices[i + 2]];
+
+			if (clipPos0.w < OCCLUSION_MIN_CLIP_W || clipPos1.w < OCCLUSION_MIN_CLIP_W || clipPos2.w < OCCLUSION_MIN_CLIP_W)
+			{
+				continue;
+			}
+
+			RasterizeTriangle(clipPos0, clipPos1, clipPos2);
+		}
+	}
+
+	void OcclusionBuffer::RasterizeTriangle(const Vector4& clipPos0, const Vector4& clipPos1, const Vector4& clipPos2)
+	{
+		float width = (float)m_Width;
+		float height = (float)m_Height;
+
+		//Ļռy£դӿڱ任һ
+		float x[3] = { (clipPos0.x / clipPos0.w * 0.5f + 0.5f) * width, (clipPos1.x / clipPos1.w * 0.5f + 0.5f) * width, (clipPos2.x / clipPos2.w * 0.5f + 0.5f) * width };
+		float y[3] = { (0.5f - clipPos0.y / clipPos0.w * 0.5f) * height, (0.5f - clipPos1.y / clipPos1.w * 0.5f) * height, (0.5f - clipPos2.y / clipPos2.w * 0.5f) * height };
+
+		float maxDepth = (std::max)((std::max)(clipPos0.z / clipPos0.w, clipPos1.z / clipPos1.w), clipPos2.z / clipPos2.w);
+		if (maxDepth >= 1.0f)
+		{
+			return;
+		}
+
+		int minX = (std::max)((int)std::floor((std::min)((std::min)(x[0], x[1]), x[2])), 0);
+		int maxX = (std::min)((int)std::ceil((std::max)((std::max)(x[0], x[1]), x[2])), (int)m_Width - 1);
+		int minY = (std::max)((int)std::floor((std::min)((std::min)(y[0], y[1]), y[2])), 0);
+		int maxY = (std::min)((int)std::ceil((std::max)((std::max)(y[0], y[1]), y[2])), (int)m_Height - 1);
+		if (minX > maxX || minY > maxY)
+		{
+			return;
+		}
+		minX &= ~3;
+
+		//ߺE(p) = A * px + B * py + CڲߵֵС0
+		float edgeA[3];
+		float edgeB[3];
+		float edgeC[3];
+		for (int i = 0; i < 3; ++i)
+		{
+			int j = (i + 1) % 3;
+			edgeA[i] = -(y[j] - y[i]);
+			edgeB[i] = x[j] - x[i];
+			edgeC[i] = (y[j] - y[i]) * x[i] - (x[j] - x[i]) * y[i];
+		}
+
+		float area2 = edgeA[0] * x[2] + edgeB[0] * y[2] + edgeC[0];
+		if (std::abs(area2) < 1e-6f)
+		{
+			return;
+		}
+
+		if (area2 < 0.0f)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				edgeA[i] = -edgeA[i];
+				edgeB[i] = -edgeB[i];
+				edgeC[i] = -edgeC[i];
+			}
+		}
+
+		//Ĳ֮ǰÿأֻضʱдȣ
+		//ֻĵڵᵲסͬһֿɼͼԪ
+		for (int i = 0; i < 3; ++i)
+		{
+			edgeC[i] -= (std::abs(edgeA[i]) + std::abs(edgeB[i])) * 0.5f;
+		}
+
+#if RD_SIMD_SSE
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 pixelOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+		const __m128 triDepth = _mm_set1_ps(maxDepth);
+
+		const __m128 edgeA0 = _mm_set1_ps(edgeA[0]);
+		const __m128 edgeA1 = _mm_set1_ps(edgeA[1]);
+		const __m128 edgeA2 = _mm_set1_ps(edgeA[2]);
+
+		for (int row = minY; row <= maxY; ++row)
+		{
+			float pixelY = row + 0.5f;
+			__m128 rowE0 = _mm_set1_ps(edgeB[0] * pixelY + edgeC[0]);
+			__m128 rowE1 = _mm_set1_ps(edgeB[1] * pixelY + edgeC[1]);
+			__m128 rowE2 = _mm_set1_ps(edgeB[2] * pixelY + edgeC[2]);
+
+			float* pRowDepths = &m_Depths[row * m_Width];
+			for (int col = minX; col <= maxX; col += 4)
+			{
+				__m128 pixelX = _mm_add_ps(_mm_set1_ps((float)col), pixelOffsets);
+
+				__m128 e0 = _mm_add_ps(_mm_mul_ps(edgeA0, pixelX), rowE0);
+				__m128 e1 = _mm_add_ps(_mm_mul_ps(edgeA1, pixelX), rowE1);
+				__m128 e2 = _mm_add_ps(_mm_mul_ps(edgeA2, pixelX), rowE2);
+
+				__m128 coverMask = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+				if (_mm_movemask_ps(coverMask) == 0)
+				{
+					continue;
+				}
+
+				__m128 depth = _mm_loadu_ps(pRowDepths + col);
+				__m128 newDepth = _mm_min_ps(depth, triDepth);
+				_mm_storeu_ps(pRowDepths + col, _mm_or_ps(_mm_and_ps(coverMask, newDepth), _mm_andnot_ps(coverMask, depth)));
+			}
+		}
+#else
+		for (int row = minY; row <= maxY; ++row)
+		{
+			float pixelY = row + 0.5f;
+
+			float* pRowDepths = &m_Depths[row * m_Width];
+			for (int col = minX; col <= maxX; ++col)
+			{
+				float pixelX = col + 0.5f;
+
+				if (edgeA[0] * pixelX + edgeB[0] * pixelY + edgeC[0] >= 0.0f &&
+					edgeA[1] * pixelX + edgeB[1] * pixelY + edgeC[1] >= 0.0f &&
+					edgeA[2] * pixelX + edgeB[2] * pixelY + edgeC[2] >= 0.0f)
+				{
+					pRowDepths[col] = (std::min)(pRowDepths[col], maxDepth);
+				}
+			}
+		}
+#endif
+	}
+
+	bool OcclusionBuffer::IsAABBVisible(const AABB& aabb) const
+	{
+		if (m_Depths.empty())
+		{
+			return true;
+		}
+
+		float minX = FLT_MAX;
+		float maxX = -FLT_MAX;
+		float minY = FLT_MAX;
+		float maxY = -FLT_MAX;
+		float minDepth = FLT_MAX;
+		for (int i = 0; i < 8; ++i)
+		{
+			Vector4 corner((i & 1) ? aabb.maxPoint.x : aabb.minPoint.x,
+						   (i & 2) ? aabb.maxPoint.y : aabb.minPoint.y,
+						   (i & 4) ? aabb.maxPoint.z : aabb.minPoint.z,
+						   1.0f);
+			Vector4 clipPos = corner * m_WorldToClipMatrix;
+			if (clipPos.w < OCCLUSION_MIN_CLIP_W)
+			{
+				return true;
+			}
+
+			float invW = 1.0f / clipPos.w;
+			float screenX = (clipPos.x * invW * 0.5f + 0.5f) * m_Width;
+			float screenY = (0.5f - clipPos.y * invW * 0.5f) * m_Height;
+			float depth = clipPos.z * invW;
+
+			minX = (std::min)(minX, screenX);
+			maxX = (std::max)(maxX, screenX);
+			minY = (std::min)(minY, screenY);
+			maxY = (std::max)(maxY, screenY);
+			minDepth = (std::min)(minDepth, depth);
+		}
+
+		if (minDepth <= 0.0f)
+		{
+			return true;
+		}
+
+		//ĻȡԵֻý
+		int startX = (std::max)((int)std::floor(minX), 0) & ~3;
+		int endX = (std::min)((int)std::ceil(maxX), (int)m_Width - 1);
+		int startY = (std::max)((int)std::floor(minY), 0);
+		int endY = (std::min)((int)std::ceil(maxY), (int)m_Height - 1);
+		if (startX > endX || startY > endY)
+		{
+			return false;
+		}
+
+#if RD_SIMD_SSE
+		const __m128 boundsDepth = _mm_set1_ps(minDepth);
+		for (int row = startY; row <= endY; ++row)
+		{
+			const float* pRowDepths = &m_Depths[row * m_Width];
+			for (int col = startX; col <= endX; col += 4)
+			{
+				if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(pRowDepths + col), boundsDepth)) != 0)
+				{
+					return true;
+				}
+			}
+		}
+#else
+		for (int row = startY; row <= endY; ++row)
+		{
+			const float* pRowDepths = &m_Depths[row * m_Width];
+			for (int col = startX; col <= endX; ++col)
+			{
+				if (pRowDepths[col] >= minDepth)
+				{
+					return true;
+				}
+			}
+		}
+#endif
+
+		return false;
+	}
+
+}// namespace RenderDog
@@ -0,0 +1,160 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: Profiler.cpp
+//Written by Xiang Weikang
+//Desc: ʱǣΪChrome Traceʽ(chrome://tracing)
+////////////////////////////////////////
+
+#include "Profiler.h"
+
+#include <Windows.h>
+#include <fstream>
+
+namespace RenderDog
+{
+	Profiler	g_Profiler;
+	Profiler*	g_pProfiler = &g_Profiler;
+
+	//̵߳һμ¼¼ʱProfiler뻺
+	thread_local ProfileThreadBuffer*	t_pThreadBuffer = nullptr;
+
+	Profiler::Profiler() :
+		m_bCapturing(false),
+		m_CaptureIndex(0),
+		m_MicroSecondsPerCount(0.0),
+		m_ThreadBuffers(0)
+	{
+		int64_t countsPerSecond = 0;
+		QueryPerformanceFrequency((LARGE_INTEGER*)&countsPerSecond);
+
+		m_MicroSecondsPerCount = 1000000.0 / (double)countsPerSecond;
+	}
+
+	Profiler::~Profiler()
+	{
+		std::lock_guard<std::mutex> lock(m_BufferMutex);
+
+		for (size_t i = 0; i < m_ThreadBuffers.size(); ++i)
+		{
+			delete m_ThreadBuffers[i];
+		}
+		m_ThreadBuffers.clear();
+	}
+
+	void Profiler::BeginCapture()
+	{
+		m_CaptureIndex.fetch_add(1, std::memory_order_relaxed);
+
+		m_bCapturing.store(true, std::memory_order_release);
+	}
+
+	void Profiler::EndCapture()
+	{
+		m_bCapturing.store(false, std::memory_order_release);
+	}
+
+	bool Profiler::ExportChromeTrace(const std::string& fileName)
+	{
+		if (IsCapturing())
+		{
+			return false;
+		}
+
+		std::ofstream fout(fileName);
+		if (!fout.is_open())
+		{
+			return false;
+		}
+
+		uint32_t captureIndex = m_CaptureIndex.load(std::memory_order_relaxed);
+
+		fout << "{\"traceEvents\":[\n";
+
+		bool bFirstEvent = true;
+
+		std::lock_guard<std::mutex> lock(m_BufferMutex);
+		for (size_t i = 0; i < m_ThreadBuffers.size(); ++i)
+		{
+			const ProfileThreadBuffer* pBuffer = m_ThreadBuffers[i];
+			if (pBuffer->captureIndex.load(std::memory_order_acquire) != captureIndex)
+			{
+				continue;
+			}
+
+			uint32_t eventNum = pBuffer->eventNum.load(std::memory_order_acquire);
+
+			for (uint32_t j = 0; j < eventNum; ++j)
+			{
+				const ProfileEvent& event = pBuffer->events[j];
+
+				double startTime = event.startCounts * m_MicroSecondsPerCount;
+				double duration = (event.endCounts - event.startCounts) * m_MicroSecondsPerCount;
+
+				if (!bFirstEvent)
+				{
+					fout << ",\n";
+				}
+				bFirstEvent = false;
+
+				fout << "{\"name\":\"" << event.name << "\",\"cat\":\"RenderDog\",\"ph\":\"X\""
+					 << ",\"ts\":" << std::fixed << startTime
+					 << ",\"dur\":" << duration
+					 << ",\"pid\":0,\"tid\":" << pBuffer->threadId << "}";
+			}
+		}
+
+		fout << "\n]}\n";
+
+		return true;
+	}
+
+	void Profiler::RecordEvent(const char* name, int64_t startCounts, int64_t endCounts)
+	{
+		ProfileThreadBuffer* pBuffer = GetThreadBuffer();
+
+		//ʱ¼
+		uint32_t eventIndex = pBuffer->eventNum.load(std::memory_order_relaxed);
+		if (eventIndex >= ProfileThreadBuffer::MAX_EVENT_NUM)
+		{
+			return;
+		}
+
+		ProfileEvent& event = pBuffer->events[eventIndex];
+		event.name = name;
+		event.startCounts = startCounts;
+		event.endCounts = endCounts;
+
+		pBuffer->eventNum.store(eventIndex + 1, std::memory_order_release);
+	}
+
+	int64_t Profiler::GetCurrCounts()
+	{
+		int64_t currCounts = 0;
+		QueryPerformanceCounter((LARGE_INTEGER*)&currCounts);
+
+		return currCounts;
+	}
+
+	ProfileThreadBuffer* Profiler::GetThreadBuffer()
+	{
+		if (!t_pThreadBuffer)
+		{
+			t_pThreadBuffer = new ProfileThreadBuffer();
+			t_pThreadBuffer->threadId = (uint32_t)GetCurrentThreadId();
+
+			std::lock_guard<std::mutex> lock(m_BufferMutex);
+			m_ThreadBuffers.push_back(t_pThreadBuffer);
+		}
+
+		//µһβɼʼ߳Լջ壬߳д
+		uint32_t captureIndex = m_CaptureIndex.load(std::memory_order_relaxed);
+		if (t_pThreadBuffer->captureIndex.load(std::memory_order_relaxed) != captureIndex)
+		{
+			t_pThreadBuffer->eventNum.store(0, std::memory_order_relaxed);
+			t_pThreadBuffer->captureIndex.store(captureIndex, std::memory_order_release);
+		}
+
+		return t_pThreadBuffer;
+	}
+
+}// namespace RenderDog
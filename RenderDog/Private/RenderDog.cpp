@@ -12,11 +12,16 @@ namespace RenderDog
 	class RenderDog : public IRenderDog
 	{
 	public:
-		RenderDog() = default;
+		RenderDog() :
+			m_bHeadless(false)
+		{}
 		virtual ~RenderDog() = default;
 
 		virtual bool Init(const InitDesc& desc) override;
 		virtual void Release() override;
+
+	private:
+		bool	m_bHeadless;
 	};
 
 	//---------------------------------------------------------------------------
@@ -24,21 +29,35 @@ namespace RenderDog
 	//---------------------------------------------------------------------------
 	bool RenderDog::Init(const InitDesc& desc)
 	{
-		if (!g_pIFramework->Init())
+		FrameworkInitDesc frameworkDesc;
+		frameworkDesc.pMainCamera = desc.pMainCamera;
+		frameworkDesc.bRenderThread = desc.bRenderThread;
+		if (!g_pIFramework->Init(frameworkDesc))
 		{
 			return false;
 		}
 
-		if (!g_pIWindow->Init(desc.wndDesc))
-		{
-			return false;
-		}
+		m_bHeadless = desc.bHeadless;
 
 		RendererInitDesc rendererDesc;
-		rendererDesc.hWnd = g_pIWindow->GetHandle();
-		rendererDesc.backBufferWidth = g_pIWindow->GetWidth();
-		rendererDesc.backBufferHeight = g_pIWindow->GetHeight();
-		rendererDesc.pMainCamera = desc.pMainCamera;
+		if (m_bHeadless)
+		{
+			rendererDesc.hWnd = nullptr;
+			rendererDesc.backBufferWidth = desc.wndDesc.width;
+			rendererDesc.backBufferHeight = desc.wndDesc.height;
+		}
+		else
+		{
+			if (!g_pIWindow->Init(desc.wndDesc))
+			{
+				return false;
+			}
+
+			rendererDesc.hWnd = g_pIWindow->GetHandle();
+			rendererDesc.backBufferWidth = g_pIWindow->GetWidth();
+			rendererDesc.backBufferHeight = g_pIWindow->GetHeight();
+		}
+		rendererDesc.pMainCamera = g_pIFramework->GetRenderCamera();
 		if (!g_pIRenderer->Init(rendererDesc))
 		{
 			return false;
@@ -51,7 +70,10 @@ namespace RenderDog
 	{
 		g_pIFramework->Release();
 
-		g_pIWindow->Release();
+		if (!m_bHeadless)
+		{
+			g_pIWindow->Release();
+		}
 
 		g_pIRenderer->Release();
 	}
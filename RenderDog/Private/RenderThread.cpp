@@ -0,0 +1,308 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: RenderThread.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "RenderThread.h"
+#include "Profiler.h"
+
+#include <cstdlib>
+
+namespace RenderDog
+{
+	RenderThread	g_RenderThread;
+	RenderThread*	g_pRenderThread = &g_RenderThread;
+
+	static uint32_t AlignCommandSize(uint32_t size)
+	{
+		return (size + RENDER_COMMAND_ALIGNMENT - 1) & ~(RENDER_COMMAND_ALIGNMENT - 1);
+	}
+
+	static const uint32_t RENDER_COMMAND_HEADER_SIZE = (sizeof(RenderCommandHeader) + RENDER_COMMAND_ALIGNMENT - 1) & ~(RENDER_COMMAND_ALIGNMENT - 1);
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//------------------           RenderCommandQueue            --------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	RenderCommandQueue::RenderCommandQueue() :
+		m_pBuffer(nullptr),
+		m_Size(0),
+		m_AllocatedPos(0),
+		m_WritePos(0),
+		m_ReadPos(0)
+	{}
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		Release();
+	}
+
+	bool RenderCommandQueue::Init(uint32_t size)
+	{
+		Release();
+
+		m_Size = AlignCommandSize(size);
+		m_pBuffer = static_cast<unsigned char*>(std::malloc(m_Size));
+		if (!m_pBuffer)
+		{
+			m_Size = 0;
+			return false;
+		}
+
+		m_AllocatedPos = 0;
+		m_WritePos.store(0, std::memory_order_relaxed);
+		m_ReadPos.store(0, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	void RenderCommandQueue::Release()
+	{
+		if (m_pBuffer)
+		{
+			std::free(m_pBuffer);
+			m_pBuffer = nullptr;
+		}
+		m_Size = 0;
+	}
+
+	void* RenderCommandQueue::Allocate(uint32_t dataSize, RenderCommandFunction pFunction)
+	{
+		uint32_t commandSize = RENDER_COMMAND_HEADER_SIZE + AlignCommandSize(dataSize);
+
+		//ʣĿռŲʱĿͷ
+		uint32_t offset = static_cast<uint32_t>(m_AllocatedPos % m_Size);
+		uint32_t paddingSize = m_Size - offset < commandSize ? m_Size - offset : 0;
+
+		uint64_t readPos = m_ReadPos.load(std::memory_order_acquire);
+		if (m_AllocatedPos + paddingSize + commandSize - readPos > m_Size)
+		{
+			return nullptr;
+		}
+
+		if (paddingSize > 0)
+		{
+			RenderCommandHeader* pPadding = reinterpret_cast<RenderCommandHeader*>(m_pBuffer + offset);
+			pPadding->pFunction = nullptr;
+			pPadding->size = paddingSize;
+
+			m_AllocatedPos += paddingSize;
+			offset = 0;
+		}
+
+		RenderCommandHeader* pHeader = reinterpret_cast<RenderCommandHeader*>(m_pBuffer + offset);
+		pHeader->pFunction = pFunction;
+		pHeader->size = commandSize;
+
+		m_AllocatedPos += commandSize;
+
+		return m_pBuffer + offset + RENDER_COMMAND_HEADER_SIZE;
+	}
+
+	void RenderCommandQueue::Commit()
+	{
+		m_WritePos.store(m_AllocatedPos, std::memory_order_release);
+	}
+
+	uint32_t RenderCommandQueue::Execute()
+	{
+		uint32_t commandNum = 0;
+
+		uint64_t readPos = m_ReadPos.load(std::memory_order_relaxed);
+		uint64_t writePos = m_WritePos.load(std::memory_order_acquire);
+		while (readPos < writePos)
+		{
+			RenderCommandHeader* pHeader = reinterpret_cast<RenderCommandHeader*>(m_pBuffer + readPos % m_Size);
+			uint32_t commandSize = pHeader->size;
+			if (pHeader->pFunction)
+			{
+				pHeader->pFunction(reinterpret_cast<unsigned char*>(pHeader) + RENDER_COMMAND_HEADER_SIZE);
+				++commandNum;
+			}
+
+			//ÿִһͷռõĿռ䣬Ϸ̲߳Ҫִ
+			readPos += commandSize;
+			m_ReadPos.store(readPos, std::memory_order_release);
+
+			if (readPos == writePos)
+			{
+				writePos = m_WritePos.load(std::memory_order_acquire);
+			}
+		}
+
+		return commandNum;
+	}
+
+	bool RenderCommandQueue::IsEmpty() const
+	{
+		return m_ReadPos.load(std::memory_order_acquire) == m_WritePos.load(std::memory_order_acquire);
+	}
+
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//------------------              RenderThread               --------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	RenderThread::RenderThread() :
+		m_Thread(),
+		m_bRunning(false),
+		m_CommandQueue(),
+		m_Mutex(),
+		m_WakeCondition(),
+		m_FenceCondition(),
+		m_WakeCount(0),
+		m_CompletedFence(0),
+		m_bQuit(false),
+		m_IssuedFence(0),
+		m_LastFrameFence(0)
+	{}
+
+	RenderThread::~RenderThread()
+	{
+		Stop();
+	}
+
+	bool RenderThread::Start()
+	{
+		if (m_bRunning)
+		{
+			return true;
+		}
+
+		if (!m_CommandQueue.Init(RENDER_COMMAND_QUEUE_SIZE))
+		{
+			return false;
+		}
+
+		m_WakeCount = 0;
+		m_CompletedFence = 0;
+		m_bQuit = false;
+		m_IssuedFence = 0;
+		m_LastFrameFence = 0;
+
+		m_Thread = std::thread(&RenderThread::RenderThreadMain, this);
+		m_bRunning = true;
+
+		return true;
+	}
+
+	void RenderThread::Stop()
+	{
+		if (!m_bRunning)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_bQuit = true;
+			++m_WakeCount;
+		}
+		m_WakeCondition.notify_one();
+
+		m_Thread.join();
+		m_bRunning = false;
+
+		m_CommandQueue.Release();
+	}
+
+	bool RenderThread::IsInRenderThread() const
+	{
+		return m_bRunning && std::this_thread::get_id() == m_Thread.get_id();
+	}
+
+	void RenderThread::EndFrame()
+	{
+		if (!m_bRunning)
+		{
+			return;
+		}
+
+		//ȴһִ֡꣬һ֡Ⱦ̺߳һ֡Ϸ߼ִ
+		uint64_t frameFence = IssueFence();
+		WaitFence(m_LastFrameFence);
+		m_LastFrameFence = frameFence;
+	}
+
+	void RenderThread::Flush()
+	{
+		if (!m_bRunning || IsInRenderThread())
+		{
+			return;
+		}
+
+		WaitFence(IssueFence());
+	}
+
+	//---------------------------------------------------------------------------
+	//   Private Function Definition
+	//---------------------------------------------------------------------------
+
+	void RenderThread::RenderThreadMain()
+	{
+		while (true)
+		{
+			//ȼ¼ѴִִڼĻѲᱻ
+			uint64_t wakeCount = 0;
+			bool bQuit = false;
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				wakeCount = m_WakeCount;
+				bQuit = m_bQuit;
+			}
+
+			uint32_t commandNum = 0;
+			{
+				RD_PROFILE_SCOPE("RenderThread::Execute");
+				commandNum = m_CommandQueue.Execute();
+			}
+			if (commandNum > 0)
+			{
+				continue;
+			}
+
+			if (bQuit)
+			{
+				break;
+			}
+
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_WakeCondition.wait(lock, [this, wakeCount]() { return m_WakeCount != wakeCount; });
+		}
+	}
+
+	void RenderThread::WakeRenderThread()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			++m_WakeCount;
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	uint64_t RenderThread::IssueFence()
+	{
+		uint64_t fence = ++m_IssuedFence;
+		EnqueueCommand([this, fence]()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_CompletedFence = fence;
+			}
+			m_FenceCondition.notify_all();
+		});
+		WakeRenderThread();
+
+		return fence;
+	}
+
+	void RenderThread::WaitFence(uint64_t fence)
+	{
+		RD_PROFILE_SCOPE("RenderThread::WaitFence");
+
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_FenceCondition.wait(lock, [this, fence]() { return m_CompletedFence >= fence; });
+	}
+
+}// namespace RenderDog
@@ -0,0 +1,161 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: ResourceRegistry.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "ResourceRegistry.h"
+
+namespace RenderDog
+{
+	static const uint32_t RESOURCE_REGISTRY_INVALID_INDEX = 0xffffffff;
+
+	//Դ͸Դ뵥Ԫеľ̬󣬾̬˳ȷ
+	//עⲻͷţ֤һԴעʱȻЧ
+	ResourceRegistry*	g_pResourceRegistry = new ResourceRegistry();
+
+	ResourceRegistry::ResourceRegistry() :
+		m_ChunkNum(0),
+		m_FreeHead(RESOURCE_REGISTRY_INVALID_INDEX),
+		m_LiveNum(0),
+		m_Mutex()
+	{
+		for (uint32_t i = 0; i < RESOURCE_REGISTRY_MAX_CHUNK_NUM; ++i)
+		{
+			m_Chunks[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	ResourceRegistry::~ResourceRegistry()
+	{
+		for (uint32_t i = 0; i < m_ChunkNum; ++i)
+		{
+			delete[] m_Chunks[i].load(std::memory_order_relaxed);
+			m_Chunks[i].store(nullptr, std::memory_order_relaxed);
+		}
+		m_ChunkNum = 0;
+	}
+
+	ResourceHandle ResourceRegistry::Register(RESOURCE_TYPE type, void* pResource)
+	{
+		if (!pResource)
+		{
+			return ResourceHandle();
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_FreeHead == RESOURCE_REGISTRY_INVALID_INDEX && !AllocateChunk())
+		{
+			return ResourceHandle();
+		}
+
+		uint32_t index = m_FreeHead;
+		Slot& slot = m_Chunks[index / RESOURCE_REGISTRY_CHUNK_SIZE].load(std::memory_order_relaxed)[index % RESOURCE_REGISTRY_CHUNK_SIZE];
+		m_FreeHead = slot.nextFree;
+
+		//дԴٷ߳̿µĴʱһܿԴָ
+		slot.pResource.store(pResource, std::memory_order_relaxed);
+		slot.type.store(static_cast<uint32_t>(type), std::memory_order_relaxed);
+		uint32_t generation = slot.generation.load(std::memory_order_relaxed) + 1;
+		slot.generation.store(generation, std::memory_order_release);
+
+		m_LiveNum.fetch_add(1, std::memory_order_relaxed);
+
+		return ResourceHandle(index | ((generation & RESOURCE_HANDLE_GENERATION_MASK) << RESOURCE_HANDLE_INDEX_BITS));
+	}
+
+	void ResourceRegistry::Unregister(ResourceHandle handle)
+	{
+		if (!handle.IsValid())
+		{
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		uint32_t index = handle.GetIndex();
+		if (index >= m_ChunkNum * RESOURCE_REGISTRY_CHUNK_SIZE)
+		{
+			return;
+		}
+
+		Slot& slot = m_Chunks[index / RESOURCE_REGISTRY_CHUNK_SIZE].load(std::memory_order_relaxed)[index % RESOURCE_REGISTRY_CHUNK_SIZE];
+		uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+		if ((generation & 1) == 0 || (generation & RESOURCE_HANDLE_GENERATION_MASK) != handle.GetGeneration())
+		{
+			return;
+		}
+
+		slot.generation.store(generation + 1, std::memory_order_release);
+		slot.pResource.store(nullptr, std::memory_order_relaxed);
+		slot.nextFree = m_FreeHead;
+		m_FreeHead = index;
+
+		m_LiveNum.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void* ResourceRegistry::Resolve(ResourceHandle handle, RESOURCE_TYPE type) const
+	{
+		uint32_t index = handle.GetIndex();
+		if (!handle.IsValid() || index / RESOURCE_REGISTRY_CHUNK_SIZE >= RESOURCE_REGISTRY_MAX_CHUNK_NUM)
+		{
+			return nullptr;
+		}
+
+		const Slot* pChunk = m_Chunks[index / RESOURCE_REGISTRY_CHUNK_SIZE].load(std::memory_order_acquire);
+		if (!pChunk)
+		{
+			return nullptr;
+		}
+
+		const Slot& slot = pChunk[index % RESOURCE_REGISTRY_CHUNK_SIZE];
+		uint32_t generation = slot.generation.load(std::memory_order_acquire);
+		if ((generation & RESOURCE_HANDLE_GENERATION_MASK) != handle.GetGeneration())
+		{
+			return nullptr;
+		}
+
+		void* pResource = slot.pResource.load(std::memory_order_acquire);
+		uint32_t slotType = slot.type.load(std::memory_order_acquire);
+
+		//ȡڼλע߸ʱı䣬ʱԴָ벻
+		if (slot.generation.load(std::memory_order_acquire) != generation || slotType != static_cast<uint32_t>(type))
+		{
+			return nullptr;
+		}
+
+		return pResource;
+	}
+
+	//---------------------------------------------------------------------------
+	//   Private Function Definition
+	//---------------------------------------------------------------------------
+
+	bool ResourceRegistry::AllocateChunk()
+	{
+		if (m_ChunkNum >= RESOURCE_REGISTRY_MAX_CHUNK_NUM)
+		{
+			return false;
+		}
+
+		Slot* pChunk = new Slot[RESOURCE_REGISTRY_CHUNK_SIZE];
+
+		uint32_t firstIndex = m_ChunkNum * RESOURCE_REGISTRY_CHUNK_SIZE;
+		for (uint32_t i = 0; i < RESOURCE_REGISTRY_CHUNK_SIZE; ++i)
+		{
+			Slot& slot = pChunk[i];
+			slot.generation.store(0, std::memory_order_relaxed);
+			slot.type.store(static_cast<uint32_t>(RESOURCE_TYPE::UNKNOWN), std::memory_order_relaxed);
+			slot.pResource.store(nullptr, std::memory_order_relaxed);
+			slot.nextFree = i + 1 < RESOURCE_REGISTRY_CHUNK_SIZE ? firstIndex + i + 1 : m_FreeHead;
+		}
+
+		m_Chunks[m_ChunkNum].store(pChunk, std::memory_order_release);
+		++m_ChunkNum;
+		m_FreeHead = firstIndex;
+
+		return true;
+	}
+
+}// namespace RenderDog
@@ -11,8 +11,13 @@
 #include "Camera.h"
 #include "Sky.h"
 #include "Bounding.h"
+#include "BVH.h"
+#include "TriangleBVH.h"
+#include "JobSystem.h"
+#include "Profiler.h"
 
 #include <vector>
+#include <algorithm>
 
 namespace RenderDog
 {
@@ -20,7 +25,26 @@ namespace RenderDog
 	// ----------------------           Scene         -------------------------------//
 	///////////////////////////////////////////////////////////////////////////////////
 
-	class Scene : public IScene
+	//refit֮ڵ֮ͳʱں̨ؽBVH
+	static const float BVH_REBUILD_DEGRADATION = 1.3f;
+	//߲ѯʱÿٴ
+	static const uint32_t SCENE_RAYCAST_BATCH_SIZE = 64;
+
+	struct SceneRayCandidate
+	{
+		float		distance;		//߽ͼԪAABBľ
+		uint32_t	primitiveId;
+	};
+
+	//߲ѯõʱ飬ڶβѯ֮临
+	struct SceneRayScratch
+	{
+		std::vector<uint32_t>			nodeStack;
+		std::vector<uint32_t>			queryItems;
+		std::vector<SceneRayCandidate>	candidates;
+	};
+
+	class Scene : public IScene, public IPrimitiveBoundsListener
 	{
 	public:
 		Scene();
@@ -29,13 +53,29 @@ namespace RenderDog
 
 		virtual void					Release() override;
 		virtual void					RegisterPrimitive(IPrimitive* pPrimitive) override;
+		virtual void					UnregisterPrimitive(IPrimitive* pPrimitive) override;
 		virtual IPrimitive*				GetPrimitive(uint32_t index) override { return m_Primitives[index]; }
 		virtual uint32_t				GetPrimitivesNum() const override { return (uint32_t)m_Primitives.size(); }
 
+		virtual void					QueryPrimitives(const Frustum& frustum, std::vector<IPrimitive*>& outPrimitives) override;
+		virtual void					QueryPrimitives(const BoundingSphere& sphere, std::vector<IPrimitive*>& outPrimitives) override;
+		virtual void					QueryPrimitives(const AABB& aabb, std::vector<IPrimitive*>& outPrimitives) override;
+		virtual void					QueryPrimitives(const Ray& ray, float maxDistance, std::vector<IPrimitive*>& outPrimitives) override;
+		virtual bool					Raycast(const Ray& ray, float maxDistance, SceneRayHit& outHit) override;
+		virtual bool					RaycastAny(const Ray& ray, float maxDistance) override;
+		virtual void					RaycastBatch(const Ray* pRays, uint32_t count, float maxDistance, SceneRayHit* pHits) override;
+		virtual void					UpdateSpatialIndex() override;
+
+		virtual void					OnPrimitiveBoundsChanged(uint32_t primitiveId) override;
+
 		virtual	void					RegisterLight(ILight* pLight) override;
+		virtual void					UnregisterLight(ILight* pLight) override;
 		virtual ILight*					GetLight(uint32_t index) override { return m_Lights[index]; }
 		virtual uint32_t				GetLightsNum() const override { return (uint32_t)m_Lights.size(); }
 
+		virtual void					AddListener(ISceneListener* pListener) override;
+		virtual void					RemoveListener(ISceneListener* pListener) override;
+
 		virtual void					RegisterSkyBox(SkyBox* pSkyBox) override { m_pSkyBox = pSkyBox; }
 		virtual SkyBox*					GetSkyBox() { return m_pSkyBox; }
 
@@ -44,14 +84,43 @@ namespace RenderDog
 
 		virtual void					Clear() override;
 
+	private:
+		void							RebuildBVH();
+		void							StartBackgroundRebuild();
+		void							WaitForBackgroundRebuild();
+		void							AppendQueryResults(std::vector<IPrimitive*>& outPrimitives);
+		//޸ĳÿ߳ʹøԵscratchʱڶ߳ͬʱ
+		bool							RaycastPrimitives(const Ray& ray, float maxDistance, bool bAnyHit, SceneRayScratch& scratch, SceneRayHit& outHit) const;
+
 	private:
 		std::string						m_Name;
 		std::vector<IPrimitive*>		m_Primitives;
 		std::vector<ILight*>			m_Lights;
 
+		std::vector<ISceneListener*>	m_Listeners;
+
 		SkyBox*							m_pSkyBox;
 
 		BoundingSphere					m_BoundingSphere;
+
+		BVH								m_BVH;
+		bool							m_bBVHDirty;
+		std::vector<AABB>				m_PrimitiveAABBs;
+		std::vector<uint32_t>			m_QueryItems;
+		std::vector<uint32_t>			m_QueryNodeStack;
+		SceneRayScratch					m_RayScratch;
+		//߲ѯʱÿ߳һݣһݸRaycastBatchķǹ߳
+		std::vector<SceneRayScratch>	m_BatchRayScratches;
+
+		std::vector<uint32_t>			m_DirtyPrimitives;
+		std::vector<uint8_t>			m_PrimitiveDirtyFlags;
+
+		//̨ؽʹùʼʱAABBգڼƶͼԪ滻֮refit
+		BVH								m_RebuildingBVH;
+		std::vector<AABB>				m_RebuildAABBs;
+		Job								m_RebuildJob;		//ؽܳ֡ʹûᱻõ
+		bool							m_bRebuilding;
+		std::vector<uint32_t>			m_PrimitivesMovedDuringRebuild;
 	};
 
 
@@ -82,22 +151,59 @@ namespace RenderDog
 		m_Name(""),
 		m_Primitives(0),
 		m_Lights(0),
+		m_Listeners(0),
 		m_pSkyBox(nullptr),
-		m_BoundingSphere()
+		m_BoundingSphere(),
+		m_BVH(),
+		m_bBVHDirty(false),
+		m_PrimitiveAABBs(0),
+		m_QueryItems(0),
+		m_QueryNodeStack(0),
+		m_RayScratch(),
+		m_BatchRayScratches(0),
+		m_DirtyPrimitives(0),
+		m_PrimitiveDirtyFlags(0),
+		m_RebuildingBVH(),
+		m_RebuildAABBs(0),
+		m_RebuildJob(),
+		m_bRebuilding(false),
+		m_PrimitivesMovedDuringRebuild(0)
 	{}
 
 	Scene::Scene(const SceneInitDesc& desc) :
 		m_Name(desc.name),
 		m_Primitives(0),
 		m_Lights(0),
+		m_Listeners(0),
 		m_pSkyBox(nullptr),
-		m_BoundingSphere()
+		m_BoundingSphere(),
+		m_BVH(),
+		m_bBVHDirty(false),
+		m_PrimitiveAABBs(0),
+		m_QueryItems(0),
+		m_QueryNodeStack(0),
+		m_RayScratch(),
+		m_BatchRayScratches(0),
+		m_DirtyPrimitives(0),
+		m_PrimitiveDirtyFlags(0),
+		m_RebuildingBVH(),
+		m_RebuildAABBs(0),
+		m_RebuildJob(),
+		m_bRebuilding(false),
+		m_PrimitivesMovedDuringRebuild(0)
 	{}
 
 	Scene::~Scene()
 	{
-		m_Primitives.clear();
-		m_Lights.clear();
+		//֪ͨͷգѾϿյOnSceneCleared
+		std::vector<ISceneListener*> listeners;
+		listeners.swap(m_Listeners);
+		for (uint32_t i = 0; i < listeners.size(); ++i)
+		{
+			listeners[i]->OnSceneReleased();
+		}
+
+		Clear();
 	}
 
 	void Scene::Release()
@@ -107,18 +213,438 @@ namespace RenderDog
 
 	void Scene::RegisterPrimitive(IPrimitive* pPrimitive)
 	{
+		pPrimitive->SetBoundsListener(this, (uint32_t)m_Primitives.size());
+
 		m_Primitives.push_back(pPrimitive);
+		m_PrimitiveDirtyFlags.push_back(0);
+
+		m_bBVHDirty = true;
+
+		for (uint32_t i = 0; i < m_Listeners.size(); ++i)
+		{
+			m_Listeners[i]->OnPrimitiveRegistered(pPrimitive);
+		}
+	}
+
+	void Scene::UnregisterPrimitive(IPrimitive* pPrimitive)
+	{
+		auto priIter = std::find(m_Primitives.begin(), m_Primitives.end(), pPrimitive);
+		if (priIter == m_Primitives.end())
+		{
+			return;
+		}
+
+		//̨ؽBVHʹþɵıţֱӶ
+		WaitForBackgroundRebuild();
+
+		uint32_t removedId = (uint32_t)(priIter - m_Primitives.begin());
+		uint32_t lastId = (uint32_t)m_Primitives.size() - 1;
+
+		//һͼԪƵɾλãеıҲҪͬ޸
+		m_Primitives[removedId] = m_Primitives[lastId];
+		m_PrimitiveDirtyFlags[removedId] = m_PrimitiveDirtyFlags[lastId];
+		m_Primitives.pop_back();
+		m_PrimitiveDirtyFlags.pop_back();
+
+		uint32_t dirtyNum = 0;
+		for (uint32_t i = 0; i < m_DirtyPrimitives.size(); ++i)
+		{
+			uint32_t primitiveId = m_DirtyPrimitives[i];
+			if (primitiveId == removedId)
+			{
+				continue;
+			}
+
+			m_DirtyPrimitives[dirtyNum++] = primitiveId == lastId ? removedId : primitiveId;
+		}
+		m_DirtyPrimitives.resize(dirtyNum);
+
+		if (removedId != lastId)
+		{
+			m_Primitives[removedId]->SetBoundsListener(this, removedId);
+		}
+		pPrimitive->SetBoundsListener(nullptr, 0);
+
+		m_bBVHDirty = true;
+
+		for (uint32_t i = 0; i < m_Listeners.size(); ++i)
+		{
+			m_Listeners[i]->OnPrimitiveUnregistered(pPrimitive);
+		}
 	}
 
 	void Scene::RegisterLight(ILight* pLight)
 	{
 		m_Lights.push_back(pLight);
+
+		for (uint32_t i = 0; i < m_Listeners.size(); ++i)
+		{
+			m_Listeners[i]->OnLightRegistered(pLight);
+		}
+	}
+
+	void Scene::UnregisterLight(ILight* pLight)
+	{
+		//ֹԴ˳򣬵һԴԴ
+		auto lightIter = std::find(m_Lights.begin(), m_Lights.end(), pLight);
+		if (lightIter == m_Lights.end())
+		{
+			return;
+		}
+
+		m_Lights.erase(lightIter);
+
+		for (uint32_t i = 0; i < m_Listeners.size(); ++i)
+		{
+			m_Listeners[i]->OnLightUnregistered(pLight);
+		}
+	}
+
+	void Scene::AddListener(ISceneListener* pListener)
+	{
+		if (std::find(m_Listeners.begin(), m_Listeners.end(), pListener) == m_Listeners.end())
+		{
+			m_Listeners.push_back(pListener);
+		}
+	}
+
+	void Scene::RemoveListener(ISceneListener* pListener)
+	{
+		auto listenerIter = std::find(m_Listeners.begin(), m_Listeners.end(), pListener);
+		if (listenerIter != m_Listeners.end())
+		{
+			m_Listeners.erase(listenerIter);
+		}
 	}
 
 	void Scene::Clear()
 	{
+		WaitForBackgroundRebuild();
+
+		for (uint32_t i = 0; i < m_Primitives.size(); ++i)
+		{
+			m_Primitives[i]->SetBoundsListener(nullptr, 0);
+		}
+
 		m_Primitives.clear();
 		m_Lights.clear();
+
+		m_BVH.Clear();
+		m_bBVHDirty = false;
+
+		m_DirtyPrimitives.clear();
+		m_PrimitiveDirtyFlags.clear();
+
+		for (uint32_t i = 0; i < m_Listeners.size(); ++i)
+		{
+			m_Listeners[i]->OnSceneCleared();
+		}
+	}
+
+	void Scene::OnPrimitiveBoundsChanged(uint32_t primitiveId)
+	{
+		if (!m_PrimitiveDirtyFlags[primitiveId])
+		{
+			m_PrimitiveDirtyFlags[primitiveId] = 1;
+			m_DirtyPrimitives.push_back(primitiveId);
+		}
+
+		for (uint32_t i = 0; i < m_Listeners.size(); ++i)
+		{
+			m_Listeners[i]->OnPrimitiveMoved(m_Primitives[primitiveId]);
+		}
+	}
+
+	void Scene::UpdateSpatialIndex()
+	{
+		RD_PROFILE_SCOPE("Scene::UpdateSpatialIndex");
+
+		bool bNeedRebuild = m_bBVHDirty;
+		for (uint32_t i = 0; i < m_DirtyPrimitives.size(); ++i)
+		{
+			uint32_t primitiveId = m_DirtyPrimitives[i];
+			m_PrimitiveDirtyFlags[primitiveId] = 0;
+
+			if (bNeedRebuild)
+			{
+				continue;
+			}
+
+			//AABBЧЧ֮仯ʱĽṹҪı䣬ֻؽ
+			if (!m_BVH.UpdateItem(primitiveId, m_Primitives[primitiveId]->GetAABB()))
+			{
+				bNeedRebuild = true;
+			}
+			else if (m_bRebuilding)
+			{
+				m_PrimitivesMovedDuringRebuild.push_back(primitiveId);
+			}
+		}
+		m_DirtyPrimitives.clear();
+
+		if (bNeedRebuild)
+		{
+			WaitForBackgroundRebuild();
+			RebuildBVH();
+			return;
+		}
+
+		m_BVH.Refit();
+
+		if (m_bRebuilding && g_pJobSystem->IsFinished(&m_RebuildJob))
+		{
+			m_bRebuilding = false;
+
+			m_BVH.Swap(m_RebuildingBVH);
+			m_RebuildingBVH.Clear();
+
+			for (uint32_t i = 0; i < m_PrimitivesMovedDuringRebuild.size(); ++i)
+			{
+				uint32_t primitiveId = m_PrimitivesMovedDuringRebuild[i];
+				m_BVH.UpdateItem(primitiveId, m_Primitives[primitiveId]->GetAABB());
+			}
+			m_PrimitivesMovedDuringRebuild.clear();
+
+			m_BVH.Refit();
+		}
+		else if (!m_bRebuilding && m_BVH.GetRefitDegradation() > BVH_REBUILD_DEGRADATION)
+		{
+			StartBackgroundRebuild();
+		}
+	}
+
+	void Scene::QueryPrimitives(const Frustum& frustum, std::vector<IPrimitive*>& outPrimitives)
+	{
+		UpdateSpatialIndex();
+
+		m_QueryItems.clear();
+		m_BVH.QueryFrustum(frustum, m_QueryNodeStack, m_QueryItems);
+
+		AppendQueryResults(outPrimitives);
+	}
+
+	void Scene::QueryPrimitives(const BoundingSphere& sphere, std::vector<IPrimitive*>& outPrimitives)
+	{
+		UpdateSpatialIndex();
+
+		m_QueryItems.clear();
+		m_BVH.QuerySphere(sphere, m_QueryNodeStack, m_QueryItems);
+
+		AppendQueryResults(outPrimitives);
+	}
+
+	void Scene::QueryPrimitives(const AABB& aabb, std::vector<IPrimitive*>& outPrimitives)
+	{
+		UpdateSpatialIndex();
+
+		m_QueryItems.clear();
+		m_BVH.QueryAABB(aabb, m_QueryNodeStack, m_QueryItems);
+
+		AppendQueryResults(outPrimitives);
+	}
+
+	void Scene::QueryPrimitives(const Ray& ray, float maxDistance, std::vector<IPrimitive*>& outPrimitives)
+	{
+		UpdateSpatialIndex();
+
+		m_QueryItems.clear();
+		m_BVH.QueryRay(ray, maxDistance, m_QueryNodeStack, m_QueryItems);
+
+		AppendQueryResults(outPrimitives);
+	}
+
+	bool Scene::Raycast(const Ray& ray, float maxDistance, SceneRayHit& outHit)
+	{
+		UpdateSpatialIndex();
+
+		outHit = SceneRayHit();
+
+		return RaycastPrimitives(ray, maxDistance, false, m_RayScratch, outHit);
+	}
+
+	bool Scene::RaycastAny(const Ray& ray, float maxDistance)
+	{
+		UpdateSpatialIndex();
+
+		SceneRayHit hit;
+
+		return RaycastPrimitives(ray, maxDistance, true, m_RayScratch, hit);
+	}
+
+	void Scene::RaycastBatch(const Ray* pRays, uint32_t count, float maxDistance, SceneRayHit* pHits)
+	{
+		RD_PROFILE_SCOPE("Scene::RaycastBatch");
+
+		UpdateSpatialIndex();
+
+		m_BatchRayScratches.resize(g_pJobSystem->GetWorkerNum() + 1);
+
+		g_pJobSystem->ParallelFor(count, SCENE_RAYCAST_BATCH_SIZE, [this, pRays, maxDistance, pHits](uint32_t begin, uint32_t end)
+		{
+			//ڲȴͬһ߳ϵ䲻ύִУԹһʱ
+			uint32_t workerIndex = g_pJobSystem->GetCurrWorkerIndex();
+			SceneRayScratch& scratch = m_BatchRayScratches[workerIndex != JOB_INVALID_WORKER ? workerIndex : m_BatchRayScratches.size() - 1];
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				pHits[i] = SceneRayHit();
+				RaycastPrimitives(pRays[i], maxDistance, false, scratch, pHits[i]);
+			}
+		});
+	}
+
+	void Scene::RebuildBVH()
+	{
+		RD_PROFILE_SCOPE("Scene::RebuildBVH");
+
+		m_PrimitiveAABBs.resize(m_Primitives.size());
+		for (uint32_t i = 0; i < m_Primitives.size(); ++i)
+		{
+			m_PrimitiveAABBs[i] = m_Primitives[i]->GetAABB();
+		}
+
+		if (m_PrimitiveAABBs.empty())
+		{
+			m_BVH.Clear();
+		}
+		else
+		{
+			m_BVH.Build(&m_PrimitiveAABBs[0], (uint32_t)m_PrimitiveAABBs.size());
+		}
+
+		m_bBVHDirty = false;
+	}
+
+	void Scene::StartBackgroundRebuild()
+	{
+		m_RebuildAABBs.resize(m_Primitives.size());
+		for (uint32_t i = 0; i < m_Primitives.size(); ++i)
+		{
+			m_RebuildAABBs[i] = m_Primitives[i]->GetAABB();
+		}
+
+		m_bRebuilding = true;
+		Job* pJob = g_pJobSystem->CreateJobInPlace(&m_RebuildJob, [this]()
+		{
+			m_RebuildingBVH.Build(&m_RebuildAABBs[0], (uint32_t)m_RebuildAABBs.size());
+		});
+		g_pJobSystem->Run(pJob);
+	}
+
+	void Scene::WaitForBackgroundRebuild()
+	{
+		if (!m_bRebuilding)
+		{
+			return;
+		}
+
+		g_pJobSystem->Wait(&m_RebuildJob);
+		m_bRebuilding = false;
+
+		m_RebuildingBVH.Clear();
+		m_PrimitivesMovedDuringRebuild.clear();
+	}
+
+	void Scene::AppendQueryResults(std::vector<IPrimitive*>& outPrimitives)
+	{
+		outPrimitives.reserve(outPrimitives.size() + m_QueryItems.size());
+		for (uint32_t i = 0; i < m_QueryItems.size(); ++i)
+		{
+			outPrimitives.push_back(m_Primitives[m_QueryItems[i]]);
+		}
+	}
+
+	bool Scene::RaycastPrimitives(const Ray& ray, float maxDistance, bool bAnyHit, SceneRayScratch& scratch, SceneRayHit& outHit) const
+	{
+		std::vector<uint32_t>& queryItems = scratch.queryItems;
+		std::vector<SceneRayCandidate>& candidates = scratch.candidates;
+
+		queryItems.clear();
+		m_BVH.QueryRay(ray, maxDistance, scratch.nodeStack, queryItems);
+
+		//߽AABBľAABBȵǰĽ㻹ԶͼԪҪٲ
+		candidates.clear();
+		for (uint32_t i = 0; i < queryItems.size(); ++i)
+		{
+			const AABB& aabb = m_Primitives[queryItems[i]]->GetAABB();
+
+			float distance = 0.0f;
+			if (aabb.IsValid() && IntersectRayAABB(ray, aabb, maxDistance, distance))
+			{
+				candidates.push_back({ distance, queryItems[i] });
+			}
+		}
+
+		std::sort(candidates.begin(), candidates.end(), [](const SceneRayCandidate& lhs, const SceneRayCandidate& rhs)
+		{
+			return lhs.distance < rhs.distance;
+		});
+
+		bool bHit = false;
+		float closestDistance = maxDistance;
+		for (uint32_t i = 0; i < candidates.size(); ++i)
+		{
+			const SceneRayCandidate& candidate = candidates[i];
+			if (candidate.distance > closestDistance)
+			{
+				break;
+			}
+
+			IPrimitive* pPrimitive = m_Primitives[candidate.primitiveId];
+
+			RaycastData raycastData;
+			if (!pPrimitive->GetRaycastData(raycastData))
+			{
+				continue;
+			}
+
+			if (!raycastData.pTriangleBVH)
+			{
+				outHit.pPrimitive = pPrimitive;
+				outHit.distance = candidate.distance;
+				outHit.triangle = SCENE_RAY_HIT_NO_TRIANGLE;
+				outHit.u = 0.0f;
+				outHit.v = 0.0f;
+			}
+			else
+			{
+				//任ıϵĲֲռľռеľ
+				Matrix3x4 worldToLocal = AffineInverse(raycastData.localToWorldMatrix);
+				Ray localRay(worldToLocal.TransformPoint(ray.origin), worldToLocal.TransformVector(ray.direction));
+
+				if (bAnyHit)
+				{
+					if (!raycastData.pTriangleBVH->RaycastAny(localRay, closestDistance))
+					{
+						continue;
+					}
+
+					outHit.pPrimitive = pPrimitive;
+					return true;
+				}
+
+				TriangleRayHit triangleHit;
+				if (!raycastData.pTriangleBVH->Raycast(localRay, closestDistance, triangleHit))
+				{
+					continue;
+				}
+
+				outHit.pPrimitive = pPrimitive;
+				outHit.distance = triangleHit.distance;
+				outHit.triangle = triangleHit.triangle;
+				outHit.u = triangleHit.u;
+				outHit.v = triangleHit.v;
+			}
+
+			bHit = true;
+			closestDistance = outHit.distance;
+
+			if (bAnyHit)
+			{
+				return true;
+			}
+		}
+
+		return bHit;
 	}
 
 	IScene* SceneManager::CreateScene(const SceneInitDesc& sceneDesc)
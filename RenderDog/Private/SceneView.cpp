@@ -8,24 +8,117 @@
 #include "Camera.h"
 #include "Primitive.h"
 #include "Light.h"
+#include "Scene.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "FrameAllocator.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace RenderDog
 {
+	//ÿٲԵİΧͼԪʱ̸߳
+	static const uint32_t	CULLING_MIN_COUNT_PER_JOB = 16384;
+	//ͼԪﵽֵʱΪѯBVHͼԪʱSIMDԸ
+	static const uint32_t	CULLING_MIN_COUNT_USE_BVH = 2048;
+	//ڵķֱÿ֡դڵ
+	static const uint32_t	OCCLUSION_BUFFER_WIDTH = 256;
+	static const uint32_t	OCCLUSION_BUFFER_HEIGHT = 128;
+	static const uint32_t	OCCLUSION_MAX_OCCLUDER_NUM = 32;
+
+	//ֶελӸλλ
+	//STATE_FIRST:   | pass 4 | shader 12 | material 16 | buffer 16 | depth 16 |
+	//FRONT_TO_BACK: | pass 4 | depth 16 | shader 12 | material 16 | buffer 16 |
+	static const uint32_t	SORT_KEY_PASS_BITS = 4;
+	static const uint32_t	SORT_KEY_SHADER_BITS = 12;
+	static const uint32_t	SORT_KEY_MATERIAL_BITS = 16;
+	static const uint32_t	SORT_KEY_BUFFER_BITS = 16;
+	static const uint32_t	SORT_KEY_DEPTH_BITS = 16;
+	//ÿһ˴λ
+	static const uint32_t	RADIX_SORT_DIGIT_BITS = 8;
+	static const uint32_t	RADIX_SORT_BUCKET_NUM = 1 << RADIX_SORT_DIGIT_BITS;
+	static const uint32_t	RADIX_SORT_PASS_NUM = 64 / RADIX_SORT_DIGIT_BITS;
+
+	//ųֶηΧʱ·䣬ֻӰ飬Ӱȷԣ·ʱbOutResetΪtrue
+	static uint32_t GetSortId(std::unordered_map<const void*, uint32_t>& ids, const void* pObject, uint32_t bits, bool& bOutReset)
+	{
+		uint32_t maxId = (1u << bits) - 1;
+
+		auto iter = ids.find(pObject);
+		if (iter != ids.end())
+		{
+			return iter->second;
+		}
+
+		if (ids.size() > maxId)
+		{
+			ids.clear();
+			bOutReset = true;
+		}
+
+		uint32_t id = (uint32_t)ids.size();
+		ids.insert({ pObject, id });
+
+		return id;
+	}
+
+	//ǸλģʽֵС˳һ£ȡλ൱ڶ
+	static uint32_t QuantizeDepth(float depth, uint32_t bits)
+	{
+		depth = depth > 0.0f ? depth : 0.0f;
+
+		uint32_t depthBits = 0;
+		memcpy(&depthBits, &depth, sizeof(float));
+
+		return depthBits >> (32 - bits);
+	}
+
+	static void FrustumTestAABBsParallel(const Frustum& frustum, const AABB* pAABBs, uint32_t count, CONTAINMENT_TYPE* pResults)
+	{
+		//ÿε㰴8룬֤SIMDԲڶڳֶβ
+		uint32_t batchNum = (count + 7) / 8;
+		g_pJobSystem->ParallelFor(batchNum, CULLING_MIN_COUNT_PER_JOB / 8, [&](uint32_t begin, uint32_t end)
+		{
+			uint32_t first = begin * 8;
+			uint32_t last = end * 8 < count ? end * 8 : count;
+			FrustumTestAABBs(frustum, pAABBs + first, last - first, pResults + first);
+		});
+	}
+
 	SceneView::SceneView():
 		m_OpaquePris(0),
 		m_SimplePris(0),
 		m_Lights(0),
 		m_pCamera(nullptr),
+		m_bPrisChanged(false),
+		m_pAttachedScene(nullptr),
+		m_ScenePris(0),
+		m_ScenePriAABBs(0),
+		m_ScenePriIndices(),
+		m_bScenePrisChanged(false),
+		m_CullingResults(0),
+		m_CullingVisiblePris(0),
+		m_CulledPrisNum(0),
+		m_OcclusionBuffer(),
+		m_OccluderCandidates(0),
+		m_bOcclusionCullingEnable(true),
+		m_OccludedPrisNum(0),
+		m_OpaqueSortMode(DRAW_SORT_MODE::STATE_FIRST),
+		m_SortItems(0),
+		m_SortTempItems(0),
+		m_ShaderSortIds(),
+		m_MaterialSortIds(),
+		m_BufferSortIds(),
 		m_WorldToViewMatrix(),
 		m_ViewToClipMatrix(),
-		m_ShadowWorldToViewMatrix(),
-		m_ShadowViewToClipMatrix(),
+		m_ShadowCascades(),
 		m_pRenderData(nullptr)
 	{
 		m_WorldToViewMatrix.Identity();
 		m_ViewToClipMatrix.Identity();
-		m_ShadowWorldToViewMatrix.Identity();
-		m_ShadowViewToClipMatrix.Identity();
+
+		m_OcclusionBuffer.Init(OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT);
 
 		m_pRenderData = new SceneViewRenderData();
 
@@ -37,12 +130,31 @@ namespace RenderDog
 		m_SimplePris(0),
 		m_Lights(0),
 		m_pCamera(pCamera),
+		m_bPrisChanged(false),
+		m_pAttachedScene(nullptr),
+		m_ScenePris(0),
+		m_ScenePriAABBs(0),
+		m_ScenePriIndices(),
+		m_bScenePrisChanged(false),
+		m_CullingResults(0),
+		m_CullingVisiblePris(0),
+		m_CulledPrisNum(0),
+		m_OcclusionBuffer(),
+		m_OccluderCandidates(0),
+		m_bOcclusionCullingEnable(true),
+		m_OccludedPrisNum(0),
+		m_OpaqueSortMode(DRAW_SORT_MODE::STATE_FIRST),
+		m_SortItems(0),
+		m_SortTempItems(0),
+		m_ShaderSortIds(),
+		m_MaterialSortIds(),
+		m_BufferSortIds(),
 		m_pRenderData(nullptr)
 	{
 		m_WorldToViewMatrix.Identity();
 		m_ViewToClipMatrix.Identity();
-		m_ShadowWorldToViewMatrix.Identity();
-		m_ShadowViewToClipMatrix.Identity();
+
+		m_OcclusionBuffer.Init(OCCLUSION_BUFFER_WIDTH, OCCLUSION_BUFFER_HEIGHT);
 
 		m_pRenderData = new SceneViewRenderData();
 
@@ -51,6 +163,8 @@ namespace RenderDog
 
 	SceneView::~SceneView()
 	{
+		DetachScene();
+
 		m_OpaquePris.clear();
 		m_SimplePris.clear();
 
@@ -65,8 +179,75 @@ namespace RenderDog
 		}
 	}
 
+	void SceneView::AttachScene(IScene* pScene)
+	{
+		if (pScene == m_pAttachedScene)
+		{
+			return;
+		}
+
+		DetachScene();
+
+		if (!pScene)
+		{
+			return;
+		}
+
+		m_pAttachedScene = pScene;
+		pScene->AddListener(this);
+
+		uint32_t priNum = pScene->GetPrimitivesNum();
+		m_ScenePris.reserve(priNum);
+		m_ScenePriAABBs.reserve(priNum);
+		for (uint32_t i = 0; i < priNum; ++i)
+		{
+			OnPrimitiveRegistered(pScene->GetPrimitive(i));
+		}
+
+		uint32_t lightNum = pScene->GetLightsNum();
+		for (uint32_t i = 0; i < lightNum; ++i)
+		{
+			OnLightRegistered(pScene->GetLight(i));
+		}
+
+		m_bScenePrisChanged = true;
+	}
+
+	void SceneView::DetachScene()
+	{
+		if (!m_pAttachedScene)
+		{
+			return;
+		}
+
+		m_pAttachedScene->RemoveListener(this);
+		m_pAttachedScene = nullptr;
+
+		OnSceneCleared();
+	}
+
+	void SceneView::AddScenePrimitives(IScene* pScene)
+	{
+		AttachScene(pScene);
+
+		if (!m_bScenePrisChanged)
+		{
+			return;
+		}
+
+		ClearPrimitives();
+		for (uint32_t i = 0; i < m_ScenePris.size(); ++i)
+		{
+			AddPrimitive(m_ScenePris[i]);
+		}
+
+		m_bScenePrisChanged = false;
+	}
+
 	void SceneView::AddPrimitive(IPrimitive* pPri)
 	{
+		m_bPrisChanged = true;
+
 		switch (pPri->GetPriType())
 		{
 		case PRIMITIVE_TYPE::SIMPLE_PRI:
@@ -85,6 +266,240 @@ namespace RenderDog
 		}
 	}
 
+	void SceneView::AddVisiblePrimitives(IScene* pScene, const Matrix4x4& worldToClip)
+	{
+		RD_PROFILE_SCOPE("SceneView::AddVisiblePrimitives");
+
+		AttachScene(pScene);
+
+		Frustum frustum(worldToClip);
+
+		uint32_t priNum = (uint32_t)m_ScenePris.size();
+
+		m_CullingVisiblePris.clear();
+		if (priNum >= CULLING_MIN_COUNT_USE_BVH)
+		{
+			pScene->QueryPrimitives(frustum, m_CullingVisiblePris);
+		}
+		else
+		{
+			//ΧѾͼԪעƶʱãﲻҪȡ
+			m_CullingResults.resize(priNum);
+			if (priNum > 0)
+			{
+				FrustumTestAABBsParallel(frustum, &m_ScenePriAABBs[0], priNum, &m_CullingResults[0]);
+			}
+
+			for (uint32_t i = 0; i < priNum; ++i)
+			{
+				if (m_CullingResults[i] != CONTAINMENT_TYPE::OUTSIDE || !m_ScenePriAABBs[i].IsValid())
+				{
+					m_CullingVisiblePris.push_back(m_ScenePris[i]);
+				}
+			}
+		}
+
+		m_CulledPrisNum = priNum - (uint32_t)m_CullingVisiblePris.size();
+		m_OccludedPrisNum = 0;
+
+		if (m_bOcclusionCullingEnable && RenderOccluders(worldToClip))
+		{
+			RD_PROFILE_SCOPE("SceneView::OcclusionTest");
+
+			uint32_t visibleNum = 0;
+			for (uint32_t i = 0; i < m_CullingVisiblePris.size(); ++i)
+			{
+				IPrimitive* pPri = m_CullingVisiblePris[i];
+
+				const AABB& aabb = pPri->GetAABB();
+				if (aabb.IsValid() && !m_OcclusionBuffer.IsAABBVisible(aabb))
+				{
+					++m_OccludedPrisNum;
+					continue;
+				}
+
+				m_CullingVisiblePris[visibleNum++] = pPri;
+			}
+			m_CullingVisiblePris.resize(visibleNum);
+		}
+
+		//ͶӰ[1][1]Ϊcot(fov / 2)ΧֱռĻ߶ȵıΪ radius * cot(fov / 2) / distance
+		float projScale = m_pCamera ? m_pCamera->GetPerspProjectionMatrix()(1, 1) : 0.0f;
+		Vector3 cameraPos = m_pCamera ? m_pCamera->GetPosition() : Vector3(0.0f, 0.0f, 0.0f);
+		for (uint32_t i = 0; i < m_CullingVisiblePris.size(); ++i)
+		{
+			IPrimitive* pPri = m_CullingVisiblePris[i];
+
+			const AABB& aabb = pPri->GetAABB();
+			if (m_pCamera && aabb.IsValid())
+			{
+				float radius = aabb.GetExtents().Length();
+				float distance = (aabb.GetCenter() - cameraPos).Length();
+				pPri->SelectLOD(radius * projScale / (std::max)(distance, radius));
+			}
+
+			AddPrimitive(pPri);
+		}
+	}
+
+	bool SceneView::RenderOccluders(const Matrix4x4& worldToClip)
+	{
+		RD_PROFILE_SCOPE("SceneView::RenderOccluders");
+
+		//ΧжԽ߳뵽ıֵѡڵ壬ԽĻԽ
+		m_OccluderCandidates.clear();
+		Vector3 cameraPos = m_pCamera ? m_pCamera->GetPosition() : Vector3(0.0f, 0.0f, 0.0f);
+		for (uint32_t i = 0; i < m_CullingVisiblePris.size(); ++i)
+		{
+			OccluderData occluder;
+			if (!m_CullingVisiblePris[i]->GetOccluderData(occluder))
+			{
+				continue;
+			}
+
+			const AABB& aabb = m_CullingVisiblePris[i]->GetAABB();
+			Vector3 diagonal = aabb.maxPoint - aabb.minPoint;
+			Vector3 toCamera = aabb.GetCenter() - cameraPos;
+
+			OccluderCandidate candidate;
+			candidate.data = occluder;
+			candidate.screenSize = DotProduct(diagonal, diagonal) / (std::max)(DotProduct(toCamera, toCamera), 1e-4f);
+			m_OccluderCandidates.push_back(candidate);
+		}
+
+		if (m_OccluderCandidates.empty())
+		{
+			return false;
+		}
+
+		if (m_OccluderCandidates.size() > OCCLUSION_MAX_OCCLUDER_NUM)
+		{
+			std::partial_sort(m_OccluderCandidates.begin(), m_OccluderCandidates.begin() + OCCLUSION_MAX_OCCLUDER_NUM, m_OccluderCandidates.end(),
+				[](const OccluderCandidate& lhs, const OccluderCandidate& rhs) { return lhs.screenSize > rhs.screenSize; });
+			m_OccluderCandidates.resize(OCCLUSION_MAX_OCCLUDER_NUM);
+		}
+
+		m_OcclusionBuffer.Clear();
+		m_OcclusionBuffer.SetWorldToClipMatrix(worldToClip);
+		for (uint32_t i = 0; i < m_OccluderCandidates.size(); ++i)
+		{
+			m_OcclusionBuffer.RenderOccluder(m_OccluderCandidates[i].data);
+		}
+
+		return true;
+	}
+
+	void SceneView::SortPrimitives()
+	{
+		RD_PROFILE_SCOPE("SceneView::SortPrimitives");
+
+		//STATE_FIRSTֻͬ״̬ڵĴбûʱһεĽ
+		if (!m_bPrisChanged && m_OpaqueSortMode != DRAW_SORT_MODE::FRONT_TO_BACK)
+		{
+			return;
+		}
+		m_bPrisChanged = false;
+
+		SortPrimitivesByKey(m_OpaquePris, m_OpaqueSortMode);
+		SortPrimitivesByKey(m_SimplePris, DRAW_SORT_MODE::STATE_FIRST);
+	}
+
+	uint64_t SceneView::CalcSortKey(const IPrimitive* pPri, DRAW_SORT_MODE mode)
+	{
+		PrimitiveRenderParam renderParam;
+		pPri->GetRenderParam(renderParam);
+
+		uint64_t pass = (uint64_t)pPri->GetPriType() & ((1u << SORT_KEY_PASS_BITS) - 1);
+		bool bIdsReset = false;
+		uint64_t shader = GetSortId(m_ShaderSortIds, renderParam.pVS, SORT_KEY_SHADER_BITS, bIdsReset);
+		uint64_t material = GetSortId(m_MaterialSortIds, renderParam.pMtlIns, SORT_KEY_MATERIAL_BITS, bIdsReset);
+		uint64_t buffer = GetSortId(m_BufferSortIds, renderParam.pVB, SORT_KEY_BUFFER_BITS, bIdsReset);
+		//֮ǰļʹõǾɱţεãһʱȫ¼
+		if (bIdsReset)
+		{
+			m_bPrisChanged = true;
+		}
+
+		uint64_t depth = 0;
+		const AABB& aabb = pPri->GetAABB();
+		if (m_pCamera && aabb.IsValid())
+		{
+			depth = QuantizeDepth(DotProduct(aabb.GetCenter() - m_pCamera->GetPosition(), m_pCamera->GetDirection()), SORT_KEY_DEPTH_BITS);
+		}
+
+		uint64_t state = (shader << (SORT_KEY_MATERIAL_BITS + SORT_KEY_BUFFER_BITS)) | (material << SORT_KEY_BUFFER_BITS) | buffer;
+		uint64_t key = pass << (64 - SORT_KEY_PASS_BITS);
+		if (mode == DRAW_SORT_MODE::FRONT_TO_BACK)
+		{
+			key |= (depth << (SORT_KEY_SHADER_BITS + SORT_KEY_MATERIAL_BITS + SORT_KEY_BUFFER_BITS)) | state;
+		}
+		else
+		{
+			key |= (state << SORT_KEY_DEPTH_BITS) | depth;
+		}
+
+		return key;
+	}
+
+	void SceneView::SortPrimitivesByKey(std::vector<IPrimitive*>& pris, DRAW_SORT_MODE mode)
+	{
+		uint32_t priNum = (uint32_t)pris.size();
+		if (priNum < 2)
+		{
+			return;
+		}
+
+		m_SortItems.resize(priNum);
+		m_SortTempItems.resize(priNum);
+		for (uint32_t i = 0; i < priNum; ++i)
+		{
+			m_SortItems[i].key = CalcSortKey(pris[i], mode);
+			m_SortItems[i].pPri = pris[i];
+		}
+
+		//LSDһαͳ˵ֱͼмĳһͬʱһ
+		uint32_t histograms[RADIX_SORT_PASS_NUM][RADIX_SORT_BUCKET_NUM] = {};
+		for (uint32_t i = 0; i < priNum; ++i)
+		{
+			uint64_t key = m_SortItems[i].key;
+			for (uint32_t pass = 0; pass < RADIX_SORT_PASS_NUM; ++pass)
+			{
+				++histograms[pass][(key >> (pass * RADIX_SORT_DIGIT_BITS)) & (RADIX_SORT_BUCKET_NUM - 1)];
+			}
+		}
+
+		for (uint32_t pass = 0; pass < RADIX_SORT_PASS_NUM; ++pass)
+		{
+			uint32_t shift = pass * RADIX_SORT_DIGIT_BITS;
+			uint32_t* pHistogram = histograms[pass];
+			if (pHistogram[(m_SortItems[0].key >> shift) & (RADIX_SORT_BUCKET_NUM - 1)] == priNum)
+			{
+				continue;
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < RADIX_SORT_BUCKET_NUM; ++bucket)
+			{
+				uint32_t count = pHistogram[bucket];
+				pHistogram[bucket] = offset;
+				offset += count;
+			}
+
+			for (uint32_t i = 0; i < priNum; ++i)
+			{
+				const DrawSortItem& item = m_SortItems[i];
+				m_SortTempItems[pHistogram[(item.key >> shift) & (RADIX_SORT_BUCKET_NUM - 1)]++] = item;
+			}
+
+			m_SortItems.swap(m_SortTempItems);
+		}
+
+		for (uint32_t i = 0; i < priNum; ++i)
+		{
+			pris[i] = m_SortItems[i].pPri;
+		}
+	}
+
 	IPrimitive* SceneView::GetOpaquePri(uint32_t index)
 	{
 		return m_OpaquePris[index];
@@ -109,6 +524,8 @@ namespace RenderDog
 	{ 
 		m_OpaquePris.clear();
 		m_SimplePris.clear();
+
+		m_bPrisChanged = true;
 	}
 
 	void SceneView::ClearLights() 
@@ -116,6 +533,87 @@ namespace RenderDog
 		m_Lights.clear();
 	}
 
+	void SceneView::OnPrimitiveRegistered(IPrimitive* pPrimitive)
+	{
+		m_ScenePriIndices.insert({ pPrimitive, (uint32_t)m_ScenePris.size() });
+		m_ScenePris.push_back(pPrimitive);
+		m_ScenePriAABBs.push_back(pPrimitive->GetAABB());
+
+		m_bScenePrisChanged = true;
+	}
+
+	void SceneView::OnPrimitiveUnregistered(IPrimitive* pPrimitive)
+	{
+		auto indexIter = m_ScenePriIndices.find(pPrimitive);
+		if (indexIter == m_ScenePriIndices.end())
+		{
+			return;
+		}
+
+		uint32_t index = indexIter->second;
+		uint32_t lastIndex = (uint32_t)m_ScenePris.size() - 1;
+		if (index != lastIndex)
+		{
+			m_ScenePris[index] = m_ScenePris[lastIndex];
+			m_ScenePriAABBs[index] = m_ScenePriAABBs[lastIndex];
+			m_ScenePriIndices[m_ScenePris[index]] = index;
+		}
+		m_ScenePris.pop_back();
+		m_ScenePriAABBs.pop_back();
+		m_ScenePriIndices.erase(pPrimitive);
+
+		//ƳͼԪڱ֡Ļб
+		m_OpaquePris.erase(std::remove(m_OpaquePris.begin(), m_OpaquePris.end(), pPrimitive), m_OpaquePris.end());
+		m_SimplePris.erase(std::remove(m_SimplePris.begin(), m_SimplePris.end(), pPrimitive), m_SimplePris.end());
+
+		m_bScenePrisChanged = true;
+	}
+
+	void SceneView::OnPrimitiveMoved(IPrimitive* pPrimitive)
+	{
+		auto indexIter = m_ScenePriIndices.find(pPrimitive);
+		if (indexIter != m_ScenePriIndices.end())
+		{
+			m_ScenePriAABBs[indexIter->second] = pPrimitive->GetAABB();
+		}
+	}
+
+	void SceneView::OnLightRegistered(ILight* pLight)
+	{
+		//ͼֻϴĲ
+		if (pLight->GetType() == LIGHT_TYPE::DIRECTIONAL)
+		{
+			m_Lights.push_back(pLight);
+		}
+	}
+
+	void SceneView::OnLightUnregistered(ILight* pLight)
+	{
+		auto lightIter = std::find(m_Lights.begin(), m_Lights.end(), pLight);
+		if (lightIter != m_Lights.end())
+		{
+			m_Lights.erase(lightIter);
+		}
+	}
+
+	void SceneView::OnSceneCleared()
+	{
+		m_ScenePris.clear();
+		m_ScenePriAABBs.clear();
+		m_ScenePriIndices.clear();
+		m_bScenePrisChanged = true;
+
+		ClearPrimitives();
+		ClearLights();
+	}
+
+	void SceneView::OnSceneReleased()
+	{
+		m_pAttachedScene = nullptr;
+
+		OnSceneCleared();
+	}
+
 	void SceneView::UpdateRenderData()
 	{
 		ViewParamData viewParamData = {};
@@ -134,16 +632,66 @@ namespace RenderDog
 			m_pRenderData->pDirLightParamCB->Update(&dirLightData, sizeof(DirectionalLightData));
 		}
 
-		ShadowDepthMatrixData shadowDepthData = {};
-		shadowDepthData.worldToViewMatrix = m_ShadowWorldToViewMatrix;
-		shadowDepthData.viewToClipMatrix = m_ShadowViewToClipMatrix;
-		m_pRenderData->pShadowMatrixCB->Update(&shadowDepthData, sizeof(ShadowDepthMatrixData));
+		UpdateShadowReceiverData();
 
 		ShadowParamData shadowParam = {};
-		shadowParam.param0 = Vector4(g_ShadowDepthOffset, (float)g_ShadowMapRTSize, 0.0f, 0.0f);
+		shadowParam.param0 = Vector4(g_ShadowDepthOffset, (float)g_ShadowMapRTSize, (float)m_ShadowCascades.cascadeNum, 0.0f);
+		for (uint32_t i = 0; i < m_ShadowCascades.cascadeNum; ++i)
+		{
+			const Matrix4x4& viewToClip = m_ShadowCascades.cascades[i].viewToClipMatrix;
+			shadowParam.cascadeScales[i] = Vector4(viewToClip(0, 0), viewToClip(1, 1), viewToClip(2, 2), 0.0f);
+			shadowParam.cascadeOffsets[i] = Vector4(viewToClip(3, 0), viewToClip(3, 1), viewToClip(3, 2), 0.0f);
+		}
 		m_pRenderData->pShadowParamCB->Update(&shadowParam, sizeof(ShadowParamData));
 	}
 
+	void SceneView::UpdateShadowCascadeData(uint32_t cascadeIndex)
+	{
+		ShadowDepthMatrixData shadowDepthData = {};
+		shadowDepthData.worldToViewMatrix = m_ShadowCascades.worldToViewMatrix;
+		shadowDepthData.viewToClipMatrix = m_ShadowCascades.cascades[cascadeIndex].viewToClipMatrix;
+		m_pRenderData->pShadowMatrixCB->Update(&shadowDepthData, sizeof(ShadowDepthMatrixData));
+	}
+
+	void SceneView::UpdateShadowReceiverData()
+	{
+		//ӰĶɫֻԴ۲ռλãɫźƽƱ任Ӱͼ
+		ShadowDepthMatrixData shadowDepthData = {};
+		shadowDepthData.worldToViewMatrix = m_ShadowCascades.worldToViewMatrix;
+		shadowDepthData.viewToClipMatrix = GetIdentityMatrix();
+		m_pRenderData->pShadowMatrixCB->Update(&shadowDepthData, sizeof(ShadowDepthMatrixData));
+	}
+
+	void SceneView::CullOpaquePrimitives(const Matrix4x4& worldToClip, std::vector<IPrimitive*>& outPris)
+	{
+		outPris.clear();
+
+		uint32_t priNum = (uint32_t)m_OpaquePris.size();
+		if (priNum == 0)
+		{
+			return;
+		}
+
+		Frustum frustum(worldToClip);
+
+		FrameVector<AABB> priAABBs(priNum);
+		for (uint32_t i = 0; i < priNum; ++i)
+		{
+			priAABBs[i] = m_OpaquePris[i]->GetAABB();
+		}
+
+		m_CullingResults.resize(priNum);
+		FrustumTestAABBsParallel(frustum, &priAABBs[0], priNum, &m_CullingResults[0]);
+
+		for (uint32_t i = 0; i < priNum; ++i)
+		{
+			if (m_CullingResults[i] != CONTAINMENT_TYPE::OUTSIDE || !priAABBs[i].IsValid())
+			{
+				outPris.push_back(m_OpaquePris[i]);
+			}
+		}
+	}
+
 	void SceneView::InitRenderData()
 	{
 		if (!m_pRenderData)
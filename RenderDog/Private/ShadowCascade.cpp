@@ -0,0 +1,97 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: ShadowCascade.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "ShadowCascade.h"
+#include "Camera.h"
+#include "Transform.h"
+#include "Utility.h"
+
+#include <cmath>
+
+namespace RenderDog
+{
+	//ֺ;ȻְlambdaϣļС
+	static void CalcCascadeSplits(float nearPlane, float farPlane, float lambda, float* pSplits)
+	{
+		pSplits[0] = nearPlane;
+		for (int i = 1; i < g_ShadowCascadeNum; ++i)
+		{
+			float ratio = static_cast<float>(i) / g_ShadowCascadeNum;
+			float logSplit = nearPlane * std::pow(farPlane / nearPlane, ratio);
+			float uniformSplit = nearPlane + (farPlane - nearPlane) * ratio;
+			pSplits[i] = lambda * logSplit + (1.0f - lambda) * uniformSplit;
+		}
+		pSplits[g_ShadowCascadeNum] = farPlane;
+	}
+
+	bool CalcShadowCascades(const FPSCamera& camera, const Vector3& lightDir, const BoundingSphere& sceneSphere,
+							float shadowDistance, uint32_t cascadeMapSize, ShadowCascadeSetup& outSetup)
+	{
+		outSetup.cascadeNum = 0;
+
+		if (sceneSphere.radius <= 0.0f || cascadeMapSize == 0)
+		{
+			return false;
+		}
+
+		//ԴڳΧ࣬۲ֻԴͳ仯仯
+		Vector3 lightDirection = Normalize(lightDir);
+		Vector3 upDir = std::fabs(lightDirection.y) > 0.99f ? Vector3(0.0f, 0.0f, 1.0f) : Vector3(0.0f, 1.0f, 0.0f);
+		Vector3 lightPos = sceneSphere.center - lightDirection * sceneSphere.radius;
+		Matrix4x4 worldToLightView = GetLookAtMatrixLH(lightPos, sceneSphere.center, upDir);
+		Matrix3x4 worldToLightView3x4(worldToLightView);
+
+		float nearPlane = camera.GetNearPlane();
+		float farPlane = shadowDistance < camera.GetFarPlane() ? shadowDistance : camera.GetFarPlane();
+		if (farPlane <= nearPlane)
+		{
+			return false;
+		}
+
+		float splits[g_ShadowCascadeNum + 1];
+		CalcCascadeSplits(nearPlane, farPlane, g_ShadowCascadeSplitLambda, splits);
+
+		//׶zԽߵһΪz * k
+		float tanHalfFov = std::tan(0.5f * AngleToRadians(camera.GetFov()));
+		float aspect = camera.GetAspect();
+		float kSquare = tanHalfFov * tanHalfFov * (1.0f + aspect * aspect);
+
+		const Vector3& cameraPos = camera.GetPosition();
+		Vector3 cameraDir = Normalize(camera.GetDirection());
+
+		for (int i = 0; i < g_ShadowCascadeNum; ++i)
+		{
+			float sliceNear = splits[i];
+			float sliceFar = splits[i + 1];
+
+			//סһ׶Сϣֻ׶״йأתʱ뾶
+			float centerZ = 0.5f * (sliceNear + sliceFar) * (1.0f + kSquare);
+			centerZ = centerZ < sliceFar ? centerZ : sliceFar;
+			float radius = std::sqrt((sliceFar - centerZ) * (sliceFar - centerZ) + sliceFar * sliceFar * kSquare);
+
+			//ڹԴ۲ռаض룬ƶʱӰͼĲλñֲ
+			Vector3 centerInLightView = worldToLightView3x4.TransformPoint(cameraPos + cameraDir * centerZ);
+			float texelSize = 2.0f * radius / cascadeMapSize;
+			centerInLightView.x = std::floor(centerInLightView.x / texelSize) * texelSize;
+			centerInLightView.y = std::floor(centerInLightView.y / texelSize) * texelSize;
+
+			//ȷ򸲸ͶӰҲͶ䵽
+			ShadowCascade& cascade = outSetup.cascades[i];
+			cascade.viewToClipMatrix = GetOrthographicMatrixLH(centerInLightView.x - radius, centerInLightView.x + radius,
+				centerInLightView.y - radius, centerInLightView.y + radius,
+				0.0f, 2.0f * sceneSphere.radius);
+			cascade.worldToClipMatrix = worldToLightView * cascade.viewToClipMatrix;
+			cascade.splitNear = sliceNear;
+			cascade.splitFar = sliceFar;
+		}
+
+		outSetup.worldToViewMatrix = worldToLightView;
+		outSetup.cascadeNum = g_ShadowCascadeNum;
+
+		return true;
+	}
+
+}// namespace RenderDog
@@ -7,11 +7,14 @@
 
 #include "SimpleMesh.h"
 #include "Transform.h"
+#include "RenderThread.h"
 
 #include <unordered_map>
 
 namespace RenderDog
 {
+	ObjectPool<SimpleMeshRenderData>	SimpleMeshRenderData::s_Pool;
+
 	struct SimpleVertexKey
 	{
 		Vector3		pos;
@@ -102,16 +105,21 @@ namespace RenderDog
 	void SimpleMesh::Render(IPrimitiveRenderer* pPrimitiveRenderer)
 	{
 		PrimitiveRenderParam renderParam = {};
-		renderParam.pVB							= m_pRenderData->pVB;
-		renderParam.pIB							= m_pRenderData->pIB;
-		renderParam.pMtlIns						= nullptr;
-		renderParam.pVS							= m_pRenderData->pVS;
-		renderParam.PerObjParam.pPerObjectCB	= m_pRenderData->pLocalToWorldCB;
-		renderParam.bRenderLine					= m_bIsLine;
+		GetRenderParam(renderParam);
 
 		pPrimitiveRenderer->Render(renderParam);
 	}
 
+	void SimpleMesh::GetRenderParam(PrimitiveRenderParam& outRenderParam) const
+	{
+		outRenderParam.pVB						= m_pRenderData->pVB;
+		outRenderParam.pIB						= m_pRenderData->pIB;
+		outRenderParam.pMtlIns					= nullptr;
+		outRenderParam.pVS						= m_pRenderData->pVS;
+		outRenderParam.PerObjParam.pPerObjectCB	= m_pRenderData->pLocalToWorldCB;
+		outRenderParam.bRenderLine				= m_bIsLine;
+	}
+
 	void SimpleMesh::LoadFromSimpleData(const std::vector<SimpleVertex>& vertices, const std::vector<uint32_t>& indices, const std::string& name)
 	{
 		m_Vertices.assign(vertices.begin(), vertices.end());
@@ -201,7 +209,7 @@ namespace RenderDog
 
 		BufferDesc cbDesc = {};
 		cbDesc.name = m_Name + "_ComVar_ConstantBuffer_PerObject";
-		cbDesc.byteWidth = sizeof(Matrix4x4);
+		cbDesc.byteWidth = sizeof(PerObjectTransformData);
 		cbDesc.isDynamic = false;
 		m_pRenderData->pLocalToWorldCB = (IConstantBuffer*)g_pIBufferManager->GetConstantBuffer(cbDesc);
 	}
@@ -222,13 +230,16 @@ namespace RenderDog
 
 	void SimpleMesh::SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale)
 	{
-		Matrix4x4 transMatrix = GetTranslationMatrix(pos.x, pos.y, pos.z);
-		Matrix4x4 rotMatrix = GetRotationMatrix(euler.x, euler.y, euler.z);
-		Matrix4x4 scaleMatrix = GetScaleMatrix(scale.x, scale.y, scale.z);
+		Matrix3x4 localToWorldMatrix = GetAffineTransform(pos, scale, euler);
 
-		Matrix4x4 localToWorldMatrix = scaleMatrix * rotMatrix * transMatrix;
+		PerObjectTransformData transformData;
+		transformData.localToWorldMatrix = localToWorldMatrix.ToMatrix4x4();
+		transformData.localToWorldNormalMatrix = GetNormalMatrix(localToWorldMatrix).ToMatrix4x4();
 
-		m_pRenderData->pLocalToWorldCB->Update(&localToWorldMatrix, sizeof(Matrix4x4));
+		g_pRenderThread->EnqueueCommand([this, transformData]() mutable
+		{
+			m_pRenderData->pLocalToWorldCB->Update(&transformData, sizeof(PerObjectTransformData));
+		});
 	}
 
 	void SimpleMesh::CloneRenderData(const SimpleMesh& mesh)
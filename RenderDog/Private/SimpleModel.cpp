@@ -7,6 +7,8 @@
 
 #include "SimpleModel.h"
 #include "Scene.h"
+#include "RenderThread.h"
+#include "BatchTransform.h"
 
 namespace RenderDog
 {
@@ -47,14 +49,16 @@ namespace RenderDog
 			for (uint32_t index = 0; index < meshData.postions.size(); ++index)
 			{
 				SimpleVertex vert;
-				Vector4 tempPos = Vector4(meshData.postions[index], 1.0f);
-				tempPos = tempPos * transAxisMatrix;
-				vert.position = Vector3(tempPos.x, tempPos.y, tempPos.z);
 				vert.color = Vector4(meshData.color[index].x, meshData.color[index].y, meshData.color[index].z, meshData.color[index].w);
 
 				vertices.push_back(vert);
 			}
 
+			if (!vertices.empty())
+			{
+				TransformPoints(&vertices[0].position, sizeof(SimpleVertex), &meshData.postions[0], sizeof(Vector3), (uint32_t)vertices.size(), transAxisMatrix);
+			}
+
 			std::string meshName = fileName + "_" + meshData.name;
 			
 			SimpleMesh mesh(meshName);
@@ -74,11 +78,27 @@ namespace RenderDog
 
 	void SimpleModel::RegisterToScene(IScene* pScene)
 	{
-		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+		//ֻȾ̷߳
+		g_pRenderThread->EnqueueCommand([this, pScene]()
 		{
-			IPrimitive* pMesh = &(m_Meshes[i]);
-			pScene->RegisterPrimitive(pMesh);
-		}
+			for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+			{
+				IPrimitive* pMesh = &(m_Meshes[i]);
+				pScene->RegisterPrimitive(pMesh);
+			}
+		});
+	}
+
+	void SimpleModel::UnregisterFromScene(IScene* pScene)
+	{
+		g_pRenderThread->EnqueueCommand([this, pScene]()
+		{
+			for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+			{
+				IPrimitive* pMesh = &(m_Meshes[i]);
+				pScene->UnregisterPrimitive(pMesh);
+			}
+		});
 	}
 
 	void SimpleModel::SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale)
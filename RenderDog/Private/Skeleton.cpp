@@ -36,27 +36,27 @@ namespace RenderDog
 		for (size_t i = 0; i < m_Bones.size(); ++i)
 		{
 			Bone& bone = m_Bones[i];
-			const Matrix4x4& upToParentMatrix = bone.GetUpToParentMatrix();
-			const Matrix4x4& offsetMatrix = bone.GetOffsetMatrix();
+			const Matrix3x4& upToParentMatrix = bone.GetUpToParentMatrix();
+			const Matrix3x4& offsetMatrix = bone.GetOffsetMatrix();
 
 			int parentIndex = bone.GetParentIndex();
 			if (parentIndex == -1)
 			{
-				Matrix4x4 upToRootMatrix = upToParentMatrix * m_LocalMatrix;
+				Matrix3x4 upToRootMatrix = upToParentMatrix * m_LocalMatrix;
 				bone.SetUpdateToRootMatrix(upToRootMatrix);
 
-				bone.SetFinalTransformMatrix(upToRootMatrix);
+				bone.SetFinalTransformMatrix(upToRootMatrix.ToMatrix4x4());
 			}
 			else
 			{
 				const Bone& parentBone = m_Bones[parentIndex];
-				const Matrix4x4& parentToRootMatrix = parentBone.GetUpToRootMatrix();
+				const Matrix3x4& parentToRootMatrix = parentBone.GetUpToRootMatrix();
 
-				Matrix4x4 upToRootMatrix = upToParentMatrix * parentToRootMatrix;
+				Matrix3x4 upToRootMatrix = upToParentMatrix * parentToRootMatrix;
 				bone.SetUpdateToRootMatrix(upToRootMatrix);
 
-				Matrix4x4 finalTranformMatrix = offsetMatrix * upToRootMatrix;
-				bone.SetFinalTransformMatrix(finalTranformMatrix);
+				Matrix3x4 finalTranformMatrix = offsetMatrix * upToRootMatrix;
+				bone.SetFinalTransformMatrix(finalTranformMatrix.ToMatrix4x4());
 			}
 		}
 	}
@@ -71,7 +71,7 @@ namespace RenderDog
 			Bone& bone = m_Bones[i];
 
 			int boneAnimIndex = animClip.GetBoneAnimIndexByName(bone.GetName());
-			Matrix4x4 upToParentMatrix;
+			Matrix3x4 upToParentMatrix;
 			if (boneAnimIndex != -1)
 			{
 				upToParentMatrix = animClip.GetBoneAnimTransform(boneAnimIndex);
@@ -84,15 +84,15 @@ namespace RenderDog
 			int parentIndex = bone.GetParentIndex();
 			if (parentIndex == -1)
 			{
-				Matrix4x4 upToRootMatrix = upToParentMatrix * m_LocalMatrix;
+				Matrix3x4 upToRootMatrix = upToParentMatrix * m_LocalMatrix;
 				bone.SetUpdateToRootMatrix(upToRootMatrix);
 			}
 			else
 			{
 				const Bone& parentBone = m_Bones[parentIndex];
-				const Matrix4x4& parentToRootMatrix = parentBone.GetUpToRootMatrix();
+				const Matrix3x4& parentToRootMatrix = parentBone.GetUpToRootMatrix();
 
-				Matrix4x4 upToRootMatrix = upToParentMatrix * parentToRootMatrix;
+				Matrix3x4 upToRootMatrix = upToParentMatrix * parentToRootMatrix;
 				bone.SetUpdateToRootMatrix(upToRootMatrix);
 			}
 		}
@@ -101,11 +101,11 @@ namespace RenderDog
 		{
 			Bone& bone = m_Bones[i];
 			
-			const Matrix4x4& offsetMatrix = bone.GetOffsetMatrix();
-			Matrix4x4 upToRootMatrix = bone.GetUpToRootMatrix();
+			const Matrix3x4& offsetMatrix = bone.GetOffsetMatrix();
+			const Matrix3x4& upToRootMatrix = bone.GetUpToRootMatrix();
 
-			Matrix4x4 finalTranformMatrix = offsetMatrix * upToRootMatrix;
-			bone.SetFinalTransformMatrix(finalTranformMatrix);
+			Matrix3x4 finalTranformMatrix = offsetMatrix * upToRootMatrix;
+			bone.SetFinalTransformMatrix(finalTranformMatrix.ToMatrix4x4());
 		}
 	}
 
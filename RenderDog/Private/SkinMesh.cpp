@@ -10,11 +10,14 @@
 #include "Transform.h"
 #include "Utility.h"
 #include "Material.h"
+#include "RenderThread.h"
 
 #include <unordered_map>
 
 namespace RenderDog
 {
+	ObjectPool<SkinMeshRenderData>	SkinMeshRenderData::s_Pool;
+
 	struct VertexKey
 	{
 		Vector3		pos;
@@ -52,19 +55,35 @@ namespace RenderDog
 		m_Name(""),
 		m_Vertices(0),
 		m_Indices(0),
+		m_LODs(0),
+		m_CurrLOD(0),
 		m_pRenderData(nullptr),
 		m_pMtlIns(nullptr),
-		m_AABB()
+		m_AABB(),
+		m_GameAABB(),
+		m_pBoundsListener(nullptr),
+		m_PrimitiveId(0),
+		m_TransformId(g_pTransformSystem->CreateTransform(this))
 	{}
 
 	SkinMesh::SkinMesh(const SkinMesh& mesh) :
 		m_Name(mesh.m_Name),
 		m_Vertices(mesh.m_Vertices),
 		m_Indices(mesh.m_Indices),
+		m_LODs(mesh.m_LODs),
+		m_CurrLOD(mesh.m_CurrLOD),
 		m_pRenderData(nullptr),
 		m_pMtlIns(nullptr),
-		m_AABB(mesh.m_AABB)
+		m_AABB(mesh.m_AABB),
+		m_GameAABB(mesh.m_GameAABB),
+		m_pBoundsListener(nullptr),
+		m_PrimitiveId(0),
+		m_TransformId(g_pTransformSystem->CreateTransform(this))
 	{
+		//Ƴһµĸڵ
+		g_pTransformSystem->SetLocalTransform(m_TransformId, g_pTransformSystem->GetLocalTransform(mesh.m_TransformId));
+		g_pTransformSystem->SetLocalBounds(m_TransformId, g_pTransformSystem->GetLocalBounds(mesh.m_TransformId));
+
 		CloneRenderData(mesh);
 	}
 
@@ -72,13 +91,21 @@ namespace RenderDog
 		m_Name(name),
 		m_Vertices(0),
 		m_Indices(0),
+		m_LODs(0),
+		m_CurrLOD(0),
 		m_pRenderData(nullptr),
 		m_pMtlIns(nullptr),
-		m_AABB()
+		m_AABB(),
+		m_GameAABB(),
+		m_pBoundsListener(nullptr),
+		m_PrimitiveId(0),
+		m_TransformId(g_pTransformSystem->CreateTransform(this))
 	{}
 
 	SkinMesh::~SkinMesh()
 	{
+		g_pTransformSystem->DestroyTransform(m_TransformId);
+
 		ReleaseRenderData();
 
 		m_Vertices.clear();
@@ -95,7 +122,13 @@ namespace RenderDog
 		m_Name = mesh.m_Name;
 		m_Vertices = mesh.m_Vertices;
 		m_Indices = mesh.m_Indices;
+		m_LODs = mesh.m_LODs;
+		m_CurrLOD = mesh.m_CurrLOD;
 		m_AABB = mesh.m_AABB;
+		m_GameAABB = mesh.m_GameAABB;
+
+		g_pTransformSystem->SetLocalTransform(m_TransformId, g_pTransformSystem->GetLocalTransform(mesh.m_TransformId));
+		g_pTransformSystem->SetLocalBounds(m_TransformId, g_pTransformSystem->GetLocalBounds(mesh.m_TransformId));
 
 		ReleaseRenderData();
 
@@ -107,17 +140,22 @@ namespace RenderDog
 	void SkinMesh::Render(IPrimitiveRenderer* pPrimitiveRenderer)
 	{
 		PrimitiveRenderParam renderParam = {};
-		renderParam.pVB								= m_pRenderData->pVB;
-		renderParam.pIB								= m_pRenderData->pIB;
-		renderParam.pMtlIns							= m_pMtlIns;
-		renderParam.pVS								= m_pRenderData->pVS;
-		renderParam.pShadowVS						= m_pRenderData->pShadowVS;
-		renderParam.PerObjParam.pPerObjectCB		= m_pRenderData->pLocalToWorldCB;
-		renderParam.PerObjParam.pBoneTransformCB	= m_pRenderData->pBoneTransformCB;
+		GetRenderParam(renderParam);
 
 		pPrimitiveRenderer->Render(renderParam);
 	}
 
+	void SkinMesh::GetRenderParam(PrimitiveRenderParam& outRenderParam) const
+	{
+		outRenderParam.pVB							= m_CurrLOD > 0 ? m_pRenderData->lodVBs[m_CurrLOD - 1] : m_pRenderData->pVB;
+		outRenderParam.pIB							= m_CurrLOD > 0 ? m_pRenderData->lodIBs[m_CurrLOD - 1] : m_pRenderData->pIB;
+		outRenderParam.pMtlIns						= m_pMtlIns;
+		outRenderParam.pVS							= m_pRenderData->pVS;
+		outRenderParam.pShadowVS					= m_pRenderData->pShadowVS;
+		outRenderParam.PerObjParam.pPerObjectCB		= m_pRenderData->pLocalToWorldCB;
+		outRenderParam.PerObjParam.pBoneTransformCB	= m_pRenderData->pBoneTransformCB;
+	}
+
 	void SkinMesh::LoadFromSkinData(const std::vector<SkinVertex>& vertices, const std::vector<uint32_t>& indices, const std::string& name)
 	{
 		m_Vertices.assign(vertices.begin(), vertices.end());
@@ -174,6 +212,22 @@ namespace RenderDog
 		ibDesc.isDynamic = false;
 		m_pRenderData->pIB = (IIndexBuffer*)g_pIBufferManager->GetIndexBuffer(ibDesc);
 
+		for (uint32_t i = 0; i < m_LODs.size(); ++i)
+		{
+			MeshLODData<SkinVertex>& lodData = m_LODs[i];
+			std::string lodName = m_Name + "_Skin_LOD" + std::to_string(i + 1);
+
+			vbDesc.name = lodName + "_VertexBuffer";
+			vbDesc.byteWidth = sizeof(SkinVertex) * (uint32_t)lodData.vertices.size();
+			vbDesc.pInitData = &(lodData.vertices[0]);
+			m_pRenderData->lodVBs.push_back((IVertexBuffer*)g_pIBufferManager->GetVertexBuffer(vbDesc));
+
+			ibDesc.name = lodName + "_IndexBuffer";
+			ibDesc.byteWidth = sizeof(uint32_t) * (uint32_t)lodData.indices.size();
+			ibDesc.pInitData = &(lodData.indices[0]);
+			m_pRenderData->lodIBs.push_back((IIndexBuffer*)g_pIBufferManager->GetIndexBuffer(ibDesc));
+		}
+
 		ShaderCompileDesc vsDesc(g_SkinModelVertexShaderFilePath, nullptr, "Main", "vs_5_0", 0);
 		m_pRenderData->pVS = g_pIShaderManager->GetModelVertexShader(VERTEX_TYPE::SKIN, vsDesc);
 
@@ -182,7 +236,7 @@ namespace RenderDog
 
 		BufferDesc cbDesc = {};
 		cbDesc.name = m_Name + "_ComVar_ConstantBuffer_PerObject";
-		cbDesc.byteWidth = sizeof(Matrix4x4);
+		cbDesc.byteWidth = sizeof(PerObjectTransformData);
 		cbDesc.isDynamic = true;
 		m_pRenderData->pLocalToWorldCB = (IConstantBuffer*)g_pIBufferManager->GetConstantBuffer(cbDesc);
 
@@ -195,15 +249,33 @@ namespace RenderDog
 
 	void SkinMesh::SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale)
 	{
-		Matrix4x4 transMat = GetTranslationMatrix(pos.x, pos.y, pos.z);
-		Matrix4x4 rotMat = GetRotationMatrix(euler.x, euler.y, euler.z);
-		Matrix4x4 scaleMat = GetScaleMatrix(scale.x, scale.y, scale.z);
+		g_pTransformSystem->SetLocalTransform(m_TransformId, GetAffineTransform(pos, scale, euler));
+	}
+
+	void SkinMesh::OnTransformUpdated(uint32_t transformId, const Matrix3x4& localToWorld, const AABB& worldAABB)
+	{
+		//ΧʹðƵľֲΧУ֮ǰ任жĽһ
+		m_GameAABB = worldAABB;
 
-		Matrix4x4 localToWorldMatrix = scaleMat * rotMat * transMat;
+		PerObjectTransformData transformData;
+		transformData.localToWorldMatrix = localToWorld.ToMatrix4x4();
+		transformData.localToWorldNormalMatrix = GetNormalMatrix(localToWorld).ToMatrix4x4();
 
-		UpdateAABB(localToWorldMatrix);
+		//Ⱦ߳ʹõİΧͨ
+		AABB aabb = m_GameAABB;
+		g_pRenderThread->EnqueueCommand([this, transformData, aabb]() mutable
+		{
+			m_AABB = aabb;
+			if (m_pBoundsListener)
+			{
+				m_pBoundsListener->OnPrimitiveBoundsChanged(m_PrimitiveId);
+			}
 
-		m_pRenderData->pLocalToWorldCB->Update(&localToWorldMatrix, sizeof(Matrix4x4));
+			if (m_pRenderData)
+			{
+				m_pRenderData->pLocalToWorldCB->Update(&transformData, sizeof(PerObjectTransformData));
+			}
+		});
 	}
 
 	void SkinMesh::CalcTangentsAndGenIndices(std::vector<SkinVertex>& rawVertices, const std::vector<uint32_t>& smoothGroup)
@@ -399,6 +471,26 @@ namespace RenderDog
 			m_AABB.maxPoint.y = m_AABB.maxPoint.y > pos.y ? m_AABB.maxPoint.y : pos.y;
 			m_AABB.maxPoint.z = m_AABB.maxPoint.z > pos.z ? m_AABB.maxPoint.z : pos.z;
 		}
+
+		m_GameAABB = m_AABB;
+
+		g_pTransformSystem->SetLocalBounds(m_TransformId, m_AABB);
+	}
+
+	void SkinMesh::GenerateLODs()
+	{
+		GenerateMeshLODs(m_Vertices, m_Indices, m_LODs);
+		m_CurrLOD = 0;
+	}
+
+	void SkinMesh::SetLODScreenSize(uint32_t lod, float screenSize)
+	{
+		if (lod == 0 || lod > m_LODs.size())
+		{
+			return;
+		}
+
+		m_LODs[lod - 1].screenSize = screenSize;
 	}
 
 	void SkinMesh::Update(SkinModelPerObjectTransform& perModelTransform)
@@ -427,6 +519,11 @@ namespace RenderDog
 		{
 			m_pRenderData->pVB->Release();
 			m_pRenderData->pIB->Release();
+			for (uint32_t i = 0; i < m_pRenderData->lodVBs.size(); ++i)
+			{
+				m_pRenderData->lodVBs[i]->Release();
+				m_pRenderData->lodIBs[i]->Release();
+			}
 			m_pRenderData->pVS->Release();
 			m_pRenderData->pShadowVS->Release();
 			m_pRenderData->pLocalToWorldCB->Release();
@@ -443,22 +540,4 @@ namespace RenderDog
 		}
 	}
 
-	void SkinMesh::UpdateAABB(const Matrix4x4& absTransMatrix)
-	{
-		m_AABB.Reset();
-		for (uint32_t i = 0; i < m_Vertices.size(); ++i)
-		{
-			Vector4 pos = Vector4(m_Vertices[i].position, 1.0f);
-			pos = pos * absTransMatrix;
-
-			m_AABB.minPoint.x = m_AABB.minPoint.x < pos.x ? m_AABB.minPoint.x : pos.x;
-			m_AABB.minPoint.y = m_AABB.minPoint.y < pos.y ? m_AABB.minPoint.y : pos.y;
-			m_AABB.minPoint.z = m_AABB.minPoint.z < pos.z ? m_AABB.minPoint.z : pos.z;
-
-			m_AABB.maxPoint.x = m_AABB.maxPoint.x > pos.x ? m_AABB.maxPoint.x : pos.x;
-			m_AABB.maxPoint.y = m_AABB.maxPoint.y > pos.y ? m_AABB.maxPoint.y : pos.y;
-			m_AABB.maxPoint.z = m_AABB.maxPoint.z > pos.z ? m_AABB.maxPoint.z : pos.z;
-		}
-	}
-
 }// namespace RenderDog
\ No newline at end of file
@@ -8,10 +8,13 @@
 #include "Scene.h"
 #include "Matrix.h"
 #include "Transform.h"
+#include "BatchTransform.h"
 #include "Skeleton.h"
 #include "Bone.h"
 #include "Shader.h"
 #include "Material.h"
+#include "Profiler.h"
+#include "RenderThread.h"
 
 namespace RenderDog
 {
@@ -20,6 +23,7 @@ namespace RenderDog
 		m_Directory(),
 		m_Meshes(0),
 		m_pSkeleton(nullptr),
+		m_LocalAABB(),
 		m_AABB(),
 		m_BoundingSphere()
 	{}
@@ -38,6 +42,8 @@ namespace RenderDog
 	bool SkinModel::LoadFromRawMeshData(const std::vector<RDFbxImporter::RawMeshData>& rawMeshDatas, const RDFbxImporter::RawSkeletonData* pSkeletonData, 
 										const std::string& fileName)
 	{
+		RD_PROFILE_SCOPE("SkinModel::LoadFromRawMeshData");
+
 		for (uint32_t i = 0; i < rawMeshDatas.size(); ++i)
 		{
 			const RDFbxImporter::RawMeshData& meshData = rawMeshDatas[i];
@@ -81,6 +87,7 @@ namespace RenderDog
 		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
 		{
 			SkinMesh& mesh = m_Meshes[i];
+			mesh.GenerateLODs();
 			mesh.InitRenderData();
 		}
 
@@ -106,6 +113,8 @@ namespace RenderDog
 
 	bool SkinModel::LoadBoneAnimation(const RDFbxImporter::RawAnimation& rawAnimation)
 	{
+		RD_PROFILE_SCOPE("SkinModel::LoadBoneAnimation");
+
 		std::vector<BoneAnimation> boneAnimations;
 		boneAnimations.resize(rawAnimation.boneAnimations.size());
 		std::unordered_map<std::string, size_t> boneAnimIndexMap;
@@ -175,16 +184,33 @@ namespace RenderDog
 
 	void SkinModel::RegisterToScene(IScene* pScene)
 	{
-		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+		//ֻȾ̷߳ʣΧ򿽱һݱϷ֮߳޸
+		BoundingSphere boundingSphere = m_BoundingSphere;
+		g_pRenderThread->EnqueueCommand([this, pScene, boundingSphere]()
 		{
-			IPrimitive* pMesh = &(m_Meshes[i]);
-			pScene->RegisterPrimitive(pMesh);
-		}
+			for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+			{
+				IPrimitive* pMesh = &(m_Meshes[i]);
+				pScene->RegisterPrimitive(pMesh);
+			}
+
+			//עģʱҪ³İΧĬϳĵռԭ
+			BoundingSphere& sceneBoundingSphere = pScene->GetBoundingSphere();
+			float modelMaxDisToSceneCenter = boundingSphere.center.Length() + boundingSphere.radius;
+			sceneBoundingSphere.radius = sceneBoundingSphere.radius > modelMaxDisToSceneCenter ? sceneBoundingSphere.radius : modelMaxDisToSceneCenter;
+		});
+	}
 
-		//עģʱҪ³İΧĬϳĵռԭ
-		BoundingSphere& sceneBoundingSphere = pScene->GetBoundingSphere();
-		float modelMaxDisToSceneCenter = m_BoundingSphere.center.Length() + m_BoundingSphere.radius;
-		sceneBoundingSphere.radius = sceneBoundingSphere.radius > modelMaxDisToSceneCenter ? sceneBoundingSphere.radius : modelMaxDisToSceneCenter;
+	void SkinModel::UnregisterFromScene(IScene* pScene)
+	{
+		g_pRenderThread->EnqueueCommand([this, pScene]()
+		{
+			for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+			{
+				IPrimitive* pMesh = &(m_Meshes[i]);
+				pScene->UnregisterPrimitive(pMesh);
+			}
+		});
 	}
 
 	void SkinModel::SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale)
@@ -199,11 +225,13 @@ namespace RenderDog
 			pMesh->SetPosGesture(pos, euler, scale);
 		}
 
-		UpdateBoundings();
+		UpdateBoundings(GetAffineTransform(pos, scale, euler));
 	}
 
 	void SkinModel::Tick(float deltaTime)
 	{
+		RD_PROFILE_SCOPE("SkinModel::Tick");
+
 		SkinModelPerObjectTransform perModelTransform;
 		
 		if (m_pSkeleton->GetBoneNum() > g_MaxBoneNum)
@@ -227,10 +255,14 @@ namespace RenderDog
 			perModelTransform.BoneFinalTransformMatrix[i] = m_pSkeleton->GetBone(i).GetFinalTransformMatrix();
 		}
 
-		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+		//󿽱УȾ̻߳һ֡ʱϷ߳̿Լһ֡Ķ
+		g_pRenderThread->EnqueueCommand([this, perModelTransform]() mutable
 		{
-			m_Meshes[i].Update(perModelTransform);
-		}
+			for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+			{
+				m_Meshes[i].Update(perModelTransform);
+			}
+		});
 	}
 
 	void SkinModel::CalculateBoundings()
@@ -240,7 +272,7 @@ namespace RenderDog
 		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
 		{
 			m_Meshes[i].CalculateAABB();
-			const AABB& meshAABB = m_Meshes[i].GetAABB();
+			const AABB& meshAABB = m_Meshes[i].GetGameAABB();
 
 			m_AABB.minPoint.x = m_AABB.minPoint.x < meshAABB.minPoint.x ? m_AABB.minPoint.x : meshAABB.minPoint.x;
 			m_AABB.minPoint.y = m_AABB.minPoint.y < meshAABB.minPoint.y ? m_AABB.minPoint.y : meshAABB.minPoint.y;
@@ -251,29 +283,23 @@ namespace RenderDog
 			m_AABB.maxPoint.z = m_AABB.maxPoint.z > meshAABB.maxPoint.z ? m_AABB.maxPoint.z : meshAABB.maxPoint.z;
 		}
 
+		m_LocalAABB = m_AABB;
+
 		m_BoundingSphere.center = (m_AABB.minPoint + m_AABB.maxPoint) * 0.5f;
 		m_BoundingSphere.radius = (m_AABB.maxPoint - m_AABB.minPoint).Length() * 0.5f;
 	}
 	
-	void SkinModel::UpdateBoundings()
+	void SkinModel::UpdateBoundings(const Matrix3x4& localToWorld)
 	{
-		m_AABB.Reset();
+		//ΧҪȵTransformSystem::UpdateŸ£ֱӱ任ģ͵ľֲΧ
+		TransformAABBs(&m_AABB, &m_LocalAABB, 1, localToWorld);
+
 		m_BoundingSphere.Reset();
-		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+		if (m_AABB.IsValid())
 		{
-			const AABB& meshAABB = m_Meshes[i].GetAABB();
-
-			m_AABB.minPoint.x = m_AABB.minPoint.x < meshAABB.minPoint.x ? m_AABB.minPoint.x : meshAABB.minPoint.x;
-			m_AABB.minPoint.y = m_AABB.minPoint.y < meshAABB.minPoint.y ? m_AABB.minPoint.y : meshAABB.minPoint.y;
-			m_AABB.minPoint.z = m_AABB.minPoint.z < meshAABB.minPoint.z ? m_AABB.minPoint.z : meshAABB.minPoint.z;
-
-			m_AABB.maxPoint.x = m_AABB.maxPoint.x > meshAABB.maxPoint.x ? m_AABB.maxPoint.x : meshAABB.maxPoint.x;
-			m_AABB.maxPoint.y = m_AABB.maxPoint.y > meshAABB.maxPoint.y ? m_AABB.maxPoint.y : meshAABB.maxPoint.y;
-			m_AABB.maxPoint.z = m_AABB.maxPoint.z > meshAABB.maxPoint.z ? m_AABB.maxPoint.z : meshAABB.maxPoint.z;
+			m_BoundingSphere.center = (m_AABB.minPoint + m_AABB.maxPoint) * 0.5f;
+			m_BoundingSphere.radius = (m_AABB.maxPoint - m_AABB.minPoint).Length() * 0.5f;
 		}
-
-		m_BoundingSphere.center = (m_AABB.minPoint + m_AABB.maxPoint) * 0.5f;
-		m_BoundingSphere.radius = (m_AABB.maxPoint - m_AABB.minPoint).Length() * 0.5f;
 	}
 
 }// namespace RenderDog
\ No newline at end of file
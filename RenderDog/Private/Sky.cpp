@@ -6,6 +6,7 @@
 
 #include "Sky.h"
 #include "Scene.h"
+#include "RenderThread.h"
 #include "GeometryGenerator.h"
 #include "Material.h"
 
@@ -54,7 +55,11 @@ namespace RenderDog
 
 	void SkyBox::RegisterToScene(IScene* pScene)
 	{
-		pScene->RegisterSkyBox(this);
+		//ֻȾ̷߳
+		g_pRenderThread->EnqueueCommand([this, pScene]()
+		{
+			pScene->RegisterSkyBox(this);
+		});
 	}
 
 	ITexture2D* SkyBox::GetCubeTexture()
@@ -9,6 +9,8 @@
 #include "Transform.h"
 #include "Utility.h"
 #include "Material.h"
+#include "OcclusionCulling.h"
+#include "RenderThread.h"
 
 #include <unordered_map>
 #include <fstream>
@@ -17,6 +19,8 @@
 
 namespace RenderDog
 {
+	ObjectPool<StaticMeshRenderData>	StaticMeshRenderData::s_Pool;
+
 	struct VertexKey
 	{
 		Vector3		pos;
@@ -54,19 +58,43 @@ namespace RenderDog
 		m_Name(""),
 		m_Vertices(0),
 		m_Indices(0),
+		m_LODs(0),
+		m_CurrLOD(0),
 		m_pRenderData(nullptr),
 		m_pMtlIns(nullptr),
-		m_AABB()
-	{}
+		m_AABB(),
+		m_GameAABB(),
+		m_pBoundsListener(nullptr),
+		m_PrimitiveId(0),
+		m_TransformId(g_pTransformSystem->CreateTransform(this)),
+		m_bOccluder(false),
+		m_LocalToWorldMatrix(),
+		m_pTriangleBVH(nullptr)
+	{
+		m_LocalToWorldMatrix.Identity();
+	}
 
 	StaticMesh::StaticMesh(const StaticMesh& mesh) :
 		m_Name(mesh.m_Name),
 		m_Vertices(mesh.m_Vertices),
 		m_Indices(mesh.m_Indices),
+		m_LODs(mesh.m_LODs),
+		m_CurrLOD(mesh.m_CurrLOD),
 		m_pRenderData(nullptr),
 		m_pMtlIns(nullptr),
-		m_AABB(mesh.m_AABB)
+		m_AABB(mesh.m_AABB),
+		m_GameAABB(mesh.m_GameAABB),
+		m_pBoundsListener(nullptr),
+		m_PrimitiveId(0),
+		m_TransformId(g_pTransformSystem->CreateTransform(this)),
+		m_bOccluder(mesh.m_bOccluder),
+		m_LocalToWorldMatrix(mesh.m_LocalToWorldMatrix),
+		m_pTriangleBVH(nullptr)
 	{
+		//Ƴһµĸڵ
+		g_pTransformSystem->SetLocalTransform(m_TransformId, g_pTransformSystem->GetLocalTransform(mesh.m_TransformId));
+		g_pTransformSystem->SetLocalBounds(m_TransformId, g_pTransformSystem->GetLocalBounds(mesh.m_TransformId));
+
 		CloneRenderData(mesh);
 	}
 
@@ -74,14 +102,28 @@ namespace RenderDog
 		m_Name(name),
 		m_Vertices(0),
 		m_Indices(0),
+		m_LODs(0),
+		m_CurrLOD(0),
 		m_pRenderData(nullptr),
 		m_pMtlIns(nullptr),
-		m_AABB()
-	{}
+		m_AABB(),
+		m_GameAABB(),
+		m_pBoundsListener(nullptr),
+		m_PrimitiveId(0),
+		m_TransformId(g_pTransformSystem->CreateTransform(this)),
+		m_bOccluder(false),
+		m_LocalToWorldMatrix(),
+		m_pTriangleBVH(nullptr)
+	{
+		m_LocalToWorldMatrix.Identity();
+	}
 
 	StaticMesh::~StaticMesh()
 	{
+		g_pTransformSystem->DestroyTransform(m_TransformId);
+
 		ReleaseRenderData();
+		ReleaseTriangleBVH();
 
 		m_Vertices.clear();
 		m_Indices.clear();
@@ -97,9 +139,18 @@ namespace RenderDog
 		m_Name					= mesh.m_Name;
 		m_Vertices				= mesh.m_Vertices;
 		m_Indices				= mesh.m_Indices;
+		m_LODs					= mesh.m_LODs;
+		m_CurrLOD				= mesh.m_CurrLOD;
 		m_AABB					= mesh.m_AABB;
+		m_GameAABB				= mesh.m_GameAABB;
+		m_bOccluder				= mesh.m_bOccluder;
+		m_LocalToWorldMatrix	= mesh.m_LocalToWorldMatrix;
+
+		g_pTransformSystem->SetLocalTransform(m_TransformId, g_pTransformSystem->GetLocalTransform(mesh.m_TransformId));
+		g_pTransformSystem->SetLocalBounds(m_TransformId, g_pTransformSystem->GetLocalBounds(mesh.m_TransformId));
 
 		ReleaseRenderData();
+		ReleaseTriangleBVH();
 
 		CloneRenderData(mesh);
 
@@ -109,16 +160,21 @@ namespace RenderDog
 	void StaticMesh::Render(IPrimitiveRenderer* pPrimitiveRenderer)
 	{
 		PrimitiveRenderParam renderParam = {};
-		renderParam.pVB							= m_pRenderData->pVB;
-		renderParam.pIB							= m_pRenderData->pIB;
-		renderParam.pMtlIns						= m_pMtlIns;
-		renderParam.pVS							= m_pRenderData->pVS;
-		renderParam.pShadowVS					= m_pRenderData->pShadowVS;
-		renderParam.PerObjParam.pPerObjectCB	= m_pRenderData->pLocalToWorldCB;
+		GetRenderParam(renderParam);
 
 		pPrimitiveRenderer->Render(renderParam);
 	}
 
+	void StaticMesh::GetRenderParam(PrimitiveRenderParam& outRenderParam) const
+	{
+		outRenderParam.pVB						= m_CurrLOD > 0 ? m_pRenderData->lodVBs[m_CurrLOD - 1] : m_pRenderData->pVB;
+		outRenderParam.pIB						= m_CurrLOD > 0 ? m_pRenderData->lodIBs[m_CurrLOD - 1] : m_pRenderData->pIB;
+		outRenderParam.pMtlIns					= m_pMtlIns;
+		outRenderParam.pVS						= m_pRenderData->pVS;
+		outRenderParam.pShadowVS				= m_pRenderData->pShadowVS;
+		outRenderParam.PerObjParam.pPerObjectCB	= m_pRenderData->pLocalToWorldCB;
+	}
+
 	void StaticMesh::LoadFromStandardData(const std::vector<StandardVertex>& vertices, const std::vector<uint32_t>& indices, const std::string& name)
 	{
 		m_Vertices.assign(vertices.begin(), vertices.end());
@@ -126,6 +182,8 @@ namespace RenderDog
 		m_Indices.assign(indices.begin(), indices.end());
 
 		m_Name = name;
+
+		ReleaseTriangleBVH();
 	}
 
 	bool StaticMesh::CreateMaterialInstance(IMaterial* pMtl, const std::vector<MaterialParam>* pMtlParams)
@@ -175,6 +233,22 @@ namespace RenderDog
 		ibDesc.isDynamic = false;
 		m_pRenderData->pIB = (IIndexBuffer*)g_pIBufferManager->GetIndexBuffer(ibDesc);
 
+		for (uint32_t i = 0; i < m_LODs.size(); ++i)
+		{
+			MeshLODData<StandardVertex>& lodData = m_LODs[i];
+			std::string lodName = m_Name + "_Static_LOD" + std::to_string(i + 1);
+
+			vbDesc.name = lodName + "_VertexBuffer";
+			vbDesc.byteWidth = sizeof(StandardVertex) * (uint32_t)lodData.vertices.size();
+			vbDesc.pInitData = &(lodData.vertices[0]);
+			m_pRenderData->lodVBs.push_back((IVertexBuffer*)g_pIBufferManager->GetVertexBuffer(vbDesc));
+
+			ibDesc.name = lodName + "_IndexBuffer";
+			ibDesc.byteWidth = sizeof(uint32_t) * (uint32_t)lodData.indices.size();
+			ibDesc.pInitData = &(lodData.indices[0]);
+			m_pRenderData->lodIBs.push_back((IIndexBuffer*)g_pIBufferManager->GetIndexBuffer(ibDesc));
+		}
+
 		ShaderCompileDesc vsDesc(g_StaticModelVertexShaderFilePath, nullptr, "Main", "vs_5_0", 0);
 		m_pRenderData->pVS = g_pIShaderManager->GetModelVertexShader(VERTEX_TYPE::STANDARD, vsDesc);
 
@@ -183,7 +257,7 @@ namespace RenderDog
 
 		BufferDesc cbDesc = {};
 		cbDesc.name = m_Name + "_ComVar_ConstantBuffer_PerObject";
-		cbDesc.byteWidth = sizeof(Matrix4x4);
+		cbDesc.byteWidth = sizeof(PerObjectTransformData);
 		cbDesc.isDynamic = false;
 		m_pRenderData->pLocalToWorldCB = (IConstantBuffer*)g_pIBufferManager->GetConstantBuffer(cbDesc);
 	}
@@ -194,6 +268,11 @@ namespace RenderDog
 		{
 			m_pRenderData->pVB->Release();
 			m_pRenderData->pIB->Release();
+			for (uint32_t i = 0; i < m_pRenderData->lodVBs.size(); ++i)
+			{
+				m_pRenderData->lodVBs[i]->Release();
+				m_pRenderData->lodIBs[i]->Release();
+			}
 			m_pRenderData->pVS->Release();
 			m_pRenderData->pShadowVS->Release();
 			m_pRenderData->pLocalToWorldCB->Release();
@@ -211,19 +290,88 @@ namespace RenderDog
 
 	void StaticMesh::SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale)
 	{
-		Matrix4x4 transMatrix = GetTranslationMatrix(pos.x, pos.y, pos.z);
-		Matrix4x4 rotMatrix = GetRotationMatrix(euler.x, euler.y, euler.z);
-		Matrix4x4 scaleMatrix = GetScaleMatrix(scale.x, scale.y, scale.z);
+		g_pTransformSystem->SetLocalTransform(m_TransformId, GetAffineTransform(pos, scale, euler));
+	}
 
-		Matrix4x4 localToWorldMatrix = scaleMatrix * rotMatrix * transMatrix;
+	void StaticMesh::OnTransformUpdated(uint32_t transformId, const Matrix3x4& localToWorld, const AABB& worldAABB)
+	{
+		//ռİΧɱ任ϵͳþֲΧֱӱ任õҪ任ж
+		m_GameAABB = worldAABB;
 
-		UpdateAABB(localToWorldMatrix);
+		PerObjectTransformData transformData;
+		transformData.localToWorldMatrix = localToWorld.ToMatrix4x4();
+		transformData.localToWorldNormalMatrix = GetNormalMatrix(localToWorld).ToMatrix4x4();
 
-		m_pRenderData->pLocalToWorldCB->Update(&localToWorldMatrix, sizeof(Matrix4x4));
+		//Ⱦ߳ʹõı任ͰΧͨ
+		AABB aabb = m_GameAABB;
+		g_pRenderThread->EnqueueCommand([this, transformData, aabb]() mutable
+		{
+			m_LocalToWorldMatrix = transformData.localToWorldMatrix;
+
+			m_AABB = aabb;
+			if (m_pBoundsListener)
+			{
+				m_pBoundsListener->OnPrimitiveBoundsChanged(m_PrimitiveId);
+			}
+
+			if (m_pRenderData)
+			{
+				m_pRenderData->pLocalToWorldCB->Update(&transformData, sizeof(PerObjectTransformData));
+			}
+		});
+	}
+
+	bool StaticMesh::GetOccluderData(OccluderData& outData) const
+	{
+		if (!m_bOccluder || m_Vertices.empty() || m_Indices.empty())
+		{
+			return false;
+		}
+
+		outData.pPositions			= &m_Vertices[0].position;
+		outData.positionStride		= sizeof(StandardVertex);
+		outData.vertNum				= (uint32_t)m_Vertices.size();
+		outData.pIndices			= &m_Indices[0];
+		outData.indexNum			= (uint32_t)m_Indices.size();
+		outData.localToWorldMatrix	= m_LocalToWorldMatrix;
+
+		return true;
+	}
+
+	bool StaticMesh::GetRaycastData(RaycastData& outData) const
+	{
+		if (m_Vertices.empty() || m_Indices.empty())
+		{
+			return false;
+		}
+
+		//߳ͬʱһβѯʱԹֻɵһ
+		TriangleBVH* pTriangleBVH = m_pTriangleBVH.load(std::memory_order_acquire);
+		if (!pTriangleBVH)
+		{
+			TriangleBVH* pNewBVH = new TriangleBVH();
+			pNewBVH->Build(&m_Vertices[0].position, sizeof(StandardVertex), (uint32_t)m_Vertices.size(), &m_Indices[0], (uint32_t)m_Indices.size());
+
+			if (m_pTriangleBVH.compare_exchange_strong(pTriangleBVH, pNewBVH, std::memory_order_acq_rel))
+			{
+				pTriangleBVH = pNewBVH;
+			}
+			else
+			{
+				delete pNewBVH;
+			}
+		}
+
+		outData.pTriangleBVH		= pTriangleBVH;
+		outData.localToWorldMatrix	= Matrix3x4(m_LocalToWorldMatrix);
+
+		return true;
 	}
 
 	void StaticMesh::CalcTangentsAndGenIndices(std::vector<StandardVertex>& rawVertices, const std::vector<uint32_t>& smoothGroup)
 	{
+		ReleaseTriangleBVH();
+
 		//1. μTBN
 		for (uint32_t i = 0; i < rawVertices.size(); i += 3)
 		{
@@ -414,6 +562,26 @@ namespace RenderDog
 			m_AABB.maxPoint.y = m_AABB.maxPoint.y > pos.y ? m_AABB.maxPoint.y : pos.y;
 			m_AABB.maxPoint.z = m_AABB.maxPoint.z > pos.z ? m_AABB.maxPoint.z : pos.z;
 		}
+
+		m_GameAABB = m_AABB;
+
+		g_pTransformSystem->SetLocalBounds(m_TransformId, m_AABB);
+	}
+
+	void StaticMesh::GenerateLODs()
+	{
+		GenerateMeshLODs(m_Vertices, m_Indices, m_LODs);
+		m_CurrLOD = 0;
+	}
+
+	void StaticMesh::SetLODScreenSize(uint32_t lod, float screenSize)
+	{
+		if (lod == 0 || lod > m_LODs.size())
+		{
+			return;
+		}
+
+		m_LODs[lod - 1].screenSize = screenSize;
 	}
 
 	void StaticMesh::CloneRenderData(const StaticMesh& mesh)
@@ -442,22 +610,12 @@ namespace RenderDog
 		}
 	}
 
-
-	void StaticMesh::UpdateAABB(const Matrix4x4& absTransMatrix)
+	void StaticMesh::ReleaseTriangleBVH()
 	{
-		m_AABB.Reset();
-		for (uint32_t i = 0; i < m_Vertices.size(); ++i)
+		TriangleBVH* pTriangleBVH = m_pTriangleBVH.exchange(nullptr);
+		if (pTriangleBVH)
 		{
-			Vector4 pos = Vector4(m_Vertices[i].position, 1.0f);
-			pos = pos * absTransMatrix;
-
-			m_AABB.minPoint.x = m_AABB.minPoint.x < pos.x ? m_AABB.minPoint.x : pos.x;
-			m_AABB.minPoint.y = m_AABB.minPoint.y < pos.y ? m_AABB.minPoint.y : pos.y;
-			m_AABB.minPoint.z = m_AABB.minPoint.z < pos.z ? m_AABB.minPoint.z : pos.z;
-
-			m_AABB.maxPoint.x = m_AABB.maxPoint.x > pos.x ? m_AABB.maxPoint.x : pos.x;
-			m_AABB.maxPoint.y = m_AABB.maxPoint.y > pos.y ? m_AABB.maxPoint.y : pos.y;
-			m_AABB.maxPoint.z = m_AABB.maxPoint.z > pos.z ? m_AABB.maxPoint.z : pos.z;
+			delete pTriangleBVH;
 		}
 	}
 
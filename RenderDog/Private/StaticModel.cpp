@@ -6,6 +6,10 @@
 
 #include "StaticModel.h"
 #include "Scene.h"
+#include "Profiler.h"
+#include "RenderThread.h"
+#include "BatchTransform.h"
+#include "Transform.h"
 
 #include <fstream>
 
@@ -14,6 +18,7 @@ namespace RenderDog
 {
 	StaticModel::StaticModel() :
 		m_Meshes(0),
+		m_LocalAABB(),
 		m_AABB(),
 		m_BoundingSphere(),
 		m_Name(),
@@ -77,6 +82,8 @@ namespace RenderDog
 
 	bool StaticModel::LoadFromRawMeshData(const std::vector<RDFbxImporter::RawMeshData>& rawMeshDatas, const std::string& fileName)
 	{
+		RD_PROFILE_SCOPE("StaticModel::LoadFromRawMeshData");
+
 		for (uint32_t i = 0; i < rawMeshDatas.size(); ++i)
 		{
 			const RDFbxImporter::RawMeshData& meshData = rawMeshDatas[i];
@@ -93,9 +100,6 @@ namespace RenderDog
 			for (uint32_t index = 0; index < meshData.postions.size(); ++index)
 			{
 				StandardVertex vert;
-				Vector4 tempPos = Vector4(meshData.postions[index], 1.0f);
-				tempPos = tempPos * transAxisMatrix;
-				vert.position = Vector3(tempPos.x, tempPos.y, tempPos.z);
 				vert.color = Vector4(meshData.color[index].x, meshData.color[index].y, meshData.color[index].z, meshData.color[index].w);
 				vert.normal = Vector3(0.0f, 0.0f, 0.0f);
 				vert.tangent = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
@@ -104,6 +108,11 @@ namespace RenderDog
 				vertices.push_back(vert);
 			}
 
+			if (!vertices.empty())
+			{
+				TransformPoints(&vertices[0].position, sizeof(StandardVertex), &meshData.postions[0], sizeof(Vector3), (uint32_t)vertices.size(), transAxisMatrix);
+			}
+
 			size_t nameStart = fileName.rfind("/") + 1;
 			size_t nameEnd = fileName.rfind(".");
 			m_Name = fileName.substr(nameStart, nameEnd - nameStart);
@@ -119,6 +128,7 @@ namespace RenderDog
 		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
 		{
 			StaticMesh& mesh = m_Meshes[i];
+			mesh.GenerateLODs();
 			mesh.InitRenderData();
 		}
 
@@ -129,6 +139,18 @@ namespace RenderDog
 		return true;
 	}
 
+	void StaticModel::UnregisterFromScene(IScene* pScene)
+	{
+		g_pRenderThread->EnqueueCommand([this, pScene]()
+		{
+			for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+			{
+				IPrimitive* pMesh = &(m_Meshes[i]);
+				pScene->UnregisterPrimitive(pMesh);
+			}
+		});
+	}
+
 	void StaticModel::SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale)
 	{
 		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
@@ -137,21 +159,34 @@ namespace RenderDog
 			pMesh->SetPosGesture(pos, euler, scale);
 		}
 
-		UpdateBoundings();
+		UpdateBoundings(GetAffineTransform(pos, scale, euler));
 	}
 
-	void StaticModel::RegisterToScene(IScene* pScene)
+	void StaticModel::SetOccluder(bool bOccluder)
 	{
 		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
 		{
-			IPrimitive* pMesh = &(m_Meshes[i]);
-			pScene->RegisterPrimitive(pMesh);
+			m_Meshes[i].SetOccluder(bOccluder);
 		}
+	}
 
-		//עģʱҪ³İΧĬϳĵռԭ
-		BoundingSphere& sceneBoundingSphere = pScene->GetBoundingSphere();
-		float modelMaxDisToSceneCenter = m_BoundingSphere.center.Length() + m_BoundingSphere.radius;
-		sceneBoundingSphere.radius = sceneBoundingSphere.radius > modelMaxDisToSceneCenter ? sceneBoundingSphere.radius : modelMaxDisToSceneCenter;
+	void StaticModel::RegisterToScene(IScene* pScene)
+	{
+		//ֻȾ̷߳ʣΧ򿽱һݱϷ֮߳޸
+		BoundingSphere boundingSphere = m_BoundingSphere;
+		g_pRenderThread->EnqueueCommand([this, pScene, boundingSphere]()
+		{
+			for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+			{
+				IPrimitive* pMesh = &(m_Meshes[i]);
+				pScene->RegisterPrimitive(pMesh);
+			}
+
+			//עģʱҪ³İΧĬϳĵռԭ
+			BoundingSphere& sceneBoundingSphere = pScene->GetBoundingSphere();
+			float modelMaxDisToSceneCenter = boundingSphere.center.Length() + boundingSphere.radius;
+			sceneBoundingSphere.radius = sceneBoundingSphere.radius > modelMaxDisToSceneCenter ? sceneBoundingSphere.radius : modelMaxDisToSceneCenter;
+		});
 	}
 
 	void StaticModel::CalculateBoundings()
@@ -161,7 +196,7 @@ namespace RenderDog
 		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
 		{
 			m_Meshes[i].CalculateAABB();
-			const AABB& meshAABB = m_Meshes[i].GetAABB();
+			const AABB& meshAABB = m_Meshes[i].GetGameAABB();
 
 			m_AABB.minPoint.x = m_AABB.minPoint.x < meshAABB.minPoint.x ? m_AABB.minPoint.x : meshAABB.minPoint.x;
 			m_AABB.minPoint.y = m_AABB.minPoint.y < meshAABB.minPoint.y ? m_AABB.minPoint.y : meshAABB.minPoint.y;
@@ -172,29 +207,23 @@ namespace RenderDog
 			m_AABB.maxPoint.z = m_AABB.maxPoint.z > meshAABB.maxPoint.z ? m_AABB.maxPoint.z : meshAABB.maxPoint.z;
 		}
 
+		m_LocalAABB = m_AABB;
+
 		m_BoundingSphere.center = (m_AABB.minPoint + m_AABB.maxPoint) * 0.5f;
 		m_BoundingSphere.radius = (m_AABB.maxPoint - m_AABB.minPoint).Length() * 0.5f;
 	}
 
-	void StaticModel::UpdateBoundings()
+	void StaticModel::UpdateBoundings(const Matrix3x4& localToWorld)
 	{
-		m_AABB.Reset();
+		//ΧҪȵTransformSystem::UpdateŸ£ֱӱ任ģ͵ľֲΧ
+		TransformAABBs(&m_AABB, &m_LocalAABB, 1, localToWorld);
+
 		m_BoundingSphere.Reset();
-		for (uint32_t i = 0; i < m_Meshes.size(); ++i)
+		if (m_AABB.IsValid())
 		{
-			const AABB& meshAABB = m_Meshes[i].GetAABB();
-
-			m_AABB.minPoint.x = m_AABB.minPoint.x < meshAABB.minPoint.x ? m_AABB.minPoint.x : meshAABB.minPoint.x;
-			m_AABB.minPoint.y = m_AABB.minPoint.y < meshAABB.minPoint.y ? m_AABB.minPoint.y : meshAABB.minPoint.y;
-			m_AABB.minPoint.z = m_AABB.minPoint.z < meshAABB.minPoint.z ? m_AABB.minPoint.z : meshAABB.minPoint.z;
-
-			m_AABB.maxPoint.x = m_AABB.maxPoint.x > meshAABB.maxPoint.x ? m_AABB.maxPoint.x : meshAABB.maxPoint.x;
-			m_AABB.maxPoint.y = m_AABB.maxPoint.y > meshAABB.maxPoint.y ? m_AABB.maxPoint.y : meshAABB.maxPoint.y;
-			m_AABB.maxPoint.z = m_AABB.maxPoint.z > meshAABB.maxPoint.z ? m_AABB.maxPoint.z : meshAABB.maxPoint.z;
+			m_BoundingSphere.center = (m_AABB.minPoint + m_AABB.maxPoint) * 0.5f;
+			m_BoundingSphere.radius = (m_AABB.maxPoint - m_AABB.minPoint).Length() * 0.5f;
 		}
-
-		m_BoundingSphere.center = (m_AABB.minPoint + m_AABB.maxPoint) * 0.5f;
-		m_BoundingSphere.radius = (m_AABB.maxPoint - m_AABB.minPoint).Length() * 0.5f;
 	}
 
 
@@ -0,0 +1,310 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: TransformSystem.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "TransformSystem.h"
+#include "JobSystem.h"
+#include "BatchTransform.h"
+#include "Profiler.h"
+
+namespace RenderDog
+{
+	TransformSystem		g_TransformSystem;
+	TransformSystem*	g_pTransformSystem = &g_TransformSystem;
+
+	TransformSystem::TransformSystem() :
+		m_LocalTransforms(0),
+		m_WorldTransforms(0),
+		m_LocalAABBs(0),
+		m_WorldAABBs(0),
+		m_Parents(0),
+		m_FirstChildren(0),
+		m_NextSiblings(0),
+		m_Depths(0),
+		m_Flags(0),
+		m_Listeners(0),
+		m_FreeIds(0),
+		m_TransformNum(0),
+		m_DirtyLevels(0),
+		m_UpdateList(0),
+		m_UpdatedIds(0)
+	{}
+
+	TransformSystem::~TransformSystem()
+	{}
+
+	uint32_t TransformSystem::CreateTransform(ITransformListener* pListener /* = nullptr */, uint32_t parentId /* = TRANSFORM_INVALID_ID */)
+	{
+		uint32_t transformId = 0;
+		if (!m_FreeIds.empty())
+		{
+			transformId = m_FreeIds.back();
+			m_FreeIds.pop_back();
+		}
+		else
+		{
+			transformId = (uint32_t)m_Flags.size();
+
+			m_LocalTransforms.push_back(Matrix3x4());
+			m_WorldTransforms.push_back(Matrix3x4());
+			m_LocalAABBs.push_back(AABB());
+			m_WorldAABBs.push_back(AABB());
+			m_Parents.push_back(TRANSFORM_INVALID_ID);
+			m_FirstChildren.push_back(TRANSFORM_INVALID_ID);
+			m_NextSiblings.push_back(TRANSFORM_INVALID_ID);
+			m_Depths.push_back(0);
+			m_Flags.push_back(0);
+			m_Listeners.push_back(nullptr);
+		}
+
+		m_LocalTransforms[transformId].Identity();
+		m_WorldTransforms[transformId].Identity();
+		m_LocalAABBs[transformId].Reset();
+		m_WorldAABBs[transformId].Reset();
+		m_Parents[transformId] = TRANSFORM_INVALID_ID;
+		m_FirstChildren[transformId] = TRANSFORM_INVALID_ID;
+		m_NextSiblings[transformId] = TRANSFORM_INVALID_ID;
+		m_Depths[transformId] = 0;
+		m_Flags[transformId] = TRANSFORM_FLAG_ALIVE;
+		m_Listeners[transformId] = pListener;
+
+		++m_TransformNum;
+
+		if (parentId != TRANSFORM_INVALID_ID && (m_Flags[parentId] & TRANSFORM_FLAG_ALIVE))
+		{
+			AttachToParent(transformId, parentId);
+			m_Depths[transformId] = m_Depths[parentId] + 1;
+		}
+
+		MarkDirty(transformId);
+
+		return transformId;
+	}
+
+	void TransformSystem::DestroyTransform(uint32_t transformId)
+	{
+		if (transformId >= m_Flags.size() || !(m_Flags[transformId] & TRANSFORM_FLAG_ALIVE))
+		{
+			return;
+		}
+
+		DetachFromParent(transformId);
+
+		uint32_t childId = m_FirstChildren[transformId];
+		while (childId != TRANSFORM_INVALID_ID)
+		{
+			uint32_t nextId = m_NextSiblings[childId];
+
+			m_Parents[childId] = TRANSFORM_INVALID_ID;
+			m_NextSiblings[childId] = TRANSFORM_INVALID_ID;
+			UpdateSubtreeDepth(childId);
+			MarkDirty(childId);
+
+			childId = nextId;
+		}
+
+		//ڵбвļ¼ڸʱΪûдǶ
+		m_FirstChildren[transformId] = TRANSFORM_INVALID_ID;
+		m_Flags[transformId] = 0;
+		m_Listeners[transformId] = nullptr;
+
+		m_FreeIds.push_back(transformId);
+		--m_TransformNum;
+	}
+
+	bool TransformSystem::SetParent(uint32_t transformId, uint32_t parentId)
+	{
+		if (m_Parents[transformId] == parentId)
+		{
+			return true;
+		}
+
+		if (parentId != TRANSFORM_INVALID_ID)
+		{
+			if (!(m_Flags[parentId] & TRANSFORM_FLAG_ALIVE))
+			{
+				return false;
+			}
+
+			//ܹҵԼڵ
+			for (uint32_t ancestorId = parentId; ancestorId != TRANSFORM_INVALID_ID; ancestorId = m_Parents[ancestorId])
+			{
+				if (ancestorId == transformId)
+				{
+					return false;
+				}
+			}
+		}
+
+		DetachFromParent(transformId);
+		if (parentId != TRANSFORM_INVALID_ID)
+		{
+			AttachToParent(transformId, parentId);
+		}
+
+		UpdateSubtreeDepth(transformId);
+		MarkDirty(transformId);
+
+		return true;
+	}
+
+	void TransformSystem::SetLocalTransform(uint32_t transformId, const Matrix3x4& localTransform)
+	{
+		m_LocalTransforms[transformId] = localTransform;
+		MarkDirty(transformId);
+	}
+
+	void TransformSystem::SetLocalBounds(uint32_t transformId, const AABB& localAABB)
+	{
+		m_LocalAABBs[transformId] = localAABB;
+		MarkDirty(transformId);
+	}
+
+	uint32_t TransformSystem::Update()
+	{
+		RD_PROFILE_SCOPE("TransformSystem::Update");
+
+		m_UpdatedIds.clear();
+
+		//ڵڵĲ㼶ȸ꣬ӽڵڵĲ㼶ŻῪʼͬһ㼶Ľڵ㻥
+		for (uint32_t depth = 0; depth < m_DirtyLevels.size(); ++depth)
+		{
+			m_UpdateList.clear();
+
+			std::vector<uint32_t>& dirtyIds = m_DirtyLevels[depth];
+			for (uint32_t i = 0; i < dirtyIds.size(); ++i)
+			{
+				uint32_t transformId = dirtyIds[i];
+				uint8_t flags = m_Flags[transformId];
+				if ((flags & TRANSFORM_FLAG_ALIVE) && (flags & TRANSFORM_FLAG_DIRTY) && m_Depths[transformId] == depth)
+				{
+					m_Flags[transformId] = (uint8_t)(flags & ~TRANSFORM_FLAG_DIRTY);
+					m_UpdateList.push_back(transformId);
+				}
+			}
+			dirtyIds.clear();
+
+			if (m_UpdateList.empty())
+			{
+				continue;
+			}
+
+			g_pJobSystem->ParallelFor((uint32_t)m_UpdateList.size(), TRANSFORM_PARALLEL_BATCH_SIZE, [this](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; ++i)
+				{
+					uint32_t transformId = m_UpdateList[i];
+					uint32_t parentId = m_Parents[transformId];
+
+					m_WorldTransforms[transformId] = parentId != TRANSFORM_INVALID_ID ? m_LocalTransforms[transformId] * m_WorldTransforms[parentId] : m_LocalTransforms[transformId];
+					TransformAABBs(&m_WorldAABBs[transformId], &m_LocalAABBs[transformId], 1, m_WorldTransforms[transformId]);
+				}
+			});
+
+			//ӽڵŵһ㼶
+			for (uint32_t i = 0; i < m_UpdateList.size(); ++i)
+			{
+				uint32_t transformId = m_UpdateList[i];
+				for (uint32_t childId = m_FirstChildren[transformId]; childId != TRANSFORM_INVALID_ID; childId = m_NextSiblings[childId])
+				{
+					MarkDirty(childId);
+				}
+
+				m_UpdatedIds.push_back(transformId);
+			}
+		}
+
+		//߿ܻ޸ı任Щ޸һUpdateʱЧ
+		for (uint32_t i = 0; i < m_UpdatedIds.size(); ++i)
+		{
+			uint32_t transformId = m_UpdatedIds[i];
+			ITransformListener* pListener = m_Listeners[transformId];
+			if (pListener && (m_Flags[transformId] & TRANSFORM_FLAG_ALIVE))
+			{
+				pListener->OnTransformUpdated(transformId, m_WorldTransforms[transformId], m_WorldAABBs[transformId]);
+			}
+		}
+
+		return (uint32_t)m_UpdatedIds.size();
+	}
+
+	//---------------------------------------------------------------------------
+	//   Private Function Definition
+	//---------------------------------------------------------------------------
+
+	void TransformSystem::MarkDirty(uint32_t transformId)
+	{
+		if (m_Flags[transformId] & TRANSFORM_FLAG_DIRTY)
+		{
+			return;
+		}
+		m_Flags[transformId] = (uint8_t)(m_Flags[transformId] | TRANSFORM_FLAG_DIRTY);
+
+		uint32_t depth = m_Depths[transformId];
+		if (depth >= m_DirtyLevels.size())
+		{
+			m_DirtyLevels.resize(depth + 1);
+		}
+		m_DirtyLevels[depth].push_back(transformId);
+	}
+
+	void TransformSystem::AttachToParent(uint32_t transformId, uint32_t parentId)
+	{
+		m_Parents[transformId] = parentId;
+		m_NextSiblings[transformId] = m_FirstChildren[parentId];
+		m_FirstChildren[parentId] = transformId;
+	}
+
+	void TransformSystem::DetachFromParent(uint32_t transformId)
+	{
+		uint32_t parentId = m_Parents[transformId];
+		if (parentId == TRANSFORM_INVALID_ID)
+		{
+			return;
+		}
+
+		uint32_t* pLink = &m_FirstChildren[parentId];
+		while (*pLink != TRANSFORM_INVALID_ID)
+		{
+			if (*pLink == transformId)
+			{
+				*pLink = m_NextSiblings[transformId];
+				break;
+			}
+			pLink = &m_NextSiblings[*pLink];
+		}
+
+		m_Parents[transformId] = TRANSFORM_INVALID_ID;
+		m_NextSiblings[transformId] = TRANSFORM_INVALID_ID;
+	}
+
+	void TransformSystem::UpdateSubtreeDepth(uint32_t transformId)
+	{
+		std::vector<uint32_t> stack;
+		stack.push_back(transformId);
+
+		while (!stack.empty())
+		{
+			uint32_t currId = stack.back();
+			stack.pop_back();
+
+			uint32_t parentId = m_Parents[currId];
+			m_Depths[currId] = parentId != TRANSFORM_INVALID_ID ? m_Depths[parentId] + 1 : 0;
+
+			//ѾǹĽڵµټ¼һΣɵļ¼ڸʱ
+			if (m_Flags[currId] & TRANSFORM_FLAG_DIRTY)
+			{
+				m_Flags[currId] = (uint8_t)(m_Flags[currId] & ~TRANSFORM_FLAG_DIRTY);
+				MarkDirty(currId);
+			}
+
+			for (uint32_t childId = m_FirstChildren[currId]; childId != TRANSFORM_INVALID_ID; childId = m_NextSiblings[childId])
+			{
+				stack.push_back(childId);
+			}
+		}
+	}
+
+}// namespace RenderDog
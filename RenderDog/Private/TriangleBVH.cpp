@@ -0,0 +1,614 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: TriangleBVH.cpp
+//Written by Xiang Weikang
+////////////////////////////////////////
+
+#include "TriangleBVH.h"
+#include "SIMD.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace RenderDog
+{
+	//ӽڵŵλΪ1ʱʾ
+	static const uint32_t	TRIANGLE_BVH_LEAF_FLAG = 0x80000000;
+	//SAHͰ
+	static const int		TRIANGLE_BVH_BIN_NUM = 16;
+	//֮λ֣֤ȲջɵķΧ
+	static const uint32_t	TRIANGLE_BVH_MAX_SAH_DEPTH = 32;
+	//ÿѹ3ֵܽڵ㣬λ֮16
+	static const uint32_t	TRIANGLE_BVH_STACK_SIZE = 256;
+	//ӽ0ʱĵ0õNaN
+	static const float		TRIANGLE_BVH_MAX_INV_DIRECTION = 1e20f;
+
+	struct TriangleBVHBuildTriangle
+	{
+		AABB		bounds;
+		Vector3		centroid;
+		Vector3		positions[3];
+		uint32_t	triangle;
+	};
+
+	struct TriangleBVHBuildTask
+	{
+		uint32_t	nodeIndex;
+		uint32_t	begin;
+		uint32_t	end;
+		uint32_t	depth;
+	};
+
+	struct TriangleBVHBin
+	{
+		AABB		bounds;
+		uint32_t	triangleNum;
+
+		TriangleBVHBin() :
+			bounds(),
+			triangleNum(0)
+		{}
+	};
+
+	static inline float GetAxisValue(const Vector3& v, int axis)
+	{
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	static inline int GetBinIndex(float centroid, float binMin, float binScale)
+	{
+		int binIndex = (int)((centroid - binMin) * binScale);
+		return binIndex < TRIANGLE_BVH_BIN_NUM - 1 ? binIndex : TRIANGLE_BVH_BIN_NUM - 1;
+	}
+
+	static inline float GetSafeInverse(float value)
+	{
+		if (std::abs(value) * TRIANGLE_BVH_MAX_INV_DIRECTION > 1.0f)
+		{
+			return 1.0f / value;
+		}
+
+		return value < 0.0f ? -TRIANGLE_BVH_MAX_INV_DIRECTION : TRIANGLE_BVH_MAX_INV_DIRECTION;
+	}
+
+	static inline AABB CalcRangeBounds(const std::vector<TriangleBVHBuildTriangle>& triangles, uint32_t begin, uint32_t end)
+	{
+		AABB bounds;
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			bounds.Merge(triangles[i].bounds);
+		}
+
+		return bounds;
+	}
+
+	TriangleBVH::TriangleBVH() :
+		m_Nodes(0),
+		m_Packets(0),
+		m_TriangleNum(0),
+		m_Bounds()
+	{}
+
+	TriangleBVH::~TriangleBVH()
+	{
+		Clear();
+	}
+
+	void TriangleBVH::Build(const Vector3* pPositions, uint32_t positionStride, uint32_t vertNum, const uint32_t* pIndices, uint32_t indexNum)
+	{
+		Clear();
+
+		if (!pPositions || !pIndices)
+		{
+			return;
+		}
+
+		const unsigned char* pPositionData = reinterpret_cast<const unsigned char*>(pPositions);
+
+		std::vector<TriangleBVHBuildTriangle> triangles;
+		triangles.reserve(indexNum / 3);
+		for (uint32_t i = 0; i + 2 < indexNum; i += 3)
+		{
+			if (pIndices[i] >= vertNum || pIndices[i + 1] >= vertNum || pIndices[i + 2] >= vertNum)
+			{
+				continue;
+			}
+
+			TriangleBVHBuildTriangle triangle;
+			triangle.triangle = i / 3;
+			for (int j = 0; j < 3; ++j)
+			{
+				triangle.positions[j] = *reinterpret_cast<const Vector3*>(pPositionData + (size_t)pIndices[i + j] * positionStride);
+				triangle.bounds.Merge(triangle.positions[j]);
+			}
+			triangle.centroid = triangle.bounds.GetCenter();
+
+			m_Bounds.Merge(triangle.bounds);
+			triangles.push_back(triangle);
+		}
+
+		if (triangles.empty())
+		{
+			return;
+		}
+
+		m_TriangleNum = (uint32_t)triangles.size();
+
+		m_Nodes.reserve(m_TriangleNum / TRIANGLE_BVH_WIDTH + 1);
+		m_Packets.reserve(m_TriangleNum / 2 + 1);
+
+		m_Nodes.push_back(Node());
+
+		std::vector<TriangleBVHBuildTask> taskStack;
+		taskStack.push_back({ 0, 0, m_TriangleNum, 0 });
+		while (!taskStack.empty())
+		{
+			TriangleBVHBuildTask task = taskStack.back();
+			taskStack.pop_back();
+
+			//ÿλ䣬ֱֳ4䶼ܷŽһҶڵ
+			uint32_t rangeBegins[TRIANGLE_BVH_WIDTH] = { task.begin };
+			uint32_t rangeEnds[TRIANGLE_BVH_WIDTH] = { task.end };
+			uint32_t rangeNum = 1;
+			while (rangeNum < TRIANGLE_BVH_WIDTH)
+			{
+				uint32_t splitRange = TRIANGLE_BVH_INVALID_INDEX;
+				uint32_t maxTriangleNum = TRIANGLE_BVH_WIDTH;
+				for (uint32_t i = 0; i < rangeNum; ++i)
+				{
+					if (rangeEnds[i] - rangeBegins[i] > maxTriangleNum)
+					{
+						maxTriangleNum = rangeEnds[i] - rangeBegins[i];
+						splitRange = i;
+					}
+				}
+
+				if (splitRange == TRIANGLE_BVH_INVALID_INDEX)
+				{
+					break;
+				}
+
+				uint32_t mid = SplitTriangles(triangles, rangeBegins[splitRange], rangeEnds[splitRange], task.depth >= TRIANGLE_BVH_MAX_SAH_DEPTH);
+				rangeBegins[rangeNum] = mid;
+				rangeEnds[rangeNum] = rangeEnds[splitRange];
+				rangeEnds[splitRange] = mid;
+				++rangeNum;
+			}
+
+			Node node;
+			for (uint32_t i = 0; i < TRIANGLE_BVH_WIDTH; ++i)
+			{
+				node.minX[i] = node.minY[i] = node.minZ[i] = 0.0f;
+				node.maxX[i] = node.maxY[i] = node.maxZ[i] = 0.0f;
+				node.children[i] = TRIANGLE_BVH_INVALID_INDEX;
+			}
+			node.childMask = 0;
+
+			for (uint32_t i = 0; i < rangeNum; ++i)
+			{
+				AABB bounds = CalcRangeBounds(triangles, rangeBegins[i], rangeEnds[i]);
+				node.minX[i] = bounds.minPoint.x;
+				node.minY[i] = bounds.minPoint.y;
+				node.minZ[i] = bounds.minPoint.z;
+				node.maxX[i] = bounds.maxPoint.x;
+				node.maxY[i] = bounds.maxPoint.y;
+				node.maxZ[i] = bounds.maxPoint.z;
+				node.childMask |= 1u << i;
+
+				if (rangeEnds[i] - rangeBegins[i] <= TRIANGLE_BVH_WIDTH)
+				{
+					node.children[i] = CreatePacket(triangles, rangeBegins[i], rangeEnds[i]) | TRIANGLE_BVH_LEAF_FLAG;
+				}
+				else
+				{
+					uint32_t childIndex = (uint32_t)m_Nodes.size();
+					m_Nodes.push_back(Node());
+					node.children[i] = childIndex;
+
+					taskStack.push_back({ childIndex, rangeBegins[i], rangeEnds[i], task.depth + 1 });
+				}
+			}
+
+			m_Nodes[task.nodeIndex] = node;
+		}
+	}
+
+	void TriangleBVH::Clear()
+	{
+		m_Nodes.clear();
+		m_Packets.clear();
+		m_TriangleNum = 0;
+		m_Bounds.Reset();
+	}
+
+	bool TriangleBVH::Raycast(const Ray& ray, float maxDistance, TriangleRayHit& outHit) const
+	{
+		return Traverse(ray, maxDistance, false, outHit);
+	}
+
+	bool TriangleBVH::RaycastAny(const Ray& ray, float maxDistance) const
+	{
+		TriangleRayHit hit;
+		return Traverse(ray, maxDistance, true, hit);
+	}
+
+	//---------------------------------------------------------------------------
+	//   Private Function Definition
+	//---------------------------------------------------------------------------
+
+	bool TriangleBVH::Traverse(const Ray& ray, float maxDistance, bool bAnyHit, TriangleRayHit& outHit) const
+	{
+		if (m_Nodes.empty())
+		{
+			return false;
+		}
+
+		Vector3 invDirection(GetSafeInverse(ray.direction.x), GetSafeInverse(ray.direction.y), GetSafeInverse(ray.direction.z));
+
+		bool bHit = false;
+		float closestDistance = maxDistance;
+
+		//ջб߽ڵľ룬ҵĽֱ֮ԶĽڵ
+		uint32_t stackEntries[TRIANGLE_BVH_STACK_SIZE];
+		float stackDistances[TRIANGLE_BVH_STACK_SIZE];
+		uint32_t stackSize = 1;
+		stackEntries[0] = 0;
+		stackDistances[0] = 0.0f;
+
+		while (stackSize > 0)
+		{
+			--stackSize;
+			if (stackDistances[stackSize] > closestDistance)
+			{
+				continue;
+			}
+
+			uint32_t entry = stackEntries[stackSize];
+			if (entry & TRIANGLE_BVH_LEAF_FLAG)
+			{
+				if (IntersectPacket(m_Packets[entry & ~TRIANGLE_BVH_LEAF_FLAG], ray, closestDistance, outHit))
+				{
+					bHit = true;
+					closestDistance = outHit.distance;
+
+					if (bAnyHit)
+					{
+						return true;
+					}
+				}
+
+				continue;
+			}
+
+			float childDistances[TRIANGLE_BVH_WIDTH];
+			uint32_t hitMask = IntersectNode(m_Nodes[entry], ray.origin, invDirection, closestDistance, childDistances);
+
+			//ཻӽڵ㰴ԶУӽڵջȳջ
+			uint32_t hitChildren[TRIANGLE_BVH_WIDTH];
+			float hitDistances[TRIANGLE_BVH_WIDTH];
+			uint32_t hitNum = 0;
+			for (uint32_t i = 0; i < TRIANGLE_BVH_WIDTH; ++i)
+			{
+				if (!(hitMask & (1u << i)))
+				{
+					continue;
+				}
+
+				uint32_t insertPos = hitNum;
+				while (insertPos > 0 && hitDistances[insertPos - 1] < childDistances[i])
+				{
+					hitChildren[insertPos] = hitChildren[insertPos - 1];
+					hitDistances[insertPos] = hitDistances[insertPos - 1];
+					--insertPos;
+				}
+				hitChildren[insertPos] = m_Nodes[entry].children[i];
+				hitDistances[insertPos] = childDistances[i];
+				++hitNum;
+			}
+
+			for (uint32_t i = 0; i < hitNum && stackSize < TRIANGLE_BVH_STACK_SIZE; ++i)
+			{
+				stackEntries[stackSize] = hitChildren[i];
+				stackDistances[stackSize] = hitDistances[i];
+				++stackSize;
+			}
+		}
+
+		return bHit;
+	}
+
+	uint32_t TriangleBVH::IntersectNode(const Node& node, const Vector3& origin, const Vector3& invDirection, float maxDistance, float* pDistances)
+	{
+#if RD_SIMD_SSE
+		__m128 originX = _mm_set1_ps(origin.x);
+		__m128 originY = _mm_set1_ps(origin.y);
+		__m128 originZ = _mm_set1_ps(origin.z);
+		__m128 invDirX = _mm_set1_ps(invDirection.x);
+		__m128 invDirY = _mm_set1_ps(invDirection.y);
+		__m128 invDirZ = _mm_set1_ps(invDirection.z);
+
+		__m128 tx0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minX), originX), invDirX);
+		__m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxX), originX), invDirX);
+		__m128 ty0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minY), originY), invDirY);
+		__m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxY), originY), invDirY);
+		__m128 tz0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.minZ), originZ), invDirZ);
+		__m128 tz1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(node.maxZ), originZ), invDirZ);
+
+		__m128 tMin = _mm_max_ps(_mm_max_ps(_mm_min_ps(tx0, tx1), _mm_min_ps(ty0, ty1)), _mm_max_ps(_mm_min_ps(tz0, tz1), _mm_setzero_ps()));
+		__m128 tMax = _mm_min_ps(_mm_min_ps(_mm_max_ps(tx0, tx1), _mm_max_ps(ty0, ty1)), _mm_min_ps(_mm_max_ps(tz0, tz1), _mm_set1_ps(maxDistance)));
+
+		_mm_storeu_ps(pDistances, tMin);
+
+		return (uint32_t)_mm_movemask_ps(_mm_cmple_ps(tMin, tMax)) & node.childMask;
+#else
+		uint32_t hitMask = 0;
+		for (uint32_t i = 0; i < TRIANGLE_BVH_WIDTH; ++i)
+		{
+			float tx0 = (node.minX[i] - origin.x) * invDirection.x;
+			float tx1 = (node.maxX[i] - origin.x) * invDirection.x;
+			float ty0 = (node.minY[i] - origin.y) * invDirection.y;
+			float ty1 = (node.maxY[i] - origin.y) * invDirection.y;
+			float tz0 = (node.minZ[i] - origin.z) * invDirection.z;
+			float tz1 = (node.maxZ[i] - origin.z) * invDirection.z;
+
+			float tMin = (std::max)((std::max)((std::min)(tx0, tx1), (std::min)(ty0, ty1)), (std::max)((std::min)(tz0, tz1), 0.0f));
+			float tMax = (std::min)((std::min)((std::max)(tx0, tx1), (std::max)(ty0, ty1)), (std::min)((std::max)(tz0, tz1), maxDistance));
+
+			pDistances[i] = tMin;
+			hitMask |= tMin <= tMax ? (1u << i) : 0;
+		}
+
+		return hitMask & node.childMask;
+#endif
+	}
+
+	//Moller-Trumbore㷨ʽΪ0ʱƽУõ˻Ҳ˲ཻ
+	bool TriangleBVH::IntersectPacket(const TrianglePacket& packet, const Ray& ray, float maxDistance, TriangleRayHit& outHit)
+	{
+		float distances[TRIANGLE_BVH_WIDTH];
+		float us[TRIANGLE_BVH_WIDTH];
+		float vs[TRIANGLE_BVH_WIDTH];
+		uint32_t hitMask = 0;
+
+#if RD_SIMD_SSE
+		{
+			__m128 dirX = _mm_set1_ps(ray.direction.x);
+			__m128 dirY = _mm_set1_ps(ray.direction.y);
+			__m128 dirZ = _mm_set1_ps(ray.direction.z);
+
+			__m128 edge1X = _mm_loadu_ps(packet.edge1X);
+			__m128 edge1Y = _mm_loadu_ps(packet.edge1Y);
+			__m128 edge1Z = _mm_loadu_ps(packet.edge1Z);
+			__m128 edge2X = _mm_loadu_ps(packet.edge2X);
+			__m128 edge2Y = _mm_loadu_ps(packet.edge2Y);
+			__m128 edge2Z = _mm_loadu_ps(packet.edge2Z);
+
+			//pVec = direction x edge2
+			__m128 pVecX = _mm_sub_ps(_mm_mul_ps(dirY, edge2Z), _mm_mul_ps(dirZ, edge2Y));
+			__m128 pVecY = _mm_sub_ps(_mm_mul_ps(dirZ, edge2X), _mm_mul_ps(dirX, edge2Z));
+			__m128 pVecZ = _mm_sub_ps(_mm_mul_ps(dirX, edge2Y), _mm_mul_ps(dirY, edge2X));
+
+			__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(edge1X, pVecX), _mm_mul_ps(edge1Y, pVecY)), _mm_mul_ps(edge1Z, pVecZ));
+			__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), det);
+
+			__m128 tVecX = _mm_sub_ps(_mm_set1_ps(ray.origin.x), _mm_loadu_ps(packet.p0X));
+			__m128 tVecY = _mm_sub_ps(_mm_set1_ps(ray.origin.y), _mm_loadu_ps(packet.p0Y));
+			__m128 tVecZ = _mm_sub_ps(_mm_set1_ps(ray.origin.z), _mm_loadu_ps(packet.p0Z));
+
+			__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tVecX, pVecX), _mm_mul_ps(tVecY, pVecY)), _mm_mul_ps(tVecZ, pVecZ)), invDet);
+
+			//qVec = tVec x edge1
+			__m128 qVecX = _mm_sub_ps(_mm_mul_ps(tVecY, edge1Z), _mm_mul_ps(tVecZ, edge1Y));
+			__m128 qVecY = _mm_sub_ps(_mm_mul_ps(tVecZ, edge1X), _mm_mul_ps(tVecX, edge1Z));
+			__m128 qVecZ = _mm_sub_ps(_mm_mul_ps(tVecX, edge1Y), _mm_mul_ps(tVecY, edge1X));
+
+			__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dirX, qVecX), _mm_mul_ps(dirY, qVecY)), _mm_mul_ps(dirZ, qVecZ)), invDet);
+			__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(edge2X, qVecX), _mm_mul_ps(edge2Y, qVecY)), _mm_mul_ps(edge2Z, qVecZ)), invDet);
+
+			//NaNıȽϽΪfalseҪ
+			__m128 zero = _mm_setzero_ps();
+			__m128 valid = _mm_cmpneq_ps(det, zero);
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+			valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.0f)));
+			valid = _mm_and_ps(valid, _mm_cmpge_ps(t, zero));
+			valid = _mm_and_ps(valid, _mm_cmplt_ps(t, _mm_set1_ps(maxDistance)));
+
+			hitMask = (uint32_t)_mm_movemask_ps(valid);
+			if (!hitMask)
+			{
+				return false;
+			}
+
+			_mm_storeu_ps(distances, t);
+			_mm_storeu_ps(us, u);
+			_mm_storeu_ps(vs, v);
+		}
+#else
+		for (uint32_t i = 0; i < TRIANGLE_BVH_WIDTH; ++i)
+		{
+			Vector3 edge1(packet.edge1X[i], packet.edge1Y[i], packet.edge1Z[i]);
+			Vector3 edge2(packet.edge2X[i], packet.edge2Y[i], packet.edge2Z[i]);
+
+			Vector3 pVec = CrossProduct(ray.direction, edge2);
+			float det = DotProduct(edge1, pVec);
+			if (det == 0.0f)
+			{
+				continue;
+			}
+			float invDet = 1.0f / det;
+
+			Vector3 tVec = ray.origin - Vector3(packet.p0X[i], packet.p0Y[i], packet.p0Z[i]);
+			float u = DotProduct(tVec, pVec) * invDet;
+
+			Vector3 qVec = CrossProduct(tVec, edge1);
+			float v = DotProduct(ray.direction, qVec) * invDet;
+			float t = DotProduct(edge2, qVec) * invDet;
+
+			if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < maxDistance)
+			{
+				distances[i] = t;
+				us[i] = u;
+				vs[i] = v;
+				hitMask |= 1u << i;
+			}
+		}
+
+		if (!hitMask)
+		{
+			return false;
+		}
+#endif
+
+		bool bHit = false;
+		for (uint32_t i = 0; i < TRIANGLE_BVH_WIDTH; ++i)
+		{
+			if ((hitMask & (1u << i)) && distances[i] < maxDistance)
+			{
+				maxDistance = distances[i];
+
+				outHit.distance = distances[i];
+				outHit.triangle = packet.triangles[i];
+				outHit.u = us[i];
+				outHit.v = vs[i];
+				bHit = true;
+			}
+		}
+
+		return bHit;
+	}
+
+	uint32_t TriangleBVH::SplitTriangles(std::vector<TriangleBVHBuildTriangle>& triangles, uint32_t begin, uint32_t end, bool bMedian)
+	{
+		AABB centroidBounds;
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			centroidBounds.Merge(triangles[i].centroid);
+		}
+
+		Vector3 centroidSize = centroidBounds.maxPoint - centroidBounds.minPoint;
+		int axis = 0;
+		if (centroidSize.y > centroidSize.x)
+		{
+			axis = 1;
+		}
+		if (centroidSize.z > GetAxisValue(centroidSize, axis))
+		{
+			axis = 2;
+		}
+
+		uint32_t mid = begin + (end - begin) / 2;
+
+		//εغʱ޷λûֱ֣Ӱֳ
+		float axisMin = GetAxisValue(centroidBounds.minPoint, axis);
+		float axisSize = GetAxisValue(centroidSize, axis);
+		if (axisSize <= 0.0f)
+		{
+			return mid;
+		}
+
+		if (!bMedian)
+		{
+			float binScale = TRIANGLE_BVH_BIN_NUM / axisSize;
+
+			TriangleBVHBin bins[TRIANGLE_BVH_BIN_NUM];
+			for (uint32_t i = begin; i < end; ++i)
+			{
+				TriangleBVHBin& bin = bins[GetBinIndex(GetAxisValue(triangles[i].centroid, axis), axisMin, binScale)];
+				bin.bounds.Merge(triangles[i].bounds);
+				++bin.triangleNum;
+			}
+
+			//ۼӣõÿλҲı
+			float rightAreas[TRIANGLE_BVH_BIN_NUM];
+			uint32_t rightNums[TRIANGLE_BVH_BIN_NUM];
+			AABB rightBounds;
+			uint32_t rightNum = 0;
+			for (int i = TRIANGLE_BVH_BIN_NUM - 1; i > 0; --i)
+			{
+				rightBounds.Merge(bins[i].bounds);
+				rightNum += bins[i].triangleNum;
+				rightAreas[i] = rightNum > 0 ? rightBounds.GetSurfaceArea() : 0.0f;
+				rightNums[i] = rightNum;
+			}
+
+			int bestSplit = -1;
+			float bestCost = FLT_MAX;
+			AABB leftBounds;
+			uint32_t leftNum = 0;
+			for (int i = 1; i < TRIANGLE_BVH_BIN_NUM; ++i)
+			{
+				leftBounds.Merge(bins[i - 1].bounds);
+				leftNum += bins[i - 1].triangleNum;
+				if (leftNum == 0 || rightNums[i] == 0)
+				{
+					continue;
+				}
+
+				float cost = leftBounds.GetSurfaceArea() * leftNum + rightAreas[i] * rightNums[i];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestSplit = i;
+				}
+			}
+
+			if (bestSplit > 0)
+			{
+				auto splitIter = std::partition(triangles.begin() + begin, triangles.begin() + end, [axis, axisMin, binScale, bestSplit](const TriangleBVHBuildTriangle& triangle)
+				{
+					return GetBinIndex(GetAxisValue(triangle.centroid, axis), axisMin, binScale) < bestSplit;
+				});
+
+				uint32_t splitPos = (uint32_t)(splitIter - triangles.begin());
+				if (splitPos > begin && splitPos < end)
+				{
+					return splitPos;
+				}
+			}
+		}
+
+		std::nth_element(triangles.begin() + begin, triangles.begin() + mid, triangles.begin() + end, [axis](const TriangleBVHBuildTriangle& lhs, const TriangleBVHBuildTriangle& rhs)
+		{
+			return GetAxisValue(lhs.centroid, axis) < GetAxisValue(rhs.centroid, axis);
+		});
+
+		return mid;
+	}
+
+	uint32_t TriangleBVH::CreatePacket(const std::vector<TriangleBVHBuildTriangle>& triangles, uint32_t begin, uint32_t end)
+	{
+		TrianglePacket packet;
+		for (uint32_t i = 0; i < TRIANGLE_BVH_WIDTH; ++i)
+		{
+			Vector3 p0(0.0f, 0.0f, 0.0f);
+			Vector3 edge1(0.0f, 0.0f, 0.0f);
+			Vector3 edge2(0.0f, 0.0f, 0.0f);
+			uint32_t triangleIndex = TRIANGLE_BVH_INVALID_INDEX;
+			if (begin + i < end)
+			{
+				const TriangleBVHBuildTriangle& triangle = triangles[begin + i];
+				p0 = triangle.positions[0];
+				edge1 = triangle.positions[1] - triangle.positions[0];
+				edge2 = triangle.positions[2] - triangle.positions[0];
+				triangleIndex = triangle.triangle;
+			}
+
+			packet.p0X[i] = p0.x;
+			packet.p0Y[i] = p0.y;
+			packet.p0Z[i] = p0.z;
+			packet.edge1X[i] = edge1.x;
+			packet.edge1Y[i] = edge1.y;
+			packet.edge1Z[i] = edge1.z;
+			packet.edge2X[i] = edge2.x;
+			packet.edge2Y[i] = edge2.y;
+			packet.edge2Z[i] = edge2.z;
+			packet.triangles[i] = triangleIndex;
+		}
+
+		m_Packets.push_back(packet);
+
+		return (uint32_t)m_Packets.size() - 1;
+	}
+
+}// namespace RenderDog
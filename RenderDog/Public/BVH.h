@@ -0,0 +1,93 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: BVH.h
+//Written by Xiang Weikang
+//Desc: AABBΪڵĲΰΧ壬ڳͼԪ׶塢ߺͰΧвѯ
+////////////////////////////////////////
+
+#pragma once
+
+#include "Bounding.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace RenderDog
+{
+	static const uint32_t BVH_INVALID_INDEX = 0xffffffff;
+
+	class BVH
+	{
+	private:
+		//еԪm_ItemIndicesģڲڵӽڵڴ
+		struct BVHNode
+		{
+			AABB		bounds;
+			uint32_t	firstItem;
+			uint32_t	itemNum;
+			uint32_t	leftChild;		//Ϊ0ʱҶڵ㣬ڵ㲻κνڵӽڵ
+			uint32_t	parent;			//ڵΪBVH_INVALID_INDEX
+			bool		bRefitDirty;
+
+			BVHNode() :
+				bounds(),
+				firstItem(0),
+				itemNum(0),
+				leftChild(0),
+				parent(0),
+				bRefitDirty(false)
+			{}
+
+			bool IsLeaf() const { return leftChild == 0; }
+		};
+
+	public:
+		BVH();
+		~BVH();
+
+		//ʹ÷ͰSAHԪصıžpAABBsе±ꣻЧAABB빹ǳڲѯ
+		void					Build(const AABB* pAABBs, uint32_t count);
+		void					Clear();
+		void					Swap(BVH& other);
+
+		bool					IsEmpty() const { return m_Nodes.empty() && m_UnboundedItems.empty(); }
+		uint32_t				GetNodeNum() const { return (uint32_t)m_Nodes.size(); }
+		uint32_t				GetItemNum() const { return m_ItemNum; }
+
+		//ԪصAABBҶڵ㵽ڵ·Refitʱ£AABBЧЧ֮仯ʱfalseҪ¹
+		bool					UpdateItem(uint32_t item, const AABB& aabb);
+		//ֻ¼UpdateItemӰ쵽Ľڵ
+		void					Refit();
+		//ǰнڵ֮빹ʱıֵrefit𽥱
+		float					GetRefitDegradation() const { return m_BuildAreaSum > 0.0f ? m_AreaSum / m_BuildAreaSum : 1.0f; }
+
+		//ѯ׷ӵoutItemsĩβoutItems
+		//nodeStackǱõջɵ߳вڶβѯ֮临ãѯʼʱᱻ
+		void					QueryFrustum(const Frustum& frustum, std::vector<uint32_t>& nodeStack, std::vector<uint32_t>& outItems) const;
+		void					QuerySphere(const BoundingSphere& sphere, std::vector<uint32_t>& nodeStack, std::vector<uint32_t>& outItems) const;
+		void					QueryAABB(const AABB& aabb, std::vector<uint32_t>& nodeStack, std::vector<uint32_t>& outItems) const;
+		//AABBmaxDistanceཻ֮ԪأڵɽԶ˳
+		void					QueryRay(const Ray& ray, float maxDistance, std::vector<uint32_t>& nodeStack, std::vector<uint32_t>& outItems) const;
+
+	private:
+		//ڵҪʱӽڵ㲢true
+		bool					SplitNode(uint32_t nodeIndex, const std::vector<Vector3>& centroids);
+
+		void					AppendSubtreeItems(const BVHNode& node, std::vector<uint32_t>& outItems) const;
+
+		void					CalcNodeBounds(BVHNode& node) const;
+
+	private:
+		std::vector<BVHNode>	m_Nodes;
+		std::vector<uint32_t>	m_ItemIndices;
+		std::vector<AABB>		m_ItemAABBs;		//ԪرŴ
+		std::vector<uint32_t>	m_UnboundedItems;
+		std::vector<uint32_t>	m_ItemLeaves;		//ԪڵҶڵ㣬ЧAABBΪBVH_INVALID_INDEX
+		std::vector<uint32_t>	m_DirtyLeaves;
+		uint32_t				m_ItemNum;
+
+		float					m_AreaSum;
+		float					m_BuildAreaSum;
+	};
+
+}// namespace RenderDog
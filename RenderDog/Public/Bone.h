@@ -58,13 +58,13 @@ namespace RenderDog
 
 		int					GetParentIndex() const { return m_ParentIndex; }
 
-		void				SetUpdateToParentMatrix(const Matrix4x4& matrix) { m_UpToParentMatrix = matrix; }
-		void				SetUpdateToRootMatrix(const Matrix4x4& matrix) { m_UpToRootMatrix = matrix; }
+		void				SetUpdateToParentMatrix(const Matrix3x4& matrix) { m_UpToParentMatrix = matrix; }
+		void				SetUpdateToRootMatrix(const Matrix3x4& matrix) { m_UpToRootMatrix = matrix; }
 		void				SetFinalTransformMatrix(const Matrix4x4& matrix) { m_FinalTransformMatrix = matrix; }
 		
-		const Matrix4x4&	GetUpToParentMatrix() const { return m_UpToParentMatrix; }
-		const Matrix4x4&	GetUpToRootMatrix() const { return m_UpToRootMatrix; }
-		const Matrix4x4&	GetOffsetMatrix() const { return m_OffsetMatrix; }
+		const Matrix3x4&	GetUpToParentMatrix() const { return m_UpToParentMatrix; }
+		const Matrix3x4&	GetUpToRootMatrix() const { return m_UpToRootMatrix; }
+		const Matrix3x4&	GetOffsetMatrix() const { return m_OffsetMatrix; }
 		const Matrix4x4&	GetFinalTransformMatrix() const { return m_FinalTransformMatrix; }
 
 	private:
@@ -72,10 +72,12 @@ namespace RenderDog
 
 		int					m_ParentIndex;			//ڵΪ-1ʾǰΪ
 
-		Matrix4x4			m_OffsetMatrix;
-		Matrix4x4			m_UpToParentMatrix;
-		Matrix4x4			m_UpToRootMatrix;
+		//ı任Ƿ任ʹMatrix3x4洢ͼ
+		Matrix3x4			m_OffsetMatrix;
+		Matrix3x4			m_UpToParentMatrix;
+		Matrix3x4			m_UpToRootMatrix;
 
+		//վҪϴ壬4x4
 		Matrix4x4			m_FinalTransformMatrix;
 	};
 
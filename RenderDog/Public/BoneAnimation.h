@@ -9,6 +9,7 @@
 #include "Vector.h"
 #include "Matrix.h"
 #include "Quaternion.h"
+#include "BatchQuaternion.h"
 
 #include <vector>
 #include <string>
@@ -43,7 +44,8 @@ namespace RenderDog
 		float						GetStartTime() const;
 		float						GetEndTime() const;
 
-		void						Interpolate(float timePos, Matrix4x4& outputUpToParent) const;
+		//timePosǰؼ֡ͲֵӣΧʱؼ֡ͬ
+		void						GetKeyFramePair(float timePos, const BoneKeyFrame*& pKeyFrame0, const BoneKeyFrame*& pKeyFrame1, float& lerpFactor) const;
 		
 		void						AddKeyFrame(const BoneKeyFrame& keyFrame) { m_KeyFrames.push_back(keyFrame); }
 
@@ -83,7 +85,7 @@ namespace RenderDog
 		void										Interpolate(float timePos);
 
 		int											GetBoneAnimIndexByName(const std::string& boneName) const;
-		const Matrix4x4&							GetBoneAnimTransform(int boneAnimIndex) const;
+		const Matrix3x4&							GetBoneAnimTransform(int boneAnimIndex) const;
 
 	private:
 		std::string									m_Name;
@@ -91,7 +93,15 @@ namespace RenderDog
 		std::vector<BoneAnimation>					m_BoneAnimations;
 		std::unordered_map<std::string, size_t>		m_BoneAnimIndexMap;
 
-		std::vector<Matrix4x4>						m_BoneAnimTransforms;	//ĳһʱдĹUpToParent
+		std::vector<Matrix3x4>						m_BoneAnimTransforms;	//ĳһʱдĹUpToParent
+
+		//InterpolateʱʹõSoAʱݣΪԱÿ֡·
+		QuaternionArraySoA							m_FromRotations;
+		QuaternionArraySoA							m_ToRotations;
+		QuaternionArraySoA							m_CurrRotations;
+		std::vector<float>							m_LerpFactors;
+		std::vector<Vector3>						m_CurrScales;
+		std::vector<Vector3>						m_CurrTranslations;
 	};
 
 }// namespace RenderDog
@@ -8,6 +8,10 @@
 #pragma once
 
 #include "Vector.h"
+#include "Matrix.h"
+
+#include <cfloat>
+#include <cstdint>
 
 namespace RenderDog
 {
@@ -18,13 +22,38 @@ namespace RenderDog
 
 		AABB() :
 			minPoint(FLT_MAX),
-			maxPoint(FLT_MIN)
+			maxPoint(-FLT_MAX)
 		{}
 
 		AABB(const AABB& aabb) = default;
 		AABB& operator=(const AABB& aabb) = default;
 
-		void Reset() { minPoint = Vector3(FLT_MAX); maxPoint = Vector3(FLT_MIN); }
+		void Reset() { minPoint = Vector3(FLT_MAX); maxPoint = Vector3(-FLT_MAX); }
+
+		void Merge(const Vector3& point)
+		{
+			minPoint = Vector3(point.x < minPoint.x ? point.x : minPoint.x, point.y < minPoint.y ? point.y : minPoint.y, point.z < minPoint.z ? point.z : minPoint.z);
+			maxPoint = Vector3(point.x > maxPoint.x ? point.x : maxPoint.x, point.y > maxPoint.y ? point.y : maxPoint.y, point.z > maxPoint.z ? point.z : maxPoint.z);
+		}
+
+		//ֱȡСֵֵϲЧAABBı
+		void Merge(const AABB& aabb)
+		{
+			minPoint = Vector3(aabb.minPoint.x < minPoint.x ? aabb.minPoint.x : minPoint.x, aabb.minPoint.y < minPoint.y ? aabb.minPoint.y : minPoint.y, aabb.minPoint.z < minPoint.z ? aabb.minPoint.z : minPoint.z);
+			maxPoint = Vector3(aabb.maxPoint.x > maxPoint.x ? aabb.maxPoint.x : maxPoint.x, aabb.maxPoint.y > maxPoint.y ? aabb.maxPoint.y : maxPoint.y, aabb.maxPoint.z > maxPoint.z ? aabb.maxPoint.z : maxPoint.z);
+		}
+
+		Vector3 GetCenter() const { return (minPoint + maxPoint) * 0.5f; }
+		Vector3 GetExtents() const { return (maxPoint - minPoint) * 0.5f; }
+
+		//Reset֮ûаκεAABBЧ
+		bool	IsValid() const { return minPoint.x <= maxPoint.x && minPoint.y <= maxPoint.y && minPoint.z <= maxPoint.z; }
+
+		float	GetSurfaceArea() const
+		{
+			Vector3 size = maxPoint - minPoint;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
 	};
 
 	struct BoundingSphere
@@ -40,4 +69,115 @@ namespace RenderDog
 		void Reset() { center = Vector3(0.0f, 0.0f, 0.0f); radius = 0.0f; }
 	};
 
+	struct OBB
+	{
+		Vector3	center;
+		Vector3	extents;		//᷽ϵİ볤
+		Vector3	axis[3];		//λ
+
+		OBB() :
+			center(0.0f, 0.0f, 0.0f),
+			extents(0.0f, 0.0f, 0.0f)
+		{
+			axis[0] = Vector3(1.0f, 0.0f, 0.0f);
+			axis[1] = Vector3(0.0f, 1.0f, 0.0f);
+			axis[2] = Vector3(0.0f, 0.0f, 1.0f);
+		}
+
+		//ֲռAABB任OBB任еŻᲢextents
+		OBB(const AABB& localAABB, const Matrix3x4& localToWorld);
+	};
+
+	//ƽ淽Ϊ DotProduct(normal, p) + distance = 0normalָһΪ
+	struct Plane
+	{
+		Vector3	normal;
+		float	distance;
+
+		Plane() :
+			normal(0.0f, 1.0f, 0.0f),
+			distance(0.0f)
+		{}
+
+		Plane(const Vector3& inNormal, float inDistance) :
+			normal(inNormal),
+			distance(inDistance)
+		{}
+
+		//ƽ淽̵ĸϵ(a, b, c, d)
+		explicit Plane(const Vector4& coefficients) :
+			normal(coefficients.x, coefficients.y, coefficients.z),
+			distance(coefficients.w)
+		{}
+
+		void	Normalize();
+
+		float	GetSignedDistance(const Vector3& point) const { return DotProduct(normal, point) + distance; }
+	};
+
+	//directionҪǵλཻdirectionĳΪλ
+	struct Ray
+	{
+		Vector3	origin;
+		Vector3	direction;
+
+		Ray() :
+			origin(0.0f, 0.0f, 0.0f),
+			direction(0.0f, 0.0f, 1.0f)
+		{}
+
+		Ray(const Vector3& inOrigin, const Vector3& inDirection) :
+			origin(inOrigin),
+			direction(inDirection)
+		{}
+
+		Vector3	GetPoint(float t) const { return origin + direction * t; }
+	};
+
+	enum class CONTAINMENT_TYPE : uint8_t
+	{
+		OUTSIDE,
+		INTERSECT,
+		INSIDE
+	};
+
+	//ƽķ߶ָ׶ڲ
+	struct Frustum
+	{
+		enum PLANE_INDEX
+		{
+			PLANE_LEFT = 0,
+			PLANE_RIGHT,
+			PLANE_BOTTOM,
+			PLANE_TOP,
+			PLANE_NEAR,
+			PLANE_FAR,
+			PLANE_NUM
+		};
+
+		Plane	planes[PLANE_NUM];
+
+		Frustum() = default;
+
+		//matrixһΪViewMatrix * ProjectionMatrixõռ׶壻üռzΧΪ[0, w]
+		explicit Frustum(const Matrix4x4& matrix) { ExtractFromMatrix(matrix); }
+
+		void				ExtractFromMatrix(const Matrix4x4& matrix);
+
+		bool				Contains(const Vector3& point) const;
+
+		CONTAINMENT_TYPE	Test(const AABB& aabb) const;
+		CONTAINMENT_TYPE	Test(const BoundingSphere& sphere) const;
+		CONTAINMENT_TYPE	Test(const OBB& obb) const;
+	};
+
+	bool	IntersectAABB(const AABB& aabb0, const AABB& aabb1);
+	bool	IntersectSphereAABB(const BoundingSphere& sphere, const AABB& aabb);
+	//slabAABBڲʱoutDistanceΪ0
+	bool	IntersectRayAABB(const Ray& ray, const AABB& aabb, float maxDistance, float& outDistance);
+
+	//ԣSSEһδ4AVXʱһδ8pResultsĳȲСcount
+	void	FrustumTestAABBs(const Frustum& frustum, const AABB* pAABBs, uint32_t count, CONTAINMENT_TYPE* pResults);
+	void	FrustumTestSpheres(const Frustum& frustum, const BoundingSphere* pSpheres, uint32_t count, CONTAINMENT_TYPE* pResults);
+
 }// namespace RenderDog
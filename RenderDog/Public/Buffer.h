@@ -8,6 +8,7 @@
 #pragma once
 
 #include "RenderDog.h"
+#include "ResourceRegistry.h"
 
 #include <cstdint>
 #include <string>
@@ -70,6 +71,10 @@ namespace RenderDog
 	{
 	protected:
 		virtual ~IConstantBuffer() = default;
+
+	public:
+		//ʱg_pResourceRegistryעᣬһReleaseʧЧɫͨ水ֲҵȫֳ
+		virtual ResourceHandle		GetHandle() const = 0;
 	};
 
 	class IBufferManager
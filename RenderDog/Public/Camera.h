@@ -12,6 +12,8 @@
 
 namespace RenderDog
 {
+	struct	Ray;
+
 	struct CameraDesc
 	{
 		Vector3		position;
@@ -56,11 +58,22 @@ namespace RenderDog
 		~FPSCamera();
 
 		const Vector3&		GetPosition() const { return m_Postion; }
+		const Vector3&		GetDirection() const { return m_Direction; }
+		float				GetFov() const { return m_Fov; }
+		float				GetAspect() const { return m_Aspect; }
+		float				GetNearPlane() const { return m_Near; }
+		float				GetFarPlane() const { return m_Far; }
 		Matrix4x4			GetViewMatrix() const;
+							//ռ䵽ռı任۲
+		Matrix3x4			GetCameraToWorldMatrix() const;
 		Matrix4x4			GetPerspProjectionMatrix() const;
+							//ndcXndcYķΧΪ[-1, 1]yϣشλóõռߣΪλ
+		Ray					GetPickRay(float ndcX, float ndcY) const;
 
 		void				Move(MOVE_MODE moveMode, float deltaTime);
 		void				Rotate(float deltaYaw, float deltaPitch);
+							//ֱλúͳyawpitchΪ
+		void				SetPosAndRotation(const Vector3& pos, float yaw, float pitch);
 
 		void				OnWindowResize(uint32_t width, uint32_t height);
 
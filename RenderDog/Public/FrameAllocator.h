@@ -0,0 +1,111 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: FrameAllocator.h
+//Written by Xiang Weikang
+//Desc: ÿ֡õԷֻһ֡ʹõʱ
+////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+namespace RenderDog
+{
+	//ÿ̵߳ڴСһ֡ʱʱ׷¿飬һʱϲһ
+	static const uint32_t	FRAME_ALLOCATOR_BLOCK_SIZE = 1024 * 1024;
+
+	//ֻһ߳ʹõԷֻãܵͷ
+	class LinearAllocator
+	{
+	public:
+		explicit LinearAllocator(uint32_t blockSize = FRAME_ALLOCATOR_BLOCK_SIZE);
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		//alignment2ݣڴ治ʱnullptr
+		void*					Allocate(size_t size, size_t alignment);
+		void					Reset();
+
+		size_t					GetUsedSize() const { return m_UsedSize; }
+
+	private:
+		bool					AllocateBlock(size_t size);
+
+	private:
+		struct Block
+		{
+			unsigned char*		pData;
+			size_t				size;
+		};
+
+		std::vector<Block>		m_Blocks;
+		size_t					m_BlockSize;
+		size_t					m_CurrOffset;		//һеƫ
+		size_t					m_UsedSize;			//˷ѵĿռ
+	};
+
+	struct FrameThreadArena;
+
+	//ÿ̸߳ӵԷ֡ʹãʱҪ
+	//֡ڴڷ֮һ֮֡ǰЧȾ̵߳һ֡BeginFrameʱҲʧЧ
+	class FrameAllocator
+	{
+	public:
+		FrameAllocator();
+		~FrameAllocator();
+
+		FrameAllocator(const FrameAllocator&) = delete;
+		FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+		//ÿ֡ʼȾʱã߳һηʱ֮֡ǰڴ
+		void					BeginFrame();
+		uint32_t				GetFrameIndex() const { return m_FrameIndex.load(std::memory_order_relaxed); }
+
+		void*					Allocate(size_t size, size_t alignment);
+
+		template<typename T>
+		T*						AllocateArray(uint32_t count) { return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T))); }
+
+	private:
+		FrameThreadArena*		GetThreadArena();
+
+	private:
+		std::atomic<uint32_t>	m_FrameIndex;
+
+		std::mutex				m_ArenaMutex;		//̵ֻ߳һηʱʹ
+		std::vector<FrameThreadArena*>	m_ThreadArenas;
+	};
+
+	extern FrameAllocator* g_pFrameAllocator;
+
+	//STLʹõķͷʱʲôҲڴ֡ʱͳһ
+	template<typename T>
+	class FrameStlAllocator
+	{
+	public:
+		typedef T			value_type;
+
+		FrameStlAllocator() = default;
+		template<typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+		T*					allocate(size_t n) { return static_cast<T*>(g_pFrameAllocator->Allocate(sizeof(T) * n, alignof(T))); }
+		void				deallocate(T*, size_t) {}
+
+		template<typename U>
+		bool				operator==(const FrameStlAllocator<U>&) const { return true; }
+		template<typename U>
+		bool				operator!=(const FrameStlAllocator<U>&) const { return false; }
+	};
+
+	//ֻΪֲʹãܿ֡
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+}// namespace RenderDog
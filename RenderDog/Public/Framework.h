@@ -12,19 +12,36 @@
 namespace RenderDog
 {
 	class IScene;
+	class FPSCamera;
+
+	struct FrameworkInitDesc
+	{
+		FPSCamera*		pMainCamera;
+		bool			bRenderThread;		//ΪtrueʱڵһFrameʱȾ̣֮߳ǰļغͳʼϷֱִ߳
+
+		FrameworkInitDesc() :
+			pMainCamera(nullptr),
+			bRenderThread(false)
+		{}
+	};
 
 	class IFramework
 	{
 	public:
 		virtual ~IFramework() = default;
 
-		virtual bool	Init() = 0;
-		virtual void	Release() = 0;
+		virtual bool		Init(const FrameworkInitDesc& desc) = 0;
+		virtual void		Release() = 0;
+
+		virtual void		Frame() = 0;
+		virtual void		OnResize(uint32_t width, uint32_t height) = 0;
 
-		virtual void	Frame() = 0;
-		virtual void	OnResize(uint32_t width, uint32_t height) = 0;
+		virtual void		RegisterScene(IScene* pScene) = 0;
 
-		virtual void	RegisterScene(IScene* pScene) = 0;
+							//ȾʹõȾ߳ʱϷÿ֡ʼȾʱĿ
+		virtual FPSCamera*	GetRenderCamera() = 0;
+							//ȴȾִ߳ѾύͷųеԴ֮ǰҪ
+		virtual void		FlushRendering() = 0;
 	};
 
 	extern IFramework* g_pIFramework;
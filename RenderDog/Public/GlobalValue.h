@@ -12,6 +12,10 @@ namespace RenderDog
 	extern int			g_ShadowMapRTSize;
 	extern float		g_ShadowDepthOffset;
 	extern float		g_ShadowDistance;
+	extern float		g_ShadowCascadeSplitLambda;
+
+	//ӰĲӰͼ2x2һͼУ޸ʱҪͬ޸ShadowTestCommon.hlsl
+	const int			g_ShadowCascadeNum = 4;
 
 	const int			g_MaxBoneNum = 256;
 
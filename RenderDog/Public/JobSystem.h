@@ -0,0 +1,259 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: JobSystem.h
+//Written by Xiang Weikang
+//Desc: ڹȡȣÿ߳ӵһ
+////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <type_traits>
+
+namespace RenderDog
+{
+	//ÿ̵߳شС֮JOB_POOL_SIZEδʱãһ֡ڲܳи紴
+	//ܳ֡ҪCreateJobInPlaceڵ߳еJob
+	static const uint32_t	JOB_POOL_SIZE = 4096;
+	//еʱύֱִ߳
+	static const uint32_t	JOB_QUEUE_SIZE = 4096;
+	static const uint32_t	JOB_MAX_CONTINUATION_NUM = 8;
+	//пԱĿɵöĴСʱҪΪָ
+	static const uint32_t	JOB_DATA_SIZE = 64;
+	static const uint32_t	JOB_INVALID_WORKER = 0xffffffff;
+
+	struct Job;
+	struct JobWorker;
+	typedef void (*JobFunction)(Job* pJob);
+
+	struct Job
+	{
+		JobFunction				pFunction;
+		Job*					pParent;
+		std::atomic<int32_t>	unfinishedNum;		//δɵΪ0ʱ
+		std::atomic<int32_t>	dependencyNum;		//δɵǰΪ0ʱŻᱻύ
+		std::atomic<int32_t>	continuationNum;
+		Job*					continuations[JOB_MAX_CONTINUATION_NUM];
+		bool					bMainThreadOnly;
+		alignas(16) unsigned char data[JOB_DATA_SIZE];
+	};
+
+	//Chase-Lev˫˶У߳ڵײѹ͵̴߳Ӷȡ
+	class JobQueue
+	{
+	public:
+		JobQueue();
+		~JobQueue() = default;
+
+		JobQueue(const JobQueue&) = delete;
+		JobQueue& operator=(const JobQueue&) = delete;
+
+		//̵ֻ߳ãʱfalse
+		bool						Push(Job* pJob);
+		Job*						Pop();
+
+		Job*						Steal();
+
+	private:
+		std::atomic<int64_t>		m_Top;
+		std::atomic<int64_t>		m_Bottom;
+		std::atomic<Job*>			m_Jobs[JOB_QUEUE_SIZE];
+	};
+
+	class JobSystem
+	{
+	public:
+		JobSystem();
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		//Init߳Ϊ̣߳Ҳ0Ẓ́߳workerNumΪ0ʱʹӲ߳
+		bool						Init(uint32_t workerNum = 0);
+		void						Release();
+
+		bool						IsInitialized() const { return m_WorkerNum > 0; }
+		//߳
+		uint32_t					GetWorkerNum() const { return m_WorkerNum; }
+		//ǹ߳ʱJOB_INVALID_WORKER
+		uint32_t					GetCurrWorkerIndex() const;
+		bool						IsMainThread() const { return GetCurrWorkerIndex() == 0; }
+
+		//funcǩΪvoid()pParentΪʱpParentҪȵ֮
+		//bMainThreadOnlyִֻ߳Уڵò߳ʹõĽӿ
+		template<typename Func>
+		Job*						CreateJob(Func&& func, Job* pParent = nullptr, bool bMainThreadOnly = false);
+		//񴴽ڵṩpJobУᱻظãpJob֮ǰЧҲ´
+		template<typename Func>
+		Job*						CreateJobInPlace(Job* pJob, Func&& func, Job* pParent = nullptr, bool bMainThreadOnly = false);
+
+		//pJob֮ԶύpContinuationpContinuationǰʱŻύ
+		//ҪpJobpContinuationύ֮ǰãpContinuationҪҲٵRun
+		bool						AddContinuation(Job* pJob, Job* pContinuation);
+
+		void						Run(Job* pJob);
+		//ȴʱǰ߳ҲִжеϵͳѾͷʱֱӷ
+		void						Wait(const Job* pJob);
+		//̵ֻ߳ãִִֻ߳е
+		void						ExecuteMainThreadJobs();
+		bool						IsFinished(const Job* pJob) const { return pJob->unfinishedNum.load(std::memory_order_acquire) == 0; }
+
+		//[0, count)ֳminBatchSizeС䣬funcǩΪvoid(uint32_t begin, uint32_t end)ʱ䶼Ѿִ
+		//ṇ̀߳Ⱦ̣߳ҲԵãͨõύнִ߳
+		template<typename Func>
+		void						ParallelFor(uint32_t count, uint32_t minBatchSize, const Func& func);
+
+	private:
+		Job*						AllocateJob();
+		void						InitJob(Job* pJob, JobFunction pFunction, Job* pParent, bool bMainThreadOnly);
+
+		void						Submit(Job* pJob);
+		Job*						GetJob(uint32_t workerIndex);
+		Job*						PopExternalJob();
+		void						Execute(Job* pJob);
+		void						Finish(Job* pJob);
+
+		void						WorkerThreadMain(uint32_t workerIndex);
+		void						WakeWorkers();
+
+		template<typename Func>
+		static void					InvokeJob(Job* pJob);
+
+		template<typename Func>
+		struct ParallelForData
+		{
+			JobSystem*				pJobSystem;
+			const Func*				pFunc;
+			uint32_t				begin;
+			uint32_t				end;
+			uint32_t				batchSize;
+		};
+
+		template<typename Func>
+		void						RunParallelForRange(Job* pParent, const ParallelForData<Func>& data);
+
+	private:
+		uint32_t					m_WorkerNum;
+		std::vector<std::thread>	m_WorkerThreads;
+		//ÿ̸߳Եкأ0߳
+		std::vector<JobWorker*>		m_Workers;
+
+		//ǹ̹߳õύ
+		Job*						m_pExternalJobPool;
+		std::atomic<uint32_t>		m_ExternalJobPoolIndex;
+		std::mutex					m_ExternalQueueMutex;
+		std::deque<Job*>			m_ExternalQueue;
+		std::atomic<uint32_t>		m_ExternalJobNum;
+
+		std::mutex					m_MainThreadQueueMutex;
+		std::deque<Job*>			m_MainThreadQueue;
+		std::atomic<uint32_t>		m_MainThreadJobNum;
+
+		//ÿύ߳˯֮ǰ¼ֵ仯˵
+		std::atomic<uint32_t>		m_SubmitCount;
+		std::atomic<uint32_t>		m_SleepingWorkerNum;
+		std::mutex					m_SleepMutex;
+		std::condition_variable		m_SleepCondition;
+		std::atomic<bool>			m_bQuit;
+	};
+
+	extern JobSystem* g_pJobSystem;
+
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//------------------         Template Implementation         --------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	template<typename Func>
+	void JobSystem::InvokeJob(Job* pJob)
+	{
+		Func* pFunc = reinterpret_cast<Func*>(pJob->data);
+		(*pFunc)();
+		pFunc->~Func();
+	}
+
+	template<typename Func>
+	Job* JobSystem::CreateJob(Func&& func, Job* pParent /* = nullptr */, bool bMainThreadOnly /* = false */)
+	{
+		return CreateJobInPlace(AllocateJob(), std::forward<Func>(func), pParent, bMainThreadOnly);
+	}
+
+	template<typename Func>
+	Job* JobSystem::CreateJobInPlace(Job* pJob, Func&& func, Job* pParent /* = nullptr */, bool bMainThreadOnly /* = false */)
+	{
+		typedef typename std::decay<Func>::type FuncType;
+		static_assert(sizeof(FuncType) <= JOB_DATA_SIZE, "Job function is too large, capture a pointer instead.");
+		static_assert(alignof(FuncType) <= 16, "Job function is over aligned.");
+
+		InitJob(pJob, &InvokeJob<FuncType>, pParent, bMainThreadOnly);
+		new (pJob->data) FuncType(std::forward<Func>(func));
+
+		return pJob;
+	}
+
+	template<typename Func>
+	void JobSystem::RunParallelForRange(Job* pParent, const ParallelForData<Func>& data)
+	{
+		//ϴʱ԰֣һ뽻߳ȡһֱ֣batchSize
+		ParallelForData<Func> range = data;
+		while (range.end - range.begin > range.batchSize)
+		{
+			uint32_t mid = range.begin + (range.end - range.begin) / 2;
+
+			ParallelForData<Func> upperRange = range;
+			upperRange.begin = mid;
+			Job* pJob = CreateJob([upperRange, pParent]()
+			{
+				upperRange.pJobSystem->RunParallelForRange(pParent, upperRange);
+			}, pParent);
+			Run(pJob);
+
+			range.end = mid;
+		}
+
+		(*range.pFunc)(range.begin, range.end);
+	}
+
+	template<typename Func>
+	void JobSystem::ParallelFor(uint32_t count, uint32_t minBatchSize, const Func& func)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		minBatchSize = minBatchSize > 0 ? minBatchSize : 1;
+		if (!IsInitialized() || count <= minBatchSize)
+		{
+			func(0, count);
+			return;
+		}
+
+		//ÿ̴߳Լֵ4䣬ڸؾ
+		uint32_t batchSize = (count + m_WorkerNum * 4 - 1) / (m_WorkerNum * 4);
+		batchSize = batchSize > minBatchSize ? batchSize : minBatchSize;
+
+		ParallelForData<Func> data;
+		data.pJobSystem = this;
+		data.pFunc = &func;
+		data.begin = 0;
+		data.end = count;
+		data.batchSize = batchSize;
+
+		//ֳ䶼pWaitJob񣬵ǰִ߳еһ䣬Ȼȴ
+		Job* pWaitJob = CreateJob([]() {});
+		RunParallelForRange(pWaitJob, data);
+		Run(pWaitJob);
+		Wait(pWaitJob);
+	}
+
+}// namespace RenderDog
@@ -38,6 +38,7 @@ namespace RenderDog
 
 		virtual LIGHT_TYPE	GetType() const = 0;
 
+		//ɫȾ߳ʹõݣȾ߳ʱSet֮ҪȾִ߳еӦŻı
 		virtual Vector3		GetDirection() const = 0;
 		virtual Vector3		GetEulerAngle() const = 0;
 		virtual Vector3		GetColor() const = 0;
@@ -0,0 +1,142 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: MeshLOD.h
+//Written by Xiang Weikang
+//Desc: ڶ򻯣ԼĻߴѡLOD
+////////////////////////////////////////
+
+#pragma once
+
+#include "Vector.h"
+
+#include <cstdint>
+#include <cfloat>
+#include <vector>
+
+namespace RenderDog
+{
+	//ԭʼLOD
+	static const uint32_t	MESH_LOD_MAX_NUM = 4;
+	//ÿһLODĿһı
+	static const float		MESH_LOD_REDUCTION = 0.5f;
+	//ֵʱɸֵLOD
+	static const uint32_t	MESH_LOD_MIN_TRIANGLE_NUM = 64;
+	//ͶӰĻռĻ߶ȵıСֵʱΪ𣬴Լ1080pµһ
+	static const float		MESH_LOD_MAX_SCREEN_ERROR = 1.0f / 1080.0f;
+	//лLODʱĻߴҪԽֵıֵ
+	static const float		MESH_LOD_HYSTERESIS = 0.1f;
+
+	template<typename VertexType>
+	struct MeshLODData
+	{
+		std::vector<VertexType>		vertices;
+		std::vector<uint32_t>		indices;
+		float						screenSize;		//ͶӰΧֱռĻ߶ȵıСʱʹһLOD
+
+		MeshLODData() :
+			vertices(0),
+			indices(0),
+			screenSize(0.0f)
+		{}
+	};
+
+	//ʹö۵ֻϲеĶϣȻָԭʼ飻
+	//λͬԲͬĶ㣨UVӷ죩ᱻƶӷ˱ֲ䣻
+	//targetIndexNum / 3maxErrorʱֹͣoutErrorΪʵʲλ붥λͬ
+	void		SimplifyMesh(const Vector3* pPositions, uint32_t positionStride, uint32_t vertNum,
+							 const std::vector<uint32_t>& indices, uint32_t targetIndexNum, float maxError,
+							 std::vector<uint32_t>& outIndices, float& outError);
+
+	//ֻĶ㣬outVertexRemap[i]Ϊ¶iԭʼе±
+	void		CompactMeshIndices(const std::vector<uint32_t>& indices, std::vector<uint32_t>& outIndices, std::vector<uint32_t>& outVertexRemap);
+
+	//Χж뾶ΪAABB
+	float		CalcMeshRadius(const Vector3* pPositions, uint32_t positionStride, uint32_t vertNum);
+
+	//ԭʼ𼶼LODԭʼ
+	template<typename VertexType>
+	void GenerateMeshLODs(const std::vector<VertexType>& vertices, const std::vector<uint32_t>& indices, std::vector<MeshLODData<VertexType>>& outLODs)
+	{
+		outLODs.clear();
+		if (vertices.empty() || indices.empty())
+		{
+			return;
+		}
+
+		const Vector3* pPositions = &vertices[0].position;
+		uint32_t vertNum = (uint32_t)vertices.size();
+
+		float radius = CalcMeshRadius(pPositions, sizeof(VertexType), vertNum);
+		if (radius <= 0.0f)
+		{
+			return;
+		}
+
+		std::vector<uint32_t> srcIndices(indices);
+		std::vector<uint32_t> simplifiedIndices;
+		std::vector<uint32_t> vertexRemap;
+		float totalError = 0.0f;
+		float prevScreenSize = FLT_MAX;
+		for (uint32_t lod = 1; lod < MESH_LOD_MAX_NUM; ++lod)
+		{
+			uint32_t targetIndexNum = (uint32_t)(srcIndices.size() * MESH_LOD_REDUCTION) / 3 * 3;
+			if (targetIndexNum < MESH_LOD_MIN_TRIANGLE_NUM * 3)
+			{
+				break;
+			}
+
+			float error = 0.0f;
+			SimplifyMesh(pPositions, sizeof(VertexType), vertNum, srcIndices, targetIndexNum, FLT_MAX, simplifiedIndices, error);
+
+			//ӷͱ߽϶ܼ򻯲ȥٵ̫ٵLODû
+			if (simplifiedIndices.empty() || simplifiedIndices.size() > srcIndices.size() * 0.8f)
+			{
+				break;
+			}
+
+			//ÿһһĻϼ򻯵ģۼΪԭʼϽ
+			totalError += error;
+
+			MeshLODData<VertexType> lodData;
+			CompactMeshIndices(simplifiedIndices, lodData.indices, vertexRemap);
+			lodData.vertices.resize(vertexRemap.size());
+			for (uint32_t i = 0; i < vertexRemap.size(); ++i)
+			{
+				lodData.vertices[i] = vertices[vertexRemap[i]];
+			}
+
+			//ĻߴΪsʱԼռĻ߶ȵ s * error / (2 * radius)
+			float screenSize = totalError > 0.0f ? 2.0f * MESH_LOD_MAX_SCREEN_ERROR * radius / totalError : FLT_MAX;
+			lodData.screenSize = screenSize < prevScreenSize ? screenSize : prevScreenSize;
+			prevScreenSize = lodData.screenSize;
+
+			outLODs.push_back(lodData);
+
+			srcIndices.swap(simplifiedIndices);
+		}
+	}
+
+	//currLODΪ0ʱԭʼlods[i]ǵi + 1LOD
+	template<typename VertexType>
+	uint32_t SelectMeshLOD(const std::vector<MeshLODData<VertexType>>& lods, uint32_t currLOD, float screenSize)
+	{
+		uint32_t lodNum = (uint32_t)lods.size();
+		if (currLOD > lodNum)
+		{
+			currLOD = lodNum;
+		}
+
+		while (currLOD < lodNum && screenSize < lods[currLOD].screenSize * (1.0f - MESH_LOD_HYSTERESIS))
+		{
+			++currLOD;
+		}
+
+		while (currLOD > 0 && screenSize > lods[currLOD - 1].screenSize * (1.0f + MESH_LOD_HYSTERESIS))
+		{
+			--currLOD;
+		}
+
+		return currLOD;
+	}
+
+}// namespace RenderDog
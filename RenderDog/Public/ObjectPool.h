@@ -0,0 +1,180 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: ObjectPool.h
+//Written by Xiang Weikang
+//Desc: ͷֿĶأͬ
+////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <mutex>
+#include <utility>
+
+namespace RenderDog
+{
+	//ÿеĶ
+	static const uint32_t	OBJECT_POOL_SLAB_SIZE = 64;
+	static const uint32_t	OBJECT_POOL_INVALID_INDEX = 0xffffffff;
+
+	template<typename T>
+	class ObjectPool
+	{
+	public:
+		ObjectPool();
+		~ObjectPool();
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		//ֻڴ棬operator newsizesizeof(T)ͬʱֱࣩӴӶϷ
+		void*					Allocate(size_t size = sizeof(T));
+		void					Free(void* pObject, size_t size = sizeof(T));
+
+		//operator newʹ
+		template<typename... Args>
+		T*						Create(Args&&... args);
+		void					Destroy(T* pObject);
+
+		uint32_t				GetLiveNum() const { return m_LiveNum; }
+
+	private:
+		//ڲλĿͷֱָתΪλָ
+		struct Slot
+		{
+			alignas(T) unsigned char	storage[sizeof(T)];
+			uint32_t					index;
+			uint32_t					nextFree;
+		};
+
+		Slot*					GetSlot(uint32_t index) const { return &m_Slabs[index / OBJECT_POOL_SLAB_SIZE][index % OBJECT_POOL_SLAB_SIZE]; }
+		void					AllocateSlab();
+
+	private:
+		std::vector<Slot*>		m_Slabs;
+		uint32_t				m_FreeHead;
+		uint32_t				m_LiveNum;
+		std::mutex				m_Mutex;
+	};
+
+	//ඨĿͷnewdeleteͷŵĶ󶼻ӶӦĶз
+	//Ҫcppж徲̬ԱObjectPool<ClassName> ClassName::s_Pool;
+#define RD_POOLED_OBJECT(ClassName)																	\
+	public:																							\
+		static void*				operator new(size_t size) { return s_Pool.Allocate(size); }		\
+		static void					operator delete(void* p, size_t size) { s_Pool.Free(p, size); }	\
+		static ObjectPool<ClassName>&	GetPool() { return s_Pool; }									\
+	private:																						\
+		static ObjectPool<ClassName>	s_Pool;
+
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//------------------         Template Implementation         --------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	template<typename T>
+	ObjectPool<T>::ObjectPool() :
+		m_Slabs(0),
+		m_FreeHead(OBJECT_POOL_INVALID_INDEX),
+		m_LiveNum(0),
+		m_Mutex()
+	{}
+
+	template<typename T>
+	ObjectPool<T>::~ObjectPool()
+	{
+		//˳ʱûͷŵĶ󲻻ᱻ
+		for (size_t i = 0; i < m_Slabs.size(); ++i)
+		{
+			::operator delete(m_Slabs[i]);
+		}
+		m_Slabs.clear();
+	}
+
+	template<typename T>
+	void* ObjectPool<T>::Allocate(size_t size /* = sizeof(T) */)
+	{
+		if (size != sizeof(T))
+		{
+			return ::operator new(size);
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_FreeHead == OBJECT_POOL_INVALID_INDEX)
+		{
+			AllocateSlab();
+		}
+
+		Slot* pSlot = GetSlot(m_FreeHead);
+		m_FreeHead = pSlot->nextFree;
+		++m_LiveNum;
+
+		return pSlot->storage;
+	}
+
+	template<typename T>
+	void ObjectPool<T>::Free(void* pObject, size_t size /* = sizeof(T) */)
+	{
+		if (!pObject)
+		{
+			return;
+		}
+
+		if (size != sizeof(T))
+		{
+			::operator delete(pObject);
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		Slot* pSlot = reinterpret_cast<Slot*>(pObject);
+		pSlot->nextFree = m_FreeHead;
+		m_FreeHead = pSlot->index;
+		--m_LiveNum;
+	}
+
+	template<typename T>
+	template<typename... Args>
+	T* ObjectPool<T>::Create(Args&&... args)
+	{
+		void* pMemory = Allocate();
+
+		return ::new (pMemory) T(std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	void ObjectPool<T>::Destroy(T* pObject)
+	{
+		if (!pObject)
+		{
+			return;
+		}
+
+		pObject->~T();
+		Free(pObject);
+	}
+
+	template<typename T>
+	void ObjectPool<T>::AllocateSlab()
+	{
+		Slot* pSlab = static_cast<Slot*>(::operator new(sizeof(Slot) * OBJECT_POOL_SLAB_SIZE));
+
+		//¿Ĳλ˳򴮵ϣȷĶڴҲ
+		uint32_t firstIndex = (uint32_t)m_Slabs.size() * OBJECT_POOL_SLAB_SIZE;
+		for (uint32_t i = 0; i < OBJECT_POOL_SLAB_SIZE; ++i)
+		{
+			Slot& slot = pSlab[i];
+			slot.index = firstIndex + i;
+			slot.nextFree = i + 1 < OBJECT_POOL_SLAB_SIZE ? firstIndex + i + 1 : m_FreeHead;
+		}
+
+		m_Slabs.push_back(pSlab);
+		m_FreeHead = firstIndex;
+	}
+
+}// namespace RenderDog
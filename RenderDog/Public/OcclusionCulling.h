@@ -0,0 +1,77 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: OcclusionCulling.h
+//Written by Xiang Weikang
+//Desc: ڵ޳ڵդͷֱʵıȻУͼԪAABB
+////////////////////////////////////////
+
+#pragma once
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "Bounding.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace RenderDog
+{
+	//ڵļݣλھֲռ䣬ʹֽڲ
+	struct OccluderData
+	{
+		const Vector3*		pPositions;
+		uint32_t			positionStride;
+		uint32_t			vertNum;
+		const uint32_t*		pIndices;
+		uint32_t			indexNum;
+		Matrix4x4			localToWorldMatrix;
+
+		OccluderData() :
+			pPositions(nullptr),
+			positionStride(0),
+			vertNum(0),
+			pIndices(nullptr),
+			indexNum(0),
+			localToWorldMatrix()
+		{
+			localToWorldMatrix.Identity();
+		}
+	};
+
+	//Ȼÿرȫڵεȣڵ屻ʵʸԶԽǱصģ
+	//üռzķΧΪ[0, w]ͶӰһ
+	class OcclusionBuffer
+	{
+	public:
+		OcclusionBuffer();
+		~OcclusionBuffer() = default;
+
+		//Ȼ϶뵽4һδ4
+		void					Init(uint32_t width, uint32_t height);
+		void					Clear();
+
+		uint32_t				GetWidth() const { return m_Width; }
+		uint32_t				GetHeight() const { return m_Height; }
+		const float*			GetDepthData() const { return m_Depths.empty() ? nullptr : &m_Depths[0]; }
+
+		void					SetWorldToClipMatrix(const Matrix4x4& worldToClip) { m_WorldToClipMatrix = worldToClip; }
+
+		//ƽཻλᱻٻڵֻ޳
+		void					RenderOccluder(const OccluderData& occluder);
+		//AABBпܿɼʱtrueƽཻ߱ڵжΪɼtrue
+		bool					IsAABBVisible(const AABB& aabb) const;
+
+	private:
+		void					RasterizeTriangle(const Vector4& clipPos0, const Vector4& clipPos1, const Vector4& clipPos2);
+
+	private:
+		uint32_t				m_Width;
+		uint32_t				m_Height;
+		std::vector<float>		m_Depths;
+
+		Matrix4x4				m_WorldToClipMatrix;
+
+		std::vector<Vector4>	m_ClipPositions;
+	};
+
+}// namespace RenderDog
@@ -17,6 +17,8 @@ namespace RenderDog
 	class   IMaterialInstance;
 	struct	BoundingSphere;
 	struct	AABB;
+	struct	OccluderData;
+	struct	RaycastData;
 
 	enum class PRIMITIVE_TYPE
 	{
@@ -57,15 +59,38 @@ namespace RenderDog
 		virtual void				Render(const PrimitiveRenderParam& renderParam) = 0;
 	};
 
+	//֪ͨͼԪİΧз˱仯
+	class IPrimitiveBoundsListener
+	{
+	public:
+		virtual ~IPrimitiveBoundsListener() = default;
+
+		virtual void				OnPrimitiveBoundsChanged(uint32_t primitiveId) = 0;
+	};
+
 	class IPrimitive
 	{
 	public:
 		virtual ~IPrimitive() = default;
 
 		virtual void				Render(IPrimitiveRenderer* pPrimitiveRenderer) = 0;
+		//RenderʱȾĲSceneViewɻ
+		virtual void				GetRenderParam(PrimitiveRenderParam& outRenderParam) const = 0;
 
 		virtual PRIMITIVE_TYPE		GetPriType() const = 0;
 		virtual const AABB&			GetAABB() const = 0;
+
+		//עᵽʱɳãƳʱΪnullptrAABBı֮Ҫ֪ͨpListener
+		virtual void				SetBoundsListener(IPrimitiveBoundsListener* pListener, uint32_t primitiveId) = 0;
+
+		//ΪڵͼԪtrue伸ݣڵ޳
+		virtual bool				GetOccluderData(OccluderData& outData) const { return false; }
+
+		//߲ѯͼԪtrueݣoutData.pTriangleBVHΪʱֻAABB
+		virtual bool				GetRaycastData(RaycastData& outData) const { return false; }
+
+		//ͶӰΧֱռĻ߶ȵıѡLODûLODͼԪҪ
+		virtual void				SelectLOD(float screenSize) {}
 	};
 
 }// namespace RenderDog
\ No newline at end of file
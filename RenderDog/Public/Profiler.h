@@ -0,0 +1,121 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: Profiler.h
+//Written by Xiang Weikang
+//Desc: ʱǣΪChrome Traceʽ(chrome://tracing)
+////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+//ڹжRD_ENABLE_PROFILER=0رռʱ
+#ifndef RD_ENABLE_PROFILER
+#define RD_ENABLE_PROFILER 1
+#endif
+
+namespace RenderDog
+{
+	struct ProfileEvent
+	{
+		const char*		name;			//ָֻ룬ʹַ
+		int64_t			startCounts;
+		int64_t			endCounts;
+	};
+
+	//ÿ̶߳ռһ¼壬ֻ߳д룬дʱҪ
+	struct ProfileThreadBuffer
+	{
+		static const uint32_t		MAX_EVENT_NUM = 65536;
+
+		uint32_t					threadId;
+		std::atomic<uint32_t>		captureIndex;		//е¼һβɼ
+		std::atomic<uint32_t>		eventNum;
+		ProfileEvent				events[MAX_EVENT_NUM];
+
+		ProfileThreadBuffer() :
+			threadId(0),
+			captureIndex(0),
+			eventNum(0)
+		{}
+	};
+
+	class Profiler
+	{
+	public:
+		Profiler();
+		~Profiler();
+
+		Profiler(const Profiler&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+
+		//ʼɼʱ֮ǰɼ¼
+		void								BeginCapture();
+		void								EndCapture();
+		bool								IsCapturing() const { return m_bCapturing.load(std::memory_order_relaxed); }
+
+		//ҪEndCapture֮
+		bool								ExportChromeTrace(const std::string& fileName);
+
+		void								RecordEvent(const char* name, int64_t startCounts, int64_t endCounts);
+
+		static int64_t						GetCurrCounts();
+
+	private:
+		ProfileThreadBuffer*				GetThreadBuffer();
+
+	private:
+		std::atomic<bool>					m_bCapturing;
+		std::atomic<uint32_t>				m_CaptureIndex;		//ÿBeginCaptureø̵߳Ļӳ
+
+		double								m_MicroSecondsPerCount;
+
+		std::mutex							m_BufferMutex;		//̵ֻ߳һμ¼¼Լʱʹ
+		std::vector<ProfileThreadBuffer*>	m_ThreadBuffers;
+	};
+
+	extern Profiler* g_pProfiler;
+
+	class ScopedProfileMarker
+	{
+	public:
+		explicit ScopedProfileMarker(const char* name) :
+			m_Name(name),
+			m_StartCounts(0)
+		{
+			if (g_pProfiler->IsCapturing())
+			{
+				m_StartCounts = Profiler::GetCurrCounts();
+			}
+		}
+
+		~ScopedProfileMarker()
+		{
+			if (m_StartCounts != 0 && g_pProfiler->IsCapturing())
+			{
+				g_pProfiler->RecordEvent(m_Name, m_StartCounts, Profiler::GetCurrCounts());
+			}
+		}
+
+		ScopedProfileMarker(const ScopedProfileMarker&) = delete;
+		ScopedProfileMarker& operator=(const ScopedProfileMarker&) = delete;
+
+	private:
+		const char*		m_Name;
+		int64_t			m_StartCounts;
+	};
+
+}// namespace RenderDog
+
+#define RD_PROFILE_CONCAT_IMPL(a, b) a##b
+#define RD_PROFILE_CONCAT(a, b) RD_PROFILE_CONCAT_IMPL(a, b)
+
+#if RD_ENABLE_PROFILER
+#define RD_PROFILE_SCOPE(name) RenderDog::ScopedProfileMarker RD_PROFILE_CONCAT(profileMarker_, __LINE__)(name)
+#else
+#define RD_PROFILE_SCOPE(name)
+#endif
@@ -17,6 +17,15 @@ namespace RenderDog
 	{
 		WindowDesc		wndDesc;
 		FPSCamera*		pMainCamera;
+		bool			bHeadless;		//ΪtrueʱڣֻʹwndDescеwidthheightΪbackbufferߴ
+		bool			bRenderThread;	//ΪtrueʱڵȾ߳ϻƣϷ̶߳Գݵ޸ʽύȾ߳
+
+		InitDesc() :
+			wndDesc(),
+			pMainCamera(nullptr),
+			bHeadless(false),
+			bRenderThread(false)
+		{}
 	};
 
 	class IRenderDog
@@ -0,0 +1,163 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: RenderThread.h
+//Written by Xiang Weikang
+//Desc: Ⱦ̣߳Ϸ߳ͨаݵ޸ύȾ߳
+////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <new>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include <type_traits>
+
+namespace RenderDog
+{
+	//еҪܷһ֡ύϷ̻߳ȴȾ߳
+	static const uint32_t	RENDER_COMMAND_QUEUE_SIZE = 4 * 1024 * 1024;
+	static const uint32_t	RENDER_COMMAND_ALIGNMENT = 16;
+
+	//ִpDataб
+	typedef void (*RenderCommandFunction)(void* pData);
+
+	struct RenderCommandHeader
+	{
+		RenderCommandFunction	pFunction;		//Ϊʱʾĩβ䣬ֱ
+		uint32_t				size;			//ͷڵĴС
+	};
+
+	//ߵߵĻζУĴСɱ䣬һԽĩβ
+	class RenderCommandQueue
+	{
+	public:
+		RenderCommandQueue();
+		~RenderCommandQueue();
+
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		bool					Init(uint32_t size);
+		void					Release();
+
+		//ֻߵãռ䲻ʱAllocatenullptr
+		//AllocateصڴCommit֮Ŷ߿ɼ
+		void*					Allocate(uint32_t dataSize, RenderCommandFunction pFunction);
+		void					Commit();
+
+		//ֻߵãִѾύִе
+		uint32_t				Execute();
+
+		bool					IsEmpty() const;
+
+	private:
+		unsigned char*			m_pBuffer;
+		uint32_t				m_Size;
+
+		//дλֻm_Sizeȡģõڻеλ
+		uint64_t				m_AllocatedPos;
+		alignas(64) std::atomic<uint64_t>	m_WritePos;
+		alignas(64) std::atomic<uint64_t>	m_ReadPos;
+	};
+
+	class RenderThread
+	{
+	public:
+		RenderThread();
+		~RenderThread();
+
+		RenderThread(const RenderThread&) = delete;
+		RenderThread& operator=(const RenderThread&) = delete;
+
+		//ֻϷ̵߳
+		bool					Start();
+		//ִʣ֮Ⱦ߳
+		void					Stop();
+
+		bool					IsRunning() const { return m_bRunning; }
+		bool					IsInRenderThread() const;
+
+		//funcǩΪvoid()ᱻУҪֵҪ
+		//Ⱦ߳ûлȾ߳еʱֱִ
+		template<typename Func>
+		void					EnqueueCommand(Func&& func);
+
+		//Ϸ߳һ֡ʱãȾ߳Ϸ߳һ֡
+		void					EndFrame();
+		//ȴȾִ߳ĿǰύͷȾ߳ʹõԴ֮ǰ
+		void					Flush();
+
+	private:
+		template<typename Func>
+		static void				InvokeCommand(void* pData);
+
+		void					RenderThreadMain();
+		void					WakeRenderThread();
+
+		uint64_t				IssueFence();
+		void					WaitFence(uint64_t fence);
+
+	private:
+		std::thread				m_Thread;
+		bool					m_bRunning;
+		RenderCommandQueue		m_CommandQueue;
+
+		//m_Mutex
+		std::mutex				m_Mutex;
+		std::condition_variable	m_WakeCondition;
+		std::condition_variable	m_FenceCondition;
+		uint64_t				m_WakeCount;
+		uint64_t				m_CompletedFence;
+		bool					m_bQuit;
+
+		//ֻϷ̷߳
+		uint64_t				m_IssuedFence;
+		uint64_t				m_LastFrameFence;
+	};
+
+	extern RenderThread* g_pRenderThread;
+
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//------------------         Template Implementation         --------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	template<typename Func>
+	void RenderThread::InvokeCommand(void* pData)
+	{
+		Func* pFunc = reinterpret_cast<Func*>(pData);
+		(*pFunc)();
+		pFunc->~Func();
+	}
+
+	template<typename Func>
+	void RenderThread::EnqueueCommand(Func&& func)
+	{
+		typedef typename std::decay<Func>::type FuncType;
+		static_assert(sizeof(FuncType) <= RENDER_COMMAND_QUEUE_SIZE / 2, "Render command is too large.");
+		static_assert(alignof(FuncType) <= RENDER_COMMAND_ALIGNMENT, "Render command is over aligned.");
+
+		if (!m_bRunning || IsInRenderThread())
+		{
+			func();
+			return;
+		}
+
+		void* pData = m_CommandQueue.Allocate(sizeof(FuncType), &InvokeCommand<FuncType>);
+		while (!pData)
+		{
+			//Ⱦ̲߳ȴ
+			WakeRenderThread();
+			std::this_thread::yield();
+			pData = m_CommandQueue.Allocate(sizeof(FuncType), &InvokeCommand<FuncType>);
+		}
+
+		new (pData) FuncType(std::forward<Func>(func));
+		m_CommandQueue.Commit();
+	}
+
+}// namespace RenderDog
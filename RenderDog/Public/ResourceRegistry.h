@@ -0,0 +1,97 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: ResourceRegistry.h
+//Written by Xiang Weikang
+//Desc: ȾԴľעΪ32λλźʹͨ±ֱӲ
+////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+
+namespace RenderDog
+{
+	//ĵ20λΪλţ12λΪ
+	static const uint32_t	RESOURCE_HANDLE_INDEX_BITS = 20;
+	static const uint32_t	RESOURCE_HANDLE_INDEX_MASK = (1u << RESOURCE_HANDLE_INDEX_BITS) - 1;
+	static const uint32_t	RESOURCE_HANDLE_GENERATION_MASK = 0xffffffffu >> RESOURCE_HANDLE_INDEX_BITS;
+	//λ䣬ַٱ仯ʱҪ
+	static const uint32_t	RESOURCE_REGISTRY_CHUNK_SIZE = 1024;
+	static const uint32_t	RESOURCE_REGISTRY_MAX_CHUNK_NUM = (RESOURCE_HANDLE_INDEX_MASK + 1) / RESOURCE_REGISTRY_CHUNK_SIZE;
+
+	//ֻҪͨҵԴעᣬĿǰɫ󶨵ȫֳ
+	enum class RESOURCE_TYPE : uint32_t
+	{
+		UNKNOWN = 0,
+		CONSTANT_BUFFER
+	};
+
+	//ʹеĲλΪֵΪ0ľһЧ
+	struct ResourceHandle
+	{
+		uint32_t	value;
+
+		ResourceHandle() :
+			value(0)
+		{}
+
+		explicit ResourceHandle(uint32_t handleValue) :
+			value(handleValue)
+		{}
+
+		bool		IsValid() const { return value != 0; }
+		uint32_t	GetIndex() const { return value & RESOURCE_HANDLE_INDEX_MASK; }
+		uint32_t	GetGeneration() const { return value >> RESOURCE_HANDLE_INDEX_BITS; }
+
+		bool		operator==(const ResourceHandle& rhs) const { return value == rhs.value; }
+		bool		operator!=(const ResourceHandle& rhs) const { return value != rhs.value; }
+	};
+
+	//עעResolve̵߳ã
+	//Resolveֻ֤ʧЧ󷵻nullptrԴȻü
+	//ȫֵעڳ˳ʱ̬ʱҲע
+	class ResourceRegistry
+	{
+	public:
+		ResourceRegistry();
+		~ResourceRegistry();
+
+		ResourceRegistry(const ResourceRegistry&) = delete;
+		ResourceRegistry& operator=(const ResourceRegistry&) = delete;
+
+		//pResourceҪtypeӦĽӿָ룬λʱЧ
+		ResourceHandle				Register(RESOURCE_TYPE type, void* pResource);
+		void						Unregister(ResourceHandle handle);
+
+		//ѾעͲʱnullptrͬһλ2048κɾĴظ
+		void*						Resolve(ResourceHandle handle, RESOURCE_TYPE type) const;
+
+		template<typename T>
+		T*							Resolve(ResourceHandle handle, RESOURCE_TYPE type) const { return static_cast<T*>(Resolve(handle, type)); }
+
+		uint32_t					GetLiveNum() const { return m_LiveNum.load(std::memory_order_relaxed); }
+
+	private:
+		struct Slot
+		{
+			std::atomic<uint32_t>	generation;		//עעʱһʾʹ
+			std::atomic<uint32_t>	type;
+			std::atomic<void*>		pResource;
+			uint32_t				nextFree;
+		};
+
+		bool						AllocateChunk();
+
+	private:
+		std::atomic<Slot*>			m_Chunks[RESOURCE_REGISTRY_MAX_CHUNK_NUM];
+		uint32_t					m_ChunkNum;
+		uint32_t					m_FreeHead;
+		std::atomic<uint32_t>		m_LiveNum;
+		std::mutex					m_Mutex;
+	};
+
+	extern ResourceRegistry* g_pResourceRegistry;
+
+}// namespace RenderDog
@@ -7,6 +7,8 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <cstdint>
 
 namespace RenderDog
 {
@@ -15,12 +17,54 @@ namespace RenderDog
 	class	ILight;
 	class	SkyBox;
 	struct	BoundingSphere;
+	struct	AABB;
+	struct	Ray;
+	struct	Frustum;
 
 	struct SceneInitDesc
 	{
 		std::string name;
 	};
 
+	static const uint32_t SCENE_RAY_HIT_NO_TRIANGLE = 0xffffffff;
+
+	struct SceneRayHit
+	{
+		IPrimitive*	pPrimitive;		//ûʱΪnullptr
+		float		distance;		//ray.directionĳΪλ
+		uint32_t	triangle;		//ֻAABB󽻵ͼԪΪSCENE_RAY_HIT_NO_TRIANGLE
+		float		u;				//꣬Ϊ(1 - u - v) * p0 + u * p1 + v * p2
+		float		v;
+
+		SceneRayHit() :
+			pPrimitive(nullptr),
+			distance(0.0f),
+			triangle(SCENE_RAY_HIT_NO_TRIANGLE),
+			u(0.0f),
+			v(0.0f)
+		{}
+	};
+
+	//SceneView֪ͨͼԪ͹ԴɾƶάפĻб
+	class ISceneListener
+	{
+	public:
+		virtual ~ISceneListener() = default;
+
+		virtual void					OnPrimitiveRegistered(IPrimitive* pPrimitive) = 0;
+		virtual void					OnPrimitiveUnregistered(IPrimitive* pPrimitive) = 0;
+		//ͼԪAABBѾ
+		virtual void					OnPrimitiveMoved(IPrimitive* pPrimitive) = 0;
+
+		virtual void					OnLightRegistered(ILight* pLight) = 0;
+		virtual void					OnLightUnregistered(ILight* pLight) = 0;
+
+		//еͼԪ͹ԴƳȻ
+		virtual void					OnSceneCleared() = 0;
+		//ͷţ֮󲻻֪ͨ
+		virtual void					OnSceneReleased() = 0;
+	};
+
 	class IScene
 	{
 	protected:
@@ -30,13 +74,33 @@ namespace RenderDog
 		virtual void					Release() = 0;
 
 		virtual void					RegisterPrimitive(IPrimitive* pPrimitive) = 0;
+		//ͼԪıŻ仯BVHһθʱؽ
+		virtual void					UnregisterPrimitive(IPrimitive* pPrimitive) = 0;
 		virtual IPrimitive*				GetPrimitive(uint32_t index) = 0;
 		virtual uint32_t				GetPrimitivesNum() const = 0;
 
+		//BVHĿռѯ׷ӵoutPrimitivesĩβ
+		virtual void					QueryPrimitives(const Frustum& frustum, std::vector<IPrimitive*>& outPrimitives) = 0;
+		virtual void					QueryPrimitives(const BoundingSphere& sphere, std::vector<IPrimitive*>& outPrimitives) = 0;
+		virtual void					QueryPrimitives(const AABB& aabb, std::vector<IPrimitive*>& outPrimitives) = 0;
+		virtual void					QueryPrimitives(const Ray& ray, float maxDistance, std::vector<IPrimitive*>& outPrimitives) = 0;
+		//ֻGetRaycastDatatrueͼԪBVHʱΣ߶βѯʹRay(start, end - start)maxDistanceΪ1
+		virtual bool					Raycast(const Ray& ray, float maxDistance, SceneRayHit& outHit) = 0;
+		//ҵһͷأ֮Ŀɼж
+		virtual bool					RaycastAny(const Ray& ray, float maxDistance) = 0;
+		//ʹϵͳдpHitsĳȲСcount
+		virtual void					RaycastBatch(const Ray* pRays, uint32_t count, float maxDistance, SceneRayHit* pHits) = 0;
+		//ƶͼԪrefitӰBVHڵ㣬½϶ʱں̨ؽѯʱԶ
+		virtual void					UpdateSpatialIndex() = 0;
+
 		virtual	void					RegisterLight(ILight* pLight) = 0;
+		virtual void					UnregisterLight(ILight* pLight) = 0;
 		virtual ILight*					GetLight(uint32_t index) = 0;
 		virtual uint32_t				GetLightsNum() const = 0;
 
+		virtual void					AddListener(ISceneListener* pListener) = 0;
+		virtual void					RemoveListener(ISceneListener* pListener) = 0;
+
 		virtual void					RegisterSkyBox(SkyBox* pSkyBox) = 0;
 		virtual SkyBox*					GetSkyBox() = 0;
 
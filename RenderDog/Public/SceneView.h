@@ -7,8 +7,13 @@
 #pragma once
 
 #include "Matrix.h"
+#include "Bounding.h"
+#include "OcclusionCulling.h"
+#include "Scene.h"
+#include "ShadowCascade.h"
 
 #include <vector>
+#include <unordered_map>
 
 namespace RenderDog
 {
@@ -17,7 +22,15 @@ namespace RenderDog
 	class FPSCamera;
 	class IConstantBuffer;
 
-	class SceneView
+	//͸ͼԪĻ˳ַʽȰpass
+	enum class DRAW_SORT_MODE
+	{
+		STATE_FIRST,		//ȰɫʺͶ㻺飬״̬л
+		FRONT_TO_BACK		//ȰɽԶ򣬾޳ڵ
+	};
+
+	//SceneViewҽӵ֮ͨISceneListenerͼԪ͹Դı仯ʱÿ֡Ҫռ
+	class SceneView : public ISceneListener
 	{
 	private:
 		struct SceneViewRenderData
@@ -40,7 +53,26 @@ namespace RenderDog
 		SceneView(FPSCamera* pCamera);
 		~SceneView();
 
+		//ҽӵռеͼԪͷ⣬֮ɳ֪ͨ仯ҽһʱȶϿ֮ǰĳ
+		void						AttachScene(IScene* pScene);
+		void						DetachScene();
+		IScene*						GetAttachedScene() { return m_pAttachedScene; }
+
 		void						AddPrimitive(IPrimitive* pPri);
+		//޳óеͼԪΪбֻгеͼԪɾʱռ
+		void						AddScenePrimitives(IScene* pScene);
+		//׶ڵ޳еͼԪֻӿɼͼԪAABBЧͼԪǻᱻӣͼԪ϶ʱʹóBVH
+		void						AddVisiblePrimitives(IScene* pScene, const Matrix4x4& worldToClip);
+		uint32_t					GetCulledPrisNum() const { return m_CulledPrisNum; }
+		uint32_t					GetOccludedPrisNum() const { return m_OccludedPrisNum; }
+
+		void						SetOcclusionCullingEnable(bool bEnable) { m_bOcclusionCullingEnable = bEnable; }
+		const OcclusionBuffer&		GetOcclusionBuffer() const { return m_OcclusionBuffer; }
+
+		//64λͼԪҪͼԪ֮Ⱦ֮ǰãбûб仯ʱֻFRONT_TO_BACKҪ
+		void						SortPrimitives();
+		void						SetOpaqueSortMode(DRAW_SORT_MODE mode) { m_OpaqueSortMode = mode; }
+		DRAW_SORT_MODE				GetOpaqueSortMode() const { return m_OpaqueSortMode; }
 
 		IPrimitive*					GetOpaquePri(uint32_t index);
 		uint32_t					GetOpaquePrisNum() const { return (uint32_t)m_OpaquePris.size(); }
@@ -61,34 +93,91 @@ namespace RenderDog
 		void						SetViewToClipMatrix(const Matrix4x4& mat) { m_ViewToClipMatrix = mat; }
 		const Matrix4x4&			GetViewToClipMatrix() const { return m_ViewToClipMatrix; }
 
-		void						SetShadowWorldToViewMatrix(const Matrix4x4& mat) { m_ShadowWorldToViewMatrix = mat; }
-		const Matrix4x4&			GetShadowWorldToViewMatrix() const { return m_ShadowWorldToViewMatrix; }
-
-		void						SetShadowViewToClipMatrix(const Matrix4x4& mat) { m_ShadowViewToClipMatrix = mat; }
-		const Matrix4x4&			GetShadowViewToClipMatrix() const { return m_ShadowViewToClipMatrix; }
+		void						SetShadowCascades(const ShadowCascadeSetup& setup) { m_ShadowCascades = setup; }
+		const ShadowCascadeSetup&	GetShadowCascades() const { return m_ShadowCascades; }
 
 		void						ClearPrimitives();
 		void						ClearLights();
 
+		//дɫҪĳʱӰֻԴ۲ɫѡ
 		void						UpdateRenderData();
+		//ĳһӰ֮ǰãӰһͶӰмUpdateShadowReceiverDataָ
+		void						UpdateShadowCascadeData(uint32_t cascadeIndex);
+		void						UpdateShadowReceiverData();
+
+		//źĲ͸ͼԪ׶޳ԭĻ˳
+		void						CullOpaquePrimitives(const Matrix4x4& worldToClip, std::vector<IPrimitive*>& outPris);
 
 		IConstantBuffer*			GetViewParamConstantBuffer() const { return m_pRenderData->pViewParamCB; }
 
+		virtual void				OnPrimitiveRegistered(IPrimitive* pPrimitive) override;
+		virtual void				OnPrimitiveUnregistered(IPrimitive* pPrimitive) override;
+		virtual void				OnPrimitiveMoved(IPrimitive* pPrimitive) override;
+		virtual void				OnLightRegistered(ILight* pLight) override;
+		virtual void				OnLightUnregistered(ILight* pLight) override;
+		virtual void				OnSceneCleared() override;
+		virtual void				OnSceneReleased() override;
+
 	private:
+		//׶޳ͼԪûڵʱfalse
+		bool						RenderOccluders(const Matrix4x4& worldToClip);
+
 		void						InitRenderData();
 		void						ReleaseRenderData();
 
+		uint64_t					CalcSortKey(const IPrimitive* pPri, DRAW_SORT_MODE mode);
+		void						SortPrimitivesByKey(std::vector<IPrimitive*>& pris, DRAW_SORT_MODE mode);
+
 	private:
 		std::vector<IPrimitive*>	m_OpaquePris;
 		std::vector<IPrimitive*>	m_SimplePris;
 		std::vector<ILight*>		m_Lights;
 		FPSCamera*					m_pCamera;
+		//AddPrimitiveClearPrimitives֮ΪtrueSortPrimitives֮Ϊfalse
+		bool						m_bPrisChanged;
+
+		//ҽӵĳеͼԪ˳볡еĲͬm_ScenePriAABBs֮һһӦֻͼԪƶʱ
+		IScene*						m_pAttachedScene;
+		std::vector<IPrimitive*>	m_ScenePris;
+		std::vector<AABB>			m_ScenePriAABBs;
+		std::unordered_map<IPrimitive*, uint32_t>	m_ScenePriIndices;
+		//еͼԪɾAddScenePrimitivesҪռ
+		bool						m_bScenePrisChanged;
+
+		//׶޳ĲԽÿ֡ñظ
+		std::vector<CONTAINMENT_TYPE>	m_CullingResults;
+		std::vector<IPrimitive*>		m_CullingVisiblePris;
+		uint32_t					m_CulledPrisNum;
+
+		struct OccluderCandidate
+		{
+			OccluderData			data;
+			float					screenSize;
+		};
+
+		OcclusionBuffer					m_OcclusionBuffer;
+		std::vector<OccluderCandidate>	m_OccluderCandidates;
+		bool						m_bOcclusionCullingEnable;
+		uint32_t					m_OccludedPrisNum;
+
+		struct DrawSortItem
+		{
+			uint64_t				key;
+			IPrimitive*				pPri;
+		};
+
+		DRAW_SORT_MODE				m_OpaqueSortMode;
+		std::vector<DrawSortItem>	m_SortItems;
+		std::vector<DrawSortItem>	m_SortTempItems;
+		//ɫʺͻеıţһγֵ˳䣬ֲ֡
+		std::unordered_map<const void*, uint32_t>	m_ShaderSortIds;
+		std::unordered_map<const void*, uint32_t>	m_MaterialSortIds;
+		std::unordered_map<const void*, uint32_t>	m_BufferSortIds;
 
 		Matrix4x4					m_WorldToViewMatrix;
 		Matrix4x4					m_ViewToClipMatrix;
 
-		Matrix4x4					m_ShadowWorldToViewMatrix;
-		Matrix4x4					m_ShadowViewToClipMatrix;
+		ShadowCascadeSetup			m_ShadowCascades;
 
 		SceneViewRenderData*		m_pRenderData;
 	};
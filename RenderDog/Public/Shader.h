@@ -58,6 +58,12 @@ namespace RenderDog
 		}
 	};
 
+	struct PerObjectTransformData
+	{
+		Matrix4x4			localToWorldMatrix;
+		Matrix4x4			localToWorldNormalMatrix;	//LocalToWorldתãڱ任
+	};
+
 	struct ViewParamData
 	{
 		Matrix4x4			worldToViewMatrix;
@@ -79,7 +85,10 @@ namespace RenderDog
 
 	struct ShadowParamData
 	{
-		Vector4				param0;			//x: shadowDepthOffset, y: shadowDistance
+		Vector4				param0;			//x: shadowDepthOffset, y: ÿһӰͼı߳, z: 
+		//Դ۲ռ䵽ÿһüռͶӰֻźƽƣɫ
+		Vector4				cascadeScales[g_ShadowCascadeNum];
+		Vector4				cascadeOffsets[g_ShadowCascadeNum];
 	};
 
 	struct ShaderMacro
@@ -241,6 +250,8 @@ namespace RenderDog
 		virtual int					GetSamplerStateSlotByName(const std::string& name) = 0;
 
 		virtual void				Apply(const ShaderPerObjParam* pPerObjParam = nullptr) = 0;
+		//ɫѾʱֻÿĲʹͬһɫʱ
+		virtual void				ApplyPerObjParam(const ShaderPerObjParam* pPerObjParam) { Apply(pPerObjParam); }
 		virtual void				ApplyMaterialParams(IMaterialInstance* pMtlIns) = 0;
 	};
 
@@ -0,0 +1,52 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: ShadowCascade.h
+//Written by Xiang Weikang
+//Desc: ⼶Ӱ׶尴ֶΣÿһضͶӰס
+////////////////////////////////////////
+
+#pragma once
+
+#include "Matrix.h"
+#include "Bounding.h"
+#include "GlobalValue.h"
+
+#include <cstdint>
+
+namespace RenderDog
+{
+	class FPSCamera;
+
+	struct ShadowCascade
+	{
+		Matrix4x4		viewToClipMatrix;	//Դ۲ռ䵽һӰͼüռ
+		Matrix4x4		worldToClipMatrix;	//޳һͶӰ
+		float			splitNear;			//һǵӿռȷΧ
+		float			splitFar;
+
+		ShadowCascade() :
+			viewToClipMatrix(GetIdentityMatrix()),
+			worldToClipMatrix(GetIdentityMatrix()),
+			splitNear(0.0f),
+			splitFar(0.0f)
+		{}
+	};
+
+	struct ShadowCascadeSetup
+	{
+		Matrix4x4		worldToViewMatrix;	//мõĹԴ۲
+		ShadowCascade	cascades[g_ShadowCascadeNum];
+		uint32_t		cascadeNum;			//Ϊ0ʱʾûӰ
+
+		ShadowCascadeSetup() :
+			worldToViewMatrix(GetIdentityMatrix()),
+			cascadeNum(0)
+		{}
+	};
+
+	//lightDirΪߵĴcascadeMapSizeΪÿһӰͼı߳ΧİһشС룬
+	//ƽƺתʱӰԵ˸Ϊʱfalse
+	bool	CalcShadowCascades(const FPSCamera& camera, const Vector3& lightDir, const BoundingSphere& sceneSphere,
+							   float shadowDistance, uint32_t cascadeMapSize, ShadowCascadeSetup& outSetup);
+
+}// namespace RenderDog
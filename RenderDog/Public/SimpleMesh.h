@@ -9,6 +9,7 @@
 
 #include "Primitive.h"
 #include "Bounding.h"
+#include "ObjectPool.h"
 
 #include <vector>
 
@@ -28,6 +29,8 @@ namespace RenderDog
 			pVS(nullptr),
 			pLocalToWorldCB(nullptr)
 		{}
+
+		RD_POOLED_OBJECT(SimpleMeshRenderData)
 	};
 
 	//------------------------------------------------------------------------
@@ -45,11 +48,15 @@ namespace RenderDog
 		SimpleMesh& operator=(const SimpleMesh& mesh);
 
 		virtual void					Render(IPrimitiveRenderer* pPrimitiveRenderer) override;
+		virtual void					GetRenderParam(PrimitiveRenderParam& outRenderParam) const override;
 
 		virtual PRIMITIVE_TYPE			GetPriType() const override { return PRIMITIVE_TYPE::SIMPLE_PRI; }
 
 		virtual const AABB&				GetAABB() const override { return m_AABB; }
 
+		//SimpleMeshAABB㣬ʼЧԲҪ֪ͨ
+		virtual void					SetBoundsListener(IPrimitiveBoundsListener* pListener, uint32_t primitiveId) override {}
+
 		void							LoadFromSimpleData(const std::vector<SimpleVertex>& vertices, const std::vector<uint32_t>& indices, const std::string& name);
 
 		void							GenVerticesAndIndices(std::vector<SimpleVertex>& rawVertices);
@@ -34,6 +34,7 @@ namespace RenderDog
 														const std::string& fileName);
 
 		void						RegisterToScene(IScene* pScene);
+		void						UnregisterFromScene(IScene* pScene);
 
 		void						SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale);
 
@@ -24,7 +24,7 @@ namespace RenderDog
 
 		Skeleton& operator=(const Skeleton& skel);
 
-		void				SetLocalMatrix(const Matrix4x4& matrix) { m_LocalMatrix = matrix; }
+		void				SetLocalMatrix(const Matrix4x4& matrix) { m_LocalMatrix = Matrix3x4(matrix); }
 
 		Bone&				GetBone(uint32_t index) { return m_Bones[index]; }
 		const Bone&			GetBone(uint32_t index) const { return m_Bones[index]; }
@@ -39,7 +39,7 @@ namespace RenderDog
 	private:
 		std::vector<Bone>	m_Bones;
 
-		Matrix4x4			m_LocalMatrix;
+		Matrix3x4			m_LocalMatrix;
 	};
 
 }// namespace RenderDog
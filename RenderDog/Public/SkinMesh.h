@@ -13,6 +13,10 @@
 #include "Matrix.h"
 #include "GlobalValue.h"
 #include "Material.h"
+#include "MeshLOD.h"
+#include "ObjectPool.h"
+#include "TransformSystem.h"
+#include "TriangleBVH.h"
 
 #include <vector>
 #include <string>
@@ -24,6 +28,9 @@ namespace RenderDog
 		IVertexBuffer*		pVB;
 		IIndexBuffer*		pIB;
 
+		std::vector<IVertexBuffer*>	lodVBs;		//iԪΪi + 1LOD
+		std::vector<IIndexBuffer*>	lodIBs;
+
 		IShader*			pVS;
 		IShader*			pShadowVS;
 		IConstantBuffer*	pLocalToWorldCB;
@@ -32,14 +39,18 @@ namespace RenderDog
 		SkinMeshRenderData() :
 			pVB(nullptr),
 			pIB(nullptr),
+			lodVBs(0),
+			lodIBs(0),
 			pVS(nullptr),
 			pShadowVS(nullptr),
 			pLocalToWorldCB(nullptr),
 			pBoneTransformCB(nullptr)
 		{}
+
+		RD_POOLED_OBJECT(SkinMeshRenderData)
 	};
 
-	class SkinMesh : public IPrimitive
+	class SkinMesh : public IPrimitive, public ITransformListener
 	{
 	public:
 		SkinMesh();
@@ -51,9 +62,18 @@ namespace RenderDog
 		explicit SkinMesh(const std::string& name);
 
 		virtual void					Render(IPrimitiveRenderer* pPrimitiveRenderer) override;
+		virtual void					GetRenderParam(PrimitiveRenderParam& outRenderParam) const override;
 		virtual PRIMITIVE_TYPE			GetPriType() const override { return PRIMITIVE_TYPE::SKIN_PRI; }
+		//Ⱦ߳ʹõİΧУȾ߳ʱSetPosGestureύ
 		virtual const AABB&				GetAABB() const override { return m_AABB; }
 
+		virtual void					SetBoundsListener(IPrimitiveBoundsListener* pListener, uint32_t primitiveId) override { m_pBoundsListener = pListener; m_PrimitiveId = primitiveId; }
+
+		virtual void					SelectLOD(float screenSize) override { m_CurrLOD = SelectMeshLOD(m_LODs, m_CurrLOD, screenSize); }
+
+		//涯仯Ƶβܴǰ״߲ѯֻʹAABB
+		virtual bool					GetRaycastData(RaycastData& outData) const override { outData.pTriangleBVH = nullptr; return true; }
+
 		void							LoadFromSkinData(const std::vector<SkinVertex>& vertices, const std::vector<uint32_t>& indices, const std::string& name);
 								
 		bool							CreateMaterialInstance(IMaterial* pMtl, const std::vector<MaterialParam>* pMtlParams);
@@ -62,19 +82,30 @@ namespace RenderDog
 
 		void							InitRenderData();
 
+		//ֻ޸ı任ϵͳеľֲ任ΧкͳTransformSystem::Updateʱ
 		void							SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale);
+		//ͨTransformSystem::SetParentҵڵ
+		uint32_t						GetTransformId() const { return m_TransformId; }
+
+		virtual void					OnTransformUpdated(uint32_t transformId, const Matrix3x4& localToWorld, const AABB& worldAABB) override;
 
 										//úĶ뱣֤䶥ΪɢĶ㣬Ϊ3
 		void							CalcTangentsAndGenIndices(std::vector<SkinVertex>& rawVertices, const std::vector<uint32_t>& smoothGroup);
 		void							CalculateAABB();
+										//Ϸ߳ʹõİΧУTransformSystem::Update֮
+		const AABB&						GetGameAABB() const { return m_GameAABB; }
+
+										//ҪInitRenderData֮ǰ
+		void							GenerateLODs();
+		uint32_t						GetLODNum() const { return (uint32_t)m_LODs.size() + 1; }
+		uint32_t						GetCurrLOD() const { return m_CurrLOD; }
+		void							SetLODScreenSize(uint32_t lod, float screenSize);
 
 		void							Update(SkinModelPerObjectTransform& perModelTransform);
 
 	private:
 		void							CloneRenderData(const SkinMesh& mesh);
 		void							ReleaseRenderData();
-										// λԼÿ֡ʱҪAABB
-		void							UpdateAABB(const Matrix4x4& absTransMatrix);
 
 
 	private:
@@ -83,11 +114,20 @@ namespace RenderDog
 		std::vector<SkinVertex>			m_Vertices;
 		std::vector<uint32_t>			m_Indices;
 
+		std::vector<MeshLODData<SkinVertex>>	m_LODs;
+		uint32_t						m_CurrLOD;
+
 		SkinMeshRenderData*				m_pRenderData;
 
 		IMaterialInstance*				m_pMtlIns;
 
 		AABB							m_AABB;
+		AABB							m_GameAABB;
+
+		IPrimitiveBoundsListener*		m_pBoundsListener;
+		uint32_t						m_PrimitiveId;
+
+		uint32_t						m_TransformId;
 	};
 
 }// namespace RenderDog
@@ -38,6 +38,7 @@ namespace RenderDog
 		bool							LoadMaterialInstance();
 
 		void							RegisterToScene(IScene* pScene);
+		void							UnregisterFromScene(IScene* pScene);
 
 		void							SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale);
 
@@ -49,7 +50,7 @@ namespace RenderDog
 	private:
 		void							CalculateBoundings();
 										//λ˵ʱ°Χ
-		void							UpdateBoundings();
+		void							UpdateBoundings(const Matrix3x4& localToWorld);
 
 	private:
 		std::string						m_Name;
@@ -58,6 +59,7 @@ namespace RenderDog
 		std::vector<SkinMesh>			m_Meshes;
 		Skeleton*						m_pSkeleton;
 
+		AABB							m_LocalAABB;
 		AABB							m_AABB;
 		BoundingSphere					m_BoundingSphere;
 
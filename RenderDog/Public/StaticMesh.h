@@ -10,9 +10,14 @@
 #include "Texture.h"
 #include "Bounding.h"
 #include "Material.h"
+#include "MeshLOD.h"
+#include "ObjectPool.h"
+#include "TransformSystem.h"
+#include "TriangleBVH.h"
 
 #include <vector>
 #include <string>
+#include <atomic>
 
 #pragma once
 
@@ -25,6 +30,9 @@ namespace RenderDog
 		IVertexBuffer*		pVB;
 		IIndexBuffer*		pIB;
 
+		std::vector<IVertexBuffer*>	lodVBs;		//iԪΪi + 1LOD
+		std::vector<IIndexBuffer*>	lodIBs;
+
 		IShader*			pVS;
 		IShader*			pShadowVS;
 		IConstantBuffer*	pLocalToWorldCB;
@@ -32,13 +40,17 @@ namespace RenderDog
 		StaticMeshRenderData() :
 			pVB(nullptr),
 			pIB(nullptr),
+			lodVBs(0),
+			lodIBs(0),
 			pVS(nullptr),
 			pShadowVS(nullptr),
 			pLocalToWorldCB(nullptr)
 		{}
+
+		RD_POOLED_OBJECT(StaticMeshRenderData)
 	};
 
-	class StaticMesh : public IPrimitive
+	class StaticMesh : public IPrimitive, public ITransformListener
 	{
 	public:
 		StaticMesh();
@@ -50,11 +62,24 @@ namespace RenderDog
 		explicit StaticMesh(const std::string& name);
 
 		virtual void					Render(IPrimitiveRenderer* pPrimitiveRenderer) override;
+		virtual void					GetRenderParam(PrimitiveRenderParam& outRenderParam) const override;
 
 		virtual PRIMITIVE_TYPE			GetPriType() const override { return PRIMITIVE_TYPE::STATIC_PRI; }
 
+		//Ⱦ߳ʹõİΧУȾ߳ʱSetPosGestureύ
 		virtual const AABB&				GetAABB() const override { return m_AABB; }
 
+		virtual void					SetBoundsListener(IPrimitiveBoundsListener* pListener, uint32_t primitiveId) override { m_pBoundsListener = pListener; m_PrimitiveId = primitiveId; }
+
+		virtual void					SelectLOD(float screenSize) override { m_CurrLOD = SelectMeshLOD(m_LODs, m_CurrLOD, screenSize); }
+
+		virtual bool					GetOccluderData(OccluderData& outData) const override;
+		//ΪڵӦ١ϴ壬ǽͽ
+		void							SetOccluder(bool bOccluder) { m_bOccluder = bOccluder; }
+
+		//BVHڵһβѯʱm_Verticesm_IndicesαŶӦ߼LOD
+		virtual bool					GetRaycastData(RaycastData& outData) const override;
+
 		void							LoadFromStandardData(const std::vector<StandardVertex>& vertices, const std::vector<uint32_t>& indices, const std::string& name);
 
 		bool							CreateMaterialInstance(IMaterial* pMtl, const std::vector<MaterialParam>* mtlParams = nullptr);
@@ -63,19 +88,32 @@ namespace RenderDog
 
 		void							InitRenderData();
 
+		//ֻ޸ı任ϵͳеľֲ任ΧкͳTransformSystem::Updateʱ
 		void							SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale);
+		//ͨTransformSystem::SetParentҵڵ
+		uint32_t						GetTransformId() const { return m_TransformId; }
+
+		virtual void					OnTransformUpdated(uint32_t transformId, const Matrix3x4& localToWorld, const AABB& worldAABB) override;
 
 										//ú뱣֤ΪɢĶ㣬Ϊ3
 		void							CalcTangentsAndGenIndices(std::vector<StandardVertex>& rawVertices, const std::vector<uint32_t>& smoothGroup);
 		void							CalculateAABB();
+										//Ϸ߳ʹõİΧУTransformSystem::Update֮
+		const AABB&						GetGameAABB() const { return m_GameAABB; }
+
+										//ҪInitRenderData֮ǰ
+		void							GenerateLODs();
+		uint32_t						GetLODNum() const { return (uint32_t)m_LODs.size() + 1; }
+		uint32_t						GetCurrLOD() const { return m_CurrLOD; }
+		void							SetLODScreenSize(uint32_t lod, float screenSize);
 
 		IMaterialInstance*				GetMaterialInstance() const { return m_pMtlIns; }
 
 	private:
 		void							CloneRenderData(const StaticMesh& mesh);
 		void							ReleaseRenderData();
-										// Use to update aabb when setPosGesture;
-		void							UpdateAABB(const Matrix4x4& absTransMatrix);
+		//ı֮Ҫͷţһβѯʱ¹
+		void							ReleaseTriangleBVH();
 
 	private:
 		std::string						m_Name;
@@ -83,11 +121,25 @@ namespace RenderDog
 		std::vector<StandardVertex>		m_Vertices;
 		std::vector<uint32_t>			m_Indices;
 
+		std::vector<MeshLODData<StandardVertex>>	m_LODs;
+		uint32_t						m_CurrLOD;
+
 		StaticMeshRenderData*			m_pRenderData;
 
 		IMaterialInstance*				m_pMtlIns;
 
 		AABB							m_AABB;
+		AABB							m_GameAABB;
+
+		IPrimitiveBoundsListener*		m_pBoundsListener;
+		uint32_t						m_PrimitiveId;
+
+		uint32_t						m_TransformId;
+
+		bool							m_bOccluder;
+		Matrix4x4						m_LocalToWorldMatrix;
+
+		mutable std::atomic<TriangleBVH*>	m_pTriangleBVH;
 	};
 
 }// namespace RenderDog
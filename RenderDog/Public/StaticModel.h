@@ -37,20 +37,25 @@ namespace RenderDog
 		bool						LoadMaterialInstance();
 		
 		void						RegisterToScene(IScene* pScene);
+		void						UnregisterFromScene(IScene* pScene);
 
 		void						SetPosGesture(const Vector3& pos, const Vector3& euler, const Vector3& scale);
 
+		//ģΪڵ޳ڵ
+		void						SetOccluder(bool bOccluder);
+
 		const AABB&					GetAABB() const { return m_AABB; }
 		const BoundingSphere&		GetBoundingSphere() const { return m_BoundingSphere; }
 
 	private:
 		void						CalculateBoundings();
 									//λ˵ʱ°Χ
-		void						UpdateBoundings();
+		void						UpdateBoundings(const Matrix3x4& localToWorld);
 
 	private:
 		std::vector<StaticMesh>		m_Meshes;
 
+		AABB						m_LocalAABB;
 		AABB						m_AABB;
 		BoundingSphere				m_BoundingSphere;
 
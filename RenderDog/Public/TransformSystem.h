@@ -0,0 +1,105 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: TransformSystem.h
+//Written by Xiang Weikang
+//Desc: 㼶任ϵͳֲ任SoAţ޸ʱֻǣÿ֡㼶Ȳи
+////////////////////////////////////////
+
+#pragma once
+
+#include "Matrix.h"
+#include "Bounding.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace RenderDog
+{
+	static const uint32_t	TRANSFORM_INVALID_ID = 0xffffffff;
+	//ͬһ㼶ҪµĽڵ㳬ʱŲֵ߳
+	static const uint32_t	TRANSFORM_PARALLEL_BATCH_SIZE = 256;
+
+	class ITransformListener
+	{
+	public:
+		virtual ~ITransformListener() = default;
+
+		//TransformSystem::UpdateаڵãʱϷ߳
+		virtual void				OnTransformUpdated(uint32_t transformId, const Matrix3x4& localToWorld, const AABB& worldAABB) = 0;
+	};
+
+	//нӿֻϷ̵߳
+	class TransformSystem
+	{
+	public:
+		TransformSystem();
+		~TransformSystem();
+
+		TransformSystem(const TransformSystem&) = delete;
+		TransformSystem& operator=(const TransformSystem&) = delete;
+
+		//ڵ㱻ͷźŻᱻ
+		uint32_t					CreateTransform(ITransformListener* pListener = nullptr, uint32_t parentId = TRANSFORM_INVALID_ID);
+		//ӽڵΪڵ㣬Եľֲ任
+		void						DestroyTransform(uint32_t transformId);
+
+		//parentIdtransformIdڵ㣬򷵻false
+		bool						SetParent(uint32_t transformId, uint32_t parentId);
+		uint32_t					GetParent(uint32_t transformId) const { return m_Parents[transformId]; }
+		uint32_t					GetDepth(uint32_t transformId) const { return m_Depths[transformId]; }
+
+		void						SetListener(uint32_t transformId, ITransformListener* pListener) { m_Listeners[transformId] = pListener; }
+
+		//ֻǽڵ㣬任ͰΧһUpdateʱŻ
+		void						SetLocalTransform(uint32_t transformId, const Matrix3x4& localTransform);
+		void						SetLocalBounds(uint32_t transformId, const AABB& localAABB);
+
+		const Matrix3x4&			GetLocalTransform(uint32_t transformId) const { return m_LocalTransforms[transformId]; }
+		const AABB&					GetLocalBounds(uint32_t transformId) const { return m_LocalAABBs[transformId]; }
+
+		//һUpdateĽ
+		const Matrix3x4&			GetWorldTransform(uint32_t transformId) const { return m_WorldTransforms[transformId]; }
+		const AABB&					GetWorldBounds(uint32_t transformId) const { return m_WorldAABBs[transformId]; }
+
+		//ǳ±ǵĽڵ㼰ڵ㣬ÿڲУظµĽڵ
+		uint32_t					Update();
+
+		uint32_t					GetTransformNum() const { return m_TransformNum; }
+
+	private:
+		void						MarkDirty(uint32_t transformId);
+		void						AttachToParent(uint32_t transformId, uint32_t parentId);
+		void						DetachFromParent(uint32_t transformId);
+		void						UpdateSubtreeDepth(uint32_t transformId);
+
+	private:
+		enum TRANSFORM_FLAG : uint8_t
+		{
+			TRANSFORM_FLAG_ALIVE	= 0x01,
+			TRANSFORM_FLAG_DIRTY	= 0x02
+		};
+
+		//SoA飬ʱÿֻҪ
+		std::vector<Matrix3x4>		m_LocalTransforms;
+		std::vector<Matrix3x4>		m_WorldTransforms;
+		std::vector<AABB>			m_LocalAABBs;
+		std::vector<AABB>			m_WorldAABBs;
+		std::vector<uint32_t>		m_Parents;
+		std::vector<uint32_t>		m_FirstChildren;
+		std::vector<uint32_t>		m_NextSiblings;
+		std::vector<uint32_t>		m_Depths;
+		std::vector<uint8_t>		m_Flags;
+		std::vector<ITransformListener*>	m_Listeners;
+
+		std::vector<uint32_t>		m_FreeIds;
+		uint32_t					m_TransformNum;
+
+		//iԪΪΪiڵ㣬ڵȸıɵļ¼ڸʱ
+		std::vector<std::vector<uint32_t>>	m_DirtyLevels;
+		std::vector<uint32_t>		m_UpdateList;
+		std::vector<uint32_t>		m_UpdatedIds;
+	};
+
+	extern TransformSystem* g_pTransformSystem;
+
+}// namespace RenderDog
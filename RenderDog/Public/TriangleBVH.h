@@ -0,0 +1,120 @@
+////////////////////////////////////////
+//RenderDog <,>
+//FileName: TriangleBVH.h
+//Written by Xiang Weikang
+//Desc: εĲBVHʰȡμĲѯһڵ4ӽڵһҶڵ4SIMDһ
+////////////////////////////////////////
+
+#pragma once
+
+#include "Vector.h"
+#include "Matrix.h"
+#include "Bounding.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace RenderDog
+{
+	static const uint32_t	TRIANGLE_BVH_INVALID_INDEX = 0xffffffff;
+	//ÿڵӽڵҲÿҶڵ
+	static const uint32_t	TRIANGLE_BVH_WIDTH = 4;
+
+	struct TriangleBVHBuildTriangle;
+
+	struct TriangleRayHit
+	{
+		float		distance;		//ray.directionĳΪλ
+		uint32_t	triangle;		//е±3
+		float		u;				//꣬Ϊ(1 - u - v) * p0 + u * p1 + v * p2
+		float		v;
+
+		TriangleRayHit() :
+			distance(0.0f),
+			triangle(TRIANGLE_BVH_INVALID_INDEX),
+			u(0.0f),
+			v(0.0f)
+		{}
+	};
+
+	class TriangleBVH
+	{
+	private:
+		//ӽڵİΧаֿţֱSIMDĴյӽڵΪTRIANGLE_BVH_INVALID_INDEX
+		struct Node
+		{
+			float		minX[TRIANGLE_BVH_WIDTH];
+			float		minY[TRIANGLE_BVH_WIDTH];
+			float		minZ[TRIANGLE_BVH_WIDTH];
+			float		maxX[TRIANGLE_BVH_WIDTH];
+			float		maxY[TRIANGLE_BVH_WIDTH];
+			float		maxZ[TRIANGLE_BVH_WIDTH];
+			uint32_t	children[TRIANGLE_BVH_WIDTH];	//λΪ1ʱıţǽڵı
+			uint32_t	childMask;						//iλʾiӽڵ㲻Ϊ
+		};
+
+		//һҶڵΣ涥p0ߣ4ʱ˻
+		struct TrianglePacket
+		{
+			float		p0X[TRIANGLE_BVH_WIDTH];
+			float		p0Y[TRIANGLE_BVH_WIDTH];
+			float		p0Z[TRIANGLE_BVH_WIDTH];
+			float		edge1X[TRIANGLE_BVH_WIDTH];		//p1 - p0
+			float		edge1Y[TRIANGLE_BVH_WIDTH];
+			float		edge1Z[TRIANGLE_BVH_WIDTH];
+			float		edge2X[TRIANGLE_BVH_WIDTH];		//p2 - p0
+			float		edge2Y[TRIANGLE_BVH_WIDTH];
+			float		edge2Z[TRIANGLE_BVH_WIDTH];
+			uint32_t	triangles[TRIANGLE_BVH_WIDTH];
+		};
+
+	public:
+		TriangleBVH();
+		~TriangleBVH();
+
+		//λðpositionStrideֽڵĲȡOccluderDataһ£Խλᱻ
+		void					Build(const Vector3* pPositions, uint32_t positionStride, uint32_t vertNum, const uint32_t* pIndices, uint32_t indexNum);
+		void					Clear();
+
+		bool					IsEmpty() const { return m_Nodes.empty(); }
+		uint32_t				GetNodeNum() const { return (uint32_t)m_Nodes.size(); }
+		uint32_t				GetTriangleNum() const { return m_TriangleNum; }
+		const AABB&				GetBounds() const { return m_Bounds; }
+
+		//maxDistance֮Ľ㣬β
+		bool					Raycast(const Ray& ray, float maxDistance, TriangleRayHit& outHit) const;
+		//ҵһͷأֻҪжڵ߶βѯ
+		bool					RaycastAny(const Ray& ray, float maxDistance) const;
+
+	private:
+		bool					Traverse(const Ray& ray, float maxDistance, bool bAnyHit, TriangleRayHit& outHit) const;
+
+		//ཻӽڵ룬pDistancesΪ߽ÿӽڵľ
+		static uint32_t			IntersectNode(const Node& node, const Vector3& origin, const Vector3& invDirection, float maxDistance, float* pDistances);
+		//ֻҵmaxDistanceĽʱ޸outHit
+		static bool				IntersectPacket(const TrianglePacket& packet, const Ray& ray, float maxDistance, TriangleRayHit& outHit);
+
+		//[begin, end)ֳ֣طֽλãbMedianΪtrueʱʹSAHֱӰλ
+		static uint32_t			SplitTriangles(std::vector<TriangleBVHBuildTriangle>& triangles, uint32_t begin, uint32_t end, bool bMedian);
+		uint32_t				CreatePacket(const std::vector<TriangleBVHBuildTriangle>& triangles, uint32_t begin, uint32_t end);
+
+	private:
+		std::vector<Node>		m_Nodes;
+		std::vector<TrianglePacket>	m_Packets;
+		uint32_t				m_TriangleNum;
+		AABB					m_Bounds;
+	};
+
+	//߲ѯͼԪṩݣpTriangleBVHھֲռ䣬ΪʱֻͼԪAABB
+	struct RaycastData
+	{
+		const TriangleBVH*	pTriangleBVH;
+		Matrix3x4			localToWorldMatrix;
+
+		RaycastData() :
+			pTriangleBVH(nullptr),
+			localToWorldMatrix()
+		{}
+	};
+
+}// namespace RenderDog
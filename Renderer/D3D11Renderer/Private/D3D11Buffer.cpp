@@ -6,6 +6,7 @@
 
 #include "Buffer.h"
 #include "RefCntObject.h"
+#include "ObjectPool.h"
 #include "D3D11Renderer.h"
 
 #include <d3d11.h>
@@ -19,6 +20,8 @@ namespace RenderDog
 
 	class D3D11VertexBuffer : public IVertexBuffer, public RefCntObject
 	{
+		RD_POOLED_OBJECT(D3D11VertexBuffer)
+
 	public:
 		explicit D3D11VertexBuffer(const BufferDesc& desc);
 
@@ -49,6 +52,8 @@ namespace RenderDog
 
 	class D3D11IndexBuffer : public IIndexBuffer, public RefCntObject
 	{
+		RD_POOLED_OBJECT(D3D11IndexBuffer)
+
 	public:
 		explicit D3D11IndexBuffer(const BufferDesc& desc);
 		virtual ~D3D11IndexBuffer();
@@ -76,6 +81,8 @@ namespace RenderDog
 
 	class D3D11ConstantBuffer : public IConstantBuffer, public RefCntObject
 	{
+		RD_POOLED_OBJECT(D3D11ConstantBuffer)
+
 	public:
 		explicit D3D11ConstantBuffer(const BufferDesc& desc);
 		virtual ~D3D11ConstantBuffer();
@@ -86,9 +93,11 @@ namespace RenderDog
 
 		virtual const std::string&	GetName() const { return m_Name; }
 		virtual void*				GetResource() override { return (void*)m_pCB; }
+		virtual ResourceHandle		GetHandle() const override { return m_Handle; }
 
 	private:
 		std::string					m_Name;
+		ResourceHandle				m_Handle;
 
 		ID3D11Buffer*				m_pCB;
 		bool						m_IsDynamic;
@@ -124,6 +133,10 @@ namespace RenderDog
 		BufferMap					m_BufferMap;
 	};
 
+	ObjectPool<D3D11VertexBuffer>	D3D11VertexBuffer::s_Pool;
+	ObjectPool<D3D11IndexBuffer>	D3D11IndexBuffer::s_Pool;
+	ObjectPool<D3D11ConstantBuffer>	D3D11ConstantBuffer::s_Pool;
+
 	D3D11BufferManager	g_D3D11BufferManager;
 	IBufferManager*	g_pIBufferManager = &g_D3D11BufferManager;
 
@@ -209,6 +222,7 @@ namespace RenderDog
 	D3D11ConstantBuffer::D3D11ConstantBuffer(const BufferDesc& desc) :
 		RefCntObject(),
 		m_Name(desc.name),
+		m_Handle(),
 		m_pCB(nullptr),
 		m_IsDynamic(desc.isDynamic)
 	{
@@ -222,10 +236,14 @@ namespace RenderDog
 		initData.pSysMem = desc.pInitData;
 
 		g_pD3D11Device->CreateBuffer(&bufferDesc, nullptr, &m_pCB);
+
+		m_Handle = g_pResourceRegistry->Register(RESOURCE_TYPE::CONSTANT_BUFFER, static_cast<IConstantBuffer*>(this));
 	}
 
 	D3D11ConstantBuffer::~D3D11ConstantBuffer()
 	{
+		g_pResourceRegistry->Unregister(m_Handle);
+
 		if (m_pCB)
 		{
 			m_pCB->Release();
@@ -17,9 +17,11 @@
 #include "Texture.h"
 #include "Bounding.h"
 #include "Transform.h"
+#include "ShadowCascade.h"
 #include "Shader.h"
 #include "GlobalValue.h"
 #include "Material.h"
+#include "Profiler.h"
 
 namespace RenderDog
 {
@@ -237,6 +239,10 @@ namespace RenderDog
 
 		virtual void					Render(const PrimitiveRenderParam& renderParam) override;
 
+	protected:
+		//󶨲ɫԼвʹõĻͼӰͼBRDFұ
+		void							ApplyMaterialShader(IShader* pMtlShader);
+
 	protected:
 		ITexture2D*						m_pShadowDepthTexture;
 		ISamplerState*					m_pShadowDepthTextureSampler;
@@ -244,6 +250,14 @@ namespace RenderDog
 		ISamplerState*					m_pEnvReflectionTextureSampler;
 		ITexture2D*						m_pIblBrdfLutTexture;
 		ISamplerState*					m_pIblBrdfLutTextureSampler;
+
+		//һλư󶨵״̬ͼԪڵĻƾʹͬ״̬ͬʱظ
+		bool							m_bStateApplied;
+		IVertexBuffer*					m_pCurrVB;
+		IIndexBuffer*					m_pCurrIB;
+		IShader*						m_pCurrVS;
+		IShader*						m_pCurrMtlShader;
+		IMaterialInstance*				m_pCurrMtlIns;
 	};
 
 	D3D11MeshLightingRenderer::D3D11MeshLightingRenderer(const MeshLightingGlobalData& globalData):
@@ -253,11 +267,24 @@ namespace RenderDog
 		m_pEnvReflectionTexture(globalData.pEnvReflectionTexture),
 		m_pEnvReflectionTextureSampler(globalData.pEnvReflectionTextureSampler),
 		m_pIblBrdfLutTexture(globalData.pIblBrdfLutTexture),
-		m_pIblBrdfLutTextureSampler(globalData.pIblBrdfLutTextureSampler)
+		m_pIblBrdfLutTextureSampler(globalData.pIblBrdfLutTextureSampler),
+		m_bStateApplied(false),
+		m_pCurrVB(nullptr),
+		m_pCurrIB(nullptr),
+		m_pCurrVS(nullptr),
+		m_pCurrMtlShader(nullptr),
+		m_pCurrMtlIns(nullptr)
 	{}
 
 	D3D11MeshLightingRenderer::~D3D11MeshLightingRenderer()
-	{}
+	{
+		//Ӱͼһ֡ΪĿ꣬лƽ
+		if (m_bStateApplied)
+		{
+			ID3D11ShaderResourceView* nullRes[] = { nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,nullptr };
+			g_pD3D11ImmediateContext->PSSetShaderResources(1, 8, nullRes);
+		}
+	}
 
 	void D3D11MeshLightingRenderer::Render(const PrimitiveRenderParam& renderParam)
 	{
@@ -271,20 +298,59 @@ namespace RenderDog
 			return;
 		}
 
-		g_pD3D11ImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		if (!m_bStateApplied)
+		{
+			g_pD3D11ImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		}
 
-		ID3D11Buffer* pVB = (ID3D11Buffer*)(renderParam.pVB->GetResource());
-		ID3D11Buffer* pIB = (ID3D11Buffer*)(renderParam.pIB->GetResource());
-		
-		uint32_t stride = renderParam.pVB->GetStride();
-		uint32_t offset = renderParam.pVB->GetOffset();
-		g_pD3D11ImmediateContext->IASetVertexBuffers(0, 1, &pVB, &stride, &offset);
-		g_pD3D11ImmediateContext->IASetIndexBuffer(pIB, DXGI_FORMAT_R32_UINT, 0);
+		if (!m_bStateApplied || renderParam.pVB != m_pCurrVB)
+		{
+			ID3D11Buffer* pVB = (ID3D11Buffer*)(renderParam.pVB->GetResource());
+			uint32_t stride = renderParam.pVB->GetStride();
+			uint32_t offset = renderParam.pVB->GetOffset();
+			g_pD3D11ImmediateContext->IASetVertexBuffers(0, 1, &pVB, &stride, &offset);
+			m_pCurrVB = renderParam.pVB;
+		}
 
-		renderParam.pVS->Apply(&renderParam.PerObjParam);
+		if (!m_bStateApplied || renderParam.pIB != m_pCurrIB)
+		{
+			ID3D11Buffer* pIB = (ID3D11Buffer*)(renderParam.pIB->GetResource());
+			g_pD3D11ImmediateContext->IASetIndexBuffer(pIB, DXGI_FORMAT_R32_UINT, 0);
+			m_pCurrIB = renderParam.pIB;
+		}
+
+		if (!m_bStateApplied || renderParam.pVS != m_pCurrVS)
+		{
+			renderParam.pVS->Apply(&renderParam.PerObjParam);
+			m_pCurrVS = renderParam.pVS;
+		}
+		else
+		{
+			renderParam.pVS->ApplyPerObjParam(&renderParam.PerObjParam);
+		}
 
 		IShader* pMtlShader = renderParam.pMtlIns->GetMaterial()->GetMaterialShader();
-		
+		if (!m_bStateApplied || pMtlShader != m_pCurrMtlShader)
+		{
+			ApplyMaterialShader(pMtlShader);
+			m_pCurrMtlShader = pMtlShader;
+			m_pCurrMtlIns = nullptr;
+		}
+
+		if (renderParam.pMtlIns != m_pCurrMtlIns)
+		{
+			pMtlShader->ApplyMaterialParams(renderParam.pMtlIns);
+			m_pCurrMtlIns = renderParam.pMtlIns;
+		}
+
+		m_bStateApplied = true;
+
+		uint32_t indexNum = renderParam.pIB->GetIndexNum();
+		g_pD3D11ImmediateContext->DrawIndexed(indexNum, 0, 0);
+	}
+
+	void D3D11MeshLightingRenderer::ApplyMaterialShader(IShader* pMtlShader)
+	{
 		ShaderParam* pSkyCubeTextureParam = pMtlShader->GetShaderParamPtrByName("ComVar_Texture_SkyCubeTexture");
 		pSkyCubeTextureParam->SetTexture(m_pEnvReflectionTexture);
 
@@ -304,14 +370,6 @@ namespace RenderDog
 		pIblBrdfLutTextureSamplerParam->SetSampler(m_pIblBrdfLutTextureSampler);
 
 		pMtlShader->Apply(nullptr);
-
-		pMtlShader->ApplyMaterialParams(renderParam.pMtlIns);
-		
-		uint32_t indexNum = renderParam.pIB->GetIndexNum();
-		g_pD3D11ImmediateContext->DrawIndexed(indexNum, 0, 0);
-
-		ID3D11ShaderResourceView* nullRes[] = { nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,nullptr,nullptr };
-		g_pD3D11ImmediateContext->PSSetShaderResources(1, 8, nullRes);
 	}
 #pragma endregion MeshLightingRenderer
 
@@ -323,10 +381,20 @@ namespace RenderDog
 		virtual ~D3D11MeshShadowRenderer();
 
 		virtual void					Render(const PrimitiveRenderParam& renderParam) override;
+
+	protected:
+		bool							m_bStateApplied;
+		IVertexBuffer*					m_pCurrVB;
+		IIndexBuffer*					m_pCurrIB;
+		IShader*						m_pCurrVS;
 	};
 
 	D3D11MeshShadowRenderer::D3D11MeshShadowRenderer(SceneView* pSceneView):
-		D3D11MeshRenderer(pSceneView)
+		D3D11MeshRenderer(pSceneView),
+		m_bStateApplied(false),
+		m_pCurrVB(nullptr),
+		m_pCurrIB(nullptr),
+		m_pCurrVS(nullptr)
 	{
 		ShaderCompileDesc psDesc = ShaderCompileDesc(g_ShadowDepthPixelShaderFilePath, nullptr, "Main", "ps_5_0", 0);
 		m_pPixelShader = g_pIShaderManager->GetPixelShader(psDesc);
@@ -347,22 +415,42 @@ namespace RenderDog
 			return;
 		}
 
-		g_pD3D11ImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+		if (!m_bStateApplied)
+		{
+			g_pD3D11ImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-		ID3D11Buffer* pVB = (ID3D11Buffer*)(renderParam.pVB->GetResource());
-		ID3D11Buffer* pIB = (ID3D11Buffer*)(renderParam.pIB->GetResource());
-		
-		uint32_t indexNum = renderParam.pIB->GetIndexNum();
+			m_pPixelShader->Apply(nullptr);
+		}
 
-		uint32_t stride = renderParam.pVB->GetStride();
-		uint32_t offset = renderParam.pVB->GetOffset();
-		g_pD3D11ImmediateContext->IASetVertexBuffers(0, 1, &pVB, &stride, &offset);
-		g_pD3D11ImmediateContext->IASetIndexBuffer(pIB, DXGI_FORMAT_R32_UINT, 0);
+		if (!m_bStateApplied || renderParam.pVB != m_pCurrVB)
+		{
+			ID3D11Buffer* pVB = (ID3D11Buffer*)(renderParam.pVB->GetResource());
+			uint32_t stride = renderParam.pVB->GetStride();
+			uint32_t offset = renderParam.pVB->GetOffset();
+			g_pD3D11ImmediateContext->IASetVertexBuffers(0, 1, &pVB, &stride, &offset);
+			m_pCurrVB = renderParam.pVB;
+		}
 
-		renderParam.pShadowVS->Apply(&renderParam.PerObjParam);
+		if (!m_bStateApplied || renderParam.pIB != m_pCurrIB)
+		{
+			ID3D11Buffer* pIB = (ID3D11Buffer*)(renderParam.pIB->GetResource());
+			g_pD3D11ImmediateContext->IASetIndexBuffer(pIB, DXGI_FORMAT_R32_UINT, 0);
+			m_pCurrIB = renderParam.pIB;
+		}
 
-		m_pPixelShader->Apply(nullptr);
+		if (!m_bStateApplied || renderParam.pShadowVS != m_pCurrVS)
+		{
+			renderParam.pShadowVS->Apply(&renderParam.PerObjParam);
+			m_pCurrVS = renderParam.pShadowVS;
+		}
+		else
+		{
+			renderParam.pShadowVS->ApplyPerObjParam(&renderParam.PerObjParam);
+		}
 
+		m_bStateApplied = true;
+
+		uint32_t indexNum = renderParam.pIB->GetIndexNum();
 		g_pD3D11ImmediateContext->DrawIndexed(indexNum, 0, 0);
 	}
 #pragma endregion MeshShadowRenderer
@@ -399,6 +487,7 @@ namespace RenderDog
 		//Shadow
 		void						AddPrisToShadowView(IScene* pScene);
 		void						CalcShadowMatrix(IScene* pScene);
+		void						CullShadowCasters();
 		void						ShadowDepthPass();
 
 		void						ClearBackRenderTarget(float* clearColor);
@@ -420,7 +509,10 @@ namespace RenderDog
 		//Shadow
 		SceneView*					m_pShadowSceneView;
 
-		D3D11_VIEWPORT				m_ShadowViewport;
+		//ÿһӰͼеӿڣ2x2
+		D3D11_VIEWPORT				m_ShadowCascadeViewports[g_ShadowCascadeNum];
+		//ÿһ޳ͶӰ壬ShadowSceneViewеĻ˳
+		std::vector<IPrimitive*>	m_ShadowCasterPris[g_ShadowCascadeNum];
 
 		ITexture2D*					m_pIblBrdfLutTexture;
 		ISamplerState*				m_pIblBrdfLutTextureSampler;
@@ -456,7 +548,7 @@ namespace RenderDog
 		m_pRenderTargetView(nullptr),
 		m_pDepthStencilView(nullptr),
 		m_ScreenViewport(),
-		m_ShadowViewport(),
+		m_ShadowCascadeViewports(),
 		m_pShadowSceneView(nullptr),
 		m_pSceneView(nullptr),
 		m_pIblBrdfLutTexture(nullptr),
@@ -567,7 +659,8 @@ namespace RenderDog
 			return false;
 		}
 
-		int ShadowMapSize = g_ShadowMapRTSize;
+		//мͬһͼУɫʱֻҪһӰͼ
+		int ShadowMapSize = g_ShadowMapRTSize * 2;
 		if (!CreateShadowResources(ShadowMapSize, ShadowMapSize))
 		{
 			return false;
@@ -686,13 +779,15 @@ namespace RenderDog
 
 	void D3D11Renderer::Update(IScene* pScene)
 	{
-		m_pShadowSceneView->ClearPrimitives();
 		AddPrisToShadowView(pScene);
+		m_pShadowSceneView->SortPrimitives();
 
 		m_pSceneView->ClearPrimitives();
 		AddPrisAndLightsToSceneView(pScene);
+		m_pSceneView->SortPrimitives();
 
 		CalcShadowMatrix(pScene);
+		CullShadowCasters();
 		m_pSceneView->UpdateRenderData();
 	}
 
@@ -708,7 +803,10 @@ namespace RenderDog
 		
 		RenderSky(pScene);
 		
-		m_pSwapChain->Present(0, 0);
+		{
+			RD_PROFILE_SCOPE("D3D11Renderer::Present");
+			m_pSwapChain->Present(0, 0);
+		}
 	}
 	
 	bool D3D11Renderer::OnResize(uint32_t width, uint32_t height)
@@ -781,13 +879,16 @@ namespace RenderDog
 		g_pD3D11ImmediateContext->RSSetViewports(1, &m_ScreenViewport);
 
 		float shadowMapSize = static_cast<float>(g_ShadowMapRTSize);
-		m_ShadowViewport.TopLeftX = 0;
-		m_ShadowViewport.TopLeftY = 0;
-		m_ShadowViewport.Width = shadowMapSize;
-		m_ShadowViewport.Height = shadowMapSize;
-		m_ShadowViewport.MinDepth = 0;
-		m_ShadowViewport.MaxDepth = 1;
-		g_pD3D11ImmediateContext->RSSetViewports(1, &m_ShadowViewport);
+		for (int i = 0; i < g_ShadowCascadeNum; ++i)
+		{
+			D3D11_VIEWPORT& cascadeViewport = m_ShadowCascadeViewports[i];
+			cascadeViewport.TopLeftX = (i % 2) * shadowMapSize;
+			cascadeViewport.TopLeftY = (i / 2) * shadowMapSize;
+			cascadeViewport.Width = shadowMapSize;
+			cascadeViewport.Height = shadowMapSize;
+			cascadeViewport.MinDepth = 0;
+			cascadeViewport.MaxDepth = 1;
+		}
 
 		if (m_pSceneView && m_pSceneView->GetCamera())
 		{
@@ -980,60 +1081,71 @@ namespace RenderDog
 
 	void D3D11Renderer::AddPrisToShadowView(IScene* pScene)
 	{
-		uint32_t priNum = pScene->GetPrimitivesNum();
-		for (uint32_t i = 0; i < priNum; ++i)
-		{
-			IPrimitive* pPri = pScene->GetPrimitive(i);
-
-			//FIXME!!! Ӧ׶ü
-			m_pShadowSceneView->AddPrimitive(pPri);
-		}
+		//бפShadowSceneViewУеͼԪûɾʱռ
+		m_pShadowSceneView->AddScenePrimitives(pScene);
 	}
 
 	void D3D11Renderer::CalcShadowMatrix(IScene* pScene)
 	{
+		ShadowCascadeSetup cascadeSetup;
+
 		if (m_pSceneView->GetLightNum() > 0)
 		{
 			ILight* pMainLight = m_pSceneView->GetLight(0);
 			if (pMainLight->GetType() == LIGHT_TYPE::DIRECTIONAL)
 			{
-				BoundingSphere sceneBoundingSphere = pScene->GetBoundingSphere();
-				float lightFrustumSize = sceneBoundingSphere.radius;
-				Vector3 dirLightPos = -(pMainLight->GetDirection() * lightFrustumSize);
-				Matrix4x4 lightViewMatrix = GetLookAtMatrixLH(dirLightPos, Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f));
-				Matrix4x4 lightOrthoMatrix = GetOrthographicMatrixLH(-lightFrustumSize, lightFrustumSize,
-					-lightFrustumSize, lightFrustumSize,
-					0.0f, 2.0f * lightFrustumSize);
-
-				m_pSceneView->SetShadowWorldToViewMatrix(lightViewMatrix);
-				m_pSceneView->SetShadowViewToClipMatrix(lightOrthoMatrix);
+				CalcShadowCascades(*m_pSceneView->GetCamera(), pMainLight->GetDirection(), pScene->GetBoundingSphere(),
+					g_ShadowDistance, g_ShadowMapRTSize, cascadeSetup);
+			}
+		}
+
+		m_pSceneView->SetShadowCascades(cascadeSetup);
+	}
+
+	void D3D11Renderer::CullShadowCasters()
+	{
+		RD_PROFILE_SCOPE("D3D11Renderer::CullShadowCasters");
+
+		//ͼеͼԪ׶޳ҰҲͶӰShadowSceneViewеͼԪÿһͶӰ޳
+		const ShadowCascadeSetup& cascadeSetup = m_pSceneView->GetShadowCascades();
+		for (uint32_t i = 0; i < (uint32_t)g_ShadowCascadeNum; ++i)
+		{
+			if (i < cascadeSetup.cascadeNum)
+			{
+				m_pShadowSceneView->CullOpaquePrimitives(cascadeSetup.cascades[i].worldToClipMatrix, m_ShadowCasterPris[i]);
+			}
+			else
+			{
+				m_ShadowCasterPris[i].clear();
 			}
 		}
 	}
 
 	void D3D11Renderer::ShadowDepthPass()
 	{
-		g_pD3D11ImmediateContext->RSSetViewports(1, &m_ShadowViewport);
+		RD_PROFILE_SCOPE("D3D11Renderer::ShadowDepthPass");
 
 		ID3D11DepthStencilView* pShadowDSV = (ID3D11DepthStencilView*)m_pShadowDepthTexture->GetDepthStencilView();
 		g_pD3D11ImmediateContext->ClearDepthStencilView(pShadowDSV, D3D11_CLEAR_DEPTH, 1.0f, 0);
 		g_pD3D11ImmediateContext->OMSetRenderTargets(0, nullptr, pShadowDSV);
 
-		D3D11MeshShadowRenderer modelShadowRenderer(m_pSceneView);
-
-		uint32_t opaquePriNum = m_pSceneView->GetOpaquePrisNum();
-		for (uint32_t i = 0; i < opaquePriNum; ++i)
+		uint32_t cascadeNum = m_pSceneView->GetShadowCascades().cascadeNum;
+		for (uint32_t cascadeIndex = 0; cascadeIndex < cascadeNum; ++cascadeIndex)
 		{
-			IPrimitive* pPri = m_pSceneView->GetOpaquePri(i);
-			if (pPri->GetPriType() != PRIMITIVE_TYPE::SKIN_PRI)
-			{
-				pPri->Render(&modelShadowRenderer);
-			}
-			else
+			g_pD3D11ImmediateContext->RSSetViewports(1, &m_ShadowCascadeViewports[cascadeIndex]);
+			m_pSceneView->UpdateShadowCascadeData(cascadeIndex);
+
+			D3D11MeshShadowRenderer modelShadowRenderer(m_pSceneView);
+
+			const std::vector<IPrimitive*>& casterPris = m_ShadowCasterPris[cascadeIndex];
+			for (uint32_t i = 0; i < casterPris.size(); ++i)
 			{
-				pPri->Render(&modelShadowRenderer);
+				casterPris[i]->Render(&modelShadowRenderer);
 			}
 		}
+
+		//ɫʱӰֻԴ۲
+		m_pSceneView->UpdateShadowReceiverData();
 	}
 
 	void D3D11Renderer::ClearBackRenderTarget(float* clearColor)
@@ -1046,29 +1158,15 @@ namespace RenderDog
 
 	void D3D11Renderer::AddPrisAndLightsToSceneView(IScene* pScene)
 	{
-		uint32_t priNum = pScene->GetPrimitivesNum();
-		for (uint32_t i = 0; i < priNum; ++i)
-		{
-			IPrimitive* pPri = pScene->GetPrimitive(i);
-
-			//FIXME!!! Ӧ׶ü
-			m_pSceneView->AddPrimitive(pPri);
-		}
-
-		uint32_t lightsNum = pScene->GetLightsNum();
-		for (uint32_t i = 0; i < lightsNum; ++i)
-		{
-			ILight* pLight = pScene->GetLight(i);
-
-			if (pLight->GetType() == LIGHT_TYPE::DIRECTIONAL)
-			{
-				m_pSceneView->AddLight(pLight);
-			}
-		}
+		FPSCamera* pCamera = m_pSceneView->GetCamera();
+		//SceneViewҽӵ֮󳡾зɾɳ֪ͨSceneView
+		m_pSceneView->AddVisiblePrimitives(pScene, pCamera->GetViewMatrix() * pCamera->GetPerspProjectionMatrix());
 	}
 
 	void D3D11Renderer::RenderPrimitives(IScene* pScene)
 	{
+		RD_PROFILE_SCOPE("D3D11Renderer::RenderPrimitives");
+
 		g_pD3D11ImmediateContext->RSSetViewports(1, &m_ScreenViewport);
 
 		D3D11SimpleMeshRenderer simpleRender(m_pSceneView);
@@ -1104,6 +1202,8 @@ namespace RenderDog
 
 	void D3D11Renderer::RenderSky(IScene* pScene)
 	{
+		RD_PROFILE_SCOPE("D3D11Renderer::RenderSky");
+
 		g_pD3D11ImmediateContext->RSSetState(m_pSkyRasterizerState);
 		g_pD3D11ImmediateContext->OMSetDepthStencilState(m_pSkyDepthStencilState, 0);
 
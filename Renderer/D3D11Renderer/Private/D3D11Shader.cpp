@@ -13,6 +13,7 @@
 #include "Matrix.h"
 #include "GlobalValue.h"
 #include "Material.h"
+#include "ResourceRegistry.h"
 
 #include <fstream>
 #include <d3d11.h>
@@ -39,6 +40,26 @@ namespace RenderDog
 
 		bool											CompileFromFile(const ShaderCompileDesc& desc);
 
+	protected:
+		//ȫֳİ󶨣λڹʱȷһʹʱֲңֱ֮ͨӷ
+		struct GlobalConstantBufferBinding
+		{
+			std::string		name;
+			int				slot;		//ɫûʹʱΪ-1
+			ResourceHandle	handle;
+
+			GlobalConstantBufferBinding() :
+				name(""),
+				slot(-1),
+				handle()
+			{}
+		};
+
+		int												GetConstantBufferSlotByName(const std::string& name) const;
+		void											InitGlobalConstantBufferBinding(GlobalConstantBufferBinding& binding, const std::string& name);
+		//ɫûʹû߻廹ûдʱnullptr
+		IConstantBuffer*								ResolveGlobalConstantBuffer(GlobalConstantBufferBinding& binding);
+
 	protected:
 		std::string										m_fileName;
 
@@ -84,6 +105,13 @@ namespace RenderDog
 		virtual void				Release() override;
 
 		virtual void				Apply(const ShaderPerObjParam* pPerObjParam = nullptr) override;
+		virtual void				ApplyPerObjParam(const ShaderPerObjParam* pPerObjParam) override;
+
+	private:
+		GlobalConstantBufferBinding	m_ViewParamCB;
+		GlobalConstantBufferBinding	m_ShadowMatrixCB;
+		int							m_PerObjectCBSlot;
+		int							m_BoneTransformsCBSlot;
 	};
 
 
@@ -105,6 +133,7 @@ namespace RenderDog
 
 	private:
 		ID3D11PixelShader*			m_pPS;
+		GlobalConstantBufferBinding	m_GlobalsCB;
 	};
 
 	class D3D11SkyPixelShader : public D3D11PixelShader
@@ -133,6 +162,9 @@ namespace RenderDog
 		virtual void				Apply(const ShaderPerObjParam* pPerObjParam = nullptr) override;
 
 	protected:
+		GlobalConstantBufferBinding	m_LightingParamCB;
+		GlobalConstantBufferBinding	m_ShadowParamCB;
+
 		ShaderParam					m_SkyCubeTextureParam;
 		ShaderParam					m_SkyCubeTextureSamplerParam;
 		ShaderParam					m_ShadowDepthTextureParam;
@@ -327,6 +359,44 @@ namespace RenderDog
 		}
 	}
 
+	int D3D11Shader::GetConstantBufferSlotByName(const std::string& name) const
+	{
+		auto iter = m_ConstantBufferMap.find(name);
+		if (iter != m_ConstantBufferMap.end())
+		{
+			return iter->second;
+		}
+		else
+		{
+			return -1;
+		}
+	}
+
+	void D3D11Shader::InitGlobalConstantBufferBinding(GlobalConstantBufferBinding& binding, const std::string& name)
+	{
+		binding.name = name;
+		binding.slot = GetConstantBufferSlotByName(name);
+		binding.handle = ResourceHandle();
+	}
+
+	IConstantBuffer* D3D11Shader::ResolveGlobalConstantBuffer(GlobalConstantBufferBinding& binding)
+	{
+		if (binding.slot < 0)
+		{
+			return nullptr;
+		}
+
+		IConstantBuffer* pCB = g_pResourceRegistry->Resolve<IConstantBuffer>(binding.handle, RESOURCE_TYPE::CONSTANT_BUFFER);
+		if (!pCB)
+		{
+			//廹ûдѾͷź´²һ
+			pCB = g_pIBufferManager->GetConstantBufferByName(binding.name);
+			binding.handle = pCB ? pCB->GetHandle() : ResourceHandle();
+		}
+
+		return pCB;
+	}
+
 	D3D11VertexShader::D3D11VertexShader(VERTEX_TYPE vertexType, const ShaderCompileDesc& desc) :
 		D3D11Shader(desc),
 		m_pVS(nullptr),
@@ -381,8 +451,18 @@ namespace RenderDog
 	}
 
 	D3D11ModelVertexShader::D3D11ModelVertexShader(VERTEX_TYPE vertexType, const ShaderCompileDesc& desc) :
-		D3D11VertexShader(vertexType, desc)
-	{}
+		D3D11VertexShader(vertexType, desc),
+		m_ViewParamCB(),
+		m_ShadowMatrixCB(),
+		m_PerObjectCBSlot(-1),
+		m_BoneTransformsCBSlot(-1)
+	{
+		InitGlobalConstantBufferBinding(m_ViewParamCB, "ComVar_ConstantBuffer_ViewParam");
+		InitGlobalConstantBufferBinding(m_ShadowMatrixCB, "ComVar_ConstantBuffer_ShadowMatrixs");
+
+		m_PerObjectCBSlot = GetConstantBufferSlotByName("ComVar_ConstantBuffer_PerObject");
+		m_BoneTransformsCBSlot = GetConstantBufferSlotByName("ComVar_ConstantBuffer_BoneTransforms");
+	}
 
 	D3D11ModelVertexShader::~D3D11ModelVertexShader()
 	{}
@@ -396,52 +476,51 @@ namespace RenderDog
 	{
 		D3D11VertexShader::Apply(pPerObjParam);
 
-		auto cbIter = m_ConstantBufferMap.find("ComVar_ConstantBuffer_PerObject");
-		if (cbIter != m_ConstantBufferMap.end() && pPerObjParam->pPerObjectCB != nullptr)
+		ApplyPerObjParam(pPerObjParam);
+
+		IConstantBuffer* pViewParamCB = ResolveGlobalConstantBuffer(m_ViewParamCB);
+		if (pViewParamCB)
 		{
-			uint32_t cbSlot = cbIter->second;
-			ID3D11Buffer* pCB = (ID3D11Buffer*)(pPerObjParam->pPerObjectCB->GetResource());
-			g_pD3D11ImmediateContext->VSSetConstantBuffers(cbSlot, 1, (ID3D11Buffer**)&pCB);
+			ID3D11Buffer* pCB = (ID3D11Buffer*)(pViewParamCB->GetResource());
+			g_pD3D11ImmediateContext->VSSetConstantBuffers(m_ViewParamCB.slot, 1, &pCB);
 		}
 
-		cbIter = m_ConstantBufferMap.find("ComVar_ConstantBuffer_BoneTransforms");
-		if (cbIter != m_ConstantBufferMap.end() && pPerObjParam->pBoneTransformCB != nullptr)
+		IConstantBuffer* pShadowMatrixCB = ResolveGlobalConstantBuffer(m_ShadowMatrixCB);
+		if (pShadowMatrixCB)
 		{
-			uint32_t cbSlot = cbIter->second;
-			ID3D11Buffer* pCB = (ID3D11Buffer*)(pPerObjParam->pBoneTransformCB->GetResource());
-			g_pD3D11ImmediateContext->VSSetConstantBuffers(cbSlot, 1, (ID3D11Buffer**)&pCB);
+			ID3D11Buffer* pCB = (ID3D11Buffer*)(pShadowMatrixCB->GetResource());
+			g_pD3D11ImmediateContext->VSSetConstantBuffers(m_ShadowMatrixCB.slot, 1, &pCB);
 		}
+	}
 
-		IConstantBuffer* pViewParamCB = g_pIBufferManager->GetConstantBufferByName("ComVar_ConstantBuffer_ViewParam");
-		if (pViewParamCB)
+	void D3D11ModelVertexShader::ApplyPerObjParam(const ShaderPerObjParam* pPerObjParam)
+	{
+		if (!pPerObjParam)
 		{
-			cbIter = m_ConstantBufferMap.find(pViewParamCB->GetName());
-			if (cbIter != m_ConstantBufferMap.end())
-			{
-				uint32_t cbSlot = cbIter->second;
-				ID3D11Buffer* pCB = (ID3D11Buffer*)(pViewParamCB->GetResource());
-				g_pD3D11ImmediateContext->VSSetConstantBuffers(cbSlot, 1, (ID3D11Buffer**)&pCB);
-			}
+			return;
 		}
 
-		IConstantBuffer* pShadowMatrixConstantBuffer = g_pIBufferManager->GetConstantBufferByName("ComVar_ConstantBuffer_ShadowMatrixs");
-		if (pShadowMatrixConstantBuffer)
+		if (m_PerObjectCBSlot >= 0 && pPerObjParam->pPerObjectCB != nullptr)
 		{
-			cbIter = m_ConstantBufferMap.find(pShadowMatrixConstantBuffer->GetName());
-			if (cbIter != m_ConstantBufferMap.end())
-			{
-				uint32_t cbSlot = cbIter->second;
-				ID3D11Buffer* pCB = (ID3D11Buffer*)(pShadowMatrixConstantBuffer->GetResource());
-				g_pD3D11ImmediateContext->VSSetConstantBuffers(cbSlot, 1, (ID3D11Buffer**)&pCB);
-			}
-		}	
+			ID3D11Buffer* pCB = (ID3D11Buffer*)(pPerObjParam->pPerObjectCB->GetResource());
+			g_pD3D11ImmediateContext->VSSetConstantBuffers(m_PerObjectCBSlot, 1, (ID3D11Buffer**)&pCB);
+		}
+
+		if (m_BoneTransformsCBSlot >= 0 && pPerObjParam->pBoneTransformCB != nullptr)
+		{
+			ID3D11Buffer* pCB = (ID3D11Buffer*)(pPerObjParam->pBoneTransformCB->GetResource());
+			g_pD3D11ImmediateContext->VSSetConstantBuffers(m_BoneTransformsCBSlot, 1, (ID3D11Buffer**)&pCB);
+		}
 	}
 
 	D3D11PixelShader::D3D11PixelShader(const ShaderCompileDesc& desc) :
 		D3D11Shader(desc),
-		m_pPS(nullptr)
+		m_pPS(nullptr),
+		m_GlobalsCB()
 	{
 		g_pD3D11Device->CreatePixelShader(m_pCompiledCode->GetBufferPointer(), m_pCompiledCode->GetBufferSize(), nullptr, &m_pPS);
+
+		InitGlobalConstantBufferBinding(m_GlobalsCB, "$Globals");
 	}
 
 	D3D11PixelShader::~D3D11PixelShader()
@@ -538,24 +617,21 @@ namespace RenderDog
 
 		if (vec4Params.size() > 0)
 		{
-			IConstantBuffer* pGlobalConstantBuffer = g_pIBufferManager->GetConstantBufferByName("$Globals");
+			IConstantBuffer* pGlobalConstantBuffer = ResolveGlobalConstantBuffer(m_GlobalsCB);
 			if (pGlobalConstantBuffer)
 			{
 				pGlobalConstantBuffer->Update(vec4Params.data(), static_cast<uint32_t>(vec4Params.size() * sizeof(Vector4)));
 
-				auto cbIter = m_ConstantBufferMap.find(pGlobalConstantBuffer->GetName());
-				if (cbIter != m_ConstantBufferMap.end())
-				{
-					uint32_t cbSlot = cbIter->second;
-					ID3D11Buffer* pCB = (ID3D11Buffer*)(pGlobalConstantBuffer->GetResource());
-					g_pD3D11ImmediateContext->PSSetConstantBuffers(cbSlot, 1, (ID3D11Buffer**)&pCB);
-				}
+				ID3D11Buffer* pCB = (ID3D11Buffer*)(pGlobalConstantBuffer->GetResource());
+				g_pD3D11ImmediateContext->PSSetConstantBuffers(m_GlobalsCB.slot, 1, &pCB);
 			}
 		}
 	}
 
 	D3D11DirectionalLightingPixelShader::D3D11DirectionalLightingPixelShader(const ShaderCompileDesc& desc) :
 		D3D11PixelShader(desc),
+		m_LightingParamCB(),
+		m_ShadowParamCB(),
 		m_SkyCubeTextureParam("ComVar_Texture_SkyCubeTexture", SHADER_PARAM_TYPE::TEXTURE),
 		m_SkyCubeTextureSamplerParam("ComVar_Texture_SkyCubeTextureSampler", SHADER_PARAM_TYPE::SAMPLER),
 		m_ShadowDepthTextureParam("ComVar_Texture_ShadowDepthTexture", SHADER_PARAM_TYPE::TEXTURE),
@@ -570,6 +646,9 @@ namespace RenderDog
 		m_ShaderParamMap.insert({ "ComVar_Texture_ShadowDepthTextureSampler", &m_ShadowDepthTextureSamplerParam });
 		m_ShaderParamMap.insert({ "ComVar_Texture_IblBrdfLutTexture", &m_IblBrdfLutTextureParam });
 		m_ShaderParamMap.insert({ "ComVar_Texture_IblBrdfLutTextureSampler", &m_IblBrdfLutTextureSamplerParam });
+
+		InitGlobalConstantBufferBinding(m_LightingParamCB, "ComVar_ConstantBuffer_LightingParam");
+		InitGlobalConstantBufferBinding(m_ShadowParamCB, "ComVar_ConstantBuffer_ShadowParam");
 	}
 
 	D3D11DirectionalLightingPixelShader::~D3D11DirectionalLightingPixelShader()
@@ -585,29 +664,19 @@ namespace RenderDog
 		D3D11PixelShader::Apply(pPerObjParam);
 
 		//LightingParams
-		IConstantBuffer* pLightingParamsConstantBuffer = g_pIBufferManager->GetConstantBufferByName("ComVar_ConstantBuffer_LightingParam");
-		if (pLightingParamsConstantBuffer)
+		IConstantBuffer* pLightingParamCB = ResolveGlobalConstantBuffer(m_LightingParamCB);
+		if (pLightingParamCB)
 		{
-			auto cbIter = m_ConstantBufferMap.find(pLightingParamsConstantBuffer->GetName());
-			if (cbIter != m_ConstantBufferMap.end())
-			{
-				uint32_t cbSlot = cbIter->second;
-				ID3D11Buffer* pCB = (ID3D11Buffer*)(pLightingParamsConstantBuffer->GetResource());
-				g_pD3D11ImmediateContext->PSSetConstantBuffers(cbSlot, 1, (ID3D11Buffer**)&pCB);
-			}
+			ID3D11Buffer* pCB = (ID3D11Buffer*)(pLightingParamCB->GetResource());
+			g_pD3D11ImmediateContext->PSSetConstantBuffers(m_LightingParamCB.slot, 1, &pCB);
 		}
 
 		//ShadowParams
-		IConstantBuffer* pShadowParamBuffer = g_pIBufferManager->GetConstantBufferByName("ComVar_ConstantBuffer_ShadowParam");
-		if (pShadowParamBuffer)
+		IConstantBuffer* pShadowParamCB = ResolveGlobalConstantBuffer(m_ShadowParamCB);
+		if (pShadowParamCB)
 		{
-			auto cbIter = m_ConstantBufferMap.find(pShadowParamBuffer->GetName());
-			if (cbIter != m_ConstantBufferMap.end())
-			{
-				uint32_t cbSlot = cbIter->second;
-				ID3D11Buffer* pCB = (ID3D11Buffer*)(pShadowParamBuffer->GetResource());
-				g_pD3D11ImmediateContext->PSSetConstantBuffers(cbSlot, 1, (ID3D11Buffer**)&pCB);
-			}
+			ID3D11Buffer* pCB = (ID3D11Buffer*)(pShadowParamCB->GetResource());
+			g_pD3D11ImmediateContext->PSSetConstantBuffers(m_ShadowParamCB.slot, 1, &pCB);
 		}
 
 		//SkyTexture
@@ -6,6 +6,7 @@
 
 #include "Texture.h"
 #include "RefCntObject.h"
+#include "ObjectPool.h"
 #include "D3D11Renderer.h"
 
 #include <d3d11.h>
@@ -41,6 +42,8 @@ namespace RenderDog
 
 	class D3D11Texture2D : public ITexture2D, public RefCntObject
 	{
+		RD_POOLED_OBJECT(D3D11Texture2D)
+
 	public:
 		D3D11Texture2D();
 		explicit D3D11Texture2D(const TextureDesc& desc);
@@ -91,6 +94,8 @@ namespace RenderDog
 		TextureMap					m_TextureMap;
 	};
 
+	ObjectPool<D3D11Texture2D>	D3D11Texture2D::s_Pool;
+
 	D3D11TextureManager	g_D3D11TextureManager;
 	ITextureManager*	g_pITextureManager = &g_D3D11TextureManager;
 
@@ -316,6 +321,8 @@ namespace RenderDog
 
 	class D3D11SamplerState : public ISamplerState, public RefCntObject
 	{
+		RD_POOLED_OBJECT(D3D11SamplerState)
+
 	public:
 		D3D11SamplerState();
 		explicit D3D11SamplerState(const SamplerDesc& desc);
@@ -355,6 +362,8 @@ namespace RenderDog
 		SamplerMap				m_SamplerMap;
 	};
 
+	ObjectPool<D3D11SamplerState>	D3D11SamplerState::s_Pool;
+
 	D3D11SamplerStateManager	g_D3D11SamplerStateManager;
 	ISamplerStateManager*		g_pISamplerStateManager = &g_D3D11SamplerStateManager;
 
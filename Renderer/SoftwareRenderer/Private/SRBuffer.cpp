@@ -7,6 +7,7 @@
 
 #include "Buffer.h"
 #include "RefCntObject.h"
+#include "ObjectPool.h"
 #include "SoftwareRenderer.h"
 #include "SoftwareRender3D.h"
 
@@ -20,6 +21,8 @@ namespace RenderDog
 
 	class SRVertexBuffer : public IVertexBuffer, public RefCntObject
 	{
+		RD_POOLED_OBJECT(SRVertexBuffer)
+
 	public:
 		explicit SRVertexBuffer(const BufferDesc& desc);
 
@@ -50,6 +53,8 @@ namespace RenderDog
 
 	class SRIndexBuffer : public IIndexBuffer, public RefCntObject
 	{
+		RD_POOLED_OBJECT(SRIndexBuffer)
+
 	public:
 		explicit SRIndexBuffer(const BufferDesc& desc);
 		virtual ~SRIndexBuffer();
@@ -77,6 +82,8 @@ namespace RenderDog
 
 	class SRConstantBuffer : public IConstantBuffer, public RefCntObject
 	{
+		RD_POOLED_OBJECT(SRConstantBuffer)
+
 	public:
 		explicit SRConstantBuffer(const BufferDesc& desc);
 		virtual ~SRConstantBuffer();
@@ -87,9 +94,11 @@ namespace RenderDog
 
 		virtual const std::string&	GetName() const { return m_Name; }
 		virtual void*				GetResource() override { return (void*)m_pCB; }
+		virtual ResourceHandle		GetHandle() const override { return m_Handle; }
 
 	private:
 		std::string					m_Name;
+		ResourceHandle				m_Handle;
 
 		ISRBuffer*					m_pCB;
 		bool						m_IsDynamic;
@@ -122,6 +131,10 @@ namespace RenderDog
 		BufferMap					m_BufferMap;
 	};
 
+	ObjectPool<SRVertexBuffer>	SRVertexBuffer::s_Pool;
+	ObjectPool<SRIndexBuffer>	SRIndexBuffer::s_Pool;
+	ObjectPool<SRConstantBuffer>	SRConstantBuffer::s_Pool;
+
 	SRBufferManager g_SRBufferManager;
 	IBufferManager* g_pIBufferManager = &g_SRBufferManager;
 
@@ -205,6 +218,7 @@ namespace RenderDog
 	SRConstantBuffer::SRConstantBuffer(const BufferDesc& desc) :
 		RefCntObject(),
 		m_Name(desc.name),
+		m_Handle(),
 		m_pCB(nullptr),
 		m_IsDynamic(desc.isDynamic)
 	{
@@ -216,10 +230,14 @@ namespace RenderDog
 		initData.pSysMem		= desc.pInitData;
 
 		g_pSRDevice->CreateBuffer(&bufferDesc, nullptr, &m_pCB);
+
+		m_Handle = g_pResourceRegistry->Register(RESOURCE_TYPE::CONSTANT_BUFFER, static_cast<IConstantBuffer*>(this));
 	}
 
 	SRConstantBuffer::~SRConstantBuffer()
 	{
+		g_pResourceRegistry->Unregister(m_Handle);
+
 		if (m_pCB)
 		{
 			m_pCB->Release();
@@ -11,6 +11,7 @@
 #include "SoftwareRenderer.h"
 #include "Buffer.h"
 #include "Texture.h"
+#include "ResourceRegistry.h"
 
 #include <unordered_map>
 
@@ -28,6 +29,10 @@ namespace RenderDog
 		virtual int										GetShaderResourceViewSlotByName(const std::string& name) override { return -1; }
 		virtual int										GetSamplerStateSlotByName(const std::string& name) override { return -1; }
 
+	protected:
+		//ȫֳһʹʱֲңֱ֮ͨӷ
+		IConstantBuffer*								ResolveGlobalConstantBuffer(ResourceHandle& handle, const std::string& name);
+
 	protected:
 		std::string										m_fileName;
 
@@ -48,11 +53,13 @@ namespace RenderDog
 		virtual void				Release() override;
 
 		virtual void				Apply(const ShaderPerObjParam* pPerObjParam = nullptr) override;
+		virtual void				ApplyPerObjParam(const ShaderPerObjParam* pPerObjParam) override;
 
 		virtual void				ApplyMaterialParams(IMaterialInstance* pMtlIns) override {};
 
 	private:
 		ISRVertexShader*			m_pVS;
+		ResourceHandle				m_ViewParamCBHandle;
 	};
 
 
@@ -74,6 +81,7 @@ namespace RenderDog
 
 	private:
 		ISRPixelShader*				m_pPS;
+		ResourceHandle				m_LightingParamCBHandle;
 
 		ShaderParam					m_DiffuseTextureParam;
 		ShaderParam					m_DiffuseTextureSamplerParam;
@@ -136,10 +144,24 @@ namespace RenderDog
 		}
 	}
 
+	IConstantBuffer* SRShader::ResolveGlobalConstantBuffer(ResourceHandle& handle, const std::string& name)
+	{
+		IConstantBuffer* pCB = g_pResourceRegistry->Resolve<IConstantBuffer>(handle, RESOURCE_TYPE::CONSTANT_BUFFER);
+		if (!pCB)
+		{
+			//廹ûдѾͷź´²һ
+			pCB = g_pIBufferManager->GetConstantBufferByName(name);
+			handle = pCB ? pCB->GetHandle() : ResourceHandle();
+		}
+
+		return pCB;
+	}
+
 
 	SRVertexShader::SRVertexShader(VERTEX_TYPE vertexType, const ShaderCompileDesc& desc) :
 		SRShader(desc),
-		m_pVS(nullptr)
+		m_pVS(nullptr),
+		m_ViewParamCBHandle()
 	{
 		g_pSRDevice->CreateVertexShader(&m_pVS);
 	}
@@ -162,21 +184,30 @@ namespace RenderDog
 	{
 		g_pSRImmediateContext->VSSetShader(m_pVS);
 
-		if (pPerObjParam->pPerObjectCB != nullptr)
+		ApplyPerObjParam(pPerObjParam);
+
+		IConstantBuffer* pViewParamCB = ResolveGlobalConstantBuffer(m_ViewParamCBHandle, "ComVar_ConstantBuffer_ViewParam");
+		if (pViewParamCB)
+		{
+			ISRBuffer* pGlobalCB = (ISRBuffer*)(pViewParamCB->GetResource());
+			g_pSRImmediateContext->VSSetConstantBuffer(0, &pGlobalCB);
+		}
+	}
+
+	void SRVertexShader::ApplyPerObjParam(const ShaderPerObjParam* pPerObjParam)
+	{
+		if (pPerObjParam && pPerObjParam->pPerObjectCB != nullptr)
 		{
 			ISRBuffer* pPerObjCB = (ISRBuffer*)(pPerObjParam->pPerObjectCB->GetResource());
 			g_pSRImmediateContext->VSSetConstantBuffer(1, &pPerObjCB);
 		}
-
-		IConstantBuffer* pViewParamCB = g_pIBufferManager->GetConstantBufferByName("ComVar_ConstantBuffer_ViewParam");
-		ISRBuffer* pGlobalCB = (ISRBuffer*)(pViewParamCB->GetResource());
-		g_pSRImmediateContext->VSSetConstantBuffer(0, &pGlobalCB);
 	}
 
 
 	SRPixelShader::SRPixelShader(const ShaderCompileDesc& desc) :
 		SRShader(desc),
 		m_pPS(nullptr),
+		m_LightingParamCBHandle(),
 		m_DiffuseTextureParam("LocVar_Material_DiffuseTexture", SHADER_PARAM_TYPE::TEXTURE),
 		m_DiffuseTextureSamplerParam("LocVar_Material_DiffuseTextureSampler", SHADER_PARAM_TYPE::SAMPLER),
 		m_NormalTextureParam("LocVar_Material_NormalTexture", SHADER_PARAM_TYPE::TEXTURE),
@@ -208,9 +239,12 @@ namespace RenderDog
 	{
 		g_pSRImmediateContext->PSSetShader(m_pPS);
 
-		IConstantBuffer* pLightingParamsConstantBuffer = g_pIBufferManager->GetConstantBufferByName("ComVar_ConstantBuffer_LightingParam");
-		ISRBuffer* pLightingCB = (ISRBuffer*)(pLightingParamsConstantBuffer->GetResource());
-		g_pSRImmediateContext->PSSetConstantBuffer(0, &pLightingCB);
+		IConstantBuffer* pLightingParamsConstantBuffer = ResolveGlobalConstantBuffer(m_LightingParamCBHandle, "ComVar_ConstantBuffer_LightingParam");
+		if (pLightingParamsConstantBuffer)
+		{
+			ISRBuffer* pLightingCB = (ISRBuffer*)(pLightingParamsConstantBuffer->GetResource());
+			g_pSRImmediateContext->PSSetConstantBuffer(0, &pLightingCB);
+		}
 
 		ISRShaderResourceView* pSRV = (ISRShaderResourceView*)(m_NormalTextureParam.GetTexture()->GetShaderResourceView());
 		g_pSRImmediateContext->PSSetShaderResource(&pSRV);
@@ -7,6 +7,7 @@
 
 #include "Texture.h"
 #include "RefCntObject.h"
+#include "ObjectPool.h"
 #include "Vector.h"
 #include "SoftwareRender3D.h"
 #include "SoftwareRenderer.h"
@@ -24,6 +25,8 @@ namespace RenderDog
 
 	class SRTexture2D : public ITexture2D, public RefCntObject
 	{
+		RD_POOLED_OBJECT(SRTexture2D)
+
 	public:
 		SRTexture2D();
 		explicit SRTexture2D(const TextureDesc& desc);
@@ -71,6 +74,8 @@ namespace RenderDog
 		TextureMap					m_TextureMap;
 	};
 
+	ObjectPool<SRTexture2D>	SRTexture2D::s_Pool;
+
 	SRTextureManager g_SRTextureManager;
 	ITextureManager* g_pITextureManager = &g_SRTextureManager;
 
@@ -277,6 +282,8 @@ namespace RenderDog
 
 	class SRSamplerState : public ISamplerState
 	{
+		RD_POOLED_OBJECT(SRSamplerState)
+
 	public:
 		SRSamplerState();
 		SRSamplerState(const SamplerDesc& desc);
@@ -311,6 +318,8 @@ namespace RenderDog
 		void					ReleaseSamplerState(SRSamplerState* pSampler);
 	};
 
+	ObjectPool<SRSamplerState>	SRSamplerState::s_Pool;
+
 	SRSamplerStateManager	g_SRSamplerStateManager;
 	ISamplerStateManager*	g_pISamplerStateManager = &g_SRSamplerStateManager;
 
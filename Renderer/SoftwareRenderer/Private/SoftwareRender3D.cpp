@@ -7,9 +7,13 @@
 #include "SoftwareRender3D.h"
 #include "Vertex.h"
 #include "Matrix.h"
+#include "BatchTransform.h"
 #include "Utility.h"
+#include "Profiler.h"
 
 #include <vector>
+#include <cmath>
+#include <algorithm>
 
 namespace RenderDog
 {
@@ -53,7 +57,8 @@ namespace RenderDog
 		virtual void	AddRef() override {}
 		virtual void	Release() override { delete this; }
 
-		VSOutputVertex	VSMain(const StandardVertex& inVertex, const Matrix4x4& matWorld, const Matrix4x4& matView, const Matrix4x4& matProj) const;
+		//һδ飬λáߺʹ任
+		void			VSMain(const StandardVertex* pInVerts, uint32_t vertNum, const Matrix4x4& matWorld, const Matrix4x4& matWorldNormal, const Matrix4x4& matView, const Matrix4x4& matProj, VSOutputVertex* pOutVerts) const;
 	};
 
 	class PixelShader : public ISRPixelShader
@@ -279,6 +284,123 @@ namespace RenderDog
 
 #pragma endregion SamplerState
 
+#pragma region DepthStencilState
+	class DepthStencilState : public ISRDepthStencilState
+	{
+	public:
+		DepthStencilState();
+		~DepthStencilState();
+
+		virtual void		AddRef() override { ++m_RefCnt; }
+		virtual void		Release() override;
+		virtual void		GetDesc(SRDepthStencilDesc* pDesc) override { *pDesc = m_Desc; }
+
+		bool				Init(const SRDepthStencilDesc* pDesc);
+
+	private:
+		int					m_RefCnt;
+		SRDepthStencilDesc	m_Desc;
+	};
+
+	DepthStencilState::DepthStencilState() :
+		m_RefCnt(0),
+		m_Desc()
+	{}
+
+	DepthStencilState::~DepthStencilState()
+	{}
+
+	void DepthStencilState::Release()
+	{
+		--m_RefCnt;
+		if (m_RefCnt == 0)
+		{
+			delete this;
+		}
+	}
+
+	bool DepthStencilState::Init(const SRDepthStencilDesc* pDesc)
+	{
+		m_Desc = *pDesc;
+
+		AddRef();
+
+		return true;
+	}
+#pragma endregion DepthStencilState
+
+#pragma region Query
+	class Query : public ISRQuery
+	{
+	public:
+		Query();
+		~Query();
+
+		virtual void					AddRef() override { ++m_RefCnt; }
+		virtual void					Release() override;
+		virtual void					GetDesc(SRQueryDesc* pDesc) override { *pDesc = m_Desc; }
+
+		bool							Init(const SRQueryDesc* pDesc);
+
+		void							SetActive(bool bActive) { m_bActive = bActive; }
+		bool							IsActive() const { return m_bActive; }
+
+		SRQueryDataPipelineStatistics&	GetStatistics() { return m_Statistics; }
+
+	private:
+		int								m_RefCnt;
+		SRQueryDesc						m_Desc;
+
+		bool							m_bActive;
+		SRQueryDataPipelineStatistics	m_Statistics;
+	};
+
+	Query::Query() :
+		m_RefCnt(0),
+		m_Desc(),
+		m_bActive(false),
+		m_Statistics()
+	{}
+
+	Query::~Query()
+	{}
+
+	void Query::Release()
+	{
+		--m_RefCnt;
+		if (m_RefCnt == 0)
+		{
+			delete this;
+		}
+	}
+
+	bool Query::Init(const SRQueryDesc* pDesc)
+	{
+		m_Desc = *pDesc;
+
+		AddRef();
+
+		return true;
+	}
+
+	//ˮͳʹõĸ߾ȼʱλΪ
+	static double GetPerfTimeInMs()
+	{
+		static double msPerCount = 0.0;
+		if (msPerCount == 0.0)
+		{
+			LARGE_INTEGER frequency;
+			QueryPerformanceFrequency(&frequency);
+			msPerCount = 1000.0 / (double)frequency.QuadPart;
+		}
+
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+
+		return (double)counter.QuadPart * msPerCount;
+	}
+#pragma endregion Query
+
 
 #pragma region View
 	class RenderTargetView : public ISRRenderTargetView
@@ -665,6 +787,8 @@ namespace RenderDog
 		virtual bool	CreateVertexShader(ISRVertexShader** ppVertexShader) override;
 		virtual bool	CreatePixelShader(ISRPixelShader** ppPixelShader) override;
 		virtual bool	CreateSamplerState(const SRSamplerDesc* pDesc, ISRSamplerState** ppSamplerState) override;
+		virtual bool	CreateDepthStencilState(const SRDepthStencilDesc* pDesc, ISRDepthStencilState** ppDepthStencilState) override;
+		virtual bool	CreateQuery(const SRQueryDesc* pDesc, ISRQuery** ppQuery) override;
 
 		virtual void	AddRef() override {}
 		virtual void	Release() override { delete this; }
@@ -829,6 +953,42 @@ namespace RenderDog
 		return true;
 	}
 
+	bool Device::CreateDepthStencilState(const SRDepthStencilDesc* pDesc, ISRDepthStencilState** ppDepthStencilState)
+	{
+		DepthStencilState* pDepthStencilState = new DepthStencilState();
+		if (!pDepthStencilState)
+		{
+			return false;
+		}
+
+		if (!pDepthStencilState->Init(pDesc))
+		{
+			return false;
+		}
+
+		*ppDepthStencilState = pDepthStencilState;
+
+		return true;
+	}
+
+	bool Device::CreateQuery(const SRQueryDesc* pDesc, ISRQuery** ppQuery)
+	{
+		Query* pQuery = new Query();
+		if (!pQuery)
+		{
+			return false;
+		}
+
+		if (!pQuery->Init(pDesc))
+		{
+			return false;
+		}
+
+		*ppQuery = pQuery;
+
+		return true;
+	}
+
 	bool Device::CreateVertexBuffer(const SRBufferDesc* pDesc, const SRSubResourceData* pInitData, ISRBuffer** ppBuffer)
 	{
 		VertexBuffer* pVB = new VertexBuffer();
@@ -885,6 +1045,22 @@ namespace RenderDog
 #pragma endregion Device
 
 #pragma region DeviceContext
+	//դʹõĶȣĻ256ȡ
+	const int32_t g_SubPixelBits = 8;
+	const int32_t g_SubPixelStep = 1 << g_SubPixelBits;
+	const int32_t g_SubPixelHalf = g_SubPixelStep >> 1;
+
+	static inline int32_t SnapToSubPixel(float value)
+	{
+		return (int32_t)std::floor(value * g_SubPixelStep + 0.5f);
+	}
+
+	//ΪĻ˳(Ļռy)ˮƽҵıΪϱߣϵıΪ
+	static inline bool IsTopLeftEdge(int32_t ax, int32_t ay, int32_t bx, int32_t by)
+	{
+		return (ay == by && bx > ax) || (by < ay);
+	}
+
 	class DeviceContext : public ISRDeviceContext
 	{
 	public:
@@ -915,31 +1091,30 @@ namespace RenderDog
 		virtual void				RSSetViewport(const SRViewport* pVP) override;
 
 		virtual void				OMSetRenderTarget(ISRRenderTargetView* pRenderTargetView, ISRDepthStencilView* pDepthStencilVew) override;
+		virtual void				OMSetDepthStencilState(ISRDepthStencilState* pDepthStencilState) override;
 		virtual void				ClearRenderTargetView(ISRRenderTargetView* pRenderTargetView, const float* clearColor) override;
 		virtual void				ClearDepthStencilView(ISRDepthStencilView* pDepthStencilView, float fDepth) override;
 		virtual void				Draw() override;
 		virtual void				DrawIndex(uint32_t indexNum) override;
-		
 
-	private:
-		void						DrawLineWithDDA(float fPos1X, float fPos1Y, float fPos2X, float fPos2Y, const float* lineColor);
+		virtual void				Begin(ISRQuery* pQuery) override;
+		virtual void				End(ISRQuery* pQuery) override;
+		virtual bool				GetData(ISRQuery* pQuery, void* pData, uint32_t dataSize) override;
 
-		void						DrawTriangleWithLine(const VSOutputVertex& v0, const VSOutputVertex& v1, const VSOutputVertex& v2);
-		void						DrawTriangleWithFlat(const VSOutputVertex& v0, const VSOutputVertex& v1, const VSOutputVertex& v2);
-
-		void						SortTriangleVertsByYGrow(VSOutputVertex& v0, VSOutputVertex& v1, VSOutputVertex& v2);
-		void						SortScanlineVertsByXGrow(VSOutputVertex& v0, VSOutputVertex& v1);
-
-		//ƽκƽ
-		void						DrawTopTriangle(VSOutputVertex& v0, VSOutputVertex& v1, VSOutputVertex& v2);
-		void						DrawBottomTriangle(VSOutputVertex& v0, VSOutputVertex& v1, VSOutputVertex& v2);
+	private:
+		//BresenhamߣĻֱӶѡȲ
+		void						DrawLineWithBresenham(const VSOutputVertex& v0, const VSOutputVertex& v1);
 
-		void						SliceTriangleToUpAndBottom(const VSOutputVertex& v0, const VSOutputVertex& v1, const VSOutputVertex& v2, VSOutputVertex& vNew);
+		//Ϊ8λؾȵĶߺǲԣѭϹ
+		void						DrawTriangleWithEdgeFunction(const VSOutputVertex& v0, const VSOutputVertex& v1, const VSOutputVertex& v2);
 
-		void						LerpVertexParamsInScreen(const VSOutputVertex& vStart, const VSOutputVertex& vEnd, VSOutputVertex& vNew, float fLerpFactor);
 		void						LerpVertexParamsInClip(const VSOutputVertex& vStart, const VSOutputVertex& vEnd, VSOutputVertex& vNew, float fLerpFactor);
 
 		void						ClipTrianglesInClipSpace();
+		void						ClipLinesInClipSpace();
+		//Liang-Barsky㷨βüռвü߶Σ߶ȫ׶ʱfalse
+		bool						ClipLineWithLiangBarsky(const VSOutputVertex& v0, const VSOutputVertex& v1, VSOutputVertex& vOut0, VSOutputVertex& vOut1);
+		bool						IsInsideClipSpace(const Vector4& clipPos) const;
 
 		void						ViewportTransform();
 
@@ -960,6 +1135,10 @@ namespace RenderDog
 		void						BackFaceCulling();
 
 		void						Rasterization();
+		void						RasterizeLines();
+
+		//ֻQueryBegin״̬ʱŽмʱ
+		void						AccumulateStageTime(float& stageTime, double& stageStartTime);
 
 	private:
 		uint32_t*					m_pFrameBuffer;
@@ -982,10 +1161,16 @@ namespace RenderDog
 		std::vector<VSOutputVertex> m_BackFaceCulledVerts;
 		std::vector<VSOutputVertex>	m_ClipOutputVerts;
 		std::vector<VSOutputVertex> m_ClippingVerts;
+		std::vector<VSOutputVertex> m_ClipResultVerts;		//m_ClippingVertsʹãÿüƽ
 
 		Matrix4x4					m_ViewportMatrix;
 
 		SR_PRIMITIVE_TOPOLOGY		m_PriTopology;
+
+		bool						m_bDepthEnable;
+		float						m_ClearDepth;
+
+		SRQueryDataPipelineStatistics* m_pStatistics;		//ǰBegin״̬QueryͳݣΪʱͳ
 	};
 
 	DeviceContext::DeviceContext() :
@@ -998,7 +1183,10 @@ namespace RenderDog
 		m_pVS(nullptr),
 		m_pPS(nullptr),
 		m_SRTexture(),
-		m_PriTopology(SR_PRIMITIVE_TOPOLOGY::TRIANGLE_LIST)
+		m_PriTopology(SR_PRIMITIVE_TOPOLOGY::TRIANGLE_LIST),
+		m_bDepthEnable(true),
+		m_ClearDepth(1.0f),
+		m_pStatistics(nullptr)
 	{
 		m_pVertexShaderCB[0] = nullptr;
 		m_pVertexShaderCB[1] = nullptr;
@@ -1014,6 +1202,7 @@ namespace RenderDog
 		m_ClipOutputVerts.clear();
 		m_AssembledVerts.clear();
 		m_ClippingVerts.clear();
+		m_ClipResultVerts.clear();
 	}
 
 	bool DeviceContext::Init(uint32_t width, uint32_t height)
@@ -1205,6 +1394,18 @@ namespace RenderDog
 		}
 	}
 
+	void DeviceContext::OMSetDepthStencilState(ISRDepthStencilState* pDepthStencilState)
+	{
+		//nullptrʱָĬ״̬D3D11һ
+		SRDepthStencilDesc desc;
+		if (pDepthStencilState)
+		{
+			pDepthStencilState->GetDesc(&desc);
+		}
+
+		m_bDepthEnable = desc.depthEnable;
+	}
+
 	void DeviceContext::ClearRenderTargetView(ISRRenderTargetView* pRenderTargetView, const float* clearColor)
 	{
 		Vector4 colorVector(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
@@ -1243,6 +1444,8 @@ namespace RenderDog
 
 	void DeviceContext::ClearDepthStencilView(ISRDepthStencilView* pDepthStencil, float depth)
 	{
+		m_ClearDepth = depth;
+
 		ISFResource* pTex = nullptr;
 		pDepthStencil->GetResource(&pTex);
 
@@ -1274,291 +1477,373 @@ namespace RenderDog
 
 	void DeviceContext::Draw()
 	{
-		float clearColor[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+		VSOutputVertex v0 = {};
+		v0.svPostion = Vector4(100.0f, 100.0f, 0.0f, 1.0f);
+		v0.color = Vector4(1.0f, 0.0f, 0.0f, 1.0f);
+
+		VSOutputVertex v1 = v0;
 
-		DrawLineWithDDA(100, 100, 100, 100, clearColor);
+		DrawLineWithBresenham(v0, v1);
 	}
 
 	void DeviceContext::DrawIndex(uint32_t indexNum)
 	{
+		RD_PROFILE_SCOPE("SR::DrawIndex");
+
+		double stageStartTime = m_pStatistics ? GetPerfTimeInMs() : 0.0;
+
 		StandardVertex* pVerts = (StandardVertex*)(m_pVB->GetData());
 
 		SRBufferDesc vbDesc;
 		m_pVB->GetDesc(&vbDesc);
 		uint32_t vertNum = vbDesc.byteWidth / sizeof(StandardVertex);
 
-		for (uint32_t i = 0; i < vertNum; ++i)
 		{
-			const StandardVertex& vert = pVerts[i];
+			RD_PROFILE_SCOPE("SR::VertexShader");
 
-			Matrix4x4* pWorldMatrix = (Matrix4x4*)m_pVertexShaderCB[1]->GetData();
+			Matrix4x4* pWorldMatrix = (Matrix4x4*)m_pVertexShaderCB[1]->GetData() + 0;
+			Matrix4x4* pWorldNormalMatrix = (Matrix4x4*)m_pVertexShaderCB[1]->GetData() + 1;
 			Matrix4x4* pViewMatrix = (Matrix4x4*)m_pVertexShaderCB[0]->GetData() + 0;
 			Matrix4x4* pProjMatrix = (Matrix4x4*)m_pVertexShaderCB[0]->GetData() + 1;
-			m_VSOutputs[i] = m_pVS->VSMain(vert, *pWorldMatrix, *pViewMatrix, *pProjMatrix);
+			m_pVS->VSMain(pVerts, vertNum, *pWorldMatrix, *pWorldNormalMatrix, *pViewMatrix, *pProjMatrix, m_VSOutputs.data());
 		}
 
-		ShapeAssemble(indexNum);
-
-		BackFaceCulling();
-
-		ClipTrianglesInClipSpace();
+		if (m_pStatistics)
+		{
+			++m_pStatistics->drawCalls;
+			m_pStatistics->vsInvocations += vertNum;
+			AccumulateStageTime(m_pStatistics->vsTime, stageStartTime);
+		}
 
-		ViewportTransform();
+		ShapeAssemble(indexNum);
 
-		Rasterization();
-	}
+		//߶βҪ޳һDrawIndexе߶ͬһPassɲü͹դ
+		if (m_PriTopology == SR_PRIMITIVE_TOPOLOGY::LINE_LIST)
+		{
+			if (m_pStatistics)
+			{
+				m_pStatistics->iaPrimitives += m_AssembledVerts.size() / 2;
+				m_pStatistics->cInvocations += m_AssembledVerts.size() / 2;
+				AccumulateStageTime(m_pStatistics->iaTime, stageStartTime);
+			}
 
+			ClipLinesInClipSpace();
 
-	//------------------------------------------------------------------------------------------------------------------
-	//Private Funtion
-	//------------------------------------------------------------------------------------------------------------------
-	void DeviceContext::DrawLineWithDDA(float pos1X, float pos1Y, float pos2X, float pos2Y, const float* lineColor)
-	{
-		Vector4 lineColorVector(lineColor[0], lineColor[1], lineColor[2], lineColor[3]);
-		uint32_t clearColor = ConvertColorToUInt32(lineColorVector);
+			if (m_pStatistics)
+			{
+				m_pStatistics->cPrimitives += m_ClipOutputVerts.size() / 2;
+				AccumulateStageTime(m_pStatistics->clipTime, stageStartTime);
+			}
 
-		float DeltaX = pos2X - pos1X;
-		float DeltaY = pos2Y - pos1Y;
+			ViewportTransform();
 
-		if (std::abs(DeltaX - 0.0f) < 0.000001f)
+			RasterizeLines();
+		}
+		else
 		{
-			float yStart = std::fmin(pos1Y, pos2Y);
-			float yEnd = std::fmax(pos1Y, pos2Y);
-			for (int yStep = (int)yStart; yStep <= (int)yEnd; ++yStep)
+			if (m_pStatistics)
 			{
-				m_pFrameBuffer[(int)pos1X + yStep * m_BackBufferWidth] = clearColor;
+				m_pStatistics->iaPrimitives += m_AssembledVerts.size() / 3;
+				AccumulateStageTime(m_pStatistics->iaTime, stageStartTime);
 			}
-			return;
-		}
 
-		float k = DeltaY / DeltaX;
-		if (std::abs(k) <= 1.0f)
-		{
-			float xStart = pos1X < pos2X ? pos1X : pos2X;
-			float xEnd = pos1X < pos2X ? pos2X : pos1X;
-			float y = pos1X < pos2X ? pos1Y : pos2Y;
-			for (int xStep = (int)xStart; xStep < (int)xEnd; ++xStep)
+			BackFaceCulling();
+
+			if (m_pStatistics)
 			{
-				y += k;
-				int yStep = (int)y;
-				m_pFrameBuffer[xStep + yStep * m_BackBufferWidth] = clearColor;
+				m_pStatistics->cullPrimitives += (m_AssembledVerts.size() - m_BackFaceCulledVerts.size()) / 3;
+				m_pStatistics->cInvocations += m_BackFaceCulledVerts.size() / 3;
+				AccumulateStageTime(m_pStatistics->cullTime, stageStartTime);
 			}
-		}
-		else
-		{
-			float yStart = pos1Y < pos2Y ? pos1Y : pos2Y;
-			float yEnd = pos1Y < pos2Y ? pos2Y : pos1Y;
-			float x = pos1Y < pos2Y ? pos1X : pos2X;
-			for (int yStep = (int)yStart; yStep < (int)yEnd; ++yStep)
+
+			ClipTrianglesInClipSpace();
+
+			if (m_pStatistics)
 			{
-				x += 1.0f / k;
-				int xStep = (int)x;
-				m_pFrameBuffer[xStep + yStep * m_BackBufferWidth] = clearColor;
+				m_pStatistics->cPrimitives += m_ClipOutputVerts.size() / 3;
+				AccumulateStageTime(m_pStatistics->clipTime, stageStartTime);
 			}
+
+			ViewportTransform();
+
+			Rasterization();
 		}
-	}
 
-	void DeviceContext::DrawTriangleWithLine(const VSOutputVertex& v0, const VSOutputVertex& v1, const VSOutputVertex& v2)
-	{
-		float lineColor[4] = { v0.color.x, v0.color.y, v0.color.z, 1.0f };
-		DrawLineWithDDA(v0.svPostion.x, v0.svPostion.y, v1.svPostion.x, v1.svPostion.y, lineColor);
-		DrawLineWithDDA(v1.svPostion.x, v1.svPostion.y, v2.svPostion.x, v2.svPostion.y, lineColor);
-		DrawLineWithDDA(v2.svPostion.x, v2.svPostion.y, v0.svPostion.x, v0.svPostion.y, lineColor);
+		if (m_pStatistics)
+		{
+			AccumulateStageTime(m_pStatistics->rasterTime, stageStartTime);
+		}
 	}
 
-	void DeviceContext::DrawTriangleWithFlat(const VSOutputVertex& v0, const VSOutputVertex& v1, const VSOutputVertex& v2)
+	void DeviceContext::Begin(ISRQuery* pQuery)
 	{
-		if (FloatEqual(v0.svPostion.y, v1.svPostion.y, RD_FLT_EPSILON) && FloatEqual(v0.svPostion.y, v2.svPostion.y, RD_FLT_EPSILON) ||
-			FloatEqual(v0.svPostion.x, v1.svPostion.x, RD_FLT_EPSILON) && FloatEqual(v0.svPostion.x, v2.svPostion.x, RD_FLT_EPSILON))
+		Query* pSRQuery = dynamic_cast<Query*>(pQuery);
+		if (!pSRQuery)
 		{
 			return;
 		}
 
-		VSOutputVertex vert0(v0);
-		VSOutputVertex vert1(v1);
-		VSOutputVertex vert2(v2);
-		SortTriangleVertsByYGrow(vert0, vert1, vert2);
+		pSRQuery->GetStatistics() = SRQueryDataPipelineStatistics();
+		pSRQuery->SetActive(true);
 
-		if (FloatEqual(vert0.svPostion.y, vert1.svPostion.y, RD_FLT_EPSILON))
-		{
-			DrawTopTriangle(vert0, vert1, vert2);
-		}
-		else if (FloatEqual(vert1.svPostion.y, vert2.svPostion.y, RD_FLT_EPSILON))
-		{
-			DrawBottomTriangle(vert0, vert1, vert2);
-		}
-		else
-		{
-			VSOutputVertex vertNew;
-			SliceTriangleToUpAndBottom(vert0, vert1, vert2, vertNew);
-
-			DrawBottomTriangle(vert0, vert1, vertNew);
-			DrawTopTriangle(vert1, vertNew, vert2);
-		}
+		m_pStatistics = &(pSRQuery->GetStatistics());
 	}
 
-	void DeviceContext::SortTriangleVertsByYGrow(VSOutputVertex& v0, VSOutputVertex& v1, VSOutputVertex& v2)
+	void DeviceContext::End(ISRQuery* pQuery)
 	{
-		if (v1.svPostion.y <= v0.svPostion.y)
+		Query* pSRQuery = dynamic_cast<Query*>(pQuery);
+		if (!pSRQuery || !pSRQuery->IsActive())
 		{
-			VSOutputVertex vTemp = v0;
-			v0 = v1;
-			v1 = vTemp;
+			return;
 		}
 
-		if (v2.svPostion.y <= v0.svPostion.y)
-		{
-			VSOutputVertex vTemp = v0;
-			v0 = v2;
-			v2 = vTemp;
-		}
+		pSRQuery->SetActive(false);
 
-		if (v2.svPostion.y <= v1.svPostion.y)
+		if (m_pStatistics == &(pSRQuery->GetStatistics()))
 		{
-			VSOutputVertex vTemp = v1;
-			v1 = v2;
-			v2 = vTemp;
+			m_pStatistics = nullptr;
 		}
 	}
 
-	void DeviceContext::SortScanlineVertsByXGrow(VSOutputVertex& v0, VSOutputVertex& v1)
+	bool DeviceContext::GetData(ISRQuery* pQuery, void* pData, uint32_t dataSize)
 	{
-		if (v1.svPostion.x <= v0.svPostion.x)
+		Query* pSRQuery = dynamic_cast<Query*>(pQuery);
+		if (!pSRQuery || pSRQuery->IsActive() || !pData)
 		{
-			VSOutputVertex vTemp = v0;
-			v0 = v1;
-			v1 = vTemp;
+			return false;
 		}
+
+		uint32_t copySize = dataSize < sizeof(SRQueryDataPipelineStatistics) ? dataSize : (uint32_t)sizeof(SRQueryDataPipelineStatistics);
+		memcpy(pData, &(pSRQuery->GetStatistics()), copySize);
+
+		return true;
 	}
 
-	void DeviceContext::DrawTopTriangle(VSOutputVertex& v0, VSOutputVertex& v1, VSOutputVertex& v2)
-	{
-		SortScanlineVertsByXGrow(v0, v1);
 
-		float yStart = std::ceilf(v0.svPostion.y - 0.5f);
-		float yEnd = std::ceilf(v2.svPostion.y - 0.5f);
-		float deltaY = v2.svPostion.y - v0.svPostion.y;
+	//------------------------------------------------------------------------------------------------------------------
+	//Private Funtion
+	//------------------------------------------------------------------------------------------------------------------
+	void DeviceContext::DrawLineWithBresenham(const VSOutputVertex& v0, const VSOutputVertex& v1)
+	{
+		int x0 = (int)std::floorf(v0.svPostion.x + 0.5f);
+		int y0 = (int)std::floorf(v0.svPostion.y + 0.5f);
+		int x1 = (int)std::floorf(v1.svPostion.x + 0.5f);
+		int y1 = (int)std::floorf(v1.svPostion.y + 0.5f);
 
-		for (uint32_t i = (uint32_t)yStart; i < (uint32_t)yEnd; ++i)
-		{
-			float lerpFactorY = (i + 0.5f - v0.svPostion.y) / deltaY;
+		int deltaX = std::abs(x1 - x0);
+		int deltaY = -std::abs(y1 - y0);
+		int stepX = x0 < x1 ? 1 : -1;
+		int stepY = y0 < y1 ? 1 : -1;
+		int error = deltaX + deltaY;
 
-			VSOutputVertex vStart;
-			LerpVertexParamsInScreen(v0, v2, vStart, lerpFactorY);
-			VSOutputVertex vEnd;
-			LerpVertexParamsInScreen(v1, v2, vEnd, lerpFactorY);
+		int stepNum = deltaX > -deltaY ? deltaX : -deltaY;
+		float invStepNum = stepNum > 0 ? 1.0f / stepNum : 0.0f;
 
-			float xStart = std::ceilf(vStart.svPostion.x - 0.5f);
-			float xEnd = std::ceilf(vEnd.svPostion.x - 0.5f);
+		//߶ɫͬʱߡᣩֻҪתһɫ
+		bool bSameColor = (v0.color == v1.color);
+		uint32_t lineColor = ConvertColorToUInt32(ConvertRGBAColorToARGBColor(v0.color));
 
-			float deltaX = vEnd.svPostion.x - vStart.svPostion.x;
-			for (uint32_t j = (uint32_t)xStart; j < (uint32_t)xEnd; ++j)
+		int width = (int)m_BackBufferWidth;
+		int height = (int)m_BackBufferHeight;
+		for (int step = 0; step <= stepNum; ++step)
+		{
+			if (x0 >= 0 && x0 < width && y0 >= 0 && y0 < height)
 			{
-				float lerpFactorX = (j + 0.5f - vStart.svPostion.x) / deltaX;
+				float lerpFactor = step * invStepNum;
+				uint32_t index = (uint32_t)x0 + (uint32_t)y0 * m_BackBufferWidth;
 
-				VSOutputVertex vCurr;
-				LerpVertexParamsInScreen(vStart, vEnd, vCurr, lerpFactorX);
+				float depth = v0.svPostion.z + (v1.svPostion.z - v0.svPostion.z) * lerpFactor;
+				float pixelDepth = m_pDepthBuffer[index];
+				if (m_pStatistics && m_bDepthEnable)
+				{
+					++m_pStatistics->testedPixels;
+				}
 
-				float pixelDepth = m_pDepthBuffer[j + i * m_BackBufferWidth];
-				if (vCurr.svPostion.z <= pixelDepth)
+				if (!m_bDepthEnable || depth <= pixelDepth)
 				{
-#ifndef RD_DEBUG_RASTERIZATION
-					Vector4 color = m_pPS->PSMain(vCurr, &m_SRTexture);
-					Vector4 argbColor = ConvertRGBAColorToARGBColor(color);
-					m_pFrameBuffer[j + i * m_BackBufferWidth] = ConvertColorToUInt32(argbColor);
-#else // defined RD_DEBUG_RASTERIZATION
-					Vector4 color = Vector4(1.0f, 0.0f, 0.0f, 1.0f);
-					Vector4 overDrawColor = Vector4(0.0f, 1.0f, 0.0f, 1.0f);
-
-					uint32_t colorUint = ConvertColorToUInt32(ConvertRGBAColorToARGBColor(color));
-					
-					uint32_t drawColor = (m_pFrameBuffer[j + i * m_BackBufferWidth] == colorUint) ?
-										ConvertColorToUInt32(ConvertRGBAColorToARGBColor(overDrawColor)) :
-										colorUint;
-					
-					m_pFrameBuffer[j + i * m_BackBufferWidth] = drawColor;
-#endif // RD_DEBUG_RASTERIZATION
+					if (m_pStatistics)
+					{
+						m_pStatistics->depthPassedPixels += m_bDepthEnable ? 1 : 0;
+						++m_pStatistics->psInvocations;
+						m_pStatistics->overdrawPixels += (pixelDepth != m_ClearDepth) ? 1 : 0;
+					}
+
+					m_pFrameBuffer[index] = bSameColor ? lineColor : ConvertColorToUInt32(ConvertRGBAColorToARGBColor(Lerp(v0.color, v1.color, lerpFactor)));
 
-					m_pDepthBuffer[j + i * m_BackBufferWidth] = vCurr.svPostion.z;
+					if (m_bDepthEnable)
+					{
+						m_pDepthBuffer[index] = depth;
+					}
 				}
 			}
+
+			int error2 = 2 * error;
+			if (error2 >= deltaY)
+			{
+				error += deltaY;
+				x0 += stepX;
+			}
+			if (error2 <= deltaX)
+			{
+				error += deltaX;
+				y0 += stepY;
+			}
 		}
 	}
 
-	void DeviceContext::DrawBottomTriangle(VSOutputVertex& v0, VSOutputVertex& v1, VSOutputVertex& v2)
+	void DeviceContext::AccumulateStageTime(float& stageTime, double& stageStartTime)
 	{
-		SortScanlineVertsByXGrow(v1, v2);
+		double currTime = GetPerfTimeInMs();
+		stageTime += (float)(currTime - stageStartTime);
+		stageStartTime = currTime;
+	}
 
-		float yStart = std::ceilf(v0.svPostion.y - 0.5f);
-		float yEnd = std::ceilf(v1.svPostion.y - 0.5f);
-		float deltaY = v1.svPostion.y - v0.svPostion.y;
+	void DeviceContext::DrawTriangleWithEdgeFunction(const VSOutputVertex& v0, const VSOutputVertex& v1, const VSOutputVertex& v2)
+	{
+		//ĻΪ֮ĸǲȫ
+		int32_t x0 = SnapToSubPixel(v0.svPostion.x);
+		int32_t y0 = SnapToSubPixel(v0.svPostion.y);
+		int32_t x1 = SnapToSubPixel(v1.svPostion.x);
+		int32_t y1 = SnapToSubPixel(v1.svPostion.y);
+		int32_t x2 = SnapToSubPixel(v2.svPostion.x);
+		int32_t y2 = SnapToSubPixel(v2.svPostion.y);
 
-		for (uint32_t i = (uint32_t)yStart; i < (uint32_t)yEnd; ++i)
+		//Ϊ0ֱӶ
+		int64_t area2 = (int64_t)(x1 - x0) * (y2 - y0) - (int64_t)(y1 - y0) * (x2 - x0);
+		if (area2 == 0)
 		{
-			float lerpFactorY = (i + 0.5f - v0.svPostion.y) / deltaY;
+			return;
+		}
 
-			VSOutputVertex vStart;
-			LerpVertexParamsInScreen(v0, v1, vStart, lerpFactorY);
-			VSOutputVertex vEnd;
-			LerpVertexParamsInScreen(v0, v2, vEnd, lerpFactorY);
+		//ͳһΪΪĻ˳򣬴ʱߺڲΪ
+		const VSOutputVertex* pVert1 = &v1;
+		const VSOutputVertex* pVert2 = &v2;
+		if (area2 < 0)
+		{
+			std::swap(x1, x2);
+			std::swap(y1, y2);
+			std::swap(pVert1, pVert2);
+			area2 = -area2;
+		}
+		const VSOutputVertex& vert0 = v0;
+		const VSOutputVertex& vert1 = *pVert1;
+		const VSOutputVertex& vert2 = *pVert2;
 
-			float xStart = std::ceilf(vStart.svPostion.x - 0.5f);
-			float xEnd = std::ceilf(vEnd.svPostion.x - 0.5f);
+		//ΧڵΪ(px * 256 + 128, py * 256 + 128)κĵﱻ޳
+		int32_t minX = (std::max)((std::min)((std::min)(x0, x1), x2) - g_SubPixelHalf + g_SubPixelStep - 1, 0) >> g_SubPixelBits;
+		int32_t minY = (std::max)((std::min)((std::min)(y0, y1), y2) - g_SubPixelHalf + g_SubPixelStep - 1, 0) >> g_SubPixelBits;
+		int32_t maxX = (std::min)(((std::max)((std::max)(x0, x1), x2) - g_SubPixelHalf) >> g_SubPixelBits, (int32_t)m_BackBufferWidth - 1);
+		int32_t maxY = (std::min)(((std::max)((std::max)(y0, y1), y2) - g_SubPixelHalf) >> g_SubPixelBits, (int32_t)m_BackBufferHeight - 1);
+		if (minX > maxX || minY > maxY)
+		{
+			return;
+		}
 
-			float deltaX = vEnd.svPostion.x - vStart.svPostion.x;
-			for (uint32_t j = (uint32_t)xStart; j < (uint32_t)xEnd; ++j)
-			{
-				float lerpFactorX = (j + 0.5f - vStart.svPostion.x) / deltaX;
+		//ߺE(a, b, p) = (bx - ax) * (py - ay) - (by - ay) * (px - ax)e0e1e2ֱӦԱߵĶ012
+		int64_t stepX0 = -(int64_t)(y2 - y1) * g_SubPixelStep;
+		int64_t stepX1 = -(int64_t)(y0 - y2) * g_SubPixelStep;
+		int64_t stepX2 = -(int64_t)(y1 - y0) * g_SubPixelStep;
+		int64_t stepY0 = (int64_t)(x2 - x1) * g_SubPixelStep;
+		int64_t stepY1 = (int64_t)(x0 - x2) * g_SubPixelStep;
+		int64_t stepY2 = (int64_t)(x1 - x0) * g_SubPixelStep;
+
+		int32_t startX = (minX << g_SubPixelBits) + g_SubPixelHalf;
+		int32_t startY = (minY << g_SubPixelBits) + g_SubPixelHalf;
+
+		//Ϲ򣺲ϱ߻ߵıߣߺΪ0ʱ㸲ǣƫ-1ӵߺϣͳһ>=0ж
+		int64_t bias0 = IsTopLeftEdge(x1, y1, x2, y2) ? 0 : -1;
+		int64_t bias1 = IsTopLeftEdge(x2, y2, x0, y0) ? 0 : -1;
+		int64_t bias2 = IsTopLeftEdge(x0, y0, x1, y1) ? 0 : -1;
+
+		int64_t rowE0 = (int64_t)(x2 - x1) * (startY - y1) - (int64_t)(y2 - y1) * (startX - x1) + bias0;
+		int64_t rowE1 = (int64_t)(x0 - x2) * (startY - y2) - (int64_t)(y0 - y2) * (startX - x2) + bias1;
+		int64_t rowE2 = (int64_t)(x1 - x0) * (startY - y0) - (int64_t)(y1 - y0) * (startX - x0) + bias2;
 
-				VSOutputVertex vCurr;
-				LerpVertexParamsInScreen(vStart, vEnd, vCurr, lerpFactorX);
+		//͸УֵԳwĻռԲֵ
+		float invArea = 1.0f / (float)area2;
+		float invW0 = 1.0f / vert0.svPostion.w;
+		float invW1 = 1.0f / vert1.svPostion.w;
+		float invW2 = 1.0f / vert2.svPostion.w;
 
-				float pixelDepth = m_pDepthBuffer[j + i * m_BackBufferWidth];
-				if (vCurr.svPostion.z <= pixelDepth)
+		for (int32_t i = minY; i <= maxY; ++i)
+		{
+			int64_t e0 = rowE0;
+			int64_t e1 = rowE1;
+			int64_t e2 = rowE2;
+
+			for (int32_t j = minX; j <= maxX; ++j)
+			{
+				if ((e0 | e1 | e2) >= 0)
 				{
+					//ȥϹƫƺټ
+					float lambda0 = (float)(e0 - bias0) * invArea;
+					float lambda1 = (float)(e1 - bias1) * invArea;
+					float lambda2 = 1.0f - lambda0 - lambda1;
+
+					uint32_t index = (uint32_t)j + (uint32_t)i * m_BackBufferWidth;
+
+					float depth = lambda0 * vert0.svPostion.z + lambda1 * vert1.svPostion.z + lambda2 * vert2.svPostion.z;
+					float pixelDepth = m_pDepthBuffer[index];
+					if (m_pStatistics)
+					{
+						++m_pStatistics->testedPixels;
+					}
+
+					if (depth <= pixelDepth)
+					{
+						if (m_pStatistics)
+						{
+							++m_pStatistics->depthPassedPixels;
+							++m_pStatistics->psInvocations;
+							m_pStatistics->overdrawPixels += (pixelDepth != m_ClearDepth) ? 1 : 0;
+						}
+
 #ifndef RD_DEBUG_RASTERIZATION
-					Vector4 color = m_pPS->PSMain(vCurr, &m_SRTexture);
-					Vector4 argbColor = ConvertRGBAColorToARGBColor(color);
-					m_pFrameBuffer[j + i * m_BackBufferWidth] = ConvertColorToUInt32(argbColor);
+						float weight0 = lambda0 * invW0;
+						float weight1 = lambda1 * invW1;
+						float weight2 = lambda2 * invW2;
+						float pixelW = 1.0f / (weight0 + weight1 + weight2);
+						weight0 *= pixelW;
+						weight1 *= pixelW;
+						weight2 *= pixelW;
+
+						VSOutputVertex vCurr;
+						vCurr.svPostion	= Vector4(j + 0.5f, i + 0.5f, depth, pixelW);
+						vCurr.color		= vert0.color * weight0 + vert1.color * weight1 + vert2.color * weight2;
+						vCurr.normal	= vert0.normal * weight0 + vert1.normal * weight1 + vert2.normal * weight2;
+						vCurr.tangent	= vert0.tangent * weight0 + vert1.tangent * weight1 + vert2.tangent * weight2;
+						vCurr.biTangent	= vert0.biTangent * weight0 + vert1.biTangent * weight1 + vert2.biTangent * weight2;
+						vCurr.texcoord	= vert0.texcoord * weight0 + vert1.texcoord * weight1 + vert2.texcoord * weight2;
+
+						Vector4 color = m_pPS->PSMain(vCurr, &m_SRTexture);
+						Vector4 argbColor = ConvertRGBAColorToARGBColor(color);
+						m_pFrameBuffer[index] = ConvertColorToUInt32(argbColor);
 #else // defined RD_DEBUG_RASTERIZATION
-					Vector4 color = Vector4(1.0f, 0.0f, 0.0f, 1.0f);
-					Vector4 overDrawColor = Vector4(0.0f, 1.0f, 0.0f, 1.0f);
+						Vector4 color = Vector4(1.0f, 0.0f, 0.0f, 1.0f);
+						Vector4 overDrawColor = Vector4(0.0f, 1.0f, 0.0f, 1.0f);
 
-					uint32_t colorUint = ConvertColorToUInt32(ConvertRGBAColorToARGBColor(color));
+						uint32_t colorUint = ConvertColorToUInt32(ConvertRGBAColorToARGBColor(color));
 
-					uint32_t drawColor = (m_pFrameBuffer[j + i * m_BackBufferWidth] == colorUint) ? 
-										ConvertColorToUInt32(ConvertRGBAColorToARGBColor(overDrawColor)) : 
-										colorUint;
+						uint32_t drawColor = (m_pFrameBuffer[index] == colorUint) ?
+											ConvertColorToUInt32(ConvertRGBAColorToARGBColor(overDrawColor)) :
+											colorUint;
 
-					m_pFrameBuffer[j + i * m_BackBufferWidth] = drawColor;
+						m_pFrameBuffer[index] = drawColor;
 #endif // RD_DEBUG_RASTERIZATION
 
-					m_pDepthBuffer[j + i * m_BackBufferWidth] = vCurr.svPostion.z;
+						m_pDepthBuffer[index] = depth;
+					}
 				}
-			}
-		}
-	}
-
-	void DeviceContext::SliceTriangleToUpAndBottom(const VSOutputVertex& v0, const VSOutputVertex& v1, const VSOutputVertex& v2, VSOutputVertex& vNew)
-	{
-		float lerpFactor = (v1.svPostion.y - v0.svPostion.y) / (v2.svPostion.y - v0.svPostion.y);
 
-		LerpVertexParamsInScreen(v0, v2, vNew, lerpFactor);
-	}
-
-	void DeviceContext::LerpVertexParamsInScreen(const VSOutputVertex& vStart, const VSOutputVertex& vEnd, VSOutputVertex& vNew, float lerpFactor)
-	{
-		float newX = vStart.svPostion.x + (vEnd.svPostion.x - vStart.svPostion.x) * lerpFactor;
-		float newY = vStart.svPostion.y + (vEnd.svPostion.y - vStart.svPostion.y) * lerpFactor;
-		float newZ = vStart.svPostion.z + (vEnd.svPostion.z - vStart.svPostion.z) * lerpFactor;
-		float newW = 1.0f / (1.0f / vStart.svPostion.w + (1.0f / vEnd.svPostion.w - 1.0f / vStart.svPostion.w) * lerpFactor);
+				e0 += stepX0;
+				e1 += stepX1;
+				e2 += stepX2;
+			}
 
-		vNew.svPostion	= Vector4(newX, newY, newZ, newW);
-		vNew.color		= newW * ((vStart.color / vStart.svPostion.w) * (1.0f - lerpFactor) + (vEnd.color / vEnd.svPostion.w) * lerpFactor);
-		vNew.normal		= newW * ((vStart.normal / vStart.svPostion.w) * (1.0f - lerpFactor) + (vEnd.normal / vEnd.svPostion.w) * lerpFactor);
-		vNew.tangent	= newW * ((vStart.tangent / vStart.svPostion.w) * (1.0f - lerpFactor) + (vEnd.tangent / vEnd.svPostion.w) * lerpFactor);
-		vNew.biTangent	= newW * ((vStart.biTangent / vStart.svPostion.w) * (1.0f - lerpFactor) + (vEnd.biTangent / vEnd.svPostion.w) * lerpFactor);
-		vNew.texcoord	= newW * ((vStart.texcoord / vStart.svPostion.w) * (1.0f - lerpFactor) + (vEnd.texcoord / vEnd.svPostion.w) * lerpFactor);
+			rowE0 += stepY0;
+			rowE1 += stepY1;
+			rowE2 += stepY2;
+		}
 	}
 
 	void DeviceContext::LerpVertexParamsInClip(const VSOutputVertex& vStart, const VSOutputVertex& vEnd, VSOutputVertex& vNew, float lerpFactor)
@@ -1578,6 +1863,8 @@ namespace RenderDog
 
 	void DeviceContext::ClipTrianglesInClipSpace()
 	{
+		RD_PROFILE_SCOPE("SR::ClipTrianglesInClipSpace");
+
 		m_ClipOutputVerts.clear();
 		if (m_ClipOutputVerts.capacity() < m_BackFaceCulledVerts.capacity())
 		{
@@ -1592,6 +1879,12 @@ namespace RenderDog
 			const VSOutputVertex& vert1 = m_BackFaceCulledVerts[i + 1];
 			const VSOutputVertex& vert2 = m_BackFaceCulledVerts[i + 2];
 
+			if (m_pStatistics && 
+				!(IsInsideClipSpace(vert0.svPostion) && IsInsideClipSpace(vert1.svPostion) && IsInsideClipSpace(vert2.svPostion)))
+			{
+				++m_pStatistics->clippedPrimitives;
+			}
+
 			m_ClippingVerts.push_back(vert0);
 			m_ClippingVerts.push_back(vert1);
 			m_ClippingVerts.push_back(vert2);
@@ -1617,22 +1910,133 @@ namespace RenderDog
 		}
 	}
 
-	void DeviceContext::ViewportTransform()
+	void DeviceContext::ClipLinesInClipSpace()
 	{
+		RD_PROFILE_SCOPE("SR::ClipLinesInClipSpace");
+
+		m_ClipOutputVerts.clear();
+		if (m_ClipOutputVerts.capacity() < m_AssembledVerts.size())
+		{
+			m_ClipOutputVerts.reserve(m_AssembledVerts.size());
+		}
+
+		for (uint32_t i = 0; i + 1 < m_AssembledVerts.size(); i += 2)
+		{
+			VSOutputVertex vOut0;
+			VSOutputVertex vOut1;
+			if (ClipLineWithLiangBarsky(m_AssembledVerts[i], m_AssembledVerts[i + 1], vOut0, vOut1))
+			{
+				m_ClipOutputVerts.push_back(vOut0);
+				m_ClipOutputVerts.push_back(vOut1);
+			}
+		}
+
 		for (uint32_t i = 0; i < m_ClipOutputVerts.size(); ++i)
 		{
-			VSOutputVertex& vsOutput = m_ClipOutputVerts[i];
-			Vector4 vScreenPos(vsOutput.svPostion.x, vsOutput.svPostion.y, vsOutput.svPostion.z, 1.0f);
-			vScreenPos = vScreenPos * m_ViewportMatrix;
-			vsOutput.svPostion.x = vScreenPos.x;
-			vsOutput.svPostion.y = vScreenPos.y;
-			vsOutput.svPostion.z = vScreenPos.z;
+			m_ClipOutputVerts[i].svPostion.x /= m_ClipOutputVerts[i].svPostion.w;
+			m_ClipOutputVerts[i].svPostion.y /= m_ClipOutputVerts[i].svPostion.w;
+			m_ClipOutputVerts[i].svPostion.z /= m_ClipOutputVerts[i].svPostion.w;
 		}
 	}
 
+	bool DeviceContext::ClipLineWithLiangBarsky(const VSOutputVertex& v0, const VSOutputVertex& v1, VSOutputVertex& vOut0, VSOutputVertex& vOut1)
+	{
+		const Vector4& pos0 = v0.svPostion;
+		const Vector4& pos1 = v1.svPostion;
+
+		//㵽ü룬Ǹʾڲüڲࣺ-w<=x<=w, -w<=y<=w, 0<=z<=w
+		float dist0[6] = { pos0.w + pos0.x, pos0.w - pos0.x, pos0.w + pos0.y, pos0.w - pos0.y, pos0.z, pos0.w - pos0.z };
+		float dist1[6] = { pos1.w + pos1.x, pos1.w - pos1.x, pos1.w + pos1.y, pos1.w - pos1.y, pos1.z, pos1.w - pos1.z };
+
+		float tStart = 0.0f;
+		float tEnd = 1.0f;
+		for (int plane = 0; plane < 6; ++plane)
+		{
+			float d0 = dist0[plane];
+			float d1 = dist1[plane];
+
+			if (d0 < 0.0f && d1 < 0.0f)
+			{
+				if (m_pStatistics)
+				{
+					++m_pStatistics->clippedPrimitives;
+				}
+
+				return false;
+			}
+
+			if (d0 < 0.0f)
+			{
+				float t = d0 / (d0 - d1);
+				tStart = t > tStart ? t : tStart;
+			}
+			else if (d1 < 0.0f)
+			{
+				float t = d0 / (d0 - d1);
+				tEnd = t < tEnd ? t : tEnd;
+			}
+
+			if (tStart > tEnd)
+			{
+				if (m_pStatistics)
+				{
+					++m_pStatistics->clippedPrimitives;
+				}
+
+				return false;
+			}
+		}
+
+		if (m_pStatistics && (tStart > 0.0f || tEnd < 1.0f))
+		{
+			++m_pStatistics->clippedPrimitives;
+		}
+
+		if (tStart > 0.0f)
+		{
+			LerpVertexParamsInClip(v0, v1, vOut0, tStart);
+		}
+		else
+		{
+			vOut0 = v0;
+		}
+
+		if (tEnd < 1.0f)
+		{
+			LerpVertexParamsInClip(v0, v1, vOut1, tEnd);
+		}
+		else
+		{
+			vOut1 = v1;
+		}
+
+		return true;
+	}
+
+	bool DeviceContext::IsInsideClipSpace(const Vector4& clipPos) const
+	{
+		return clipPos.x >= -clipPos.w && clipPos.x <= clipPos.w &&
+			   clipPos.y >= -clipPos.w && clipPos.y <= clipPos.w &&
+			   clipPos.z >= 0.0f && clipPos.z <= clipPos.w;
+	}
+
+	void DeviceContext::ViewportTransform()
+	{
+		RD_PROFILE_SCOPE("SR::ViewportTransform");
+
+		if (m_ClipOutputVerts.empty())
+		{
+			return;
+		}
+
+		//svPostionxyzw = 1ԭر任wֲ
+		Vector3* pScreenPos = reinterpret_cast<Vector3*>(&m_ClipOutputVerts[0].svPostion);
+		TransformPoints(pScreenPos, sizeof(VSOutputVertex), pScreenPos, sizeof(VSOutputVertex), (uint32_t)m_ClipOutputVerts.size(), m_ViewportMatrix);
+	}
+
 	void DeviceContext::ClipTriangleWithPlaneX(int sign)
 	{
-		std::vector<VSOutputVertex> currClipResultVerts = {};
+		m_ClipResultVerts.clear();
 
 		for (uint32_t i = 0; i < m_ClippingVerts.size(); i += 3)
 		{
@@ -1648,9 +2052,9 @@ namespace RenderDog
 
 			if (outOfClipPlaneNum == 0)
 			{
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
@@ -1679,9 +2083,9 @@ namespace RenderDog
 					ClipTwoVertsInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2);
 				}
 
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
@@ -1691,39 +2095,35 @@ namespace RenderDog
 				{
 					float lerpFactor1 = GetClipLerpFactorX(vert1, vert0, sign);
 					float lerpFactor2 = GetClipLerpFactorX(vert2, vert0, sign);
-					ClipOneVertInTriangle(vert0, vert1, vert2, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert0, vert1, vert2, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 				else if (sign * vert1.svPostion.x > vert1.svPostion.w)
 				{
 					float lerpFactor1 = GetClipLerpFactorX(vert2, vert1, sign);
 					float lerpFactor2 = GetClipLerpFactorX(vert0, vert1, sign);
-					ClipOneVertInTriangle(vert1, vert2, vert0, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert1, vert2, vert0, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 				else
 				{
 					float lerpFactor1 = GetClipLerpFactorX(vert0, vert2, sign);
 					float lerpFactor2 = GetClipLerpFactorX(vert1, vert2, sign);
-					ClipOneVertInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
 		}
 
-		m_ClippingVerts.clear();
-		for (uint32_t i = 0; i < currClipResultVerts.size(); ++i)
-		{
-			m_ClippingVerts.push_back(currClipResultVerts[i]);
-		}
+		m_ClippingVerts.swap(m_ClipResultVerts);
 	}
 
 	void DeviceContext::ClipTriangleWithPlaneY(int sign)
 	{
-		std::vector<VSOutputVertex> currClipResultVerts = {};
+		m_ClipResultVerts.clear();
 
 		for (uint32_t i = 0; i < m_ClippingVerts.size(); i += 3)
 		{
@@ -1739,9 +2139,9 @@ namespace RenderDog
 
 			if (outOfClipPlaneNum == 0)
 			{
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
@@ -1770,9 +2170,9 @@ namespace RenderDog
 					ClipTwoVertsInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2);
 				}
 
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
@@ -1782,39 +2182,35 @@ namespace RenderDog
 				{
 					float lerpFactor1 = GetClipLerpFactorY(vert1, vert0, sign);
 					float lerpFactor2 = GetClipLerpFactorY(vert2, vert0, sign);
-					ClipOneVertInTriangle(vert0, vert1, vert2, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert0, vert1, vert2, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 				else if (sign * vert1.svPostion.y > vert1.svPostion.w)
 				{
 					float lerpFactor1 = GetClipLerpFactorY(vert2, vert1, sign);
 					float lerpFactor2 = GetClipLerpFactorY(vert0, vert1, sign);
-					ClipOneVertInTriangle(vert1, vert2, vert0, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert1, vert2, vert0, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 				else
 				{
 					float lerpFactor1 = GetClipLerpFactorY(vert0, vert2, sign);
 					float lerpFactor2 = GetClipLerpFactorY(vert1, vert2, sign);
-					ClipOneVertInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
 		}
 
-		m_ClippingVerts.clear();
-		for (uint32_t i = 0; i < currClipResultVerts.size(); ++i)
-		{
-			m_ClippingVerts.push_back(currClipResultVerts[i]);
-		}
+		m_ClippingVerts.swap(m_ClipResultVerts);
 	}
 
 	void DeviceContext::ClipTriangleWithPlaneZeroZ()
 	{
-		std::vector<VSOutputVertex> currClipResultVerts = {};
+		m_ClipResultVerts.clear();
 
 		for (uint32_t i = 0; i < m_ClippingVerts.size(); i += 3)
 		{
@@ -1830,9 +2226,9 @@ namespace RenderDog
 
 			if (outOfClipPlaneNum == 0)
 			{
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
@@ -1861,9 +2257,9 @@ namespace RenderDog
 					ClipTwoVertsInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2);
 				}
 
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
@@ -1873,39 +2269,35 @@ namespace RenderDog
 				{
 					float lerpFactor1 = GetClipLerpFactorZeroZ(vert1, vert0);
 					float lerpFactor2 = GetClipLerpFactorZeroZ(vert2, vert0);
-					ClipOneVertInTriangle(vert0, vert1, vert2, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert0, vert1, vert2, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 				else if (vert1.svPostion.z < 0.0f)
 				{
 					float lerpFactor1 = GetClipLerpFactorZeroZ(vert2, vert1);
 					float lerpFactor2 = GetClipLerpFactorZeroZ(vert0, vert1);
-					ClipOneVertInTriangle(vert1, vert2, vert0, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert1, vert2, vert0, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 				else
 				{
 					float lerpFactor1 = GetClipLerpFactorZeroZ(vert0, vert2);
 					float lerpFactor2 = GetClipLerpFactorZeroZ(vert1, vert2);
-					ClipOneVertInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
 		}
 
-		m_ClippingVerts.clear();
-		for (uint32_t i = 0; i < currClipResultVerts.size(); ++i)
-		{
-			m_ClippingVerts.push_back(currClipResultVerts[i]);
-		}
+		m_ClippingVerts.swap(m_ClipResultVerts);
 	}
 
 	void DeviceContext::ClipTriangleWithPlanePositiveZ()
 	{
-		std::vector<VSOutputVertex> currClipResultVerts = {};
+		m_ClipResultVerts.clear();
 
 		for (uint32_t i = 0; i < m_ClippingVerts.size(); i += 3)
 		{
@@ -1921,9 +2313,9 @@ namespace RenderDog
 
 			if (outOfClipPlaneNum == 0)
 			{
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
@@ -1952,9 +2344,9 @@ namespace RenderDog
 					ClipTwoVertsInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2);
 				}
 
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
@@ -1964,34 +2356,30 @@ namespace RenderDog
 				{
 					float lerpFactor1 = GetClipLerpFactorPositiveZ(vert1, vert0);
 					float lerpFactor2 = GetClipLerpFactorPositiveZ(vert2, vert0);
-					ClipOneVertInTriangle(vert0, vert1, vert2, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert0, vert1, vert2, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 				else if (vert1.svPostion.z > vert1.svPostion.w)
 				{
 					float lerpFactor1 = GetClipLerpFactorPositiveZ(vert2, vert1);
 					float lerpFactor2 = GetClipLerpFactorPositiveZ(vert0, vert1);
-					ClipOneVertInTriangle(vert1, vert2, vert0, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert1, vert2, vert0, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 				else
 				{
 					float lerpFactor1 = GetClipLerpFactorPositiveZ(vert0, vert2);
 					float lerpFactor2 = GetClipLerpFactorPositiveZ(vert1, vert2);
-					ClipOneVertInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2, currClipResultVerts);
+					ClipOneVertInTriangle(vert2, vert0, vert1, lerpFactor1, lerpFactor2, m_ClipResultVerts);
 				}
 
-				currClipResultVerts.push_back(vert0);
-				currClipResultVerts.push_back(vert1);
-				currClipResultVerts.push_back(vert2);
+				m_ClipResultVerts.push_back(vert0);
+				m_ClipResultVerts.push_back(vert1);
+				m_ClipResultVerts.push_back(vert2);
 
 				continue;
 			}
 		}
 
-		m_ClippingVerts.clear();
-		for (uint32_t i = 0; i < currClipResultVerts.size(); ++i)
-		{
-			m_ClippingVerts.push_back(currClipResultVerts[i]);
-		}
+		m_ClippingVerts.swap(m_ClipResultVerts);
 	}
 
 	void DeviceContext::ClipTwoVertsInTriangle(const VSOutputVertex& vertIn, VSOutputVertex& vertOut1, VSOutputVertex& vertOut2, float lerpFactor1, float lerpFactor2)
@@ -2042,6 +2430,8 @@ namespace RenderDog
 
 	void DeviceContext::ShapeAssemble(uint32_t indexNum)
 	{
+		RD_PROFILE_SCOPE("SR::ShapeAssemble");
+
 		m_AssembledVerts.clear();
 		if (m_AssembledVerts.capacity() < indexNum)
 		{
@@ -2063,6 +2453,8 @@ namespace RenderDog
 
 	void DeviceContext::BackFaceCulling()
 	{
+		RD_PROFILE_SCOPE("SR::BackFaceCulling");
+
 		m_BackFaceCulledVerts.clear();
 		if (m_BackFaceCulledVerts.capacity() < m_AssembledVerts.size())
 		{
@@ -2088,20 +2480,25 @@ namespace RenderDog
 	//涨صĲĵ㣬Ͻǵĵһ˵Ϊ(0.5, 0.5)
 	void DeviceContext::Rasterization()
 	{
+		RD_PROFILE_SCOPE("SR::Rasterization");
+
 		for (uint32_t i = 0; i < m_ClipOutputVerts.size(); i += 3)
 		{
 			const VSOutputVertex& vert0 = m_ClipOutputVerts[i];
 			const VSOutputVertex& vert1 = m_ClipOutputVerts[i + 1];
 			const VSOutputVertex& vert2 = m_ClipOutputVerts[i + 2];
 
-			if (m_PriTopology == SR_PRIMITIVE_TOPOLOGY::LINE_LIST)
-			{
-				DrawTriangleWithLine(vert0, vert1, vert2);
-			}
-			else if (m_PriTopology == SR_PRIMITIVE_TOPOLOGY::TRIANGLE_LIST)
-			{
-				DrawTriangleWithFlat(vert0, vert1, vert2);
-			}
+			DrawTriangleWithEdgeFunction(vert0, vert1, vert2);
+		}
+	}
+
+	void DeviceContext::RasterizeLines()
+	{
+		RD_PROFILE_SCOPE("SR::RasterizeLines");
+
+		for (uint32_t i = 0; i + 1 < m_ClipOutputVerts.size(); i += 2)
+		{
+			DrawLineWithBresenham(m_ClipOutputVerts[i], m_ClipOutputVerts[i + 1]);
 		}
 	}
 
@@ -2161,6 +2558,23 @@ namespace RenderDog
 			return false;
 		}
 
+		//ûʱ(Ⱦ)backbufferڴTexture2DԼ䣬Presentκ
+		if (!m_Desc.hOutputWindow)
+		{
+			SRTexture2DDesc texDesc;
+			texDesc.width = m_Desc.width;
+			texDesc.height = m_Desc.height;
+			texDesc.format = m_Desc.format;
+			if (!m_pBackBuffer->Init(&texDesc, nullptr))
+			{
+				return false;
+			}
+
+			AddRef();
+
+			return true;
+		}
+
 		SRTexture2DDesc texDesc;
 		texDesc.width = m_Desc.width;
 		texDesc.height = m_Desc.height;
@@ -2259,6 +2673,11 @@ namespace RenderDog
 
 	void SwapChain::Present()
 	{
+		if (!m_Desc.hOutputWindow)
+		{
+			return;
+		}
+
 		HDC hDC = GetDC(m_Desc.hOutputWindow);
 		BitBlt(hDC, 0, 0, m_Desc.width, m_Desc.height, m_hWndDC, 0, 0, SRCCOPY);
 		ReleaseDC(m_Desc.hOutputWindow, hDC);
@@ -2303,6 +2722,16 @@ namespace RenderDog
 			return false;
 		}
 
+		if (!m_Desc.hOutputWindow)
+		{
+			SRTexture2DDesc texDesc;
+			texDesc.width = m_Desc.width;
+			texDesc.height = m_Desc.height;
+			texDesc.format = m_Desc.format;
+
+			return m_pBackBuffer->Init(&texDesc, nullptr);
+		}
+
 		SRTexture2DDesc texDesc;
 		texDesc.width = m_Desc.width;
 		texDesc.height = m_Desc.height;
@@ -2404,38 +2833,30 @@ namespace RenderDog
 	}
 
 #pragma region Shader
-	VSOutputVertex VertexShader::VSMain(const StandardVertex& inVertex, const Matrix4x4& matWorld, const Matrix4x4& matView, const Matrix4x4& matProj) const
-	{
-		VSOutputVertex vOutput = {};
-		Vector4 inPos = Vector4(inVertex.position, 1.0f);
-		inPos = inPos * matWorld;
-		inPos = inPos * matView;
-		inPos = inPos * matProj;
-
-		vOutput.svPostion.x = inPos.x;
-		vOutput.svPostion.y = inPos.y;
-		vOutput.svPostion.z = inPos.z;
-		vOutput.svPostion.w = inPos.w;
-
-		vOutput.color = Vector4(inVertex.color);
-
-		Vector4 vNormal = Vector4(inVertex.normal, 0.0f);
-		vNormal = vNormal * matWorld;
-		vOutput.normal.x = vNormal.x;
-		vOutput.normal.y = vNormal.y;
-		vOutput.normal.z = vNormal.z;
-
-		Vector4 vTangent = Vector4(inVertex.tangent.x, inVertex.tangent.y, inVertex.tangent.z, 0.0f);
-		vTangent = vTangent * matWorld;
-		vOutput.tangent.x = vTangent.x;
-		vOutput.tangent.y = vTangent.y;
-		vOutput.tangent.z = vTangent.z;
-		
-		vOutput.biTangent = CrossProduct(vOutput.normal, vOutput.tangent) * inVertex.tangent.w;
+	void VertexShader::VSMain(const StandardVertex* pInVerts, uint32_t vertNum, const Matrix4x4& matWorld, const Matrix4x4& matWorldNormal, const Matrix4x4& matView, const Matrix4x4& matProj, VSOutputVertex* pOutVerts) const
+	{
+		if (vertNum == 0)
+		{
+			return;
+		}
 
-		vOutput.texcoord = inVertex.texcoord;
+		Matrix4x4 matWorldViewProj = matWorld * matView * matProj;
 
-		return vOutput;
+		TransformPointsToVector4(&pOutVerts[0].svPostion, sizeof(VSOutputVertex), &pInVerts[0].position, sizeof(StandardVertex), vertNum, matWorldViewProj);
+		//ʹתþ󣬷Ǿʱֺܱߴֱ
+		TransformDirections(&pOutVerts[0].normal, sizeof(VSOutputVertex), &pInVerts[0].normal, sizeof(StandardVertex), vertNum, matWorldNormal);
+		//ߵwʾԣֻ任xyz
+		TransformDirections(&pOutVerts[0].tangent, sizeof(VSOutputVertex), reinterpret_cast<const Vector3*>(&pInVerts[0].tangent), sizeof(StandardVertex), vertNum, matWorld);
+
+		for (uint32_t i = 0; i < vertNum; ++i)
+		{
+			const StandardVertex& inVertex = pInVerts[i];
+			VSOutputVertex& vOutput = pOutVerts[i];
+
+			vOutput.color = Vector4(inVertex.color);
+			vOutput.biTangent = CrossProduct(vOutput.normal, vOutput.tangent) * inVertex.tangent.w;
+			vOutput.texcoord = inVertex.texcoord;
+		}
 	}
 
 	Vector4 PixelShader::PSMain(const VSOutputVertex& psInput, const ShaderResourceTexture* pNormalTexture) const
@@ -22,6 +22,8 @@ namespace RenderDog
 	ISRDevice*			g_pSRDevice = nullptr;
 	ISRDeviceContext*	g_pSRImmediateContext = nullptr;
 
+	SRQueryDataPipelineStatistics g_SRFrameStatistics;
+
 	///////////////////////////////////////////////////////////////////////////////////
 	//-----------------------         Mesh Renderer         -------------------------//
 	///////////////////////////////////////////////////////////////////////////////////
@@ -130,10 +132,23 @@ namespace RenderDog
 
 	protected:
 		void						ApplyMaterialParam(IMaterialInstance* pMtlIns);
+
+	protected:
+		//һλư󶨵״̬ͼԪڵĻƾʹͬ״̬ͬʱظ
+		bool						m_bStateApplied;
+		IVertexBuffer*				m_pCurrVB;
+		IIndexBuffer*				m_pCurrIB;
+		IShader*					m_pCurrVS;
+		IMaterialInstance*			m_pCurrMtlIns;
 	};
 
 	SoftwareMeshLightingRenderer::SoftwareMeshLightingRenderer(const MeshLightingGlobalData& globalData) :
-		SoftwareMeshRenderer(globalData.pSceneView)
+		SoftwareMeshRenderer(globalData.pSceneView),
+		m_bStateApplied(false),
+		m_pCurrVB(nullptr),
+		m_pCurrIB(nullptr),
+		m_pCurrVS(nullptr),
+		m_pCurrMtlIns(nullptr)
 	{
 		ShaderCompileDesc psDesc(g_DirectionalLightingPixelShaderFilePath, nullptr, "Main", "ps_5_0", 0);
 		m_pPixelShader = g_pIShaderManager->GetDirectionLightingPixelShader(psDesc);
@@ -154,24 +169,46 @@ namespace RenderDog
 			return;
 		}
 
-		g_pSRImmediateContext->IASetPrimitiveTopology(RenderDog::SR_PRIMITIVE_TOPOLOGY::TRIANGLE_LIST);
+		if (!m_bStateApplied)
+		{
+			g_pSRImmediateContext->IASetPrimitiveTopology(RenderDog::SR_PRIMITIVE_TOPOLOGY::TRIANGLE_LIST);
+		}
 
-		ISRBuffer* pVB = (ISRBuffer*)(renderParam.pVB->GetResource());
-		ISRBuffer* pIB = (ISRBuffer*)(renderParam.pIB->GetResource());
+		if (!m_bStateApplied || renderParam.pVB != m_pCurrVB)
+		{
+			ISRBuffer* pVB = (ISRBuffer*)(renderParam.pVB->GetResource());
+			g_pSRImmediateContext->IASetVertexBuffer(pVB);
+			m_pCurrVB = renderParam.pVB;
+		}
 
-		uint32_t indexNum = renderParam.pIB->GetIndexNum();
+		if (!m_bStateApplied || renderParam.pIB != m_pCurrIB)
+		{
+			ISRBuffer* pIB = (ISRBuffer*)(renderParam.pIB->GetResource());
+			g_pSRImmediateContext->IASetIndexBuffer(pIB);
+			m_pCurrIB = renderParam.pIB;
+		}
 
-		uint32_t stride = renderParam.pVB->GetStride();
-		uint32_t offset = renderParam.pVB->GetOffset();
-		g_pSRImmediateContext->IASetVertexBuffer(pVB);
-		g_pSRImmediateContext->IASetIndexBuffer(pIB);
+		if (!m_bStateApplied || renderParam.pVS != m_pCurrVS)
+		{
+			renderParam.pVS->Apply(&renderParam.PerObjParam);
+			m_pCurrVS = renderParam.pVS;
+		}
+		else
+		{
+			renderParam.pVS->ApplyPerObjParam(&renderParam.PerObjParam);
+		}
 
-		renderParam.pVS->Apply(&renderParam.PerObjParam);
+		if (!m_bStateApplied || renderParam.pMtlIns != m_pCurrMtlIns)
+		{
+			ApplyMaterialParam(renderParam.pMtlIns);
 
-		ApplyMaterialParam(renderParam.pMtlIns);
+			m_pPixelShader->Apply();
+			m_pCurrMtlIns = renderParam.pMtlIns;
+		}
 
-		m_pPixelShader->Apply();
+		m_bStateApplied = true;
 
+		uint32_t indexNum = renderParam.pIB->GetIndexNum();
 		g_pSRImmediateContext->DrawIndex(indexNum);
 	}
 
@@ -257,6 +294,8 @@ namespace RenderDog
 
 		virtual bool				OnResize(uint32_t width, uint32_t height);
 
+		bool						ReadBackBuffer(std::vector<uint32_t>& outPixels, uint32_t& outWidth, uint32_t& outHeight);
+
 	private:
 		bool						CreateInternalShaders();
 		void						ReleaseInternalShaders();
@@ -274,6 +313,8 @@ namespace RenderDog
 		ISRRenderTargetView*		m_pRenderTargetView;
 		ISRDepthStencilView*		m_pDepthStencilView;
 
+		ISRQuery*					m_pPipelineStatisticsQuery;
+
 		SceneView*					m_pSceneView;
 
 		IConstantBuffer*			m_pViewParamConstantBuffer;
@@ -296,6 +337,7 @@ namespace RenderDog
 		m_pDepthStencilTexture(nullptr),
 		m_pRenderTargetView(nullptr),
 		m_pDepthStencilView(nullptr),
+		m_pPipelineStatisticsQuery(nullptr),
 		m_pSceneView(nullptr),
 		m_pViewParamConstantBuffer(nullptr),
 		m_pLightingConstantBuffer(nullptr),
@@ -327,7 +369,17 @@ namespace RenderDog
 			return false;
 		}
 
+		SRQueryDesc queryDesc;
+		queryDesc.query = SR_QUERY::PIPELINE_STATISTICS;
+		if (!g_pSRDevice->CreateQuery(&queryDesc, &m_pPipelineStatisticsQuery))
+		{
+			MessageBox(nullptr, "SoftwareRenderer CreateQuery failed.", 0, 0);
+			return false;
+		}
+
 		m_pSceneView = new SceneView(desc.pMainCamera);
+		//դɫ֮ǰȲԣ״̬лĿСɽԶƿԼɫ
+		m_pSceneView->SetOpaqueSortMode(DRAW_SORT_MODE::FRONT_TO_BACK);
 
 		BufferDesc cbDesc = {};
 		cbDesc.name = "ComVar_ConstantBuffer_ViewParam";
@@ -363,6 +415,12 @@ namespace RenderDog
 			m_pLightingConstantBuffer = nullptr;
 		}
 
+		if (m_pPipelineStatisticsQuery)
+		{
+			m_pPipelineStatisticsQuery->Release();
+			m_pPipelineStatisticsQuery = nullptr;
+		}
+
 		if (m_pRenderTargetView)
 		{
 			m_pRenderTargetView->Release();
@@ -416,6 +474,7 @@ namespace RenderDog
 
 		m_pSceneView->ClearPrimitives();
 		AddPrisAndLightsToSceneView(pScene);
+		m_pSceneView->SortPrimitives();
 	}
 
 	void SoftwareRenderer::Render(IScene* pScene)
@@ -423,8 +482,13 @@ namespace RenderDog
 		float clearColor[4] = { 0.85f, 0.92f, 0.99f, 1.0f };
 		ClearBackRenderTarget(clearColor);
 
+		g_pSRImmediateContext->Begin(m_pPipelineStatisticsQuery);
+
 		RenderPrimitives();
 
+		g_pSRImmediateContext->End(m_pPipelineStatisticsQuery);
+		g_pSRImmediateContext->GetData(m_pPipelineStatisticsQuery, &g_SRFrameStatistics, sizeof(g_SRFrameStatistics));
+
 		m_pSwapChain->Present();
 	}
 
@@ -502,6 +566,39 @@ namespace RenderDog
 	}
 
 
+	bool SoftwareRenderer::ReadBackBuffer(std::vector<uint32_t>& outPixels, uint32_t& outWidth, uint32_t& outHeight)
+	{
+		if (!m_pSwapChain)
+		{
+			return false;
+		}
+
+		RenderDog::ISRTexture2D* pBackBuffer = nullptr;
+		if (!m_pSwapChain->GetBuffer((void**)&pBackBuffer))
+		{
+			return false;
+		}
+
+		SRTexture2DDesc texDesc;
+		pBackBuffer->GetDesc(&texDesc);
+
+		const uint32_t* pPixels = (const uint32_t*)pBackBuffer->GetData();
+		if (!pPixels)
+		{
+			pBackBuffer->Release();
+			return false;
+		}
+
+		outWidth = texDesc.width;
+		outHeight = texDesc.height;
+		outPixels.assign(pPixels, pPixels + texDesc.width * texDesc.height);
+
+		pBackBuffer->Release();
+
+		return true;
+	}
+
+
 	///////////////////////////////////////////////////////////////////////////////////
 	//-----------------------        Private Function          ----------------------//
 	///////////////////////////////////////////////////////////////////////////////////
@@ -544,25 +641,9 @@ namespace RenderDog
 
 	void SoftwareRenderer::AddPrisAndLightsToSceneView(IScene* pScene)
 	{
-		uint32_t priNum = pScene->GetPrimitivesNum();
-		for (uint32_t i = 0; i < priNum; ++i)
-		{
-			IPrimitive* pPri = pScene->GetPrimitive(i);
-
-			//FIXME!!! Ӧ׶ü
-			m_pSceneView->AddPrimitive(pPri);
-		}
-
-		uint32_t lightsNum = pScene->GetLightsNum();
-		for (uint32_t i = 0; i < lightsNum; ++i)
-		{
-			ILight* pLight = pScene->GetLight(i);
-
-			if (pLight->GetType() == LIGHT_TYPE::DIRECTIONAL)
-			{
-				m_pSceneView->AddLight(pLight);
-			}
-		}
+		FPSCamera* pCamera = m_pSceneView->GetCamera();
+		//SceneViewҽӵ֮󳡾зɾɳ֪ͨSceneView
+		m_pSceneView->AddVisiblePrimitives(pScene, pCamera->GetViewMatrix() * pCamera->GetPerspProjectionMatrix());
 	}
 
 	void SoftwareRenderer::RenderPrimitives()
@@ -588,4 +669,14 @@ namespace RenderDog
 		}
 	}
 
+
+	///////////////////////////////////////////////////////////////////////////////////
+	//-----------------------        Global Function           ----------------------//
+	///////////////////////////////////////////////////////////////////////////////////
+
+	bool SRReadBackBuffer(std::vector<uint32_t>& outPixels, uint32_t& outWidth, uint32_t& outHeight)
+	{
+		return g_SoftwareRenderer.ReadBackBuffer(outPixels, outWidth, outHeight);
+	}
+
 }// namespace RenderDog
\ No newline at end of file
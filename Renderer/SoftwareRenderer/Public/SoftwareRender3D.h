@@ -72,6 +72,11 @@ namespace RenderDog
 		POINT = 0,
 		BILINEAR
 	};
+
+	enum class SR_QUERY
+	{
+		PIPELINE_STATISTICS = 0
+	};
 #pragma endregion Enum
 
 #pragma region Description
@@ -140,6 +145,24 @@ namespace RenderDog
 		{}
 	};
 
+	struct SRDepthStencilDesc
+	{
+		bool			depthEnable;
+
+		SRDepthStencilDesc() :
+			depthEnable(true)
+		{}
+	};
+
+	struct SRQueryDesc
+	{
+		SR_QUERY		query;
+
+		SRQueryDesc() :
+			query(SR_QUERY::PIPELINE_STATISTICS)
+		{}
+	};
+
 	struct SRRenderTargetViewDesc
 	{
 		SR_FORMAT			format;
@@ -180,6 +203,48 @@ namespace RenderDog
 		{}
 	};
 
+	//ӦD3D11_QUERY_DATA_PIPELINE_STATISTICS¼޳ȲԡOverdrawԼ׶κʱ
+	struct SRQueryDataPipelineStatistics
+	{
+		uint64_t	drawCalls;
+		uint64_t	vsInvocations;			//ִжɫĶ
+		uint64_t	iaPrimitives;			//ͼԪװͼԪ
+		uint64_t	cullPrimitives;			//޳ͼԪ
+		uint64_t	cInvocations;			//ü׶εͼԪ
+		uint64_t	clippedPrimitives;		//üཻȫ׶ͼԪ
+		uint64_t	cPrimitives;			//ü׶ͼԪüɵͼԪ
+		uint64_t	testedPixels;			//ȲԵ
+		uint64_t	depthPassedPixels;		//ͨȲԵ
+		uint64_t	psInvocations;			//ɫдɫ
+		uint64_t	overdrawPixels;			//ѾдصĴ
+
+		//׶κʱλΪ
+		float		vsTime;
+		float		iaTime;
+		float		cullTime;
+		float		clipTime;
+		float		rasterTime;
+
+		SRQueryDataPipelineStatistics() :
+			drawCalls(0),
+			vsInvocations(0),
+			iaPrimitives(0),
+			cullPrimitives(0),
+			cInvocations(0),
+			clippedPrimitives(0),
+			cPrimitives(0),
+			testedPixels(0),
+			depthPassedPixels(0),
+			psInvocations(0),
+			overdrawPixels(0),
+			vsTime(0.0f),
+			iaTime(0.0f),
+			cullTime(0.0f),
+			clipTime(0.0f),
+			rasterTime(0.0f)
+		{}
+	};
+
 	struct SRViewport
 	{
 		float topLeftX;
@@ -236,6 +301,18 @@ namespace RenderDog
 		virtual void GetDesc(SRSamplerDesc* pDesc) = 0;
 	};
 
+	class ISRDepthStencilState : public ISRUnknown
+	{
+	public:
+		virtual void GetDesc(SRDepthStencilDesc* pDesc) = 0;
+	};
+
+	class ISRQuery : public ISRUnknown
+	{
+	public:
+		virtual void GetDesc(SRQueryDesc* pDesc) = 0;
+	};
+
 	class ISRView : public ISRUnknown
 	{
 	public:
@@ -272,6 +349,8 @@ namespace RenderDog
 		virtual bool CreateVertexShader(ISRVertexShader** ppVertexShader) = 0;
 		virtual bool CreatePixelShader(ISRPixelShader** ppPixelShader) = 0;
 		virtual bool CreateSamplerState(const SRSamplerDesc* pDesc, ISRSamplerState** ppSamplerState) = 0;
+		virtual bool CreateDepthStencilState(const SRDepthStencilDesc* pDesc, ISRDepthStencilState** ppDepthStencilState) = 0;
+		virtual bool CreateQuery(const SRQueryDesc* pDesc, ISRQuery** ppQuery) = 0;
 	};
 
 	class ISRDeviceContext : public ISRUnknown
@@ -293,10 +372,16 @@ namespace RenderDog
 		virtual void RSSetViewport(const SRViewport* pViewport) = 0;
 
 		virtual void OMSetRenderTarget(ISRRenderTargetView* pRenderTargetView, ISRDepthStencilView* pDepthStencilView) = 0;
+		virtual void OMSetDepthStencilState(ISRDepthStencilState* pDepthStencilState) = 0;
 		virtual void ClearRenderTargetView(ISRRenderTargetView* pRenderTargetView, const float* clearColor) = 0;
 		virtual void ClearDepthStencilView(ISRDepthStencilView* pDepthStencilView, float fDepth) = 0;
 		virtual void Draw() = 0;
 		virtual void DrawIndex(uint32_t nIndexNum) = 0;
+
+		//ͬһʱֻһQueryBegin״̬GetDataEnd֮Ż᷵true
+		virtual void Begin(ISRQuery* pQuery) = 0;
+		virtual void End(ISRQuery* pQuery) = 0;
+		virtual bool GetData(ISRQuery* pQuery, void* pData, uint32_t dataSize) = 0;
 	};
 #pragma endregion Device
 
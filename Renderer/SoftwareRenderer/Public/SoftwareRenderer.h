@@ -8,9 +8,17 @@
 
 #include "SoftwareRender3D.h"
 
+#include <vector>
+
 namespace RenderDog
 {
 	extern ISRDevice*			g_pSRDevice;
 	extern ISRDeviceContext*	g_pSRImmediateContext;
 
+	//һ֡RenderPrimitivesˮͳ
+	extern SRQueryDataPipelineStatistics g_SRFrameStatistics;
+
+	//ȡһ֡backbuffer(R8G8B8A8_UNORM)ҪȾʱͼȶ
+	bool SRReadBackBuffer(std::vector<uint32_t>& outPixels, uint32_t& outWidth, uint32_t& outHeight);
+
 }// namespace RenderDog
\ No newline at end of file
@@ -9,6 +9,8 @@
 #include "GeometryGenerator.h"
 #include "Utility.h"
 #include "FbxImporter.h"
+#include "Bounding.h"
+#include "RenderThread.h"
 
 #include <windowsx.h>
 #include <sstream>
@@ -38,6 +40,7 @@ ModelViewer::ModelViewer() :
 	m_LastMousePosY(0),
 	m_bShowUnitGrid(true),
 	m_bModelMoved(false),
+	m_PickInfo(""),
 	m_pBasicMaterial(nullptr),
 	m_pSkyMaterial(nullptr)
 {
@@ -344,6 +347,11 @@ LRESULT ModelViewer::MessageProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lPar
 	case WM_KEYUP:
 	{
 		m_Keys[wParam & 511] = 0;
+
+		if (wParam == VK_F9)
+		{
+			ToggleProfileCapture();
+		}
 		break;
 	}
 	default:
@@ -816,7 +824,8 @@ void ModelViewer::CalculateFrameStats()
 		std::ostringstream outs;
 		outs.precision(6);
 		outs << "FPS: " << framePerSecond << "    "
-			<< "Frame Time: " << millisecondsPerFrame << " (ms)";
+			<< "Frame Time: " << millisecondsPerFrame << " (ms)"
+			<< m_PickInfo;
 		SetWindowTextA(RenderDog::g_pIWindow->GetHandle(), outs.str().c_str());
 
 		frameCnt = 0;
@@ -824,11 +833,61 @@ void ModelViewer::CalculateFrameStats()
 	}
 }
 
+void ModelViewer::ToggleProfileCapture()
+{
+	if (!RenderDog::g_pProfiler->IsCapturing())
+	{
+		RenderDog::g_pProfiler->BeginCapture();
+		return;
+	}
+
+	RenderDog::g_pProfiler->EndCapture();
+	if (!RenderDog::g_pProfiler->ExportChromeTrace("ModelViewerTrace.json"))
+	{
+		MessageBox(nullptr, "Export Profile Trace Failed!", "ERROR", MB_OK);
+	}
+}
+
+void ModelViewer::PickObject(int x, int y)
+{
+	float ndcX = 2.0f * x / RenderDog::g_pIWindow->GetWidth() - 1.0f;
+	float ndcY = 1.0f - 2.0f * y / RenderDog::g_pIWindow->GetHeight();
+	RenderDog::Ray ray = m_pFPSCamera->GetPickRay(ndcX, ndcY);
+	float maxDistance = m_pFPSCamera->GetFarPlane();
+
+	//ֻȾ̷߳ʣȾ߳вѯȴɺٶȡ
+	RenderDog::SceneRayHit hit;
+	RenderDog::SceneRayHit* pHit = &hit;
+	RenderDog::IScene* pScene = m_pScene;
+	RenderDog::g_pRenderThread->EnqueueCommand([pScene, ray, maxDistance, pHit]()
+	{
+		pScene->Raycast(ray, maxDistance, *pHit);
+	});
+	RenderDog::g_pIFramework->FlushRendering();
+
+	std::ostringstream outs;
+	if (hit.pPrimitive)
+	{
+		outs.precision(6);
+		outs << "    Picked: Distance " << hit.distance;
+		if (hit.triangle != RenderDog::SCENE_RAY_HIT_NO_TRIANGLE)
+		{
+			outs << " Triangle " << hit.triangle;
+		}
+	}
+	m_PickInfo = outs.str();
+}
+
 void ModelViewer::OnMouseDown(WPARAM btnState, int x, int y)
 {
 	m_LastMousePosX = x;
 	m_LastMousePosY = y;
 
+	if ((btnState & MK_MBUTTON) != 0)
+	{
+		PickObject(x, y);
+	}
+
 	SetCapture(RenderDog::g_pIWindow->GetHandle());
 }
 
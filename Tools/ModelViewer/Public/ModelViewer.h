@@ -16,6 +16,7 @@
 #include "Sky.h"
 #include "GameTimer.h"
 #include "Material.h"
+#include "Profiler.h"
 
 struct ModelViewerInitDesc
 {
@@ -62,6 +63,12 @@ private:
 
 	void						CalculateFrameStats();
 
+	//ʼܲɼʱChrome Traceļ
+	void						ToggleProfileCapture();
+
+	//λõʰȡеͼԪʾڱ
+	void						PickObject(int x, int y);
+
 	void						OnMouseDown(WPARAM btnState, int x, int y);
 	void						OnMouseUp(WPARAM btnState, int x, int y);
 	void						OnMouseMove(WPARAM btnState, int x, int y);
@@ -92,6 +99,8 @@ private:
 	bool						m_bShowUnitGrid;
 	bool						m_bModelMoved;
 
+	std::string					m_PickInfo;
+
 	RenderDog::IMaterial*		m_pBasicMaterial;
 	RenderDog::IMaterial*		m_pSkyMaterial;
 };
@@ -0,0 +1,105 @@
+///////////////////////////////////////////
+//RenderBenchmark
+//FileName: Main.cpp
+//Written by Xiang Weikang
+///////////////////////////////////////////
+
+#include "RenderBenchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void PrintUsage()
+{
+	printf("Usage: RenderBenchmark [options]\n");
+	printf("  -size <width> <height>    backbuffer size, default 640 360\n");
+	printf("  -frames <num>             frames per case, default 60\n");
+	printf("  -warmup <num>             warmup frames per case, default 2\n");
+	printf("  -tolerance <value>        max per-channel difference, default 2\n");
+	printf("  -badratio <value>         max ratio of pixels over tolerance, default 0.001\n");
+	printf("  -reference <dir>          reference image directory, default BenchmarkReference\n");
+	printf("  -update                   overwrite reference images with current results\n");
+	printf("  -model <file>             additionally benchmark an fbx model\n");
+	printf("  -report <file>            write results as csv\n");
+	printf("  -trace <file>             export chrome trace of the whole run\n");
+}
+
+static bool ParseCommandLine(int argc, char** argv, RenderBenchmarkInitDesc& desc)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+		bool bHasNext = i + 1 < argc;
+
+		if (strcmp(arg, "-size") == 0 && i + 2 < argc)
+		{
+			desc.width = (uint32_t)atoi(argv[++i]);
+			desc.height = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(arg, "-frames") == 0 && bHasNext)
+		{
+			desc.frameNum = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(arg, "-warmup") == 0 && bHasNext)
+		{
+			desc.warmupFrameNum = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(arg, "-tolerance") == 0 && bHasNext)
+		{
+			desc.colorTolerance = (uint32_t)atoi(argv[++i]);
+		}
+		else if (strcmp(arg, "-badratio") == 0 && bHasNext)
+		{
+			desc.maxBadPixelRatio = (float)atof(argv[++i]);
+		}
+		else if (strcmp(arg, "-reference") == 0 && bHasNext)
+		{
+			desc.referenceDir = argv[++i];
+		}
+		else if (strcmp(arg, "-update") == 0)
+		{
+			desc.bUpdateReference = true;
+		}
+		else if (strcmp(arg, "-model") == 0 && bHasNext)
+		{
+			desc.modelFile = argv[++i];
+		}
+		else if (strcmp(arg, "-report") == 0 && bHasNext)
+		{
+			desc.reportFile = argv[++i];
+		}
+		else if (strcmp(arg, "-trace") == 0 && bHasNext)
+		{
+			desc.traceFile = argv[++i];
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return desc.width > 0 && desc.height > 0 && desc.frameNum > 0;
+}
+
+int main(int argc, char** argv)
+{
+	RenderBenchmarkInitDesc initDesc;
+	if (!ParseCommandLine(argc, argv, initDesc))
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	if (!g_pRenderBenchmark->Init(initDesc))
+	{
+		return 2;
+	}
+
+	uint32_t failedFrameNum = g_pRenderBenchmark->Run();
+
+	g_pRenderBenchmark->Release();
+
+	//ʧʱط0ڽűʹ
+	return failedFrameNum == 0 ? 0 : 1;
+}
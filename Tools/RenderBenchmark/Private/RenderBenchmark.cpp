@@ -0,0 +1,696 @@
+///////////////////////////////////////////
+//RenderBenchmark
+//FileName: RenderBenchmark.cpp
+//Written by Xiang Weikang
+///////////////////////////////////////////
+
+#include "RenderBenchmark.h"
+#include "SoftwareRenderer.h"
+#include "Vector.h"
+#include "GeometryGenerator.h"
+#include "Utility.h"
+#include "FbxImporter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+RenderBenchmark g_RenderBenchmark;
+RenderBenchmark* g_pRenderBenchmark = &g_RenderBenchmark;
+
+RenderBenchmark::RenderBenchmark() :
+	m_Desc(),
+	m_pRenderDog(nullptr),
+	m_pScene(nullptr),
+	m_pFPSCamera(nullptr),
+	m_pMainLight(nullptr),
+	m_pBasicMaterial(nullptr),
+	m_Cases(0),
+	m_FramePixels(0),
+	m_ReferencePixels(0),
+	m_MilliSecondsPerCount(0.0)
+{}
+
+RenderBenchmark::~RenderBenchmark()
+{}
+
+bool RenderBenchmark::Init(const RenderBenchmarkInitDesc& desc)
+{
+	m_Desc = desc;
+
+	int64_t countsPerSecond = 0;
+	QueryPerformanceFrequency((LARGE_INTEGER*)&countsPerSecond);
+	m_MilliSecondsPerCount = 1000.0 / (double)countsPerSecond;
+
+	RenderDog::CameraDesc camDesc;
+	camDesc.position = RenderDog::Vector3(0.0f, 300.0f, -800.0f);
+	camDesc.fov = 45.0f;
+	camDesc.aspectRitio = (float)desc.width / (float)desc.height;
+	camDesc.nearPlane = 0.1f;
+	camDesc.farPlane = 100000.0f;
+	m_pFPSCamera = new RenderDog::FPSCamera(camDesc);
+
+	if (!RenderDog::CreateRenderDog(&m_pRenderDog))
+	{
+		return false;
+	}
+
+	RenderDog::InitDesc renderDogDesc;
+	renderDogDesc.wndDesc.width = desc.width;
+	renderDogDesc.wndDesc.height = desc.height;
+	renderDogDesc.pMainCamera = m_pFPSCamera;
+	renderDogDesc.bHeadless = true;
+	if (!m_pRenderDog->Init(renderDogDesc))
+	{
+		printf("RenderDog Init Failed!\n");
+		return false;
+	}
+
+	if (!RenderDog::g_pRDFbxImporter->Init())
+	{
+		printf("RenderDog::FBXImporter Init Failed!\n");
+		return false;
+	}
+
+	RenderDog::SceneInitDesc sceneDesc;
+	sceneDesc.name = "BenchmarkScene";
+	m_pScene = RenderDog::g_pISceneManager->CreateScene(sceneDesc);
+	if (!m_pScene)
+	{
+		printf("Create Scene Failed!\n");
+		return false;
+	}
+
+	m_pBasicMaterial = RenderDog::g_pMaterialManager->GetMaterial("UserAsset/Materials/Basic.mtl");
+
+	if (!CreateGridCase() || !CreateBoxesCase() || !CreateSpheresCase())
+	{
+		printf("Create Benchmark Case Failed!\n");
+		return false;
+	}
+
+	if (!desc.modelFile.empty())
+	{
+		if (!CreateModelCase(desc.modelFile))
+		{
+			printf("Load Model %s Failed!\n", desc.modelFile.c_str());
+			return false;
+		}
+	}
+
+	//Դ̶֤ÿеĽһ
+	RenderDog::LightDesc lightDesc = {};
+	lightDesc.type = RenderDog::LIGHT_TYPE::DIRECTIONAL;
+	lightDesc.color = RenderDog::Vector3(1.0f, 1.0f, 1.0f);
+	lightDesc.eulerDir = RenderDog::Vector3(45.0f, 45.0f, 0.0f);
+	lightDesc.luminance = 1.0f;
+	m_pMainLight = RenderDog::g_pILightManager->CreateLight(lightDesc);
+
+	RenderDog::g_pIFramework->RegisterScene(m_pScene);
+
+	CreateDirectory(m_Desc.referenceDir.c_str(), nullptr);
+
+	return true;
+}
+
+void RenderBenchmark::Release()
+{
+	RenderDog::g_pRDFbxImporter->Release();
+
+	for (size_t i = 0; i < m_Cases.size(); ++i)
+	{
+		BenchmarkCase& benchCase = m_Cases[i];
+		for (size_t j = 0; j < benchCase.simpleModels.size(); ++j)
+		{
+			delete benchCase.simpleModels[j];
+		}
+
+		for (size_t j = 0; j < benchCase.staticModels.size(); ++j)
+		{
+			delete benchCase.staticModels[j];
+		}
+	}
+	m_Cases.clear();
+
+	if (m_pBasicMaterial)
+	{
+		m_pBasicMaterial->Release();
+		m_pBasicMaterial = nullptr;
+	}
+
+	if (m_pMainLight)
+	{
+		m_pMainLight->Release();
+		m_pMainLight = nullptr;
+	}
+
+	if (m_pFPSCamera)
+	{
+		delete m_pFPSCamera;
+		m_pFPSCamera = nullptr;
+	}
+
+	if (m_pScene)
+	{
+		m_pScene->Release();
+		m_pScene = nullptr;
+	}
+
+	if (m_pRenderDog)
+	{
+		m_pRenderDog->Release();
+
+		RenderDog::DestoryRenderDog(&m_pRenderDog);
+	}
+}
+
+uint32_t RenderBenchmark::Run()
+{
+	if (!m_Desc.traceFile.empty())
+	{
+		RenderDog::g_pProfiler->BeginCapture();
+	}
+
+	std::vector<BenchmarkResult> results;
+	results.reserve(m_Cases.size());
+
+	uint32_t failedFrameNum = 0;
+	for (size_t i = 0; i < m_Cases.size(); ++i)
+	{
+		BenchmarkResult result;
+		RunCase(m_Cases[i], result);
+		PrintResult(result);
+
+		//ûвοͼʱ޷жϽǷȷʹ-updateʱҲʧ
+		failedFrameNum += result.failedFrameNum + result.missingReferenceNum;
+		results.push_back(result);
+	}
+
+	if (!m_Desc.traceFile.empty())
+	{
+		RenderDog::g_pProfiler->EndCapture();
+		if (!RenderDog::g_pProfiler->ExportChromeTrace(m_Desc.traceFile))
+		{
+			printf("Export Profile Trace %s Failed!\n", m_Desc.traceFile.c_str());
+		}
+	}
+
+	if (!m_Desc.reportFile.empty())
+	{
+		if (!WriteReport(results))
+		{
+			printf("Write Report %s Failed!\n", m_Desc.reportFile.c_str());
+		}
+	}
+
+	return failedFrameNum;
+}
+
+bool RenderBenchmark::CreateGridCase()
+{
+	BenchmarkCase benchCase;
+	benchCase.name = "Grid";
+	benchCase.orbitRadius = 900.0f;
+	benchCase.orbitHeight = 400.0f;
+
+	RenderDog::StaticModel* pFloor = CreateFloor(20, 20, 50.0f);
+	if (!pFloor)
+	{
+		return false;
+	}
+	benchCase.staticModels.push_back(pFloor);
+
+	RenderDog::SimpleModel* pGridLine = CreateGridLine(20, 20, 50.0f);
+	benchCase.simpleModels.push_back(pGridLine);
+
+	m_Cases.push_back(benchCase);
+
+	return true;
+}
+
+bool RenderBenchmark::CreateBoxesCase()
+{
+	BenchmarkCase benchCase;
+	benchCase.name = "Boxes";
+	benchCase.orbitRadius = 900.0f;
+	benchCase.orbitHeight = 300.0f;
+
+	RenderDog::StaticModel* pFloor = CreateFloor(10, 10, 100.0f);
+	if (!pFloor)
+	{
+		return false;
+	}
+	benchCase.staticModels.push_back(pFloor);
+
+	RenderDog::GeometryGenerator::StandardMeshData boxMeshData;
+	RenderDog::g_pGeometryGenerator->GenerateBox(50.0f, 50.0f, 50.0f, boxMeshData);
+
+	//8x8ڵĺӣҪȲԺoverdraw
+	const int boxNumPerSide = 8;
+	for (int i = 0; i < boxNumPerSide; ++i)
+	{
+		for (int j = 0; j < boxNumPerSide; ++j)
+		{
+			RenderDog::StaticModel* pBox = new RenderDog::StaticModel();
+			pBox->LoadFromStandardData(boxMeshData.vertices, boxMeshData.indices, "BenchmarkBox");
+			if (!pBox->CreateMaterialInstance(m_pBasicMaterial, nullptr))
+			{
+				delete pBox;
+				return false;
+			}
+
+			float posX = (i - boxNumPerSide / 2 + 0.5f) * 100.0f;
+			float posZ = (j - boxNumPerSide / 2 + 0.5f) * 100.0f;
+			float rotY = (float)((i * boxNumPerSide + j) * 15 % 360);
+			pBox->SetPosGesture(RenderDog::Vector3(posX, 25.0f, posZ), RenderDog::Vector3(0.0f, rotY, 0.0f), RenderDog::Vector3(1.0f));
+
+			benchCase.staticModels.push_back(pBox);
+		}
+	}
+
+	m_Cases.push_back(benchCase);
+
+	return true;
+}
+
+bool RenderBenchmark::CreateSpheresCase()
+{
+	BenchmarkCase benchCase;
+	benchCase.name = "Spheres";
+	benchCase.orbitRadius = 700.0f;
+	benchCase.orbitHeight = 200.0f;
+
+	RenderDog::StaticModel* pFloor = CreateFloor(10, 10, 100.0f);
+	if (!pFloor)
+	{
+		return false;
+	}
+	benchCase.staticModels.push_back(pFloor);
+
+	//ϸֵ壬ҪԶ㴦СεĹդ
+	RenderDog::GeometryGenerator::StandardMeshData sphereMeshData;
+	RenderDog::g_pGeometryGenerator->GenerateSphere(64, 64, 60.0f, sphereMeshData);
+
+	const int sphereNumPerSide = 3;
+	for (int i = 0; i < sphereNumPerSide; ++i)
+	{
+		for (int j = 0; j < sphereNumPerSide; ++j)
+		{
+			RenderDog::StaticModel* pSphere = new RenderDog::StaticModel();
+			pSphere->LoadFromStandardData(sphereMeshData.vertices, sphereMeshData.indices, "BenchmarkSphere");
+			if (!pSphere->CreateMaterialInstance(m_pBasicMaterial, nullptr))
+			{
+				delete pSphere;
+				return false;
+			}
+
+			float posX = (i - 1) * 200.0f;
+			float posZ = (j - 1) * 200.0f;
+			pSphere->SetPosGesture(RenderDog::Vector3(posX, 60.0f, posZ), RenderDog::Vector3(0.0f), RenderDog::Vector3(1.0f));
+
+			benchCase.staticModels.push_back(pSphere);
+		}
+	}
+
+	m_Cases.push_back(benchCase);
+
+	return true;
+}
+
+bool RenderBenchmark::CreateModelCase(const std::string& fileName)
+{
+	BenchmarkCase benchCase;
+	benchCase.name = "Model";
+
+	RenderDog::StaticModel* pModel = new RenderDog::StaticModel();
+
+	RenderDog::RDFbxImporter::FbxLoadParam fbxLoadParam;
+	fbxLoadParam.bIsFlipTexcoordV = true;
+	if (!RenderDog::g_pRDFbxImporter->LoadFbxFile(fileName, RenderDog::RDFbxImporter::FBX_LOAD_TYPE::STATIC_MODEL, fbxLoadParam))
+	{
+		delete pModel;
+		return false;
+	}
+
+	if (!pModel->LoadFromRawMeshData(RenderDog::g_pRDFbxImporter->GetRawMeshData(), fileName))
+	{
+		delete pModel;
+		return false;
+	}
+
+	if (!pModel->CreateMaterialInstance(m_pBasicMaterial, nullptr))
+	{
+		delete pModel;
+		return false;
+	}
+
+	pModel->SetPosGesture(RenderDog::Vector3(0.0f, 0.0f, 0.0f), RenderDog::Vector3(0.0f, 0.0f, 0.0f), RenderDog::Vector3(1.0f));
+
+	//ݰΧȷʹģڻ
+	const RenderDog::BoundingSphere& sphere = pModel->GetBoundingSphere();
+	benchCase.orbitRadius = sphere.radius * 2.5f;
+	benchCase.orbitHeight = sphere.center.y + sphere.radius;
+
+	benchCase.staticModels.push_back(pModel);
+
+	m_Cases.push_back(benchCase);
+
+	return true;
+}
+
+RenderDog::StaticModel* RenderBenchmark::CreateFloor(uint32_t width, uint32_t depth, float unit)
+{
+	RenderDog::GeometryGenerator::StandardMeshData gridMeshData;
+	RenderDog::g_pGeometryGenerator->GenerateGrid(width, depth, unit, gridMeshData);
+
+	RenderDog::StaticModel* pFloor = new RenderDog::StaticModel();
+	pFloor->LoadFromStandardData(gridMeshData.vertices, gridMeshData.indices, "BenchmarkFloor");
+	if (!pFloor->CreateMaterialInstance(m_pBasicMaterial, nullptr))
+	{
+		delete pFloor;
+		return nullptr;
+	}
+	pFloor->SetPosGesture(RenderDog::Vector3(0.0f, 0.0f, 0.0f), RenderDog::Vector3(0.0f, 0.0f, 0.0f), RenderDog::Vector3(1.0f));
+
+	return pFloor;
+}
+
+RenderDog::SimpleModel* RenderBenchmark::CreateGridLine(uint32_t width, uint32_t depth, float unit)
+{
+	RenderDog::GeometryGenerator::SimpleMeshData gridLineMeshData;
+	RenderDog::g_pGeometryGenerator->GenerateGridLine(width, depth, unit, RenderDog::Vector4(0.2f, 0.2f, 0.2f, 1.0f), gridLineMeshData);
+
+	RenderDog::SimpleModel* pGridLine = new RenderDog::SimpleModel();
+	pGridLine->LoadFromSimpleData(gridLineMeshData.vertices, gridLineMeshData.indices, "BenchmarkGridLine");
+	pGridLine->SetPosGesture(RenderDog::Vector3(0.0f, 0.0f, 0.0f), RenderDog::Vector3(0.0f, 0.0f, 0.0f), RenderDog::Vector3(1.0f));
+	pGridLine->SetRenderLine(true);
+
+	return pGridLine;
+}
+
+void RenderBenchmark::RunCase(const BenchmarkCase& benchCase, BenchmarkResult& result)
+{
+	RD_PROFILE_SCOPE("RenderBenchmark::RunCase");
+
+	result.name = benchCase.name;
+	result.frameNum = 0;
+	result.totalFrameTime = 0.0;
+	result.minFrameTime = 0.0;
+	result.maxFrameTime = 0.0;
+	result.vsTime = 0.0;
+	result.iaTime = 0.0;
+	result.cullTime = 0.0;
+	result.clipTime = 0.0;
+	result.rasterTime = 0.0;
+	result.primitiveNum = 0;
+	result.pixelNum = 0;
+	result.failedFrameNum = 0;
+	result.missingReferenceNum = 0;
+	result.maxColorDiff = 0;
+
+	uint32_t totalFrameNum = m_Desc.warmupFrameNum + m_Desc.frameNum;
+	for (uint32_t i = 0; i < totalFrameNum; ++i)
+	{
+		bool bWarmup = i < m_Desc.warmupFrameNum;
+		uint32_t frameIndex = bWarmup ? 0 : i - m_Desc.warmupFrameNum;
+
+		UpdateCamera(benchCase, frameIndex);
+		RegisterCaseToScene(benchCase);
+
+		int64_t startCounts = 0;
+		QueryPerformanceCounter((LARGE_INTEGER*)&startCounts);
+
+		RenderDog::g_pIFramework->Frame();
+
+		int64_t endCounts = 0;
+		QueryPerformanceCounter((LARGE_INTEGER*)&endCounts);
+
+		if (bWarmup)
+		{
+			continue;
+		}
+
+		double frameTime = (endCounts - startCounts) * m_MilliSecondsPerCount;
+		result.totalFrameTime += frameTime;
+		result.minFrameTime = (result.frameNum == 0 || frameTime < result.minFrameTime) ? frameTime : result.minFrameTime;
+		result.maxFrameTime = frameTime > result.maxFrameTime ? frameTime : result.maxFrameTime;
+		++result.frameNum;
+
+		const RenderDog::SRQueryDataPipelineStatistics& stats = RenderDog::g_SRFrameStatistics;
+		result.vsTime += stats.vsTime;
+		result.iaTime += stats.iaTime;
+		result.cullTime += stats.cullTime;
+		result.clipTime += stats.clipTime;
+		result.rasterTime += stats.rasterTime;
+		result.primitiveNum += stats.iaPrimitives;
+		result.pixelNum += stats.psInvocations;
+
+		char referenceName[256];
+		snprintf(referenceName, sizeof(referenceName), "%s/%s_%03u.bmp", m_Desc.referenceDir.c_str(), benchCase.name.c_str(), frameIndex);
+		CompareWithReference(referenceName, result);
+	}
+}
+
+void RenderBenchmark::RegisterCaseToScene(const BenchmarkCase& benchCase)
+{
+	m_pScene->Clear();
+
+	m_pMainLight->RegisterToScene(m_pScene);
+
+	for (size_t i = 0; i < benchCase.simpleModels.size(); ++i)
+	{
+		benchCase.simpleModels[i]->RegisterToScene(m_pScene);
+	}
+
+	for (size_t i = 0; i < benchCase.staticModels.size(); ++i)
+	{
+		benchCase.staticModels[i]->RegisterToScene(m_pScene);
+	}
+}
+
+void RenderBenchmark::UpdateCamera(const BenchmarkCase& benchCase, uint32_t frameIndex)
+{
+	//·ֻ֡žʵʺʱ޹
+	float angle = 2.0f * RenderDog::RD_PI * (float)frameIndex / (float)m_Desc.frameNum;
+
+	RenderDog::Vector3 camPos(benchCase.orbitRadius * sinf(angle), benchCase.orbitHeight, -benchCase.orbitRadius * cosf(angle));
+
+	float yaw = atan2f(-camPos.x, -camPos.z);
+	float pitch = atan2f(-camPos.y, benchCase.orbitRadius);
+
+	m_pFPSCamera->SetPosAndRotation(camPos, yaw, pitch);
+}
+
+void RenderBenchmark::CompareWithReference(const std::string& fileName, BenchmarkResult& result)
+{
+	uint32_t width = 0;
+	uint32_t height = 0;
+	if (!RenderDog::SRReadBackBuffer(m_FramePixels, width, height))
+	{
+		++result.failedFrameNum;
+		return;
+	}
+
+	if (m_Desc.bUpdateReference)
+	{
+		if (!WriteBitmapFile(fileName, m_FramePixels, width, height))
+		{
+			printf("Write Reference %s Failed!\n", fileName.c_str());
+		}
+
+		return;
+	}
+
+	uint32_t refWidth = 0;
+	uint32_t refHeight = 0;
+	if (!ReadBitmapFile(fileName, m_ReferencePixels, refWidth, refHeight))
+	{
+		//ÿֻʾһ
+		if (result.missingReferenceNum == 0)
+		{
+			printf("  %s missing, run with -update to create reference images\n", fileName.c_str());
+		}
+
+		++result.missingReferenceNum;
+		return;
+	}
+
+	if (refWidth != width || refHeight != height)
+	{
+		++result.failedFrameNum;
+		return;
+	}
+
+	uint32_t badPixelNum = 0;
+	for (size_t i = 0; i < m_FramePixels.size(); ++i)
+	{
+		uint32_t currColor = m_FramePixels[i];
+		uint32_t refColor = m_ReferencePixels[i];
+		if (currColor == refColor)
+		{
+			continue;
+		}
+
+		uint32_t maxDiff = 0;
+		for (uint32_t channel = 0; channel < 4; ++channel)
+		{
+			int currValue = (currColor >> (channel * 8)) & 0xff;
+			int refValue = (refColor >> (channel * 8)) & 0xff;
+			uint32_t diff = (uint32_t)abs(currValue - refValue);
+			maxDiff = diff > maxDiff ? diff : maxDiff;
+		}
+
+		result.maxColorDiff = maxDiff > result.maxColorDiff ? maxDiff : result.maxColorDiff;
+		if (maxDiff > m_Desc.colorTolerance)
+		{
+			++badPixelNum;
+		}
+	}
+
+	float badPixelRatio = (float)badPixelNum / (float)m_FramePixels.size();
+	if (badPixelRatio > m_Desc.maxBadPixelRatio)
+	{
+		++result.failedFrameNum;
+
+		//ʧ֡ͲοͼԱ
+		std::string failedFileName = fileName.substr(0, fileName.size() - 4) + "_failed.bmp";
+		WriteBitmapFile(failedFileName, m_FramePixels, width, height);
+
+		printf("  %s mismatch: %u pixels (%.4f%%) exceed tolerance\n", fileName.c_str(), badPixelNum, badPixelRatio * 100.0f);
+	}
+}
+
+void RenderBenchmark::PrintResult(const BenchmarkResult& result)
+{
+	if (result.frameNum == 0)
+	{
+		printf("[%s] no frame rendered\n", result.name.c_str());
+		return;
+	}
+
+	double frameNum = (double)result.frameNum;
+	double avgFrameTime = result.totalFrameTime / frameNum;
+	double totalSeconds = result.totalFrameTime / 1000.0;
+
+	printf("[%s] %u frames\n", result.name.c_str(), result.frameNum);
+	printf("  frame time   avg %.3f ms  min %.3f ms  max %.3f ms\n", avgFrameTime, result.minFrameTime, result.maxFrameTime);
+	printf("  stage time   vs %.3f  ia %.3f  cull %.3f  clip %.3f  raster %.3f (ms/frame)\n",
+		result.vsTime / frameNum, result.iaTime / frameNum, result.cullTime / frameNum, result.clipTime / frameNum, result.rasterTime / frameNum);
+	printf("  throughput   %.3f Mtris/s  %.3f Mpixels/s\n",
+		result.primitiveNum / totalSeconds / 1000000.0, result.pixelNum / totalSeconds / 1000000.0);
+
+	if (m_Desc.bUpdateReference)
+	{
+		printf("  reference    updated\n");
+	}
+	else
+	{
+		printf("  reference    %u failed  %u missing  max channel diff %u\n", result.failedFrameNum, result.missingReferenceNum, result.maxColorDiff);
+	}
+}
+
+bool RenderBenchmark::WriteReport(const std::vector<BenchmarkResult>& results)
+{
+	std::ofstream fout(m_Desc.reportFile);
+	if (!fout.is_open())
+	{
+		return false;
+	}
+
+	fout << "Case,Frames,AvgFrameMs,MinFrameMs,MaxFrameMs,VSMs,IAMs,CullMs,ClipMs,RasterMs,MTrisPerSec,MPixelsPerSec,FailedFrames,MissingReferences,MaxColorDiff\n";
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const BenchmarkResult& result = results[i];
+		if (result.frameNum == 0)
+		{
+			continue;
+		}
+
+		double frameNum = (double)result.frameNum;
+		double totalSeconds = result.totalFrameTime / 1000.0;
+
+		fout << result.name << ","
+			 << result.frameNum << ","
+			 << result.totalFrameTime / frameNum << ","
+			 << result.minFrameTime << ","
+			 << result.maxFrameTime << ","
+			 << result.vsTime / frameNum << ","
+			 << result.iaTime / frameNum << ","
+			 << result.cullTime / frameNum << ","
+			 << result.clipTime / frameNum << ","
+			 << result.rasterTime / frameNum << ","
+			 << result.primitiveNum / totalSeconds / 1000000.0 << ","
+			 << result.pixelNum / totalSeconds / 1000000.0 << ","
+			 << result.failedFrameNum << ","
+			 << result.missingReferenceNum << ","
+			 << result.maxColorDiff << "\n";
+	}
+
+	return true;
+}
+
+//οͼ񱣴Ϊ32λ϶µBMPֱÿͼ߲鿴
+bool RenderBenchmark::WriteBitmapFile(const std::string& fileName, const std::vector<uint32_t>& pixels, uint32_t width, uint32_t height)
+{
+	std::ofstream fout(fileName, std::ios::binary);
+	if (!fout.is_open())
+	{
+		return false;
+	}
+
+	uint32_t imageSize = width * height * 4;
+
+	BITMAPFILEHEADER fileHeader = {};
+	fileHeader.bfType = 0x4D42;		//"BM"
+	fileHeader.bfOffBits = sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER);
+	fileHeader.bfSize = fileHeader.bfOffBits + imageSize;
+
+	BITMAPINFOHEADER infoHeader = {};
+	infoHeader.biSize = sizeof(BITMAPINFOHEADER);
+	infoHeader.biWidth = (LONG)width;
+	infoHeader.biHeight = -(LONG)height;
+	infoHeader.biPlanes = 1;
+	infoHeader.biBitCount = 32;
+	infoHeader.biCompression = BI_RGB;
+	infoHeader.biSizeImage = imageSize;
+
+	fout.write((const char*)&fileHeader, sizeof(fileHeader));
+	fout.write((const char*)&infoHeader, sizeof(infoHeader));
+	fout.write((const char*)pixels.data(), imageSize);
+
+	return fout.good();
+}
+
+bool RenderBenchmark::ReadBitmapFile(const std::string& fileName, std::vector<uint32_t>& pixels, uint32_t& width, uint32_t& height)
+{
+	std::ifstream fin(fileName, std::ios::binary);
+	if (!fin.is_open())
+	{
+		return false;
+	}
+
+	BITMAPFILEHEADER fileHeader = {};
+	BITMAPINFOHEADER infoHeader = {};
+	fin.read((char*)&fileHeader, sizeof(fileHeader));
+	fin.read((char*)&infoHeader, sizeof(infoHeader));
+	if (!fin.good() || fileHeader.bfType != 0x4D42)
+	{
+		return false;
+	}
+
+	//ֻ֧WriteBitmapFileдĸʽ
+	if (infoHeader.biBitCount != 32 || infoHeader.biCompression != BI_RGB || infoHeader.biHeight >= 0)
+	{
+		return false;
+	}
+
+	width = (uint32_t)infoHeader.biWidth;
+	height = (uint32_t)(-infoHeader.biHeight);
+
+	pixels.resize((size_t)width * height);
+	fin.seekg(fileHeader.bfOffBits, std::ios::beg);
+	fin.read((char*)pixels.data(), (std::streamsize)pixels.size() * 4);
+
+	return fin.good();
+}
@@ -0,0 +1,142 @@
+///////////////////////////////////////////
+//RenderBenchmark
+//FileName: RenderBenchmark.h
+//Written by Xiang Weikang
+//Desc: ʹդȾ̶·ͳ֡ʱοͼȶ
+///////////////////////////////////////////
+
+#pragma once
+
+#include "RenderDog.h"
+#include "Scene.h"
+#include "Camera.h"
+#include "Light.h"
+#include "SimpleModel.h"
+#include "StaticModel.h"
+#include "Material.h"
+#include "Profiler.h"
+
+#include <string>
+#include <vector>
+
+struct RenderBenchmarkInitDesc
+{
+	uint32_t					width;
+	uint32_t					height;
+	uint32_t					frameNum;				//ÿԳȾ֡
+	uint32_t					warmupFrameNum;			//ͳƺͱȶԵԤ֡
+
+	uint32_t					colorTolerance;			//ֵͨ
+	float						maxBadPixelRatio;		//ݲռȲֵʱΪͼһ
+
+	std::string					referenceDir;
+	bool						bUpdateReference;		//Ϊtrueʱõǰǲοͼ
+
+	std::string					modelFile;				//ѡFbxģͣΪʱģͳ
+	std::string					reportFile;				//Ϊʱcsv
+	std::string					traceFile;				//ΪʱChrome Trace
+
+	RenderBenchmarkInitDesc() :
+		width(640),
+		height(360),
+		frameNum(60),
+		warmupFrameNum(2),
+		colorTolerance(2),
+		maxBadPixelRatio(0.001f),
+		referenceDir("BenchmarkReference"),
+		bUpdateReference(false),
+		modelFile(),
+		reportFile(),
+		traceFile()
+	{}
+};
+
+class RenderBenchmark
+{
+private:
+	struct BenchmarkCase
+	{
+		std::string							name;
+
+		std::vector<RenderDog::SimpleModel*> simpleModels;
+		std::vector<RenderDog::StaticModel*> staticModels;
+
+		//ԭԲ˶
+		float								orbitRadius;
+		float								orbitHeight;
+	};
+
+	struct BenchmarkResult
+	{
+		std::string		name;
+		uint32_t		frameNum;
+
+		double			totalFrameTime;		//ms
+		double			minFrameTime;
+		double			maxFrameTime;
+
+		double			vsTime;
+		double			iaTime;
+		double			cullTime;
+		double			clipTime;
+		double			rasterTime;
+
+		uint64_t		primitiveNum;
+		uint64_t		pixelNum;
+
+		uint32_t		failedFrameNum;
+		uint32_t		missingReferenceNum;
+		uint32_t		maxColorDiff;
+	};
+
+public:
+	RenderBenchmark();
+	~RenderBenchmark();
+
+	bool						Init(const RenderBenchmarkInitDesc& desc);
+	void						Release();
+
+	//رȶʧܺȱٲοͼ֮֡
+	uint32_t					Run();
+
+private:
+	bool						CreateGridCase();
+	bool						CreateBoxesCase();
+	bool						CreateSpheresCase();
+	bool						CreateModelCase(const std::string& fileName);
+
+	RenderDog::StaticModel*		CreateFloor(uint32_t width, uint32_t depth, float unit);
+	RenderDog::SimpleModel*		CreateGridLine(uint32_t width, uint32_t depth, float unit);
+
+	void						RunCase(const BenchmarkCase& benchCase, BenchmarkResult& result);
+	void						RegisterCaseToScene(const BenchmarkCase& benchCase);
+	void						UpdateCamera(const BenchmarkCase& benchCase, uint32_t frameIndex);
+
+	void						CompareWithReference(const std::string& fileName, BenchmarkResult& result);
+
+	void						PrintResult(const BenchmarkResult& result);
+	bool						WriteReport(const std::vector<BenchmarkResult>& results);
+
+	static bool					WriteBitmapFile(const std::string& fileName, const std::vector<uint32_t>& pixels, uint32_t width, uint32_t height);
+	static bool					ReadBitmapFile(const std::string& fileName, std::vector<uint32_t>& pixels, uint32_t& width, uint32_t& height);
+
+private:
+	RenderBenchmarkInitDesc		m_Desc;
+
+	RenderDog::IRenderDog*		m_pRenderDog;
+	RenderDog::IScene*			m_pScene;
+
+	RenderDog::FPSCamera*		m_pFPSCamera;
+	RenderDog::ILight*			m_pMainLight;
+
+	RenderDog::IMaterial*		m_pBasicMaterial;
+
+	std::vector<BenchmarkCase>	m_Cases;
+
+	std::vector<uint32_t>		m_FramePixels;
+	std::vector<uint32_t>		m_ReferencePixels;
+
+	double						m_MilliSecondsPerCount;
+};
+
+extern RenderBenchmark* g_pRenderBenchmark;